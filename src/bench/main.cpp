@@ -0,0 +1,445 @@
+// INDENTING (emacs/vi): -*- mode:c++; tab-width:2; c-basic-offset:2; intent-tabs-mode:nil; -*- ex: set tabstop=2 expandtab:
+
+/*
+ * Simple Geolocalization and Course Transmission Protocol (SGCTP)
+ * Copyright (C) 2014 Cedric Dufour <http://cedric.dufour.name>
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * free software:
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, Version 3.
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ */
+
+// C/C++
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+
+// SGCTP
+#include "sgctp/version.hpp"
+#include "sgctp/data.hpp"
+#include "sgctp/payload.hpp"
+#include "sgctp/payload_aes128.hpp"
+#include "sgctp/transmit_file.hpp"
+using namespace SGCTP;
+
+
+//----------------------------------------------------------------------
+// CONSTANTS / STATIC
+//----------------------------------------------------------------------
+
+/// Records (per mix) quantity
+static const int RECORDS = 1024;
+/// Default iterations (over all records) quantity
+static const int ITERATIONS = 200;
+
+/// Benchmark checksum (prevents the compiler from optimizing benchmarks away)
+static volatile uint64_t ui64tChecksum = 0;
+
+/// Return the current (monotonic) time, in nanoseconds
+static uint64_t nanoseconds()
+{
+  timespec __tTimespec;
+  clock_gettime( CLOCK_MONOTONIC, &__tTimespec );
+  return (uint64_t)__tTimespec.tv_sec * 1000000000ULL
+    + (uint64_t)__tTimespec.tv_nsec;
+}
+
+/// Return a pseudo-random value in the given range (deterministic)
+static double randomValue( double _fdMinimum,
+                           double _fdMaximum )
+{
+  static uint64_t __ui64tState = 88172645463325252ULL;
+  __ui64tState ^= __ui64tState << 13;
+  __ui64tState ^= __ui64tState >> 7;
+  __ui64tState ^= __ui64tState << 17;
+  return _fdMinimum
+    + ( _fdMaximum - _fdMinimum ) * (double)( __ui64tState % 1000001 ) / 1000000.0;
+}
+
+
+//----------------------------------------------------------------------
+// RECORD MIXES
+//----------------------------------------------------------------------
+
+/// Record mixes
+enum EMix {
+  MIX_GPS = 0,   ///< GPS-only (3D position and course)
+  MIX_ADSB = 1,  ///< ADS-B (3D position and course, along errors)
+  MIX_BLOB = 2,  ///< GPS along large data blobs
+  MIX_COUNT
+};
+
+/// Record mixes names
+static const char* MIX_NAMES[MIX_COUNT] = { "gps", "adsb", "blob" };
+
+/// Fill the given data object according to the given record mix
+static void makeData( CData *_poData,
+                      EMix _eMix,
+                      int _iIndex )
+{
+  static unsigned char __pucBlob[4096];
+  char __pcID[16];
+
+  _poData->reset();
+  _poData->setTime( 1402653600.0 + _iIndex * 0.1 );
+  _poData->setLatitude( randomValue( 45.0, 47.0 ) );
+  _poData->setLongitude( randomValue( 6.0, 8.0 ) );
+  _poData->setElevation( randomValue( 0.0, 4000.0 ) );
+  _poData->setBearing( randomValue( 0.0, 360.0 ) );
+  _poData->setGndSpeed( randomValue( 0.0, 50.0 ) );
+  _poData->setVrtSpeed( randomValue( -5.0, 5.0 ) );
+  switch( _eMix )
+  {
+
+  case MIX_GPS:
+    snprintf( __pcID, sizeof( __pcID ), "gps%d", _iIndex % 64 );
+    _poData->setID( __pcID );
+    _poData->setSourceType( CData::SOURCE_GPS );
+    break;
+
+  case MIX_ADSB:
+    snprintf( __pcID, sizeof( __pcID ), "%06X", 0x4B0000 + _iIndex % 512 );
+    _poData->setID( __pcID );
+    _poData->setSourceType( CData::SOURCE_ADSB );
+    _poData->setGndSpeed( randomValue( 50.0, 300.0 ) );
+    _poData->setVrtSpeed( randomValue( -20.0, 20.0 ) );
+    _poData->setElevation( randomValue( 0.0, 12000.0 ) );
+    _poData->setLatitudeError( randomValue( 0.0, 50.0 ) );
+    _poData->setLongitudeError( randomValue( 0.0, 50.0 ) );
+    _poData->setElevationError( randomValue( 0.0, 50.0 ) );
+    _poData->setBearingError( randomValue( 0.0, 5.0 ) );
+    _poData->setGndSpeedError( randomValue( 0.0, 5.0 ) );
+    _poData->setVrtSpeedError( randomValue( 0.0, 5.0 ) );
+    break;
+
+  case MIX_BLOB:
+    snprintf( __pcID, sizeof( __pcID ), "blob%d", _iIndex % 16 );
+    _poData->setID( __pcID );
+    for( unsigned int __i = 0; __i < sizeof( __pucBlob ); __i++ )
+      __pucBlob[__i] = (unsigned char)randomValue( 0.0, 255.0 );
+    _poData->setData( __pucBlob, 512 + _iIndex % 3584 );
+    break;
+
+  default:;
+  }
+}
+
+
+//----------------------------------------------------------------------
+// BENCHMARKS
+//----------------------------------------------------------------------
+
+/// Print the given benchmark result (JSON)
+static void report( const char *_pcName,
+                    EMix _eMix,
+                    uint64_t _ui64tRecords,
+                    uint64_t _ui64tNanoseconds )
+{
+  static bool __bFirst = true;
+  double __fdNanoseconds = (double)_ui64tNanoseconds / (double)_ui64tRecords;
+  printf( "%s    {\"name\": \"%s\", \"mix\": \"%s\", \"records\": %llu, \"ns_per_record\": %.1f, \"records_per_second\": %.0f}",
+          __bFirst ? "" : ",\n",
+          _pcName, MIX_NAMES[_eMix],
+          (unsigned long long)_ui64tRecords,
+          __fdNanoseconds,
+          1000000000.0 / __fdNanoseconds );
+  __bFirst = false;
+}
+
+/// Benchmark payload (un-)serialization
+static int benchPayload( const char *_pcName,
+                         CPayload *_poPayload,
+                         EMix _eMix,
+                         CData *_poData,
+                         int _iIterations )
+{
+  int __iReturn = 0;
+  unsigned char *__pucBuffer = CPayload::allocBuffer();
+  int __iBatchBufferSize = 0;
+  for( int __i = 0; __i < RECORDS; __i++ )
+    __iBatchBufferSize += _poPayload->encodedSize( _poData[__i] )+2;
+  unsigned char *__pucBatchBuffer =
+    (unsigned char*)malloc( __iBatchBufferSize );
+  CData __oData;
+  char __pcName[64];
+  uint64_t __ui64tStart;
+
+  do // Error-catching block
+  {
+    if( !__pucBuffer || !__pucBatchBuffer )
+    {
+      __iReturn = -ENOMEM;
+      break;
+    }
+
+    // Serialize
+    __ui64tStart = nanoseconds();
+    for( int __j = 0; __j < _iIterations && __iReturn >= 0; __j++ )
+      for( int __i = 0; __i < RECORDS; __i++ )
+      {
+        __iReturn = _poPayload->serialize( __pucBuffer, _poData[__i] );
+        if( __iReturn < 0 )
+          break;
+        ui64tChecksum += __iReturn;
+      }
+    if( __iReturn < 0 )
+      break;
+    snprintf( __pcName, sizeof( __pcName ), "%s_serialize", _pcName );
+    report( __pcName, _eMix,
+            (uint64_t)_iIterations * RECORDS,
+            nanoseconds() - __ui64tStart );
+
+    // Unserialize (all records, serialized as framed payloads)
+    int __iBatchSize =
+      _poPayload->serializeBatch( __pucBatchBuffer,
+                                  __iBatchBufferSize,
+                                  _poData, RECORDS );
+    if( __iBatchSize < 0 )
+    {
+      __iReturn = __iBatchSize;
+      break;
+    }
+    __ui64tStart = nanoseconds();
+    for( int __j = 0; __j < _iIterations && __iReturn >= 0; __j++ )
+      for( int __iOffset = 0; __iOffset < __iBatchSize; )
+      {
+        uint16_t __ui16tPayloadSize =
+          __pucBatchBuffer[__iOffset] << 8 | __pucBatchBuffer[__iOffset+1];
+        __iReturn = _poPayload->unserialize( &__oData,
+                                             __pucBatchBuffer+__iOffset+2,
+                                             __ui16tPayloadSize );
+        if( __iReturn < 0 )
+          break;
+        ui64tChecksum += __iReturn;
+        __iOffset += __ui16tPayloadSize+2;
+      }
+    if( __iReturn < 0 )
+      break;
+    snprintf( __pcName, sizeof( __pcName ), "%s_unserialize", _pcName );
+    report( __pcName, _eMix,
+            (uint64_t)_iIterations * RECORDS,
+            nanoseconds() - __ui64tStart );
+  }
+  while( false ); // Error-catching block
+
+  // Done
+  if( __pucBuffer )
+    CPayload::freeBuffer( __pucBuffer );
+  free( __pucBatchBuffer );
+  return ( __iReturn < 0 ) ? __iReturn : 0;
+}
+
+/// Benchmark data setters/getters, copy and synchronization
+static int benchData( EMix _eMix,
+                      CData *_poData,
+                      int _iIterations )
+{
+  CData __oData;
+
+  // Setters
+  uint64_t __ui64tStart = nanoseconds();
+  for( int __j = 0; __j < _iIterations; __j++ )
+    for( int __i = 0; __i < RECORDS; __i++ )
+    {
+      double __fdValue = __i * 0.001;
+      __oData.setTime( 1402653600.0 + __fdValue );
+      __oData.setLatitude( 46.0 + __fdValue );
+      __oData.setLongitude( 7.0 + __fdValue );
+      __oData.setElevation( 500.0 + __fdValue );
+      __oData.setBearing( 90.0 + __fdValue );
+      __oData.setGndSpeed( 10.0 + __fdValue );
+      __oData.setVrtSpeed( 1.0 + __fdValue );
+    }
+  report( "data_set", _eMix,
+          (uint64_t)_iIterations * RECORDS,
+          nanoseconds() - __ui64tStart );
+
+  // Getters
+  double __fdSum = 0.0;
+  __ui64tStart = nanoseconds();
+  for( int __j = 0; __j < _iIterations; __j++ )
+    for( int __i = 0; __i < RECORDS; __i++ )
+    {
+      const CData &__roData = _poData[__i];
+      __fdSum +=
+        __roData.getTime()
+        + __roData.getLatitude()
+        + __roData.getLongitude()
+        + __roData.getElevation()
+        + __roData.getBearing()
+        + __roData.getGndSpeed()
+        + __roData.getVrtSpeed();
+    }
+  report( "data_get", _eMix,
+          (uint64_t)_iIterations * RECORDS,
+          nanoseconds() - __ui64tStart );
+  ui64tChecksum += (uint64_t)__fdSum;
+
+  // Copy
+  __ui64tStart = nanoseconds();
+  for( int __j = 0; __j < _iIterations; __j++ )
+    for( int __i = 0; __i < RECORDS; __i++ )
+      __oData.copy( _poData[__i] );
+  report( "data_copy", _eMix,
+          (uint64_t)_iIterations * RECORDS,
+          nanoseconds() - __ui64tStart );
+
+  // Synchronization
+  __ui64tStart = nanoseconds();
+  for( int __j = 0; __j < _iIterations; __j++ )
+    for( int __i = 0; __i < RECORDS; __i++ )
+      ui64tChecksum += __oData.sync( _poData[__i] );
+  report( "data_sync", _eMix,
+          (uint64_t)_iIterations * RECORDS,
+          nanoseconds() - __ui64tStart );
+
+  // Done
+  return 0;
+}
+
+/// Benchmark file transmission round trips (serialization to and unserialization from file)
+static int benchFile( EMix _eMix,
+                      CData *_poData,
+                      int _iIterations )
+{
+  int __iReturn = 0;
+  char __pcPath[] = "/tmp/sgctp_bench.XXXXXX";
+  int __fd = mkstemp( __pcPath );
+  if( __fd < 0 )
+    return -errno;
+  close( __fd );
+  CTransmit_File __oTransmit_File;
+  __oTransmit_File.initPayload( CTransmit::PAYLOAD_RAW );
+  CData __oData;
+
+  uint64_t __ui64tStart = nanoseconds();
+  for( int __j = 0; __j < _iIterations; __j++ )
+  {
+    // ... serialize
+    __fd = open( __pcPath, O_TRUNC|O_WRONLY );
+    if( __fd < 0 )
+    {
+      __iReturn = -errno;
+      break;
+    }
+    for( int __i = 0; __i < RECORDS && __iReturn >= 0; __i++ )
+      __iReturn = __oTransmit_File.serialize( __fd, _poData[__i] );
+    __oTransmit_File.free();
+    close( __fd );
+    if( __iReturn < 0 )
+      break;
+
+    // ... unserialize
+    __fd = open( __pcPath, O_RDONLY );
+    if( __fd < 0 )
+    {
+      __iReturn = -errno;
+      break;
+    }
+    for( int __i = 0; __i < RECORDS && __iReturn > 0; __i++ )
+    {
+      __iReturn = __oTransmit_File.unserialize( __fd, &__oData );
+      ui64tChecksum += __iReturn;
+    }
+    __oTransmit_File.free();
+    close( __fd );
+    if( __iReturn <= 0 )
+    {
+      __iReturn = ( __iReturn < 0 ) ? __iReturn : -ENODATA;
+      break;
+    }
+  }
+  if( __iReturn >= 0 )
+    report( "file_roundtrip", _eMix,
+            (uint64_t)_iIterations * RECORDS,
+            nanoseconds() - __ui64tStart );
+  unlink( __pcPath );
+
+  // Done
+  return ( __iReturn < 0 ) ? __iReturn : 0;
+}
+
+
+//----------------------------------------------------------------------
+// MAIN
+//----------------------------------------------------------------------
+
+int main( int argc, char* argv[] )
+{
+  int __iReturn;
+
+  // Arguments
+  if( argc > 2 || ( argc == 2 && atoi( argv[1] ) <= 0 ) )
+  {
+    fprintf( stderr, "USAGE: sgctp_bench [<iterations>]\n" );
+    return EINVAL;
+  }
+  int __iIterations = ( argc == 2 ) ? atoi( argv[1] ) : ITERATIONS;
+
+  // Payloads
+  CPayload __oPayload_RAW;
+  CPayload_AES128 __oPayload_AES128;
+  __iReturn = __oPayload_AES128.makeCryptoKey( (unsigned char*)"password", 8,
+                                               (unsigned char*)"1234567890123456" );
+  if( __iReturn < 0 )
+  {
+    fprintf( stderr, "ERROR: Failed to create cryptographic key @ makeCryptoKey=%d\n", __iReturn );
+    return -__iReturn;
+  }
+
+  // Benchmarks
+  printf( "{\n  \"version\": \"%s\",\n  \"crypto\": \"%s\",\n  \"iterations\": %d,\n  \"results\": [\n",
+          SGCTP_VERSION_STRING,
+#ifdef __SGCTP_USE_OPENSSL__
+          "openssl",
+#else // __SGCTP_USE_OPENSSL__
+          "gcrypt",
+#endif // NOT __SGCTP_USE_OPENSSL__
+          __iIterations );
+  CData *__poData = new CData[RECORDS];
+  for( int __m = 0; __m < MIX_COUNT; __m++ )
+  {
+    EMix __eMix = (EMix)__m;
+    for( int __i = 0; __i < RECORDS; __i++ )
+      makeData( &__poData[__i], __eMix, __i );
+    do // Error-catching block
+    {
+      __iReturn = benchPayload( "payload", &__oPayload_RAW, __eMix, __poData, __iIterations );
+      if( __iReturn < 0 )
+        break;
+      __iReturn = benchPayload( "aes128", &__oPayload_AES128, __eMix, __poData, __iIterations );
+      if( __iReturn < 0 )
+        break;
+      __iReturn = benchData( __eMix, __poData, __iIterations );
+      if( __iReturn < 0 )
+        break;
+      __iReturn = benchFile( __eMix, __poData, __iIterations );
+    }
+    while( false ); // Error-catching block
+    if( __iReturn < 0 )
+      break;
+  }
+  delete[] __poData;
+  printf( "\n  ],\n  \"checksum\": %llu\n}\n", (unsigned long long)ui64tChecksum );
+  if( __iReturn < 0 )
+  {
+    fprintf( stderr, "ERROR: Benchmark failed @ %d\n", __iReturn );
+    return -__iReturn;
+  }
+
+  // Done
+  return 0;
+}
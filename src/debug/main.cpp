@@ -18,20 +18,32 @@
  */
 
 // C/C++
+#include <errno.h>
 #include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
 #include <string.h>
 #include <stdint.h>
 #include <time.h>
 #include <unistd.h>
+#include <sys/socket.h>
 #include <sys/time.h>
+#include <sys/wait.h>
+#include <utility>
 
 // SGCTP
+#include "sgctp/clock.hpp"
+#include "sgctp/columnar_reader.hpp"
+#include "sgctp/columnar_writer.hpp"
 #include "sgctp/data.hpp"
+#include "sgctp/data_block.hpp"
+#include "sgctp/id_table.hpp"
 #include "sgctp/parameters.hpp"
 #include "sgctp/payload.hpp"
 #include "sgctp/payload_aes128.hpp"
 #include "sgctp/principal.hpp"
 #include "sgctp/transmit_file.hpp"
+#include "sgctp/transmit_tcp.hpp"
 using namespace SGCTP;
 
 
@@ -59,6 +71,153 @@ int main( int argc, char* argv[] )
   char __pcData[] = "This is some very long data: 123456789 123456789 123456789 123456789 123456789 123456789 123456789 123456789 123456789 123456789 123456789 123456789";
   __oData_IN.setData( (unsigned char*)__pcData, strlen( __pcData ) );
 
+  // Payload buffer usage (serialization MUST leave the rest of the buffer untouched)
+  CPayload __oPayload;
+  unsigned char *__pucBuffer = CPayload::allocBuffer();
+  memset( __pucBuffer, 0xA5, CPayload::BUFFER_SIZE );
+  int __iPayloadSize = __oPayload.serialize( __pucBuffer, __oData_IN );
+  if( __iPayloadSize != (int)__oPayload.getBufferPutSize() )
+    return 1;
+  for( int __i = __iPayloadSize; __i < CPayload::BUFFER_SIZE; __i++ )
+    if( __pucBuffer[__i] != 0xA5 )
+      return 1;
+
+  // Payload peek (ID and size, without unserializing)
+  const char *__pcID;
+  uint8_t __ui8tIDLength;
+  if( __oPayload.peek( __pucBuffer, __iPayloadSize, NULL, &__pcID, &__ui8tIDLength ) != __iPayloadSize
+      || __ui8tIDLength != strlen( __oData_IN.getID() )
+      || memcmp( __pcID, __oData_IN.getID(), __ui8tIDLength ) )
+    return 1;
+  CPayload::freeBuffer( __pucBuffer );
+
+  // Compact data (long ID, overflow and copy/sync)
+  {
+    CData __oData_TMP, __oData_SYNC;
+    __oData_TMP.copy( __oData_IN );
+    __oData_TMP.setID( "SGCTP-long-identifier-0123456789" );
+    __oData_TMP.setGndSpeed( 10000.0 );
+    __oData_SYNC.setID( "SGCTP" );
+    __oData_SYNC.setLatitudeError( 1.0 );
+    __oData_SYNC.sync( __oData_TMP );
+    if( strcmp( __oData_TMP.getID(), "SGCTP-long-identifier-0123456789" )
+        || CData::isValid( __oData_TMP.getGndSpeed() )
+        || CData::isDefined( __oData_TMP.getLatitudeError() )
+        || __oData_TMP.getLongitude() != __oData_IN.getLongitude()
+        || strcmp( __oData_SYNC.getID(), "SGCTP" )
+        || __oData_SYNC.getLatitudeError() != 1.0
+        || __oData_SYNC.getTime() != __oData_IN.getTime()
+        || CData::isValid( __oData_SYNC.getGndSpeed() ) )
+      return 1;
+    __oData_TMP.setID( "SGCTP" );
+    if( strcmp( __oData_TMP.getID(), "SGCTP" ) )
+      return 1;
+
+    // ... small (inline) and large data; swap/move
+    __oData_SYNC.setData( (unsigned char*)"small", 5 );
+    __oData_TMP.swap( __oData_SYNC );
+    if( __oData_TMP.getDataSize() != 5
+        || memcmp( __oData_TMP.getData(), "small", 5 )
+        || __oData_SYNC.getDataSize() != __oData_IN.getDataSize()
+        || memcmp( __oData_SYNC.getData(), __oData_IN.getData(), __oData_IN.getDataSize() ) )
+      return 1;
+    CData __oData_MOVE( std::move( __oData_TMP ) );
+    __oData_TMP = std::move( __oData_SYNC );
+    if( __oData_MOVE.getDataSize() != 5
+        || memcmp( __oData_MOVE.getData(), "small", 5 )
+        || strcmp( __oData_MOVE.getID(), "SGCTP" )
+        || __oData_TMP.getDataSize() != __oData_IN.getDataSize()
+        || memcmp( __oData_TMP.getData(), __oData_IN.getData(), __oData_IN.getDataSize() ) )
+      return 1;
+  }
+
+  // ID interning table (handles MUST remain stable while the table grows)
+  {
+    CIDTable __oIDTable;
+    char __pcIDTable[16];
+    for( int __i = 0; __i < 1000; __i++ )
+    {
+      snprintf( __pcIDTable, sizeof( __pcIDTable ), "ID%d", __i );
+      if( __oIDTable.intern( __pcIDTable ) != (uint32_t)__i )
+        return 1;
+    }
+    for( int __i = 0; __i < 1000; __i++ )
+    {
+      snprintf( __pcIDTable, sizeof( __pcIDTable ), "ID%d", __i );
+      if( __oIDTable.intern( __pcIDTable ) != (uint32_t)__i
+          || __oIDTable.find( __pcIDTable ) != (uint32_t)__i
+          || strcmp( __oIDTable.getID( __i ), __pcIDTable ) )
+        return 1;
+    }
+    if( __oIDTable.getSize() != 1000
+        || __oIDTable.find( "ID1000" ) != CIDTable::INVALID_HANDLE )
+      return 1;
+    // ... erase (handles MUST be re-used and remaining IDs left untouched)
+    for( int __i = 0; __i < 1000; __i += 2 )
+      __oIDTable.erase( __i );
+    for( int __i = 0; __i < 1000; __i++ )
+    {
+      snprintf( __pcIDTable, sizeof( __pcIDTable ), "ID%d", __i );
+      if( __i % 2
+          ? __oIDTable.find( __pcIDTable ) != (uint32_t)__i || strcmp( __oIDTable.getID( __i ), __pcIDTable )
+          : __oIDTable.find( __pcIDTable ) != CIDTable::INVALID_HANDLE || __oIDTable.isValid( __i ) )
+        return 1;
+    }
+    for( int __i = 0; __i < 100000; __i++ )
+    {
+      snprintf( __pcIDTable, sizeof( __pcIDTable ), "NEW%d", __i );
+      uint32_t __ui32tIDTable = __oIDTable.intern( __pcIDTable );
+      if( __ui32tIDTable >= 1000 )
+        return 1;
+      __oIDTable.erase( __ui32tIDTable );
+    }
+    if( __oIDTable.getSize() != 500 || __oIDTable.getLimit() != 1000
+        || __oIDTable.find( "ID999" ) != 999 )
+      return 1;
+  }
+
+  // Clock (integer arithmetic MUST match gmtime/timegm)
+  {
+    const double __pfdEpochClock[] = { 0.5, 86399.95, 86400.0, 1400000000.25, 1400025599.9, -1.5 };
+    for( unsigned int __i = 0; __i < sizeof( __pfdEpochClock )/sizeof( double ); __i++ )
+    {
+      tm __tTmClock;
+      time_t __ttClock = (time_t)__pfdEpochClock[__i];
+      gmtime_r( &__ttClock, &__tTmClock );
+      double __fdTimeClock = 3600*__tTmClock.tm_hour + 60*__tTmClock.tm_min + __tTmClock.tm_sec
+        + ( __pfdEpochClock[__i] - (double)__ttClock );
+      __tTmClock.tm_hour = 0; __tTmClock.tm_min = 0; __tTmClock.tm_sec = 0;
+      if( CClock::toTime( __pfdEpochClock[__i] ) != __fdTimeClock
+          || CClock::toEpoch( 3600.5, __pfdEpochClock[__i] ) != timegm( &__tTmClock ) + 3600.5 )
+        return 1;
+    }
+    time_t __ttMidnight = CClock::midnight();
+    if( __ttMidnight % 86400
+        || CClock::now() - (double)__ttMidnight < 0
+        || CClock::now() - (double)__ttMidnight >= 86401 )
+      return 1;
+  }
+
+  // ISO-8601 (bulk formatting and parsing round-trip)
+  {
+    const double __pfdEpochIso8601[] = { 1400000000.25, 1400000001.5, 1400086399.999, 951825600.0, 45045.5 };
+    const char *__ppcIso8601[] = { "2014-05-13T16:53:20.250Z", "2014-05-13T16:53:21.500Z",
+                                   "2014-05-14T16:53:19.999Z", "2000-02-29T12:00:00.000Z", "12:30:45.500Z" };
+    char __pcIso8601[5*CClock::ISO8601_SIZE];
+    CClock::toIso8601( __pcIso8601, __pfdEpochIso8601, 5 );
+    for( int __i = 0; __i < 5; __i++ )
+    {
+      double __fdEpochIso8601;
+      if( strcmp( __pcIso8601 + __i*CClock::ISO8601_SIZE, __ppcIso8601[__i] )
+          || !CClock::fromIso8601( __ppcIso8601[__i], &__fdEpochIso8601 )
+          || fabs( __fdEpochIso8601 - __pfdEpochIso8601[__i] ) > 0.0005 )
+        return 1;
+    }
+    if( CData::fromIso8601( "2014-05-13 16:53:20" ) != 1400000000.0
+        || CData::fromIso8601( "1400000000.5" ) != 1400000000.5 )
+      return 1;
+  }
+
   // File dump
   int __fd;
   CTransmit_File __oTransmit_File;
@@ -87,7 +246,343 @@ int main( int argc, char* argv[] )
   __oTransmit_File.unserialize( __fd, &__oData_File_AES128 );
   __oTransmit_File.free();
   close( __fd );
+  // ... headerless file (payload size matching the header signature prefix)
+  {
+    CPayload __oPayload;
+    unsigned char __pucData[32767];
+    memset( __pucData, 'x', sizeof( __pucData ) );
+    CData __poData_File_SG[2];
+    __poData_File_SG[0].copy( __oData_IN );
+    __poData_File_SG[0].setData( __pucData, 128 );
+    __poData_File_SG[0].setData( __pucData, 128 + 0x5347 - __oPayload.encodedSize( __poData_File_SG[0] ) );
+    __poData_File_SG[1].copy( __oData_IN );
+    __oTransmit_File.initPayload( CTransmit::PAYLOAD_RAW );
+    __fd = open( "sgctp-file-sg.dat", O_CREAT|O_TRUNC|O_WRONLY, S_IRUSR|S_IWUSR );
+    __oTransmit_File.serializeBatch( __fd, __poData_File_SG, 2 );
+    __oTransmit_File.free();
+    close( __fd );
+    char __pcSignature[2];
+    __fd = open( "sgctp-file-sg.dat", O_RDONLY );
+    if( read( __fd, __pcSignature, 2 ) != 2
+        || memcmp( __pcSignature, "SG", 2 ) )
+      return 1;
+    lseek( __fd, 0, SEEK_SET );
+    CData __oData_File_SG;
+    if( __oTransmit_File.unserialize( __fd, &__oData_File_SG ) != 0x5347+2
+        || __oData_File_SG.getDataSize() != __poData_File_SG[0].getDataSize()
+        || __oTransmit_File.unserialize( __fd, &__oData_File_SG ) <= 0
+        || __oData_File_SG.getLatitude() != __oData_IN.getLatitude()
+        || __oTransmit_File.isFramed() )
+      return 1;
+    __oTransmit_File.free();
+    close( __fd );
+    __oTransmit_File.freePayload();
+  }
+  // ... batch (raw payload)
+  CData __poData_File_Batch[3];
+  for( int __i = 0; __i < 3; __i++ )
+    __poData_File_Batch[__i].copy( __oData_IN );
+  __oTransmit_File.initPayload( CTransmit::PAYLOAD_RAW );
+  __fd = open( "sgctp-file-batch.dat", O_CREAT|O_TRUNC|O_WRONLY, S_IRUSR|S_IWUSR );
+  int __iBatchSize = __oTransmit_File.serializeBatch( __fd, __poData_File_Batch, 3 );
+  __oTransmit_File.free();
+  close( __fd );
+  __fd = open( "sgctp-file-batch.dat", O_RDONLY );
+  for( int __i = 0; __i < 3; __i++ )
+  {
+    int __iReturn = __oTransmit_File.unserialize( __fd, &__poData_File_Batch[__i] );
+    if( __iReturn <= 0 )
+      return 1;
+    __iBatchSize -= __iReturn;
+  }
+  if( __iBatchSize != 0 )
+    return 1;
+  __oTransmit_File.free();
+  close( __fd );
+  // ... batch (raw payload; data block)
+  CDataBlock __oDataBlock;
+  __oDataBlock.alloc( 8 );
+  __fd = open( "sgctp-file-batch.dat", O_RDONLY );
+  while( !__oDataBlock.isFull() )
+    if( __oTransmit_File.unserializeBatch( __fd, &__oDataBlock ) <= 0 )
+      break;
+  __oTransmit_File.free();
+  close( __fd );
+  if( __oDataBlock.getSize() != 3 )
+    return 1;
+  double __pfdLatitude[3];
+  __oDataBlock.getValues<CField::LATITUDE>( __pfdLatitude );
+  for( int __i = 0; __i < 3; __i++ )
+  {
+    __oDataBlock.getRecord( __i, &__poData_File_Batch[__i] );
+    if( __pfdLatitude[__i] != __oData_IN.getLatitude()
+        || __poData_File_Batch[__i].getVrtSpeedDt() != __oData_IN.getVrtSpeedDt()
+        || strcmp( __oDataBlock.getID( __i ), __oData_IN.getID() )
+        || __oDataBlock.getDataSize( __i ) != __oData_IN.getDataSize()
+        || memcmp( __oDataBlock.getData( __i ), __oData_IN.getData(), __oData_IN.getDataSize() ) )
+      return 1;
+  }
+  __oTransmit_File.freePayload();
+  // ... batch (delta payload)
+  for( int __i = 0; __i < 3; __i++ )
+    __poData_File_Batch[__i].setLatitude( __oData_IN.getLatitude() + __i );
+  __oTransmit_File.initPayload( CTransmit::PAYLOAD_DELTA );
+  __fd = open( "sgctp-file-delta.dat", O_CREAT|O_TRUNC|O_WRONLY, S_IRUSR|S_IWUSR );
+  __oTransmit_File.serializeBatch( __fd, __poData_File_Batch, 3 );
+  __oTransmit_File.free();
+  close( __fd );
+  __fd = open( "sgctp-file-delta.dat", O_RDONLY );
+  for( int __i = 0; __i < 3; __i++ )
+  {
+    CData __oData_File_DELTA;
+    if( __oTransmit_File.unserialize( __fd, &__oData_File_DELTA ) <= 0
+        || __oData_File_DELTA.getLatitude() != __poData_File_Batch[__i].getLatitude()
+        || __oData_File_DELTA.getVrtSpeedDt() != __oData_IN.getVrtSpeedDt()
+        || strcmp( __oData_File_DELTA.getID(), __oData_IN.getID() ) )
+      return 1;
+  }
+  __oTransmit_File.free();
+  close( __fd );
   __oTransmit_File.freePayload();
+  // ... batch (raw payload; multi-record frames)
+  __oTransmit_File.initPayload( CTransmit::PAYLOAD_RAW );
+  __oTransmit_File.setFramed( true );
+  __fd = open( "sgctp-file-framed.dat", O_CREAT|O_TRUNC|O_WRONLY, S_IRUSR|S_IWUSR );
+  __oTransmit_File.serializeBatch( __fd, __poData_File_Batch, 3 );
+  __oTransmit_File.free();
+  close( __fd );
+  __oTransmit_File.setFramed( false );
+  __oDataBlock.reset();
+  __fd = open( "sgctp-file-framed.dat", O_RDONLY );
+  if( __oTransmit_File.unserializeBatch( __fd, &__oDataBlock ) <= 0
+      || !__oTransmit_File.isFramed()
+      || __oDataBlock.getSize() != 3 )
+    return 1;
+  __oTransmit_File.free();
+  close( __fd );
+  // ... batch (raw payload; compressed blocks)
+  __oTransmit_File.setCompression( CCompressor::COMPRESSION_LZ );
+  __fd = open( "sgctp-file-compressed.dat", O_CREAT|O_TRUNC|O_WRONLY, S_IRUSR|S_IWUSR );
+  __oTransmit_File.serializeBatch( __fd, __poData_File_Batch, 3 );
+  // NOTE: flush() may be called several times; the block index is written once, by finish()
+  if( __oTransmit_File.flush( __fd ) < 0
+      || __oTransmit_File.flush( __fd ) < 0
+      || __oTransmit_File.finish( __fd ) < 0
+      || __oTransmit_File.finish( __fd ) != 0 )
+    return 1;
+  __oTransmit_File.free();
+  close( __fd );
+  __oTransmit_File.setCompression( CCompressor::COMPRESSION_NONE );
+  {
+    unsigned char __pucFile[4096];
+    __fd = open( "sgctp-file-compressed.dat", O_RDONLY );
+    int __iFileSize = read( __fd, __pucFile, sizeof( __pucFile ) );
+    close( __fd );
+    if( __iFileSize < 4
+        || memcmp( __pucFile+__iFileSize-4, "SGIX", 4 )
+        || memmem( __pucFile, __iFileSize-4, "SGIX", 4 ) )
+      return 1;
+  }
+  __oDataBlock.reset();
+  __fd = open( "sgctp-file-compressed.dat", O_RDONLY );
+  if( __oTransmit_File.unserializeBatch( __fd, &__oDataBlock ) <= 0
+      || !__oTransmit_File.isCompressed()
+      || __oDataBlock.getSize() != 3 )
+    return 1;
+  __oTransmit_File.free();
+  close( __fd );
+  // ... batch (raw payload; buffered output)
+  __oTransmit_File.setOutputBuffer( 4096 );
+  __fd = open( "sgctp-file-buffered.dat", O_CREAT|O_TRUNC|O_WRONLY, S_IRUSR|S_IWUSR );
+  __oTransmit_File.serializeBatch( __fd, __poData_File_Batch, 3 );
+  if( lseek( __fd, 0, SEEK_END ) != 0
+      || __oTransmit_File.flush( __fd ) < 0
+      || lseek( __fd, 0, SEEK_END ) <= 0 )
+    return 1;
+  __oTransmit_File.free();
+  close( __fd );
+  __oTransmit_File.setOutputBuffer( 0 );
+  __oTransmit_File.freePayload();
+  // ... columnar archive (projection and ID filter)
+  CColumnar_Writer __oColumnar_Writer;
+  __fd = open( "sgctp-file-columnar.sgctpc", O_CREAT|O_TRUNC|O_WRONLY, S_IRUSR|S_IWUSR );
+  for( int __i = 0; __i < 3; __i++ )
+    __oColumnar_Writer.write( __fd, __poData_File_Batch[__i] );
+  __oColumnar_Writer.flush( __fd );
+  __oColumnar_Writer.free();
+  close( __fd );
+  CColumnar_Reader __oColumnar_Reader;
+  __oColumnar_Reader.setProjection( CColumnar::columnMask( CField::TIME ) );
+  __oColumnar_Reader.setFilterID( __oData_IN.getID() );
+  __fd = open( "sgctp-file-columnar.sgctpc", O_RDONLY );
+  if( __oColumnar_Reader.read( __fd, &__oDataBlock ) != 3
+      || CField::toValue<CField::TIME>( __oDataBlock.getColumn( CField::TIME )[0] ) != __oData_IN.getTime() )
+    return 1;
+  __oColumnar_Reader.free();
+  close( __fd );
+  // ... file index (tell/seek)
+  __oTransmit_File.initPayload( CTransmit::PAYLOAD_RAW );
+  __fd = open( "sgctp-file-batch.dat", O_RDONLY );
+  __oTransmit_File.unserialize( __fd, &__oData_File_RAW );
+  int64_t __i64tOffset = __oTransmit_File.tell();
+  int __iRecordSize = __oTransmit_File.unserialize( __fd, &__oData_File_RAW );
+  if( __i64tOffset <= 0
+      || __oTransmit_File.seek( __fd, __i64tOffset ) < 0
+      || __oTransmit_File.unserialize( __fd, &__oData_File_RAW ) != __iRecordSize
+      || __oTransmit_File.tell() != __i64tOffset + __iRecordSize )
+    return 1;
+  __oTransmit_File.free();
+  close( __fd );
+  // ... memory-mapped file (compressed blocks)
+  __oTransmit_File.setMapped( true );
+  __oDataBlock.reset();
+  __fd = open( "sgctp-file-compressed.dat", O_RDONLY );
+  if( __oTransmit_File.unserializeBatch( __fd, &__oDataBlock ) <= 0
+      || !__oTransmit_File.isMapped()
+      || __oDataBlock.getSize() != 3
+      || __oTransmit_File.unserializeBatch( __fd, &__oDataBlock ) != 0 )
+    return 1;
+  __oTransmit_File.setMapped( false );
+  close( __fd );
+  // ... asynchronous file (buffered output; read ahead)
+  // NOTE: io_uring may not be available (synchronous I/O is then used)
+  if( __oTransmit_File.setAsync( true ) >= 0 )
+  {
+    __oTransmit_File.setOutputBuffer( 4096 );
+    __fd = open( "sgctp-file-async.dat", O_CREAT|O_TRUNC|O_WRONLY, S_IRUSR|S_IWUSR );
+    for( int __i = 0; __i < 1000; __i++ )
+      __oTransmit_File.serializeBatch( __fd, __poData_File_Batch, 3 );
+    if( __oTransmit_File.flush( __fd ) < 0 )
+      return 1;
+    __oTransmit_File.free();
+    close( __fd );
+    __oTransmit_File.setOutputBuffer( 0 );
+    __fd = open( "sgctp-file-async.dat", O_RDONLY );
+    int __iRecords = 0;
+    __oDataBlock.reset();
+    while( __oTransmit_File.unserializeBatch( __fd, &__oDataBlock ) > 0 )
+    {
+      __iRecords += __oDataBlock.getSize();
+      __oDataBlock.reset();
+    }
+    if( __iRecords != 3000 )
+      return 1;
+    __oTransmit_File.setAsync( false );
+    close( __fd );
+  }
+  // ... batch (raw payload; transient send error)
+  // NOTE: unsent data are kept in the batch buffer and sent on retry (rather than lost)
+  {
+    unsigned char __pucData[30000];
+    memset( __pucData, 'x', sizeof( __pucData ) );
+    CData __poData_File_Retry[3];
+    for( int __i = 0; __i < 3; __i++ )
+    {
+      __poData_File_Retry[__i].copy( __oData_IN );
+      __poData_File_Retry[__i].setData( __pucData, sizeof( __pucData ) );
+    }
+    int __pfd[2];
+    if( pipe2( __pfd, O_NONBLOCK ) < 0 )
+      return 1;
+    __oTransmit_File.initPayload( CTransmit::PAYLOAD_RAW );
+    __fd = open( "sgctp-file-retry.dat", O_CREAT|O_TRUNC|O_WRONLY, S_IRUSR|S_IWUSR );
+    int __iReturn = __oTransmit_File.serializeBatch( __pfd[1], __poData_File_Retry, 3 );
+    if( __iReturn != -EAGAIN )
+      return 1;
+    do
+    {
+      int __iSize;
+      while( ( __iSize = read( __pfd[0], __pucData, sizeof( __pucData ) ) ) > 0 )
+        if( write( __fd, __pucData, __iSize ) != __iSize )
+          return 1;
+      if( __iReturn < 0 && __iReturn != -EAGAIN )
+        return 1;
+      __iReturn = __oTransmit_File.flushFrames( __pfd[1] );
+    }
+    while( __iReturn );
+    __oTransmit_File.free();
+    close( __pfd[0] );
+    close( __pfd[1] );
+    close( __fd );
+    __fd = open( "sgctp-file-retry.dat", O_RDONLY );
+    for( int __i = 0; __i < 3; __i++ )
+      if( __oTransmit_File.unserialize( __fd, &__poData_File_Retry[__i] ) <= 0
+          || __poData_File_Retry[__i].getDataSize() != sizeof( __pucData ) )
+        return 1;
+    __oTransmit_File.free();
+    close( __fd );
+  }
+  __oTransmit_File.freePayload();
+
+  // Non-blocking (incremental) unserialization
+  int __psd[2];
+  if( socketpair( AF_UNIX, SOCK_STREAM, 0, __psd ) < 0 )
+    return 1;
+  CTransmit_TCP __oTransmit_TCP_OUT, __oTransmit_TCP_IN;
+  __oTransmit_TCP_OUT.initPayload( CTransmit::PAYLOAD_RAW );
+  __oTransmit_TCP_IN.initPayload( CTransmit::PAYLOAD_RAW );
+  int __iSize = __oTransmit_TCP_OUT.serialize( __psd[0], __oData_IN );
+  unsigned char __pucPayload[CPayload::BUFFER_SIZE];
+  if( __iSize <= 0 || recv( __psd[1], __pucPayload, __iSize, MSG_WAITALL ) != __iSize )
+    return 1;
+  CData __oData_TCP;
+  if( __oTransmit_TCP_IN.tryUnserialize( __psd[1], &__oData_TCP ) != -EAGAIN )
+    return 1;
+  for( int __i = 0; __i < __iSize; __i++ )
+  {
+    send( __psd[0], __pucPayload+__i, 1, 0 );
+    int __iReturn = __oTransmit_TCP_IN.tryUnserialize( __psd[1], &__oData_TCP );
+    if( __iReturn != ( ( __i < __iSize-1 ) ? -EAGAIN : __iSize ) )
+      return 1;
+  }
+  if( strcmp( __oData_TCP.getID(), __oData_IN.getID() )
+      || __oData_TCP.getLatitude() != __oData_IN.getLatitude() )
+    return 1;
+  close( __psd[0] );
+  if( __oTransmit_TCP_IN.tryUnserialize( __psd[1], &__oData_TCP ) != 0 )
+    return 1;
+  close( __psd[1] );
+
+  // Re-connection (delta payload state reset at handshake)
+  CTransmit_TCP __oTransmit_TCP_Client;
+  __oTransmit_TCP_Client.initPayload( CTransmit::PAYLOAD_DELTA );
+  for( int __iConnection = 0; __iConnection < 2; __iConnection++ )
+  {
+    if( socketpair( AF_UNIX, SOCK_STREAM, 0, __psd ) < 0 )
+      return 1;
+    pid_t __pid = fork();
+    if( __pid < 0 )
+      return 1;
+    if( !__pid )
+    {
+      // ... server (fresh transmission object, as per connection)
+      close( __psd[0] );
+      CTransmit_TCP __oTransmit_TCP_Server;
+      if( __oTransmit_TCP_Server.recvHandshake( __psd[1] ) <= 0 )
+        _exit( 1 );
+      for( int __i = 0; __i < 3; __i++ )
+        if( __oTransmit_TCP_Server.unserialize( __psd[1], &__oData_TCP ) <= 0
+            || __oData_TCP.getLatitude() != __oData_IN.getLatitude() + __i )
+          _exit( 1 );
+      _exit( 0 );
+    }
+    // ... client (same transmission object, across connections)
+    close( __psd[1] );
+    int __iReturn = __oTransmit_TCP_Client.sendHandshake( __psd[0] );
+    for( int __i = 0; __i < 3 && __iReturn > 0; __i++ )
+    {
+      CData __oData_Delta;
+      __oData_Delta.copy( __oData_IN );
+      __oData_Delta.setLatitude( __oData_IN.getLatitude() + __i );
+      __iReturn = __oTransmit_TCP_Client.serialize( __psd[0], __oData_Delta );
+    }
+    close( __psd[0] );
+    int __iStatus;
+    if( waitpid( __pid, &__iStatus, 0 ) != __pid
+        || !WIFEXITED( __iStatus ) || WEXITSTATUS( __iStatus )
+        || __iReturn <= 0 )
+      return 1;
+  }
 
   // Done
   return 0;
@@ -0,0 +1,293 @@
+// INDENTING (emacs/vi): -*- mode:c++; tab-width:2; c-basic-offset:2; intent-tabs-mode:nil; -*- ex: set tabstop=2 expandtab:
+
+/*
+ * Simple Geolocalization and Course Transmission Protocol (SGCTP)
+ * Copyright (C) 2014 Cedric Dufour <http://cedric.dufour.name>
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * free software:
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, Version 3.
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ */
+
+// C
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+// SGCTP
+#include "sgctp/clock.hpp"
+using namespace SGCTP;
+
+
+//----------------------------------------------------------------------
+// CONSTANTS / STATIC
+//----------------------------------------------------------------------
+
+thread_local time_t CClock::ttIso8601Date = 1; // NOTE: never a midnight
+thread_local char CClock::pcIso8601Date[11];
+
+double CClock::now()
+{
+  timespec __tTimespec;
+  clock_gettime( CLOCK_REALTIME, &__tTimespec );
+  return( (double)__tTimespec.tv_sec
+          + (double)__tTimespec.tv_nsec/1000000000.0 );
+}
+
+double CClock::nowCoarse()
+{
+  timespec __tTimespec;
+#ifdef CLOCK_REALTIME_COARSE
+  clock_gettime( CLOCK_REALTIME_COARSE, &__tTimespec );
+#else
+  clock_gettime( CLOCK_REALTIME, &__tTimespec );
+#endif
+  return( (double)__tTimespec.tv_sec
+          + (double)__tTimespec.tv_nsec/1000000000.0 );
+}
+
+time_t CClock::midnight()
+{
+  return midnight( (time_t)now() );
+}
+
+double CClock::toEpoch( double _fdTime,
+                        double _fdEpochReference )
+{
+  if( __isnanl( _fdTime ) ) return 0.0;
+
+  // Build "fully qualified" UNIX epoch
+  double __fdEpoch;
+  time_t __ttNow = 0;
+  if( _fdEpochReference == 0 )
+  {
+    __ttNow = (time_t)nowCoarse();
+    __fdEpoch = (double)midnight( __ttNow ) + _fdTime;
+  }
+  else
+    __fdEpoch = (double)midnight( (time_t)_fdEpochReference ) + _fdTime;
+
+  // Fix midnight innacuracies
+  if( _fdEpochReference == 0
+      && _fdTime >= 43000
+      && ( __ttNow - (time_t)__fdEpoch ) >= 43000 )
+    __fdEpoch -= DAY;
+
+  // Done
+  return __fdEpoch;
+}
+
+double CClock::toTime( double _fdEpoch )
+{
+  time_t __ttEpoch = (time_t)_fdEpoch;
+  double __fd;
+  return (double)( __ttEpoch - midnight( __ttEpoch ) ) + modf( _fdEpoch, &__fd );
+}
+
+time_t CClock::fromDate( int _iYear,
+                         int _iMonth,
+                         int _iDay )
+{
+  // NOTE: days from civil (H. Hinnant's algorithm; March-based years)
+  int64_t __i64tYear = _iYear - ( _iMonth <= 2 );
+  int64_t __i64tEra = ( __i64tYear >= 0 ? __i64tYear : __i64tYear-399 ) / 400;
+  int64_t __i64tYearOfEra = __i64tYear - __i64tEra * 400;
+  int64_t __i64tDayOfYear = ( 153 * ( _iMonth > 2 ? _iMonth-3 : _iMonth+9 ) + 2 ) / 5 + _iDay-1;
+  int64_t __i64tDayOfEra = __i64tYearOfEra * 365 + __i64tYearOfEra/4 - __i64tYearOfEra/100 + __i64tDayOfYear;
+  return (time_t)( ( __i64tEra * 146097 + __i64tDayOfEra - 719468 ) * DAY );
+}
+
+void CClock::toDate( time_t _ttEpoch,
+                     int *_piYear,
+                     int *_piMonth,
+                     int *_piDay )
+{
+  // NOTE: civil from days (H. Hinnant's algorithm; March-based years)
+  int64_t __i64tDays = (int64_t)( midnight( _ttEpoch ) / DAY ) + 719468;
+  int64_t __i64tEra = ( __i64tDays >= 0 ? __i64tDays : __i64tDays-146096 ) / 146097;
+  int64_t __i64tDayOfEra = __i64tDays - __i64tEra * 146097;
+  int64_t __i64tYearOfEra =
+    ( __i64tDayOfEra - __i64tDayOfEra/1460 + __i64tDayOfEra/36524 - __i64tDayOfEra/146096 ) / 365;
+  int64_t __i64tDayOfYear =
+    __i64tDayOfEra - ( 365 * __i64tYearOfEra + __i64tYearOfEra/4 - __i64tYearOfEra/100 );
+  int64_t __i64tMonth = ( 5 * __i64tDayOfYear + 2 ) / 153;
+  *_piDay = (int)( __i64tDayOfYear - ( 153 * __i64tMonth + 2 ) / 5 + 1 );
+  *_piMonth = (int)( __i64tMonth < 10 ? __i64tMonth+3 : __i64tMonth-9 );
+  *_piYear = (int)( __i64tYearOfEra + __i64tEra * 400 + ( *_piMonth <= 2 ) );
+}
+
+int CClock::toIso8601( char *_pcIso8601,
+                       double _fdEpoch )
+{
+  // Split epoch (milliseconds)
+  int64_t __i64tMilliseconds = (int64_t)floor( _fdEpoch * 1000.0 + 0.5 );
+  int64_t __i64tSeconds = __i64tMilliseconds / 1000;
+  int __iMilliseconds = (int)( __i64tMilliseconds % 1000 );
+  if( __iMilliseconds < 0 )
+  {
+    __i64tSeconds -= 1;
+    __iMilliseconds += 1000;
+  }
+  time_t __ttMidnight = midnight( (time_t)__i64tSeconds );
+  int __iTime = (int)( __i64tSeconds - __ttMidnight );
+
+  // Date ("YYYY-MM-DDT"; cached)
+  char *__pc = _pcIso8601;
+  if( _fdEpoch >= DAY )
+  {
+    if( __ttMidnight != ttIso8601Date )
+    {
+      int __iYear, __iMonth, __iDay;
+      toDate( __ttMidnight, &__iYear, &__iMonth, &__iDay );
+      pcIso8601Date[0] = '0' + __iYear/1000 % 10;
+      pcIso8601Date[1] = '0' + __iYear/100 % 10;
+      pcIso8601Date[2] = '0' + __iYear/10 % 10;
+      pcIso8601Date[3] = '0' + __iYear % 10;
+      pcIso8601Date[4] = '-';
+      pcIso8601Date[5] = '0' + __iMonth/10;
+      pcIso8601Date[6] = '0' + __iMonth % 10;
+      pcIso8601Date[7] = '-';
+      pcIso8601Date[8] = '0' + __iDay/10;
+      pcIso8601Date[9] = '0' + __iDay % 10;
+      pcIso8601Date[10] = 'T';
+      ttIso8601Date = __ttMidnight;
+    }
+    memcpy( __pc, pcIso8601Date, 11 );
+    __pc += 11;
+  }
+
+  // Time ("HH:MM:SS.sssZ")
+  int __iHour = __iTime / 3600;
+  int __iMinute = __iTime / 60 % 60;
+  int __iSecond = __iTime % 60;
+  __pc[0] = '0' + __iHour/10;
+  __pc[1] = '0' + __iHour % 10;
+  __pc[2] = ':';
+  __pc[3] = '0' + __iMinute/10;
+  __pc[4] = '0' + __iMinute % 10;
+  __pc[5] = ':';
+  __pc[6] = '0' + __iSecond/10;
+  __pc[7] = '0' + __iSecond % 10;
+  __pc[8] = '.';
+  __pc[9] = '0' + __iMilliseconds/100;
+  __pc[10] = '0' + __iMilliseconds/10 % 10;
+  __pc[11] = '0' + __iMilliseconds % 10;
+  __pc[12] = 'Z';
+  __pc[13] = '\0';
+
+  // Done
+  return __pc + 13 - _pcIso8601;
+}
+
+void CClock::toIso8601( char *_pcIso8601,
+                        const double *_pfdEpoch,
+                        unsigned int _uiCount )
+{
+  for( unsigned int __ui = 0; __ui < _uiCount; __ui++ )
+    toIso8601( _pcIso8601 + __ui * ISO8601_SIZE, _pfdEpoch[__ui] );
+}
+
+const char* CClock::fromIso8601( const char *_pcIso8601,
+                                 double *_pfdEpoch )
+{
+  const char *__pc;
+  time_t __ttEpoch = 0;
+  int __iYear, __iMonth, __iDay;
+  do
+  {
+    // ... date
+    __pc = parseNumber( _pcIso8601, 4, 0, 9999, &__iYear );
+    if( __pc && *__pc == '-' )
+      __pc = parseNumber( __pc+1, 2, 1, 12, &__iMonth );
+    else
+      __pc = NULL;
+    if( __pc && *__pc == '-' )
+      __pc = parseNumber( __pc+1, 2, 1, 31, &__iDay );
+    else
+      __pc = NULL;
+    if( __pc )
+    {
+      __ttEpoch = fromDate( __iYear, __iMonth, __iDay );
+      // ... date/time
+      if( *__pc == 'T' || *__pc == ' ' )
+      {
+        time_t __ttTime;
+        const char *__pcTime = parseTime( __pc+1, &__ttTime );
+        if( __pcTime )
+        {
+          __ttEpoch += __ttTime;
+          __pc = __pcTime;
+        }
+      }
+      break;
+    }
+    // ... time
+    __pc = parseTime( _pcIso8601, &__ttEpoch );
+    if( __pc ) break;
+    return NULL;
+  }
+  while( false );
+  *_pfdEpoch = (double)__ttEpoch;
+
+  // Sub-seconds
+  if( *__pc == '.' )
+  {
+    int64_t __i64tNumerator = 0, __i64tDenominator = 1;
+    for( __pc++; *__pc >= '0' && *__pc <= '9'; __pc++ )
+    {
+      // NOTE: numerator and denominator remain exact (and so does their division)
+      if( __i64tDenominator >= 1000000000000000LL ) continue;
+      __i64tNumerator = __i64tNumerator * 10 + ( *__pc - '0' );
+      __i64tDenominator *= 10;
+    }
+    *_pfdEpoch += (double)__i64tNumerator / (double)__i64tDenominator;
+  }
+
+  // Done
+  return __pc;
+}
+
+const char* CClock::parseNumber( const char *_pcNumber,
+                                 int _iDigits,
+                                 int _iMin,
+                                 int _iMax,
+                                 int *_piValue )
+{
+  int __iValue = 0, __iDigits = 0;
+  while( __iDigits < _iDigits && *_pcNumber >= '0' && *_pcNumber <= '9' )
+  {
+    __iValue = __iValue * 10 + ( *_pcNumber++ - '0' );
+    __iDigits++;
+  }
+  if( !__iDigits || __iValue < _iMin || __iValue > _iMax )
+    return NULL;
+  *_piValue = __iValue;
+  return _pcNumber;
+}
+
+const char* CClock::parseTime( const char *_pcTime,
+                               time_t *_ptTime )
+{
+  int __iHour, __iMinute, __iSecond;
+  const char *__pc = parseNumber( _pcTime, 2, 0, 23, &__iHour );
+  if( __pc && *__pc == ':' )
+    __pc = parseNumber( __pc+1, 2, 0, 59, &__iMinute );
+  else
+    return NULL;
+  if( __pc && *__pc == ':' )
+    __pc = parseNumber( __pc+1, 2, 0, 60, &__iSecond );
+  else
+    return NULL;
+  if( __pc )
+    *_ptTime = 3600*__iHour + 60*__iMinute + __iSecond;
+  return __pc;
+}
@@ -0,0 +1,142 @@
+// INDENTING (emacs/vi): -*- mode:c++; tab-width:2; c-basic-offset:2; intent-tabs-mode:nil; -*- ex: set tabstop=2 expandtab:
+
+/*
+ * Simple Geolocalization and Course Transmission Protocol (SGCTP)
+ * Copyright (C) 2014 Cedric Dufour <http://cedric.dufour.name>
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * free software:
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, Version 3.
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ */
+
+// C
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+// SGCTP
+#include "sgctp/columnar.hpp"
+using namespace SGCTP;
+
+
+//----------------------------------------------------------------------
+// CONSTANTS / STATIC
+//----------------------------------------------------------------------
+
+const char* const CColumnar::COLUMN_NAMES[COLUMN_COUNT] = {
+  "time", "lat", "lon", "ele", "bng", "gsd", "vsd", "rtn", "gac", "vac", "hng", "asd",
+  "srct", "elat", "elon", "eele", "ebng", "egsd", "evsd", "ertn", "egac", "evac", "ehng", "easd",
+  "id", "data"
+};
+
+int CColumnar::getColumn( const char *_pcName )
+{
+  for( int __i = 0; __i < COLUMN_COUNT; __i++ )
+    if( !strcmp( _pcName, COLUMN_NAMES[__i] ) )
+      return __i;
+  return -EINVAL;
+}
+
+uint32_t CColumnar::payloadColumns( uint32_t _ui32tColumns )
+{
+  uint32_t __ui32tColumns = _ui32tColumns;
+  for( int __iField = 0; __iField < CField::COUNT; __iField++ )
+  {
+    if( !( _ui32tColumns & columnMask( __iField ) ) )
+      continue;
+    for( uint8_t __ui8tGroup = CField::FIELDS[__iField].ui8tGroup;
+         __ui8tGroup != CField::GROUP_NONE;
+         __ui8tGroup = CField::GROUPS[__ui8tGroup].ui8tParent )
+      __ui32tColumns |= CField::groupFields( __ui8tGroup );
+  }
+  return __ui32tColumns;
+}
+
+uint8_t CColumnar::columnEncoding( int _iColumn )
+{
+  switch( _iColumn )
+  {
+  case CField::TIME: return ENCODING_DELTA2;
+  case COLUMN_ID: return ENCODING_DICTIONARY;
+  case COLUMN_DATA: return ENCODING_PLAIN;
+  default:;
+  }
+  return ENCODING_DELTA;
+}
+
+int CColumnar::writeFile( int _iFileDescriptor,
+                          const void *_pBuffer,
+                          int _iSize )
+{
+  int __iReturn;
+  int __iSentSize = 0;
+  while( __iSentSize < _iSize )
+  {
+    __iReturn = ::write( _iFileDescriptor, (const unsigned char*)_pBuffer+__iSentSize, _iSize-__iSentSize );
+    if( __iReturn < 0 )
+    {
+      if( errno == EINTR )
+        continue;
+      return -errno;
+    }
+    __iSentSize += __iReturn;
+  }
+  return __iSentSize;
+}
+
+int CColumnar::readFile( int _iFileDescriptor,
+                         void *_pBuffer,
+                         int _iSize )
+{
+  int __iReturn;
+  int __iReceivedSize = 0;
+  while( __iReceivedSize < _iSize )
+  {
+    __iReturn = ::read( _iFileDescriptor, (unsigned char*)_pBuffer+__iReceivedSize, _iSize-__iReceivedSize );
+    if( __iReturn < 0 )
+    {
+      if( errno == EINTR )
+        continue;
+      return -errno;
+    }
+    if( !__iReturn )
+      break;
+    __iReceivedSize += __iReturn;
+  }
+  return __iReceivedSize;
+}
+
+int CColumnar::skipFile( int _iFileDescriptor,
+                         uint32_t _ui32tSize )
+{
+  int __iReturn;
+
+  // Seek
+  if( lseek( _iFileDescriptor, _ui32tSize, SEEK_CUR ) >= 0 )
+    return 0;
+  if( errno != ESPIPE )
+    return -errno;
+
+  // Read (non-seekable file)
+  unsigned char __pucBuffer[4096];
+  while( _ui32tSize )
+  {
+    int __iSize = ( _ui32tSize < sizeof( __pucBuffer ) ) ? _ui32tSize : sizeof( __pucBuffer );
+    __iReturn = readFile( _iFileDescriptor, __pucBuffer, __iSize );
+    if( __iReturn != __iSize )
+      return
+        ( __iReturn < 0 )
+        ? __iReturn
+        : -EPROTO;
+    _ui32tSize -= __iSize;
+  }
+  return 0;
+}
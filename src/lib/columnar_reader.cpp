@@ -0,0 +1,443 @@
+// INDENTING (emacs/vi): -*- mode:c++; tab-width:2; c-basic-offset:2; intent-tabs-mode:nil; -*- ex: set tabstop=2 expandtab:
+
+/*
+ * Simple Geolocalization and Course Transmission Protocol (SGCTP)
+ * Copyright (C) 2014 Cedric Dufour <http://cedric.dufour.name>
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * free software:
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, Version 3.
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ */
+
+// C
+#include <errno.h>
+#include <string.h>
+#include <arpa/inet.h>
+
+// SGCTP
+#include "sgctp/columnar_reader.hpp"
+#include "sgctp/data.hpp"
+#include "sgctp/data_block.hpp"
+using namespace SGCTP;
+
+
+//----------------------------------------------------------------------
+// METHODS
+//----------------------------------------------------------------------
+
+int CColumnar_Reader::recvFileHeader( int _iFileDescriptor )
+{
+  int __iReturn;
+
+  // Receive header
+  unsigned char __pucFileHeader[FILE_HEADER_SIZE];
+  __iReturn = readFile( _iFileDescriptor, __pucFileHeader, FILE_HEADER_SIZE );
+  if( __iReturn != FILE_HEADER_SIZE )
+    return
+      ( __iReturn <= 0 )
+      ? __iReturn
+      : -EPROTO;
+  if( memcmp( __pucFileHeader, "SGCTPC", 6 )
+      || __pucFileHeader[6] != FILE_VERSION )
+    return -EPROTO;
+  bFileHeaderReceived = true;
+  ui64tBytesRead += FILE_HEADER_SIZE;
+
+  // Done
+  return FILE_HEADER_SIZE;
+}
+
+int CColumnar_Reader::decodeColumn( int _iColumn,
+                                    int _iRows,
+                                    CDataBlock *_poDataBlock )
+{
+  int __iReturn;
+  const unsigned char *__pucBuffer = ucColumn_vector.data();
+  int __iBufferSize = ucColumn_vector.size();
+  int __iOffset = 0;
+  uint64_t __ui64tValue;
+
+  switch( _iColumn )
+  {
+
+  case COLUMN_ID:
+    {
+      // ... dictionary
+      __iReturn = getVarint( __pucBuffer, __iBufferSize, &__iOffset, &__ui64tValue );
+      if( __iReturn < 0 )
+        return __iReturn;
+      if( __ui64tValue > (uint64_t)_iRows )
+        return -EPROTO;
+      vector<int> __iEntries_vector( __ui64tValue );
+      i64tFilterIDIndex = -1;
+      for( uint32_t __i = 0; __i < __iEntries_vector.size(); __i++ )
+      {
+        if( __iOffset >= __iBufferSize )
+          return -EPROTO;
+        uint8_t __ui8tLength = __pucBuffer[__iOffset];
+        if( __ui8tLength > CData::MAX_ID_LENGTH
+            || __iOffset + 1 + __ui8tLength > __iBufferSize )
+          return -EPROTO;
+        __iEntries_vector[__i] = __iOffset;
+        if( !sFilterID.empty()
+            && sFilterID.size() == __ui8tLength
+            && !memcmp( sFilterID.data(), __pucBuffer+__iOffset+1, __ui8tLength ) )
+          i64tFilterIDIndex = __i;
+        __iOffset += 1 + __ui8tLength;
+      }
+      // ... index
+      ui32tIDIndex_vector.resize( _iRows );
+      uint32_t __ui32tIDsSize = 0;
+      for( int __i = 0; __i < _iRows; __i++ )
+      {
+        __iReturn = getVarint( __pucBuffer, __iBufferSize, &__iOffset, &__ui64tValue );
+        if( __iReturn < 0 )
+          return __iReturn;
+        if( __ui64tValue >= __iEntries_vector.size() )
+          return -EPROTO;
+        ui32tIDIndex_vector[__i] = __ui64tValue;
+        __ui32tIDsSize += __pucBuffer[__iEntries_vector[__ui64tValue]] + 1;
+      }
+      // ... IDs
+      __iReturn = _poDataBlock->reserve( __ui32tIDsSize, 0 );
+      if( __iReturn < 0 )
+        return __iReturn;
+      uint32_t __ui32tIDOffset = 0;
+      for( int __i = 0; __i < _iRows; __i++ )
+      {
+        const unsigned char *__pucEntry = __pucBuffer + __iEntries_vector[ui32tIDIndex_vector[__i]];
+        memcpy( _poDataBlock->pcIDs + __ui32tIDOffset, __pucEntry+1, __pucEntry[0] );
+        __ui32tIDOffset += __pucEntry[0];
+        _poDataBlock->pcIDs[__ui32tIDOffset++] = '\0';
+        _poDataBlock->pui32tIDOffsets[__i+1] = __ui32tIDOffset;
+      }
+    }
+    break;
+
+  case COLUMN_DATA:
+    {
+      // ... presence bitmap
+      const unsigned char *__pucBitmap = __pucBuffer;
+      __iOffset = ( _iRows+7 ) / 8;
+      if( __iOffset > __iBufferSize )
+        return -EPROTO;
+      // ... data
+      __iReturn = _poDataBlock->reserve( 0, __iBufferSize );
+      if( __iReturn < 0 )
+        return __iReturn;
+      uint32_t __ui32tDataOffset = 0;
+      for( int __i = 0; __i < _iRows; __i++ )
+      {
+        if( __pucBitmap[__i >> 3] & ( 1 << ( __i & 7 ) ) )
+        {
+          __iReturn = getVarint( __pucBuffer, __iBufferSize, &__iOffset, &__ui64tValue );
+          if( __iReturn < 0 )
+            return __iReturn;
+          if( __ui64tValue > CData::MAX_DATA_SIZE
+              || __iOffset + __ui64tValue > (uint64_t)__iBufferSize )
+            return -EPROTO;
+          memcpy( _poDataBlock->pucData + __ui32tDataOffset, __pucBuffer+__iOffset, __ui64tValue );
+          __iOffset += __ui64tValue;
+          __ui32tDataOffset += __ui64tValue;
+        }
+        _poDataBlock->pui32tDataOffsets[__i+1] = __ui32tDataOffset;
+      }
+    }
+    break;
+
+  default:
+    {
+      // ... presence bitmap
+      const unsigned char *__pucBitmap = __pucBuffer;
+      __iOffset = ( _iRows+7 ) / 8;
+      if( __iOffset > __iBufferSize )
+        return -EPROTO;
+      // ... values
+      uint32_t *__pui32tColumn = _poDataBlock->pui32tFields + _iColumn * _poDataBlock->iCapacity;
+      bool __bDelta2 = columnEncoding( _iColumn ) == ENCODING_DELTA2;
+      int64_t __i64tPrevious = 0;
+      int64_t __i64tPreviousDelta = 0;
+      for( int __i = 0; __i < _iRows; __i++ )
+      {
+        if( !( __pucBitmap[__i >> 3] & ( 1 << ( __i & 7 ) ) ) )
+          continue;
+        __iReturn = getVarint( __pucBuffer, __iBufferSize, &__iOffset, &__ui64tValue );
+        if( __iReturn < 0 )
+          return __iReturn;
+        int64_t __i64tDelta = unzigzag( __ui64tValue );
+        if( __bDelta2 )
+        {
+          __i64tDelta += __i64tPreviousDelta;
+          __i64tPreviousDelta = __i64tDelta;
+        }
+        __i64tPrevious += __i64tDelta;
+        if( __i64tPrevious < 0 || __i64tPrevious >= CField::UNDEFINED_UINT32 )
+          return -EPROTO;
+        __pui32tColumn[__i] = __i64tPrevious;
+        _poDataBlock->pui32tDefined[__i] |= 1u << _iColumn;
+      }
+    }
+    break;
+
+  }
+
+  // Done
+  return 0;
+}
+
+void CColumnar_Reader::filterRows( CDataBlock *_poDataBlock )
+{
+  int __iRows = _poDataBlock->iSize;
+  int __iCapacity = _poDataBlock->iCapacity;
+  uint32_t *__pui32tFields = _poDataBlock->pui32tFields;
+  uint32_t *__pui32tIDOffsets = _poDataBlock->pui32tIDOffsets;
+  uint32_t *__pui32tDataOffsets = _poDataBlock->pui32tDataOffsets;
+  bool __bFilterID = !sFilterID.empty();
+
+  // Filter (and compact) records
+  int __iSize = 0;
+  for( int __i = 0; __i < __iRows; __i++ )
+  {
+    // ... filter
+    if( __bFilterID && ui32tIDIndex_vector[__i] != i64tFilterIDIndex )
+      continue;
+    bool __bMatch = true;
+    for( vector<TFilter>::const_iterator __it = tFilters_vector.begin();
+         __it != tFilters_vector.end();
+         ++__it )
+    {
+      uint32_t __ui32tValue = __pui32tFields[__it->ui8tField * __iCapacity + __i];
+      if( __ui32tValue & CField::UNDEFINED_UINT32
+          || __ui32tValue < __it->ui32tMinimum
+          || __ui32tValue > __it->ui32tMaximum )
+      {
+        __bMatch = false;
+        break;
+      }
+    }
+    if( !__bMatch )
+      continue;
+
+    // ... compact
+    if( __iSize != __i )
+    {
+      for( int __j = 0; __j < CField::COUNT; __j++ )
+        __pui32tFields[__j * __iCapacity + __iSize] = __pui32tFields[__j * __iCapacity + __i];
+      _poDataBlock->pui32tDefined[__iSize] = _poDataBlock->pui32tDefined[__i];
+      uint32_t __ui32tIDStart = __pui32tIDOffsets[__i];
+      uint32_t __ui32tIDSize = __pui32tIDOffsets[__i+1] - __ui32tIDStart;
+      memmove( _poDataBlock->pcIDs + __pui32tIDOffsets[__iSize],
+               _poDataBlock->pcIDs + __ui32tIDStart,
+               __ui32tIDSize );
+      __pui32tIDOffsets[__iSize+1] = __pui32tIDOffsets[__iSize] + __ui32tIDSize;
+      uint32_t __ui32tDataStart = __pui32tDataOffsets[__i];
+      uint32_t __ui32tDataSize = __pui32tDataOffsets[__i+1] - __ui32tDataStart;
+      memmove( _poDataBlock->pucData + __pui32tDataOffsets[__iSize],
+               _poDataBlock->pucData + __ui32tDataStart,
+               __ui32tDataSize );
+      __pui32tDataOffsets[__iSize+1] = __pui32tDataOffsets[__iSize] + __ui32tDataSize;
+    }
+    __iSize++;
+  }
+  _poDataBlock->iSize = __iSize;
+}
+
+void CColumnar_Reader::addFilter( CField::EField _eField,
+                                  uint32_t _ui32tMinimum,
+                                  uint32_t _ui32tMaximum )
+{
+  TFilter __tFilter;
+  __tFilter.ui8tField = _eField;
+  __tFilter.ui32tMinimum = _ui32tMinimum;
+  __tFilter.ui32tMaximum = _ui32tMaximum;
+  tFilters_vector.push_back( __tFilter );
+}
+
+int CColumnar_Reader::read( int _iFileDescriptor,
+                            CDataBlock *_poDataBlock )
+{
+  int __iReturn;
+
+  // File header
+  if( !bFileHeaderReceived )
+  {
+    __iReturn = recvFileHeader( _iFileDescriptor );
+    if( __iReturn <= 0 )
+      return __iReturn;
+  }
+
+  // Decoded columns (projection and filters)
+  uint32_t __ui32tColumns = ui32tProjection;
+  for( vector<TFilter>::const_iterator __it = tFilters_vector.begin();
+       __it != tFilters_vector.end();
+       ++__it )
+    __ui32tColumns |= columnMask( __it->ui8tField );
+  if( !sFilterID.empty() )
+    __ui32tColumns |= columnMask( COLUMN_ID );
+
+  // Loop through row groups
+  for(;;)
+  {
+    // Row group header
+    ucHeader_vector.resize( ROW_GROUP_HEADER_SIZE );
+    __iReturn = readFile( _iFileDescriptor, ucHeader_vector.data(), ROW_GROUP_HEADER_SIZE );
+    if( __iReturn != ROW_GROUP_HEADER_SIZE )
+      return
+        ( __iReturn <= 0 )
+        ? __iReturn
+        : -EPROTO;
+    uint32_t __ui32tRows_NS, __ui32tColumnsSize_NS;
+    memcpy( &__ui32tRows_NS, ucHeader_vector.data(), 4 );
+    memcpy( &__ui32tColumnsSize_NS, ucHeader_vector.data()+4, 4 );
+    int __iRows = ntohl( __ui32tRows_NS );
+    uint32_t __ui32tColumnsSize = ntohl( __ui32tColumnsSize_NS );
+    int __iColumnsCount = ucHeader_vector[8];
+    if( __iRows <= 0 || __iColumnsCount > COLUMN_COUNT )
+      return -EPROTO;
+
+    // Columns directory
+    ucHeader_vector.resize( ROW_GROUP_HEADER_SIZE + __iColumnsCount * COLUMN_ENTRY_SIZE );
+    __iReturn = readFile( _iFileDescriptor, ucHeader_vector.data()+ROW_GROUP_HEADER_SIZE, __iColumnsCount * COLUMN_ENTRY_SIZE );
+    if( __iReturn != __iColumnsCount * COLUMN_ENTRY_SIZE )
+      return
+        ( __iReturn < 0 )
+        ? __iReturn
+        : -EPROTO;
+    ui64tBytesRead += ucHeader_vector.size();
+    const unsigned char *__pucDirectory = ucHeader_vector.data() + ROW_GROUP_HEADER_SIZE;
+
+    // Predicate pushdown (columns statistics)
+    bool __bSkip = false;
+    for( vector<TFilter>::const_iterator __it = tFilters_vector.begin();
+         __it != tFilters_vector.end() && !__bSkip;
+         ++__it )
+    {
+      __bSkip = true; // undefined (not stored) column
+      for( int __i = 0; __i < __iColumnsCount; __i++ )
+      {
+        const unsigned char *__pucEntry = __pucDirectory + __i * COLUMN_ENTRY_SIZE;
+        if( __pucEntry[0] != __it->ui8tField )
+          continue;
+        // NOTE: directory entries are (possibly) unaligned; let's use memcpy
+        uint32_t __ui32tMinimum_NS, __ui32tMaximum_NS;
+        memcpy( &__ui32tMinimum_NS, __pucEntry+8, 4 );
+        memcpy( &__ui32tMaximum_NS, __pucEntry+12, 4 );
+        __bSkip =
+          ntohl( __ui32tMaximum_NS ) < __it->ui32tMinimum
+          || ntohl( __ui32tMinimum_NS ) > __it->ui32tMaximum;
+        break;
+      }
+    }
+    if( __bSkip )
+    {
+      __iReturn = skipFile( _iFileDescriptor, __ui32tColumnsSize );
+      if( __iReturn < 0 )
+        return __iReturn;
+      ui64tBytesSkipped += __ui32tColumnsSize;
+      continue;
+    }
+
+    // Prepare data block
+    if( _poDataBlock->getCapacity() < __iRows )
+    {
+      __iReturn = _poDataBlock->alloc( __iRows );
+      if( __iReturn < 0 )
+        return __iReturn;
+    }
+    _poDataBlock->reset();
+    int __iCapacity = _poDataBlock->iCapacity;
+    for( int __i = 0; __i < CField::COUNT; __i++ )
+    {
+      uint32_t *__pui32tColumn = _poDataBlock->pui32tFields + __i * __iCapacity;
+      for( int __j = 0; __j < __iRows; __j++ )
+        __pui32tColumn[__j] = CField::UNDEFINED_UINT32;
+    }
+    memset( _poDataBlock->pui32tDefined, 0, __iRows * sizeof( uint32_t ) );
+    // ... (empty) IDs and data
+    __iReturn = _poDataBlock->reserve( __iRows, 0 );
+    if( __iReturn < 0 )
+      return __iReturn;
+    memset( _poDataBlock->pcIDs, 0, __iRows );
+    for( int __i = 0; __i < __iRows; __i++ )
+    {
+      _poDataBlock->pui32tIDOffsets[__i+1] = __i+1;
+      _poDataBlock->pui32tDataOffsets[__i+1] = 0;
+    }
+
+    // Columns
+    uint32_t __ui32tSkipSize = 0;
+    i64tFilterIDIndex = -1;
+    for( int __i = 0; __i < __iColumnsCount; __i++ )
+    {
+      const unsigned char *__pucEntry = __pucDirectory + __i * COLUMN_ENTRY_SIZE;
+      int __iColumn = __pucEntry[0];
+      uint32_t __ui32tSize_NS;
+      memcpy( &__ui32tSize_NS, __pucEntry+4, 4 );
+      uint32_t __ui32tSize = ntohl( __ui32tSize_NS );
+      if( __iColumn >= COLUMN_COUNT || __pucEntry[1] != columnEncoding( __iColumn ) )
+        return -EPROTO;
+      // ... skip (projection or ID filter mismatch)
+      if( __bSkip || !( __ui32tColumns & columnMask( __iColumn ) ) )
+      {
+        __ui32tSkipSize += __ui32tSize;
+        continue;
+      }
+      if( __ui32tSkipSize )
+      {
+        __iReturn = skipFile( _iFileDescriptor, __ui32tSkipSize );
+        if( __iReturn < 0 )
+          return __iReturn;
+        ui64tBytesSkipped += __ui32tSkipSize;
+        __ui32tSkipSize = 0;
+      }
+      // ... decode
+      ucColumn_vector.resize( __ui32tSize );
+      __iReturn = readFile( _iFileDescriptor, ucColumn_vector.data(), __ui32tSize );
+      if( __iReturn != (int)__ui32tSize )
+        return
+          ( __iReturn < 0 )
+          ? __iReturn
+          : -EPROTO;
+      ui64tBytesRead += __ui32tSize;
+      __iReturn = decodeColumn( __iColumn, __iRows, _poDataBlock );
+      if( __iReturn < 0 )
+        return __iReturn;
+      if( __iColumn == COLUMN_ID && !sFilterID.empty() && i64tFilterIDIndex < 0 )
+        __bSkip = true;
+    }
+    if( __ui32tSkipSize )
+    {
+      __iReturn = skipFile( _iFileDescriptor, __ui32tSkipSize );
+      if( __iReturn < 0 )
+        return __iReturn;
+      ui64tBytesSkipped += __ui32tSkipSize;
+    }
+    if( __bSkip || ( !sFilterID.empty() && i64tFilterIDIndex < 0 ) )
+      continue;
+    _poDataBlock->iSize = __iRows;
+
+    // Filter records
+    if( !tFilters_vector.empty() || !sFilterID.empty() )
+      filterRows( _poDataBlock );
+    if( _poDataBlock->iSize )
+      return _poDataBlock->iSize;
+  }
+}
+
+void CColumnar_Reader::free()
+{
+  ucHeader_vector.clear();
+  ucColumn_vector.clear();
+  ui32tIDIndex_vector.clear();
+  bFileHeaderReceived = false;
+  ui64tBytesRead = 0;
+  ui64tBytesSkipped = 0;
+}
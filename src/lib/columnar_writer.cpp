@@ -0,0 +1,268 @@
+// INDENTING (emacs/vi): -*- mode:c++; tab-width:2; c-basic-offset:2; intent-tabs-mode:nil; -*- ex: set tabstop=2 expandtab:
+
+/*
+ * Simple Geolocalization and Course Transmission Protocol (SGCTP)
+ * Copyright (C) 2014 Cedric Dufour <http://cedric.dufour.name>
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * free software:
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, Version 3.
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ */
+
+// C
+#include <errno.h>
+#include <string.h>
+#include <arpa/inet.h>
+
+// C++
+#include <string>
+#include <unordered_map>
+using namespace std;
+
+// SGCTP
+#include "sgctp/columnar_writer.hpp"
+#include "sgctp/data.hpp"
+#include "sgctp/data_block.hpp"
+using namespace SGCTP;
+
+
+//----------------------------------------------------------------------
+// METHODS
+//----------------------------------------------------------------------
+
+void CColumnar_Writer::encodeColumn( int _iColumn )
+{
+  int __iRows = oDataBlock.getSize();
+  int __iColumnStart = ucColumns_vector.size();
+  uint32_t __ui32tMinimum = 0;
+  uint32_t __ui32tMaximum = 0;
+
+  // Encode column
+  switch( _iColumn )
+  {
+
+  case COLUMN_ID:
+    {
+      // ... dictionary
+      unordered_map<string,uint32_t> __ui32tDictionary_umap;
+      vector<uint32_t> __ui32tIndex_vector( __iRows );
+      vector<const char*> __pcEntries_vector;
+      for( int __i = 0; __i < __iRows; __i++ )
+      {
+        const char *__pcID = oDataBlock.getID( __i );
+        unordered_map<string,uint32_t>::const_iterator __it =
+          __ui32tDictionary_umap.find( __pcID );
+        if( __it == __ui32tDictionary_umap.end() )
+        {
+          __it = __ui32tDictionary_umap.insert( make_pair( string( __pcID ), (uint32_t)__pcEntries_vector.size() ) ).first;
+          __pcEntries_vector.push_back( __pcID );
+        }
+        __ui32tIndex_vector[__i] = __it->second;
+      }
+      putVarint( &ucColumns_vector, __pcEntries_vector.size() );
+      for( vector<const char*>::const_iterator __it = __pcEntries_vector.begin();
+           __it != __pcEntries_vector.end();
+           ++__it )
+      {
+        uint8_t __ui8tLength = strlen( *__it );
+        ucColumns_vector.push_back( __ui8tLength );
+        ucColumns_vector.insert( ucColumns_vector.end(), *__it, *__it+__ui8tLength );
+      }
+      // ... index
+      for( int __i = 0; __i < __iRows; __i++ )
+        putVarint( &ucColumns_vector, __ui32tIndex_vector[__i] );
+    }
+    break;
+
+  case COLUMN_DATA:
+    {
+      // ... presence bitmap
+      int __iBitmapStart = ucColumns_vector.size();
+      ucColumns_vector.resize( __iBitmapStart + ( __iRows+7 ) / 8, 0 );
+      bool __bData = false;
+      for( int __i = 0; __i < __iRows; __i++ )
+      {
+        uint16_t __ui16tDataSize = oDataBlock.getDataSize( __i );
+        if( !__ui16tDataSize )
+          continue;
+        __bData = true;
+        ucColumns_vector[__iBitmapStart + ( __i >> 3 )] |= 1 << ( __i & 7 );
+        putVarint( &ucColumns_vector, __ui16tDataSize );
+        const unsigned char *__pucData = oDataBlock.getData( __i );
+        ucColumns_vector.insert( ucColumns_vector.end(), __pucData, __pucData+__ui16tDataSize );
+      }
+      if( !__bData )
+      {
+        ucColumns_vector.resize( __iColumnStart );
+        return;
+      }
+    }
+    break;
+
+  default:
+    {
+      // ... presence bitmap
+      const uint32_t *__pui32tColumn = oDataBlock.getColumn( (CField::EField)_iColumn );
+      int __iBitmapStart = ucColumns_vector.size();
+      ucColumns_vector.resize( __iBitmapStart + ( __iRows+7 ) / 8, 0 );
+      bool __bDefined = false;
+      bool __bDelta2 = columnEncoding( _iColumn ) == ENCODING_DELTA2;
+      int64_t __i64tPrevious = 0;
+      int64_t __i64tPreviousDelta = 0;
+      for( int __i = 0; __i < __iRows; __i++ )
+      {
+        uint32_t __ui32tValue = __pui32tColumn[__i];
+        if( __ui32tValue & CField::UNDEFINED_UINT32 )
+          continue;
+        if( !__bDefined )
+        {
+          __bDefined = true;
+          __ui32tMinimum = __ui32tMaximum = __ui32tValue;
+        }
+        else if( __ui32tValue < __ui32tMinimum )
+          __ui32tMinimum = __ui32tValue;
+        else if( __ui32tValue > __ui32tMaximum )
+          __ui32tMaximum = __ui32tValue;
+        ucColumns_vector[__iBitmapStart + ( __i >> 3 )] |= 1 << ( __i & 7 );
+        // ... values
+        int64_t __i64tDelta = (int64_t)__ui32tValue - __i64tPrevious;
+        __i64tPrevious = __ui32tValue;
+        if( __bDelta2 )
+        {
+          putVarint( &ucColumns_vector, zigzag( __i64tDelta - __i64tPreviousDelta ) );
+          __i64tPreviousDelta = __i64tDelta;
+        }
+        else
+          putVarint( &ucColumns_vector, zigzag( __i64tDelta ) );
+      }
+      if( !__bDefined )
+      {
+        ucColumns_vector.resize( __iColumnStart );
+        return;
+      }
+    }
+    break;
+
+  }
+
+  // Directory entry
+  uint32_t __ui32tSize = ucColumns_vector.size() - __iColumnStart;
+  unsigned char __pucEntry[COLUMN_ENTRY_SIZE];
+  __pucEntry[0] = _iColumn;
+  __pucEntry[1] = columnEncoding( _iColumn );
+  __pucEntry[2] = 0;
+  __pucEntry[3] = 0;
+  // NOTE: multi-byte fields are (possibly) unaligned; let's use memcpy
+  uint32_t __ui32tSize_NS = htonl( __ui32tSize );
+  uint32_t __ui32tMinimum_NS = htonl( __ui32tMinimum );
+  uint32_t __ui32tMaximum_NS = htonl( __ui32tMaximum );
+  memcpy( __pucEntry+4, &__ui32tSize_NS, 4 );
+  memcpy( __pucEntry+8, &__ui32tMinimum_NS, 4 );
+  memcpy( __pucEntry+12, &__ui32tMaximum_NS, 4 );
+  ucHeader_vector.insert( ucHeader_vector.end(), __pucEntry, __pucEntry+COLUMN_ENTRY_SIZE );
+}
+
+int CColumnar_Writer::writeRowGroup( int _iFileDescriptor )
+{
+  int __iReturn;
+  int __iSentSize = 0;
+
+  // Check row group
+  if( !oDataBlock.getSize() )
+    return 0;
+
+  // File header
+  if( !bFileHeaderSent )
+  {
+    unsigned char __pucFileHeader[FILE_HEADER_SIZE];
+    memcpy( __pucFileHeader, "SGCTPC", 6 );
+    __pucFileHeader[6] = FILE_VERSION;
+    __pucFileHeader[7] = 0;
+    __iReturn = writeFile( _iFileDescriptor, __pucFileHeader, FILE_HEADER_SIZE );
+    if( __iReturn < 0 )
+      return __iReturn;
+    bFileHeaderSent = true;
+    __iSentSize += __iReturn;
+  }
+
+  // Encode columns
+  ucHeader_vector.assign( ROW_GROUP_HEADER_SIZE, 0 );
+  ucColumns_vector.clear();
+  encodeColumn( COLUMN_ID );
+  for( int __i = 0; __i < CField::COUNT; __i++ )
+    encodeColumn( __i );
+  encodeColumn( COLUMN_DATA );
+
+  // Row group header
+  uint32_t __ui32tRows_NS = htonl( oDataBlock.getSize() );
+  uint32_t __ui32tColumnsSize_NS = htonl( ucColumns_vector.size() );
+  memcpy( ucHeader_vector.data(), &__ui32tRows_NS, 4 );
+  memcpy( ucHeader_vector.data()+4, &__ui32tColumnsSize_NS, 4 );
+  ucHeader_vector[8] = ( ucHeader_vector.size() - ROW_GROUP_HEADER_SIZE ) / COLUMN_ENTRY_SIZE;
+
+  // Write row group
+  __iReturn = writeFile( _iFileDescriptor, ucHeader_vector.data(), ucHeader_vector.size() );
+  if( __iReturn < 0 )
+    return __iReturn;
+  __iSentSize += __iReturn;
+  __iReturn = writeFile( _iFileDescriptor, ucColumns_vector.data(), ucColumns_vector.size() );
+  if( __iReturn < 0 )
+    return __iReturn;
+  __iSentSize += __iReturn;
+  oDataBlock.reset();
+
+  // Done
+  return __iSentSize;
+}
+
+int CColumnar_Writer::alloc( int _iRowGroupSize )
+{
+  return oDataBlock.alloc( _iRowGroupSize );
+}
+
+void CColumnar_Writer::free()
+{
+  oDataBlock.free();
+  ucHeader_vector.clear();
+  ucColumns_vector.clear();
+  bFileHeaderSent = false;
+}
+
+int CColumnar_Writer::write( int _iFileDescriptor,
+                             const CData &_roData )
+{
+  int __iReturn;
+
+  // Check resources
+  if( !oDataBlock.getCapacity() )
+  {
+    __iReturn = alloc();
+    if( __iReturn < 0 )
+      return __iReturn;
+  }
+
+  // Buffer data
+  __iReturn = oDataBlock.append( _roData );
+  if( __iReturn < 0 )
+    return __iReturn;
+
+  // Write row group (when full)
+  if( oDataBlock.isFull() )
+    return writeRowGroup( _iFileDescriptor );
+
+  // Done
+  return 0;
+}
+
+int CColumnar_Writer::flush( int _iFileDescriptor )
+{
+  return writeRowGroup( _iFileDescriptor );
+}
@@ -0,0 +1,287 @@
+// INDENTING (emacs/vi): -*- mode:c++; tab-width:2; c-basic-offset:2; intent-tabs-mode:nil; -*- ex: set tabstop=2 expandtab:
+
+/*
+ * Simple Geolocalization and Course Transmission Protocol (SGCTP)
+ * Copyright (C) 2014 Cedric Dufour <http://cedric.dufour.name>
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * free software:
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, Version 3.
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ */
+
+// C
+#include <errno.h>
+#include <string.h>
+
+#ifdef __SGCTP_USE_ZLIB__
+
+// ZLib
+#include "zlib.h"
+
+#endif // __SGCTP_USE_ZLIB__
+
+// SGCTP
+#include "sgctp/compressor.hpp"
+using namespace SGCTP;
+
+
+//----------------------------------------------------------------------
+// CONSTANTS / STATIC
+//----------------------------------------------------------------------
+
+bool CCompressor::isAvailable( uint8_t _ui8tCompressionType )
+{
+  switch( _ui8tCompressionType )
+  {
+  case COMPRESSION_NONE:
+  case COMPRESSION_LZ:
+    return true;
+#ifdef __SGCTP_USE_ZLIB__
+  case COMPRESSION_ZLIB:
+    return true;
+#endif // __SGCTP_USE_ZLIB__
+  default:;
+  }
+  return false;
+}
+
+int CCompressor::compress( uint8_t _ui8tCompressionType,
+                           const unsigned char *_pucInput,
+                           int _iInputSize,
+                           unsigned char *_pucOutput,
+                           int _iOutputSize )
+{
+  switch( _ui8tCompressionType )
+  {
+
+  case COMPRESSION_NONE:
+    if( _iInputSize > _iOutputSize )
+      return -ENOSPC;
+    memcpy( _pucOutput, _pucInput, _iInputSize );
+    return _iInputSize;
+
+  case COMPRESSION_LZ:
+    return compressLZ( _pucInput, _iInputSize, _pucOutput, _iOutputSize );
+
+#ifdef __SGCTP_USE_ZLIB__
+  case COMPRESSION_ZLIB:
+    {
+      uLongf __ulOutputSize = _iOutputSize;
+      int __iReturn = ::compress2( _pucOutput, &__ulOutputSize,
+                                   _pucInput, _iInputSize,
+                                   Z_BEST_COMPRESSION );
+      if( __iReturn != Z_OK )
+        return
+          ( __iReturn == Z_BUF_ERROR )
+          ? -ENOSPC
+          : -ENOMEM;
+      return (int)__ulOutputSize;
+    }
+#endif // __SGCTP_USE_ZLIB__
+
+  default:;
+  }
+  return -ENOTSUP;
+}
+
+int CCompressor::decompress( uint8_t _ui8tCompressionType,
+                             const unsigned char *_pucInput,
+                             int _iInputSize,
+                             unsigned char *_pucOutput,
+                             int _iOutputSize )
+{
+  switch( _ui8tCompressionType )
+  {
+
+  case COMPRESSION_NONE:
+    if( _iInputSize > _iOutputSize )
+      return -EPROTO;
+    memcpy( _pucOutput, _pucInput, _iInputSize );
+    return _iInputSize;
+
+  case COMPRESSION_LZ:
+    return decompressLZ( _pucInput, _iInputSize, _pucOutput, _iOutputSize );
+
+#ifdef __SGCTP_USE_ZLIB__
+  case COMPRESSION_ZLIB:
+    {
+      uLongf __ulOutputSize = _iOutputSize;
+      int __iReturn = ::uncompress( _pucOutput, &__ulOutputSize,
+                                    _pucInput, _iInputSize );
+      if( __iReturn != Z_OK )
+        return
+          ( __iReturn == Z_MEM_ERROR )
+          ? -ENOMEM
+          : -EPROTO;
+      return (int)__ulOutputSize;
+    }
+#endif // __SGCTP_USE_ZLIB__
+
+  default:;
+  }
+  return -ENOTSUP;
+}
+
+int CCompressor::compressLZ( const unsigned char *_pucInput,
+                             int _iInputSize,
+                             unsigned char *_pucOutput,
+                             int _iOutputSize )
+{
+  // Sequence: token (literals length << 4 | match length - 4), extended
+  //           literals length, literals, match offset (16-bit), extended
+  //           match length; the last sequence contains only literals
+  int __iReturn;
+  int __piHashTable[1 << LZ_HASH_BITS];
+  memset( __piHashTable, -1, sizeof( __piHashTable ) );
+  int __iInput = 0;
+  int __iAnchor = 0;
+  int __iOutput = 0;
+
+  for(;;)
+  {
+    // Find match
+    int __iMatchLength = 0;
+    int __iMatchOffset = 0;
+    while( __iInput + LZ_MIN_MATCH <= _iInputSize )
+    {
+      uint32_t __ui32tSequence;
+      memcpy( &__ui32tSequence, _pucInput+__iInput, 4 );
+      uint32_t __ui32tHash = ( __ui32tSequence * 2654435761U ) >> ( 32 - LZ_HASH_BITS );
+      int __iReference = __piHashTable[__ui32tHash];
+      __piHashTable[__ui32tHash] = __iInput;
+      if( __iReference >= 0
+          && __iInput - __iReference <= LZ_MAX_OFFSET
+          && !memcmp( _pucInput+__iReference, _pucInput+__iInput, 4 ) )
+      {
+        __iMatchLength = LZ_MIN_MATCH;
+        while( __iInput + __iMatchLength < _iInputSize
+               && _pucInput[__iReference+__iMatchLength] == _pucInput[__iInput+__iMatchLength] )
+          __iMatchLength++;
+        __iMatchOffset = __iInput - __iReference;
+        break;
+      }
+      __iInput++;
+    }
+    if( !__iMatchLength )
+      __iInput = _iInputSize;
+
+    // Token
+    int __iLiteralsLength = __iInput - __iAnchor;
+    if( __iOutput >= _iOutputSize )
+      return -ENOSPC;
+    unsigned char *__pucToken = _pucOutput + __iOutput++;
+    *__pucToken =
+      ( ( __iLiteralsLength < 15 ? __iLiteralsLength : 15 ) << 4 )
+      | ( __iMatchLength ? ( __iMatchLength-LZ_MIN_MATCH < 15 ? __iMatchLength-LZ_MIN_MATCH : 15 ) : 0 );
+
+    // Literals
+    if( __iLiteralsLength >= 15 )
+    {
+      __iReturn = putLength( _pucOutput+__iOutput, _iOutputSize-__iOutput, __iLiteralsLength-15 );
+      if( __iReturn < 0 )
+        return __iReturn;
+      __iOutput += __iReturn;
+    }
+    if( __iOutput + __iLiteralsLength > _iOutputSize )
+      return -ENOSPC;
+    memcpy( _pucOutput+__iOutput, _pucInput+__iAnchor, __iLiteralsLength );
+    __iOutput += __iLiteralsLength;
+    if( !__iMatchLength )
+      break;
+
+    // Match
+    if( __iOutput + 2 > _iOutputSize )
+      return -ENOSPC;
+    _pucOutput[__iOutput++] = (unsigned char)( __iMatchOffset >> 8 );
+    _pucOutput[__iOutput++] = (unsigned char)__iMatchOffset;
+    if( __iMatchLength-LZ_MIN_MATCH >= 15 )
+    {
+      __iReturn = putLength( _pucOutput+__iOutput, _iOutputSize-__iOutput, __iMatchLength-LZ_MIN_MATCH-15 );
+      if( __iReturn < 0 )
+        return __iReturn;
+      __iOutput += __iReturn;
+    }
+    __iInput += __iMatchLength;
+    __iAnchor = __iInput;
+  }
+
+  // Done
+  return __iOutput;
+}
+
+int CCompressor::decompressLZ( const unsigned char *_pucInput,
+                               int _iInputSize,
+                               unsigned char *_pucOutput,
+                               int _iOutputSize )
+{
+  int __iInput = 0;
+  int __iOutput = 0;
+
+  while( __iInput < _iInputSize )
+  {
+    // Token
+    uint8_t __ui8tToken = _pucInput[__iInput++];
+
+    // Literals
+    int __iLiteralsLength = __ui8tToken >> 4;
+    if( __iLiteralsLength == 15 )
+    {
+      uint8_t __ui8tLength;
+      do
+      {
+        if( __iInput >= _iInputSize )
+          return -EPROTO;
+        __ui8tLength = _pucInput[__iInput++];
+        __iLiteralsLength += __ui8tLength;
+      }
+      while( __ui8tLength == 255 );
+    }
+    if( __iInput + __iLiteralsLength > _iInputSize
+        || __iOutput + __iLiteralsLength > _iOutputSize )
+      return -EPROTO;
+    memcpy( _pucOutput+__iOutput, _pucInput+__iInput, __iLiteralsLength );
+    __iInput += __iLiteralsLength;
+    __iOutput += __iLiteralsLength;
+    if( __iInput >= _iInputSize )
+      break; // last sequence
+
+    // Match
+    if( __iInput + 2 > _iInputSize )
+      return -EPROTO;
+    int __iMatchOffset = ( _pucInput[__iInput] << 8 ) | _pucInput[__iInput+1];
+    __iInput += 2;
+    int __iMatchLength = ( __ui8tToken & 0x0F ) + LZ_MIN_MATCH;
+    if( __iMatchLength == 15 + LZ_MIN_MATCH )
+    {
+      uint8_t __ui8tLength;
+      do
+      {
+        if( __iInput >= _iInputSize )
+          return -EPROTO;
+        __ui8tLength = _pucInput[__iInput++];
+        __iMatchLength += __ui8tLength;
+      }
+      while( __ui8tLength == 255 );
+    }
+    if( !__iMatchOffset || __iMatchOffset > __iOutput
+        || __iOutput + __iMatchLength > _iOutputSize )
+      return -EPROTO;
+    // ... (possibly overlapping) copy
+    const unsigned char *__pucMatch = _pucOutput + __iOutput - __iMatchOffset;
+    unsigned char *__pucOutput = _pucOutput + __iOutput;
+    for( int __i = 0; __i < __iMatchLength; __i++ )
+      __pucOutput[__i] = __pucMatch[__i];
+    __iOutput += __iMatchLength;
+  }
+
+  // Done
+  return __iOutput;
+}
@@ -0,0 +1,155 @@
+// INDENTING (emacs/vi): -*- mode:c++; tab-width:2; c-basic-offset:2; intent-tabs-mode:nil; -*- ex: set tabstop=2 expandtab:
+
+/*
+ * Simple Geolocalization and Course Transmission Protocol (SGCTP)
+ * Copyright (C) 2014 Cedric Dufour <http://cedric.dufour.name>
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * free software:
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, Version 3.
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ */
+
+// C
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+// SGCTP
+#include "sgctp/field.hpp"
+#include "sgctp/data.hpp"
+#include "sgctp/data_block.hpp"
+using namespace SGCTP;
+
+
+//----------------------------------------------------------------------
+// METHODS
+//----------------------------------------------------------------------
+
+int CDataBlock::reserve( uint32_t _ui32tIDSize,
+                         uint32_t _ui32tDataSize )
+{
+  // IDs heap
+  uint32_t __ui32tSize = pui32tIDOffsets[iSize] + _ui32tIDSize;
+  if( __ui32tSize > ui32tIDsSize )
+  {
+    __ui32tSize = ( __ui32tSize > 2*ui32tIDsSize ) ? __ui32tSize : 2*ui32tIDsSize;
+    char *__pcIDs = (char*)realloc( pcIDs, __ui32tSize );
+    if( !__pcIDs )
+      return -ENOMEM;
+    pcIDs = __pcIDs;
+    ui32tIDsSize = __ui32tSize;
+  }
+
+  // Data heap
+  __ui32tSize = pui32tDataOffsets[iSize] + _ui32tDataSize;
+  if( __ui32tSize > ui32tDataSize )
+  {
+    __ui32tSize = ( __ui32tSize > 2*ui32tDataSize ) ? __ui32tSize : 2*ui32tDataSize;
+    unsigned char *__pucData = (unsigned char*)realloc( pucData, __ui32tSize );
+    if( !__pucData )
+      return -ENOMEM;
+    pucData = __pucData;
+    ui32tDataSize = __ui32tSize;
+  }
+
+  // Done
+  return 0;
+}
+
+int CDataBlock::alloc( int _iCapacity )
+{
+  // Check capacity
+  if( _iCapacity <= 0 )
+    return -EINVAL;
+
+  // Allocate resources
+  free();
+  pui32tFields = (uint32_t*)malloc( CField::COUNT * _iCapacity * sizeof( uint32_t ) );
+  pui32tDefined = (uint32_t*)malloc( _iCapacity * sizeof( uint32_t ) );
+  pui32tIDOffsets = (uint32_t*)malloc( ( _iCapacity+1 ) * sizeof( uint32_t ) );
+  pui32tDataOffsets = (uint32_t*)malloc( ( _iCapacity+1 ) * sizeof( uint32_t ) );
+  if( !pui32tFields || !pui32tDefined || !pui32tIDOffsets || !pui32tDataOffsets )
+  {
+    free();
+    return -ENOMEM;
+  }
+  iCapacity = _iCapacity;
+  reset();
+
+  // Done
+  return 0;
+}
+
+void CDataBlock::free()
+{
+  ::free( pui32tFields );
+  pui32tFields = NULL;
+  ::free( pui32tDefined );
+  pui32tDefined = NULL;
+  ::free( pui32tIDOffsets );
+  pui32tIDOffsets = NULL;
+  ::free( pcIDs );
+  pcIDs = NULL;
+  ui32tIDsSize = 0;
+  ::free( pui32tDataOffsets );
+  pui32tDataOffsets = NULL;
+  ::free( pucData );
+  pucData = NULL;
+  ui32tDataSize = 0;
+  iCapacity = 0;
+  iSize = 0;
+}
+
+int CDataBlock::append( const CData &_roData )
+{
+  int __iReturn;
+
+  // Check data block
+  if( isFull() )
+    return -ENOSPC;
+
+  // Reserve heaps
+  uint32_t __ui32tIDSize = _roData.ui8tIDLength + 1;
+  __iReturn = reserve( __ui32tIDSize, _roData.ui16tDataSize );
+  if( __iReturn < 0 )
+    return __iReturn;
+
+  // Append record
+  memcpy( pcIDs + pui32tIDOffsets[iSize], _roData.getID(), __ui32tIDSize );
+  if( _roData.ui16tDataSize > 0 )
+    memcpy( pucData + pui32tDataOffsets[iSize], _roData.pucData, _roData.ui16tDataSize );
+  uint32_t __pui32tFields[CField::COUNT];
+  _roData.getFields( __pui32tFields );
+  for( int __i = 0; __i < CField::COUNT; __i++ )
+    pui32tFields[__i * iCapacity + iSize] = __pui32tFields[__i];
+  pui32tDefined[iSize] = _roData.ui32tDefined;
+  pui32tIDOffsets[iSize+1] = pui32tIDOffsets[iSize] + __ui32tIDSize;
+  pui32tDataOffsets[iSize+1] = pui32tDataOffsets[iSize] + _roData.ui16tDataSize;
+  iSize++;
+
+  // Done
+  return 0;
+}
+
+void CDataBlock::getRecord( int _iIndex,
+                            CData *_poData ) const
+{
+  _poData->reset( false );
+  _poData->setID( getID( _iIndex ) );
+  if( getDataSize( _iIndex ) > 0 )
+    _poData->setData( getData( _iIndex ), getDataSize( _iIndex ) );
+  else
+    _poData->allocData( 0 );
+  uint32_t __pui32tFields[CField::COUNT];
+  for( int __i = 0; __i < CField::COUNT; __i++ )
+    __pui32tFields[__i] = pui32tFields[__i * iCapacity + _iIndex];
+  _poData->setFields( __pui32tFields );
+}
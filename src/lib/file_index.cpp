@@ -0,0 +1,427 @@
+// INDENTING (emacs/vi): -*- mode:c++; tab-width:2; c-basic-offset:2; intent-tabs-mode:nil; -*- ex: set tabstop=2 expandtab:
+
+/*
+ * Simple Geolocalization and Course Transmission Protocol (SGCTP)
+ * Copyright (C) 2014 Cedric Dufour <http://cedric.dufour.name>
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * free software:
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, Version 3.
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ */
+
+// C
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/stat.h>
+
+// SGCTP
+#include "sgctp/data.hpp"
+#include "sgctp/file_index.hpp"
+#include "sgctp/transmit_file.hpp"
+using namespace SGCTP;
+
+
+//----------------------------------------------------------------------
+// METHODS
+//----------------------------------------------------------------------
+
+uint32_t CFileIndex::addID( const char *_pcID,
+                            bool _bEntry )
+{
+  unordered_map<string,uint32_t>::const_iterator __it =
+    ui32tIDs_umap.find( _pcID );
+  if( __it != ui32tIDs_umap.end() )
+    return __it->second;
+  uint32_t __ui32tID = sIDs_vector.size();
+  sIDs_vector.push_back( _pcID );
+  ui32tIDs_umap[sIDs_vector.back()] = __ui32tID;
+  ui32tPostings_vector.push_back( vector<uint32_t>() );
+  if( _bEntry )
+  {
+    uint8_t __ui8tLength = strlen( _pcID );
+    ucEntries_vector.push_back( ENTRY_ID );
+    ucEntries_vector.push_back( __ui8tLength );
+    ucEntries_vector.insert( ucEntries_vector.end(), _pcID, _pcID+__ui8tLength );
+  }
+  return __ui32tID;
+}
+
+void CFileIndex::addCheckpoint( const TCheckpoint &_rtCheckpoint,
+                                const vector<uint32_t> &_rui32tIDs_vector,
+                                bool _bEntry )
+{
+  uint32_t __ui32tCheckpoint = tCheckpoints_vector.size();
+  tCheckpoints_vector.push_back( _rtCheckpoint );
+  for( vector<uint32_t>::const_iterator __it = _rui32tIDs_vector.begin();
+       __it != _rui32tIDs_vector.end();
+       ++__it )
+    ui32tPostings_vector[*__it].push_back( __ui32tCheckpoint );
+  if( _bEntry )
+  {
+    unsigned char __pucEntry[CHECKPOINT_ENTRY_SIZE];
+    __pucEntry[0] = ENTRY_CHECKPOINT;
+    __pucEntry[1] = 0;
+    __pucEntry[2] = 0;
+    __pucEntry[3] = 0;
+    uint32_t __pui32tFields_NS[7];
+    __pui32tFields_NS[0] = htonl( _rui32tIDs_vector.size() );
+    __pui32tFields_NS[1] = htonl( _rtCheckpoint.ui64tOffset >> 32 );
+    __pui32tFields_NS[2] = htonl( _rtCheckpoint.ui64tOffset & 0xFFFFFFFF );
+    __pui32tFields_NS[3] = htonl( _rtCheckpoint.ui32tSize );
+    __pui32tFields_NS[4] = htonl( _rtCheckpoint.ui32tRecords );
+    __pui32tFields_NS[5] = htonl( _rtCheckpoint.ui32tTimeMinimum );
+    __pui32tFields_NS[6] = htonl( _rtCheckpoint.ui32tTimeMaximum );
+    memcpy( __pucEntry+4, __pui32tFields_NS, sizeof( __pui32tFields_NS ) );
+    ucEntries_vector.insert( ucEntries_vector.end(), __pucEntry, __pucEntry+CHECKPOINT_ENTRY_SIZE );
+    for( vector<uint32_t>::const_iterator __it = _rui32tIDs_vector.begin();
+         __it != _rui32tIDs_vector.end();
+         ++__it )
+    {
+      uint32_t __ui32tID_NS = htonl( *__it );
+      ucEntries_vector.insert( ucEntries_vector.end(), (unsigned char*)&__ui32tID_NS, (unsigned char*)&__ui32tID_NS+4 );
+    }
+  }
+}
+
+int CFileIndex::writeEntries( int _iIndexFileDescriptor )
+{
+  int __iReturn;
+  size_t __iSentSize = 0;
+  while( __iSentSize < ucEntries_vector.size() )
+  {
+    __iReturn = ::write( _iIndexFileDescriptor, ucEntries_vector.data()+__iSentSize, ucEntries_vector.size()-__iSentSize );
+    if( __iReturn < 0 )
+    {
+      if( errno == EINTR )
+        continue;
+      return -errno;
+    }
+    __iSentSize += __iReturn;
+  }
+  ui64tIndexSize += __iSentSize;
+  ucEntries_vector.clear();
+  return 0;
+}
+
+int CFileIndex::load( int _iIndexFileDescriptor )
+{
+  int __iReturn;
+
+  // Reset index
+  free();
+
+  // Read index file
+  struct stat __tStat;
+  if( fstat( _iIndexFileDescriptor, &__tStat ) < 0 )
+    return -errno;
+  if( lseek( _iIndexFileDescriptor, 0, SEEK_SET ) < 0 )
+    return -errno;
+  vector<unsigned char> __ucIndex_vector( __tStat.st_size );
+  size_t __iSize = 0;
+  while( __iSize < __ucIndex_vector.size() )
+  {
+    __iReturn = ::read( _iIndexFileDescriptor, __ucIndex_vector.data()+__iSize, __ucIndex_vector.size()-__iSize );
+    if( __iReturn < 0 )
+    {
+      if( errno == EINTR )
+        continue;
+      return -errno;
+    }
+    if( !__iReturn )
+      break;
+    __iSize += __iReturn;
+  }
+  const unsigned char *__pucIndex = __ucIndex_vector.data();
+
+  // Header
+  // NOTE: an empty (or incomplete) header stands for an empty index
+  if( __iSize < (size_t)FILE_HEADER_SIZE )
+    return 0;
+  if( memcmp( __pucIndex, "SGCTPI", 6 )
+      || __pucIndex[6] != FILE_VERSION )
+    return -EPROTO;
+  size_t __iOffset = FILE_HEADER_SIZE;
+  ui64tIndexSize = __iOffset;
+
+  // Entries
+  vector<uint32_t> __ui32tIDs_vector;
+  while( __iOffset < __iSize )
+  {
+    switch( __pucIndex[__iOffset] )
+    {
+
+    case ENTRY_ID:
+      {
+        if( __iOffset+2 > __iSize
+            || __iOffset+2+__pucIndex[__iOffset+1] > __iSize )
+          return tCheckpoints_vector.size();
+        char __pcID[CData::MAX_ID_SIZE];
+        uint8_t __ui8tLength = __pucIndex[__iOffset+1];
+        if( __ui8tLength > CData::MAX_ID_LENGTH )
+          return -EPROTO;
+        memcpy( __pcID, __pucIndex+__iOffset+2, __ui8tLength );
+        __pcID[__ui8tLength] = 0;
+        addID( __pcID, false );
+        __iOffset += 2+__ui8tLength;
+      }
+      break;
+
+    case ENTRY_CHECKPOINT:
+      {
+        if( __iOffset+CHECKPOINT_ENTRY_SIZE > __iSize )
+          return tCheckpoints_vector.size();
+        const unsigned char *__pucEntry = __pucIndex+__iOffset;
+        // NOTE: entries follow variable-length ID entries and are thus
+        //       unaligned; let's use memcpy
+        uint32_t __pui32tFields_NS[7];
+        memcpy( __pui32tFields_NS, __pucEntry+4, sizeof( __pui32tFields_NS ) );
+        uint32_t __ui32tIDs = ntohl( __pui32tFields_NS[0] );
+        if( __ui32tIDs > ( __iSize-__iOffset-CHECKPOINT_ENTRY_SIZE ) / 4 )
+          return tCheckpoints_vector.size();
+        TCheckpoint __tCheckpoint;
+        __tCheckpoint.ui64tOffset =
+          (uint64_t)ntohl( __pui32tFields_NS[1] ) << 32
+          | ntohl( __pui32tFields_NS[2] );
+        __tCheckpoint.ui32tSize = ntohl( __pui32tFields_NS[3] );
+        __tCheckpoint.ui32tRecords = ntohl( __pui32tFields_NS[4] );
+        __tCheckpoint.ui32tTimeMinimum = ntohl( __pui32tFields_NS[5] );
+        __tCheckpoint.ui32tTimeMaximum = ntohl( __pui32tFields_NS[6] );
+        if( __tCheckpoint.ui64tOffset != getEndOffset()
+            && !tCheckpoints_vector.empty() )
+          return -EPROTO;
+        __ui32tIDs_vector.resize( __ui32tIDs );
+        for( uint32_t __i = 0; __i < __ui32tIDs; __i++ )
+        {
+          uint32_t __ui32tID_NS;
+          memcpy( &__ui32tID_NS, __pucEntry+CHECKPOINT_ENTRY_SIZE+4*__i, 4 );
+          __ui32tIDs_vector[__i] = ntohl( __ui32tID_NS );
+          if( __ui32tIDs_vector[__i] >= sIDs_vector.size() )
+            return -EPROTO;
+        }
+        addCheckpoint( __tCheckpoint, __ui32tIDs_vector, false );
+        __iOffset += CHECKPOINT_ENTRY_SIZE+4*__ui32tIDs;
+      }
+      break;
+
+    default:
+      return -EPROTO;
+
+    }
+    ui64tIndexSize = __iOffset;
+  }
+
+  // Done
+  return tCheckpoints_vector.size();
+}
+
+int CFileIndex::update( int _iIndexFileDescriptor,
+                        int _iFileDescriptor,
+                        CTransmit_File *_poTransmit,
+                        int _iCheckpointRecords )
+{
+  int __iReturn;
+
+  // Position index file (discarding incomplete entries)
+  if( ftruncate( _iIndexFileDescriptor, ui64tIndexSize ) < 0 )
+    return -errno;
+  if( lseek( _iIndexFileDescriptor, ui64tIndexSize, SEEK_SET ) < 0 )
+    return -errno;
+  if( !ui64tIndexSize )
+  {
+    const unsigned char __pucFileHeader[FILE_HEADER_SIZE] = { 'S', 'G', 'C', 'T', 'P', 'I', FILE_VERSION, 0 };
+    ucEntries_vector.assign( __pucFileHeader, __pucFileHeader+FILE_HEADER_SIZE );
+  }
+
+  // Position SGCTP file
+  __iReturn = _poTransmit->seek( _iFileDescriptor, getEndOffset() );
+  if( __iReturn < 0 )
+    return __iReturn;
+
+  // Index records
+  // NOTE: records are accounted for (committed to the current checkpoint) only
+  //       once a synchronization point is reached
+  int __iRecords = 0;
+  TCheckpoint __tCheckpoint = { getEndOffset(), 0, 0, CField::UNDEFINED_UINT32, 0 };
+  vector<uint32_t> __ui32tIDs_vector;
+  vector<bool> __bIDs_vector( sIDs_vector.size(), false );
+  vector<uint32_t> __ui32tPendingIDs_vector;
+  vector<uint32_t> __ui32tPendingTimes_vector;
+  CData __oData;
+  for(;;)
+  {
+    int64_t __i64tOffset = _poTransmit->tell();
+    if( __i64tOffset >= 0 )
+    {
+      // ... commit pending records
+      for( size_t __i = 0; __i < __ui32tPendingIDs_vector.size(); __i++ )
+      {
+        uint32_t __ui32tID = __ui32tPendingIDs_vector[__i];
+        if( __ui32tID >= __bIDs_vector.size() )
+          __bIDs_vector.resize( sIDs_vector.size(), false );
+        if( !__bIDs_vector[__ui32tID] )
+        {
+          __bIDs_vector[__ui32tID] = true;
+          __ui32tIDs_vector.push_back( __ui32tID );
+        }
+        uint32_t __ui32tTime = __ui32tPendingTimes_vector[__i];
+        if( __ui32tTime & CField::UNDEFINED_UINT32 )
+        {
+          __tCheckpoint.ui32tTimeMinimum = 0;
+          __tCheckpoint.ui32tTimeMaximum = CField::OVERFLOW_UINT32;
+        }
+        else
+        {
+          if( __ui32tTime < __tCheckpoint.ui32tTimeMinimum )
+            __tCheckpoint.ui32tTimeMinimum = __ui32tTime;
+          if( __ui32tTime > __tCheckpoint.ui32tTimeMaximum )
+            __tCheckpoint.ui32tTimeMaximum = __ui32tTime;
+        }
+      }
+      __tCheckpoint.ui32tRecords += __ui32tPendingIDs_vector.size();
+      __iRecords += __ui32tPendingIDs_vector.size();
+      __ui32tPendingIDs_vector.clear();
+      __ui32tPendingTimes_vector.clear();
+      __tCheckpoint.ui32tSize = __i64tOffset - __tCheckpoint.ui64tOffset;
+
+      // ... add checkpoint
+      if( __tCheckpoint.ui32tRecords >= (uint32_t)_iCheckpointRecords )
+      {
+        addCheckpoint( __tCheckpoint, __ui32tIDs_vector, true );
+        __iReturn = writeEntries( _iIndexFileDescriptor );
+        if( __iReturn < 0 )
+          return __iReturn;
+        for( vector<uint32_t>::const_iterator __it = __ui32tIDs_vector.begin();
+             __it != __ui32tIDs_vector.end();
+             ++__it )
+          __bIDs_vector[*__it] = false;
+        __ui32tIDs_vector.clear();
+        __tCheckpoint.ui64tOffset = __i64tOffset;
+        __tCheckpoint.ui32tSize = 0;
+        __tCheckpoint.ui32tRecords = 0;
+        __tCheckpoint.ui32tTimeMinimum = CField::UNDEFINED_UINT32;
+        __tCheckpoint.ui32tTimeMaximum = 0;
+      }
+    }
+
+    // ... unserialize
+    __iReturn = _poTransmit->unserialize( _iFileDescriptor, &__oData );
+    if( __iReturn <= 0 )
+      break;
+    __ui32tPendingIDs_vector.push_back( addID( __oData.getID(), true ) );
+    __ui32tPendingTimes_vector.push_back( __oData.getField<CField::TIME>() );
+  }
+  // NOTE: incomplete (or invalid) trailing records are left for later
+  if( __iReturn < 0 && __iReturn != -EPROTO )
+    return __iReturn;
+
+  // Add last checkpoint
+  if( __tCheckpoint.ui32tRecords )
+    addCheckpoint( __tCheckpoint, __ui32tIDs_vector, true );
+  __iReturn = writeEntries( _iIndexFileDescriptor );
+  if( __iReturn < 0 )
+    return __iReturn;
+
+  // Done
+  return __iRecords;
+}
+
+int CFileIndex::select( const char *_pcID,
+                        uint32_t _ui32tTimeMinimum,
+                        uint32_t _ui32tTimeMaximum )
+{
+  bSelection = true;
+  ui32tSelection_vector.clear();
+  iSelection = 0;
+  ui32tSelectionRecords = 0;
+
+  // Candidate checkpoints (ID)
+  const vector<uint32_t> *__pui32tPostings_vector = NULL;
+  if( _pcID && *_pcID )
+  {
+    unordered_map<string,uint32_t>::const_iterator __it =
+      ui32tIDs_umap.find( _pcID );
+    if( __it == ui32tIDs_umap.end() )
+      return 0;
+    __pui32tPostings_vector = &ui32tPostings_vector[__it->second];
+  }
+  int __iCandidates =
+    __pui32tPostings_vector
+    ? __pui32tPostings_vector->size()
+    : tCheckpoints_vector.size();
+
+  // Selected checkpoints (time)
+  for( int __i = 0; __i < __iCandidates; __i++ )
+  {
+    uint32_t __ui32tCheckpoint =
+      __pui32tPostings_vector
+      ? (*__pui32tPostings_vector)[__i]
+      : __i;
+    const TCheckpoint &__rtCheckpoint = tCheckpoints_vector[__ui32tCheckpoint];
+    if( !( _ui32tTimeMinimum & CField::UNDEFINED_UINT32 )
+        && __rtCheckpoint.ui32tTimeMaximum < _ui32tTimeMinimum )
+      continue;
+    if( !( _ui32tTimeMaximum & CField::UNDEFINED_UINT32 )
+        && __rtCheckpoint.ui32tTimeMinimum > _ui32tTimeMaximum )
+      continue;
+    ui32tSelection_vector.push_back( __ui32tCheckpoint );
+  }
+
+  // Done
+  return ui32tSelection_vector.size();
+}
+
+int CFileIndex::seek( int _iFileDescriptor,
+                      CTransmit_File *_poTransmit )
+{
+  // Check selection
+  if( !bSelection )
+    return 0;
+  if( ui32tSelectionRecords )
+  {
+    ui32tSelectionRecords--;
+    return 0;
+  }
+
+  // Next selected checkpoint (or non-indexed records)
+  uint64_t __ui64tOffset;
+  if( iSelection < ui32tSelection_vector.size() )
+  {
+    const TCheckpoint &__rtCheckpoint = tCheckpoints_vector[ui32tSelection_vector[iSelection++]];
+    __ui64tOffset = __rtCheckpoint.ui64tOffset;
+    ui32tSelectionRecords = __rtCheckpoint.ui32tRecords - 1;
+  }
+  else
+  {
+    __ui64tOffset = getEndOffset();
+    bSelection = false;
+  }
+
+  // Seek (unless already there)
+  if( _poTransmit->tell() == (int64_t)__ui64tOffset )
+    return 0;
+  return _poTransmit->seek( _iFileDescriptor, __ui64tOffset );
+}
+
+void CFileIndex::free()
+{
+  sIDs_vector.clear();
+  ui32tIDs_umap.clear();
+  tCheckpoints_vector.clear();
+  ui32tPostings_vector.clear();
+  ui64tIndexSize = 0;
+  ucEntries_vector.clear();
+  bSelection = false;
+  ui32tSelection_vector.clear();
+  iSelection = 0;
+  ui32tSelectionRecords = 0;
+}
@@ -0,0 +1,202 @@
+// INDENTING (emacs/vi): -*- mode:c++; tab-width:2; c-basic-offset:2; intent-tabs-mode:nil; -*- ex: set tabstop=2 expandtab:
+
+/*
+ * Simple Geolocalization and Course Transmission Protocol (SGCTP)
+ * Copyright (C) 2014 Cedric Dufour <http://cedric.dufour.name>
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * free software:
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, Version 3.
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ */
+
+// C
+#include <stdint.h>
+#include <string.h>
+
+// C++
+#include <vector>
+using namespace std;
+
+// SGCTP
+#include "sgctp/id_table.hpp"
+using namespace SGCTP;
+
+
+//----------------------------------------------------------------------
+// CONSTANTS / STATIC
+//----------------------------------------------------------------------
+
+uint32_t CIDTable::hash( const char *_pcID,
+                         uint8_t _ui8tIDLength )
+{
+  uint32_t __ui32tHash = 2166136261u;
+  for( int __i = 0; __i < _ui8tIDLength; __i++ )
+  {
+    __ui32tHash ^= (unsigned char)_pcID[__i];
+    __ui32tHash *= 16777619u;
+  }
+  return __ui32tHash;
+}
+
+
+//----------------------------------------------------------------------
+// METHODS
+//----------------------------------------------------------------------
+
+void CIDTable::clear()
+{
+  tEntries_vector.clear();
+  ui32tFree_vector.clear();
+  cIDs_vector.clear();
+  ui32tIDsHoles = 0;
+  ui32tSlots_vector.assign( INITIAL_SLOTS, 0 );
+  ui32tTombstones = 0;
+}
+
+uint32_t CIDTable::intern( const char *_pcID,
+                           uint8_t _ui8tIDLength )
+{
+  uint32_t __ui32tHash = hash( _pcID, _ui8tIDLength );
+  uint32_t __ui32tTombstone = INVALID_HANDLE;
+  uint32_t __ui32tSlot =
+    slot( __ui32tHash, _pcID, _ui8tIDLength, &__ui32tTombstone );
+  if( ui32tSlots_vector[__ui32tSlot] )
+    return ui32tSlots_vector[__ui32tSlot] - 1;
+
+  // Add entry (re-using tombstones and erased handles)
+  if( __ui32tTombstone != INVALID_HANDLE )
+  {
+    __ui32tSlot = __ui32tTombstone;
+    ui32tTombstones--;
+  }
+  uint32_t __ui32tHandle;
+  if( !ui32tFree_vector.empty() )
+  {
+    __ui32tHandle = ui32tFree_vector.back();
+    ui32tFree_vector.pop_back();
+  }
+  else
+  {
+    __ui32tHandle = tEntries_vector.size();
+    tEntries_vector.push_back( TEntry() );
+  }
+  TEntry &__rtEntry = tEntries_vector[__ui32tHandle];
+  __rtEntry.ui32tHash = __ui32tHash;
+  __rtEntry.ui32tOffset = cIDs_vector.size();
+  __rtEntry.ui8tLength = _ui8tIDLength;
+  cIDs_vector.insert( cIDs_vector.end(), _pcID, _pcID+_ui8tIDLength );
+  cIDs_vector.push_back( '\0' );
+  ui32tSlots_vector[__ui32tSlot] = __ui32tHandle + 1;
+
+  // Keep the hash table (at most) half full (including tombstones)
+  if( ( getSize() + ui32tTombstones ) * 2 > ui32tSlots_vector.size() )
+    rehash();
+
+  // Done
+  return __ui32tHandle;
+}
+
+uint32_t CIDTable::find( const char *_pcID,
+                         uint8_t _ui8tIDLength ) const
+{
+  uint32_t __ui32tSlot =
+    slot( hash( _pcID, _ui8tIDLength ), _pcID, _ui8tIDLength );
+  return ui32tSlots_vector[__ui32tSlot]
+    ? ui32tSlots_vector[__ui32tSlot] - 1
+    : INVALID_HANDLE;
+}
+
+void CIDTable::erase( uint32_t _ui32tHandle )
+{
+  if( !isValid( _ui32tHandle ) )
+    return;
+
+  // Erase entry (leaving a tombstone and a hole behind)
+  TEntry &__rtEntry = tEntries_vector[_ui32tHandle];
+  uint32_t __ui32tSlot = slot( __rtEntry.ui32tHash,
+                               cIDs_vector.data() + __rtEntry.ui32tOffset,
+                               __rtEntry.ui8tLength );
+  ui32tSlots_vector[__ui32tSlot] = TOMBSTONE_SLOT;
+  ui32tTombstones++;
+  ui32tIDsHoles += __rtEntry.ui8tLength + 1;
+  __rtEntry.ui32tOffset = ERASED_OFFSET;
+  ui32tFree_vector.push_back( _ui32tHandle );
+
+  // Keep the IDs heap (at least) half used
+  if( ui32tIDsHoles * 2 > cIDs_vector.size() )
+    compact();
+}
+
+uint32_t CIDTable::slot( uint32_t _ui32tHash,
+                         const char *_pcID,
+                         uint8_t _ui8tIDLength,
+                         uint32_t *_pui32tTombstone ) const
+{
+  // NOTE: linear probing; the hash table size is a power of two
+  uint32_t __ui32tMask = ui32tSlots_vector.size() - 1;
+  for( uint32_t __ui32tSlot = _ui32tHash & __ui32tMask;;
+       __ui32tSlot = ( __ui32tSlot + 1 ) & __ui32tMask )
+  {
+    uint32_t __ui32tHandle = ui32tSlots_vector[__ui32tSlot];
+    if( !__ui32tHandle )
+      return __ui32tSlot;
+    if( __ui32tHandle == TOMBSTONE_SLOT )
+    {
+      if( _pui32tTombstone && *_pui32tTombstone == INVALID_HANDLE )
+        *_pui32tTombstone = __ui32tSlot;
+      continue;
+    }
+    const TEntry &__rtEntry = tEntries_vector[__ui32tHandle-1];
+    if( __rtEntry.ui32tHash == _ui32tHash
+        && __rtEntry.ui8tLength == _ui8tIDLength
+        && !memcmp( cIDs_vector.data() + __rtEntry.ui32tOffset, _pcID, _ui8tIDLength ) )
+      return __ui32tSlot;
+  }
+}
+
+void CIDTable::rehash()
+{
+  // NOTE: entries are re-inserted along their pre-computed hash; the table
+  //       is doubled only if live entries fill more than a quarter of it
+  uint32_t __ui32tSlots = ui32tSlots_vector.size();
+  if( getSize() * 4 > __ui32tSlots )
+    __ui32tSlots *= 2;
+  ui32tSlots_vector.assign( __ui32tSlots, 0 );
+  ui32tTombstones = 0;
+  uint32_t __ui32tMask = __ui32tSlots - 1;
+  for( uint32_t __ui32tHandle = 0; __ui32tHandle < tEntries_vector.size(); __ui32tHandle++ )
+  {
+    if( tEntries_vector[__ui32tHandle].ui32tOffset == ERASED_OFFSET )
+      continue;
+    uint32_t __ui32tSlot = tEntries_vector[__ui32tHandle].ui32tHash & __ui32tMask;
+    while( ui32tSlots_vector[__ui32tSlot] )
+      __ui32tSlot = ( __ui32tSlot + 1 ) & __ui32tMask;
+    ui32tSlots_vector[__ui32tSlot] = __ui32tHandle + 1;
+  }
+}
+
+void CIDTable::compact()
+{
+  vector<char> __cIDs_vector;
+  __cIDs_vector.reserve( cIDs_vector.size() - ui32tIDsHoles );
+  for( vector<TEntry>::iterator __it = tEntries_vector.begin();
+       __it != tEntries_vector.end();
+       ++__it )
+  {
+    if( __it->ui32tOffset == ERASED_OFFSET )
+      continue;
+    const char *__pcID = cIDs_vector.data() + __it->ui32tOffset;
+    __it->ui32tOffset = __cIDs_vector.size();
+    __cIDs_vector.insert( __cIDs_vector.end(), __pcID, __pcID + __it->ui8tLength + 1 );
+  }
+  cIDs_vector.swap( __cIDs_vector );
+  ui32tIDsHoles = 0;
+}
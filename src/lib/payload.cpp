@@ -18,21 +18,219 @@
  */
 
 // C
+#include <endian.h>
 #include <errno.h>
 #include <stdlib.h>
 #include <string.h>
+#include <arpa/inet.h>
 
 // SGCTP
+#include "sgctp/field.hpp"
 #include "sgctp/data.hpp"
+#include "sgctp/data_block.hpp"
 #include "sgctp/payload.hpp"
 using namespace SGCTP;
 
 
 //----------------------------------------------------------------------
-// CONSTANTS / STATIC
+// CODECS
 //----------------------------------------------------------------------
 
-const uint8_t CPayload::BITMASK[9] = { 0, 1, 3, 7, 15, 31, 63, 127, 255 };
+//
+// FIELDS
+//
+
+template<int I, int N>
+struct CPayload::CFieldCodec
+{
+  /// Return whether this field is encoded (given the used groups)
+  static constexpr bool encoded( uint32_t _ui32tGroups )
+  {
+    return !CField::GROUPS[CField::FIELDS[I].ui8tGroup].ui8tFlag
+      || _ui32tGroups & ( 1u << CField::FIELDS[I].ui8tGroup );
+  }
+
+  /// Return the (bit) mask of the defined fields
+  static inline uint32_t defined( const uint32_t *_pui32tFields )
+  {
+    return ( ( _pui32tFields[I] & CField::UNDEFINED_UINT32 ) ? 0 : 1u << I )
+      | CFieldCodec<I+1,N>::defined( _pui32tFields );
+  }
+
+  /// Return the size (bits quantity) of the fields (belonging to the given used groups)
+  static constexpr uint32_t bits( uint32_t _ui32tGroups )
+  {
+    return ( encoded( _ui32tGroups ) ? CField::FIELDS[I].ui8tBits : 0 )
+      + CFieldCodec<I+1,N>::bits( _ui32tGroups );
+  }
+
+  /// Add the fields (belonging to the used groups G) to the payload
+  template<uint32_t G>
+  static inline void put( CPayload *_poPayload,
+                          const uint32_t *_pui32tFields )
+  {
+    if( encoded( G ) )
+    {
+      uint32_t __ui32tData = _pui32tFields[I];
+      if( CField::FIELDS[I].ui32tUndefinedCode != CField::CODE_NONE
+          && __ui32tData & CField::UNDEFINED_UINT32 )
+        __ui32tData = CField::FIELDS[I].ui32tUndefinedCode;
+      _poPayload->putBits( CField::FIELDS[I].ui8tBits, __ui32tData );
+    }
+    CFieldCodec<I+1,N>::template put<G>( _poPayload, _pui32tFields );
+  }
+
+  /// Retrieve the fields (belonging to the used groups G) from the payload
+  template<uint32_t G>
+  static inline void get( CPayload *_poPayload,
+                          uint32_t *_pui32tFields )
+  {
+    if( encoded( G ) )
+    {
+      uint32_t __ui32tData = _poPayload->getBits( CField::FIELDS[I].ui8tBits );
+      if( CField::FIELDS[I].ui32tUndefinedCode != CField::CODE_NONE
+          && __ui32tData == CField::FIELDS[I].ui32tUndefinedCode )
+        __ui32tData = CField::UNDEFINED_UINT32;
+      else if( CField::FIELDS[I].ui32tOverflowCode != CField::CODE_NONE
+               && __ui32tData == CField::FIELDS[I].ui32tOverflowCode )
+        __ui32tData = CField::OVERFLOW_UINT32;
+      _pui32tFields[I] = __ui32tData;
+    }
+    CFieldCodec<I+1,N>::template get<G>( _poPayload, _pui32tFields );
+  }
+};
+
+template<int N>
+struct CPayload::CFieldCodec<N,N>
+{
+  static inline uint32_t defined( const uint32_t * )
+  {
+    return 0;
+  }
+  static constexpr uint32_t bits( uint32_t )
+  {
+    return 0;
+  }
+  template<uint32_t G>
+  static inline void put( CPayload *, const uint32_t * ) {}
+  template<uint32_t G>
+  static inline void get( CPayload *, uint32_t * ) {}
+};
+
+//
+// GROUPS
+//
+
+template<int G, int N>
+struct CPayload::CGroupCodec
+{
+  /// Fields belonging to this group
+  static const uint32_t FIELDS = CField::groupFields( G );
+  /// Parent group
+  static const uint32_t PARENT = CField::groupParent( G );
+
+  /// Return the (bit) mask of the used groups (all fields defined and parent group used)
+  static inline uint32_t used( uint32_t _ui32tDefined,
+                               uint32_t _ui32tGroups = 0 )
+  {
+    if( ( _ui32tDefined & FIELDS ) == FIELDS
+        && ( _ui32tGroups & PARENT ) == PARENT )
+      _ui32tGroups |= 1u << G;
+    return CGroupCodec<G+1,N>::used( _ui32tDefined, _ui32tGroups );
+  }
+
+  /// Return the content flags corresponding to the given used groups
+  static inline uint8_t content( uint8_t _ui8tContent,
+                                 uint32_t _ui32tGroups )
+  {
+    return ( ( CField::GROUPS[G].ui8tContent == _ui8tContent
+               && _ui32tGroups & ( 1u << G ) )
+             ? CField::GROUPS[G].ui8tFlag
+             : 0 )
+      | CGroupCodec<G+1,N>::content( _ui8tContent, _ui32tGroups );
+  }
+};
+
+template<int N>
+struct CPayload::CGroupCodec<N,N>
+{
+  static inline uint32_t used( uint32_t, uint32_t _ui32tGroups )
+  {
+    return _ui32tGroups;
+  }
+  static inline uint8_t content( uint8_t, uint32_t )
+  {
+    return 0;
+  }
+};
+
+//
+// SHAPES
+//
+
+template<int C>
+struct CPayload::CShapeCodec
+{
+  /// Used groups (content)
+  static const uint32_t GROUPS =
+    CField::flagsGroups( CField::CONTENT, C );
+  /// Used groups (extended content)
+  static const uint32_t GROUPS_EXTENDED =
+    CField::flagsGroups( CField::CONTENT_EXTENDED, C );
+
+  /// Add the content fields to the payload
+  static void put( CPayload *_poPayload,
+                   const uint32_t *_pui32tFields )
+  {
+    CFieldCodec<CField::TIME,CField::EXTENDED>::template put<GROUPS>( _poPayload,
+                                                                     _pui32tFields );
+  }
+
+  /// Retrieve the content fields from the payload
+  static void get( CPayload *_poPayload,
+                   uint32_t *_pui32tFields )
+  {
+    CFieldCodec<CField::TIME,CField::EXTENDED>::template get<GROUPS>( _poPayload,
+                                                                     _pui32tFields );
+  }
+
+  /// Add the extended content fields to the payload
+  static void putExtended( CPayload *_poPayload,
+                           const uint32_t *_pui32tFields )
+  {
+    CFieldCodec<CField::EXTENDED,CField::COUNT>::template put<GROUPS_EXTENDED>( _poPayload,
+                                                                               _pui32tFields );
+  }
+
+  /// Retrieve the extended content fields from the payload
+  static void getExtended( CPayload *_poPayload,
+                           uint32_t *_pui32tFields )
+  {
+    CFieldCodec<CField::EXTENDED,CField::COUNT>::template get<GROUPS_EXTENDED>( _poPayload,
+                                                                               _pui32tFields );
+  }
+};
+
+template<int N, int... C>
+struct CPayload::CShapeTable: public CShapeTable<N-1, N-1, C...>
+{};
+
+template<int... C>
+struct CPayload::CShapeTable<0, C...>
+{
+  /// Dispatch table
+  static const TShapeTable TABLE;
+};
+
+template<int... C>
+const CPayload::TShapeTable CPayload::CShapeTable<0, C...>::TABLE = {
+  { &CShapeCodec<C>::put... },
+  { &CShapeCodec<C>::get... },
+  { CFieldCodec<CField::TIME,CField::EXTENDED>::bits( CShapeCodec<C>::GROUPS )... },
+  { &CShapeCodec<C>::putExtended... },
+  { &CShapeCodec<C>::getExtended... },
+  { CFieldCodec<CField::EXTENDED,CField::COUNT>::bits( CShapeCodec<C>::GROUPS_EXTENDED )... }
+};
 
 
 //----------------------------------------------------------------------
@@ -40,56 +238,171 @@ const uint8_t CPayload::BITMASK[9] = { 0, 1, 3, 7, 15, 31, 63, 127, 255 };
 //----------------------------------------------------------------------
 
 void CPayload::putBits( uint8_t _ui8tBitsCount,
-                        uint8_t _ui8tBits )
+                        uint32_t _ui32tBits )
 {
   // WARNING: code MUST be hardware-independent, so as to have most significant bits first!
-  uint32_t __ui32tBufferByteOffset = ( ui32tBufferBitOffset >> 3 );
-  uint16_t __ui16tData =
-    ( _ui8tBits & BITMASK[_ui8tBitsCount] )
-    << ( 16 - _ui8tBitsCount - ( ui32tBufferBitOffset & 0x7 ) );
-  *(unsigned char*)(pucBufferPut+__ui32tBufferByteOffset) |=
-    (unsigned char)( __ui16tData >> 8 );
-  *(unsigned char*)(pucBufferPut+__ui32tBufferByteOffset+1) |=
-    (unsigned char)( __ui16tData & 0xFF );
+  ui64tBitCache =
+    ( ui64tBitCache << _ui8tBitsCount )
+    | ( _ui32tBits & ( 0xFFFFFFFF >> ( 32 - _ui8tBitsCount ) ) );
+  ui32tBitCacheSize += _ui8tBitsCount;
   ui32tBufferBitOffset += _ui8tBitsCount;
+  if( ui32tBitCacheSize >= 32 )
+  {
+    ui32tBitCacheSize -= 32;
+    uint32_t __ui32tBits_NS = htobe32( (uint32_t)( ui64tBitCache >> ui32tBitCacheSize ) );
+    memcpy( pucBufferPut+ui32tBufferByteOffset, &__ui32tBits_NS, 4 );
+    ui32tBufferByteOffset += 4;
+  }
 }
 
 void CPayload::putBytes( uint16_t _ui16tBytesCount,
                          const unsigned char *_pucBytes )
 {
-  if( uint8_t __ui8tBufferBitAlign = ( ui32tBufferBitOffset & 0x7 ) )
-    putBits( 8 - __ui8tBufferBitAlign, 0 );
+  // Flush bits cache (and re-align)
+  while( ui32tBitCacheSize >= 8 )
+  {
+    ui32tBitCacheSize -= 8;
+    pucBufferPut[ui32tBufferByteOffset++] =
+      (unsigned char)( ui64tBitCache >> ui32tBitCacheSize );
+  }
+  if( ui32tBitCacheSize )
+  {
+    pucBufferPut[ui32tBufferByteOffset++] =
+      (unsigned char)( ui64tBitCache << ( 8 - ui32tBitCacheSize ) );
+    ui32tBufferBitOffset += 8 - ui32tBitCacheSize;
+    ui32tBitCacheSize = 0;
+  }
   if( _ui16tBytesCount == 0 )
     return;
-  uint32_t __ui32tBufferByteOffset = ( ui32tBufferBitOffset >> 3 );
-  memcpy( pucBufferPut+__ui32tBufferByteOffset, _pucBytes, _ui16tBytesCount );
+  memcpy( pucBufferPut+ui32tBufferByteOffset, _pucBytes, _ui16tBytesCount );
+  ui32tBufferByteOffset += _ui16tBytesCount;
   ui32tBufferBitOffset += _ui16tBytesCount * 8;
 }
 
-uint8_t CPayload::getBits( uint8_t _ui8tBitsCount )
+uint32_t CPayload::getBits( uint8_t _ui8tBitsCount )
 {
   // WARNING: code MUST be hardware-independent, so as to have most significant bits first!
-  uint32_t __ui32tBufferByteOffset = ( ui32tBufferBitOffset >> 3 );
-  uint16_t __ui16tBits =
-    (uint16_t)( *(unsigned char*)(pucBufferGet+__ui32tBufferByteOffset) ) << 8
-    | *(unsigned char*)(pucBufferGet+__ui32tBufferByteOffset+1);
-  __ui16tBits >>= ( 16 - _ui8tBitsCount - ( ui32tBufferBitOffset & 0x7 ) );
+  if( ui32tBitCacheSize < _ui8tBitsCount )
+  {
+    // Refill bits cache (most significant bits first)
+    if( ui32tBufferByteOffset + 8 <= ui32tBufferByteSize )
+    {
+      // ... 64-bit word at once (extra bits are the actual subsequent payload bits)
+      uint64_t __ui64tBits_NS;
+      memcpy( &__ui64tBits_NS, pucBufferGet+ui32tBufferByteOffset, 8 );
+      ui64tBitCache |= be64toh( __ui64tBits_NS ) >> ui32tBitCacheSize;
+      uint32_t __ui32tBytesCount = ( 63 - ui32tBitCacheSize ) >> 3;
+      ui32tBufferByteOffset += __ui32tBytesCount;
+      ui32tBitCacheSize += __ui32tBytesCount * 8;
+    }
+    else
+    {
+      // ... byte-per-byte (payload end; missing bytes are read as zero)
+      while( ui32tBitCacheSize <= 56 )
+      {
+        if( ui32tBufferByteOffset < ui32tBufferByteSize )
+          ui64tBitCache |=
+            (uint64_t)pucBufferGet[ui32tBufferByteOffset] << ( 56 - ui32tBitCacheSize );
+        ui32tBufferByteOffset++;
+        ui32tBitCacheSize += 8;
+      }
+    }
+  }
+  uint32_t __ui32tBits = (uint32_t)( ui64tBitCache >> ( 64 - _ui8tBitsCount ) );
+  ui64tBitCache <<= _ui8tBitsCount;
+  ui32tBitCacheSize -= _ui8tBitsCount;
   ui32tBufferBitOffset += _ui8tBitsCount;
-  return __ui16tBits & BITMASK[_ui8tBitsCount];
+  return __ui32tBits;
 }
 
 void CPayload::getBytes( uint16_t _ui16tBytesCount,
                          unsigned char *_pucBytes )
 {
-  if( uint8_t __ui8tBufferBitAlign = ( ui32tBufferBitOffset & 0x7 ) )
-    getBits( 8 - __ui8tBufferBitAlign );
+  // Re-align and discard bits cache
+  ui32tBufferBitOffset = ( ui32tBufferBitOffset + 7 ) & ~0x7;
+  ui32tBufferByteOffset = ( ui32tBufferBitOffset >> 3 );
+  ui64tBitCache = 0;
+  ui32tBitCacheSize = 0;
   if( _ui16tBytesCount == 0 )
     return;
-  uint32_t __ui32tBufferByteOffset = ( ui32tBufferBitOffset >> 3 );
-  memcpy( _pucBytes, pucBufferGet+__ui32tBufferByteOffset, _ui16tBytesCount );
+  if( ui32tBufferByteOffset + _ui16tBytesCount <= ui32tBufferByteSize )
+    memcpy( _pucBytes, pucBufferGet+ui32tBufferByteOffset, _ui16tBytesCount );
+  else
+    memset( _pucBytes, 0, _ui16tBytesCount );
+  ui32tBufferByteOffset += _ui16tBytesCount;
   ui32tBufferBitOffset += _ui16tBytesCount * 8;
 }
 
+uint8_t CPayload::getContent( const unsigned char *_pucBuffer,
+                              uint16_t _ui16tPayloadSize )
+{
+  pucBufferGet = _pucBuffer;
+
+  // Reset bit counter
+  ui32tBufferBitOffset = 0;
+  ui32tBufferByteOffset = 0;
+  ui32tBufferByteSize = _ui16tPayloadSize;
+  ui64tBitCache = 0;
+  ui32tBitCacheSize = 0;
+
+  // Content
+  return getBits( 8 );
+}
+
+void CPayload::getFields( uint8_t _ui8tContent,
+                          uint32_t *_pui32tFields )
+{
+  // Content
+  CShapeTable<256>::TABLE.pGet[_ui8tContent]( this, _pui32tFields );
+
+  // Extended content
+  uint8_t __ui8tContentExtended = 0;
+  if( _ui8tContent & CField::FLAG_EXTENDED )
+  {
+    getBytes( 0, NULL ); // re-align
+    __ui8tContentExtended = getBits( 8 );
+  }
+  CShapeTable<256>::TABLE.pGetExtended[__ui8tContentExtended]( this,
+                                                               _pui32tFields );
+}
+
+int CPayload::encodedSize( const CData &_roData ) const
+{
+  // Payload parameters
+  uint32_t __ui32tGroups =
+    CGroupCodec<0,CField::GROUP_COUNT>::used(
+      _roData.ui32tDefined );
+  uint8_t __ui8tContent =
+    CGroupCodec<0,CField::GROUP_COUNT>::content( CField::CONTENT,
+                                                 __ui32tGroups );
+  uint8_t __ui8tContentExtended =
+    CGroupCodec<0,CField::GROUP_COUNT>::content( CField::CONTENT_EXTENDED,
+                                                 __ui32tGroups );
+  bool __bExtendedContent =
+    __ui32tGroups & CField::contentGroups( CField::CONTENT_EXTENDED );
+
+  // Content + ID' + ID
+  uint32_t __ui32tBitOffset = ( 2 + _roData.ui8tIDLength ) * 8;
+
+  // Data' + Data" + Data
+  if( _roData.ui16tDataSize > 0 )
+    __ui32tBitOffset +=
+      ( ( _roData.ui16tDataSize > 127 ) ? 2 : 1 ) * 8
+      + _roData.ui16tDataSize * 8;
+
+  // Content
+  __ui32tBitOffset += CShapeTable<256>::TABLE.pui16tBits[__ui8tContent];
+
+  // Extended content
+  if( __bExtendedContent )
+    __ui32tBitOffset = ( ( __ui32tBitOffset + 7 ) & ~0x7 ) + 8; // re-align
+  __ui32tBitOffset +=
+    CShapeTable<256>::TABLE.pui16tBitsExtended[__ui8tContentExtended];
+
+  // Done
+  return ( __ui32tBitOffset + 7 ) >> 3;
+}
+
 int CPayload::serialize( unsigned char *_pucBuffer,
                          const CData &_roData )
 {
@@ -98,258 +411,110 @@ int CPayload::serialize( unsigned char *_pucBuffer,
     return -EINVAL;
   pucBufferPut = _pucBuffer;
 
-  // Zero buffer and reset bit counter
-  zeroBuffer( pucBufferPut );
+  // Reset bit counter
+  // NOTE: there is no need to zero the buffer; only the bytes actually
+  //       making up the payload are written to (and entirely so)
   ui32tBufferBitOffset = 0;
+  ui32tBufferByteOffset = 0;
+  ui64tBitCache = 0;
+  ui32tBitCacheSize = 0;
 
   // Payload parameters
-  uint8_t __ui8tIDLength = strlen( _roData.pcID );
-  bool __bTime =
-    !( _roData.ui32tTime & CData::UNDEFINED_UINT32 );
-  bool __b2DPosition =
-    !( _roData.ui32tLatitude & CData::UNDEFINED_UINT32
-       || _roData.ui32tLongitude & CData::UNDEFINED_UINT32 );
-  bool __b3DPosition =
-    __b2DPosition
-    && !( _roData.ui32tElevation & CData::UNDEFINED_UINT32 );
-  bool __b2DGndCourse =
-    !( _roData.ui32tBearing & CData::UNDEFINED_UINT32
-       || _roData.ui32tGndSpeed & CData::UNDEFINED_UINT32 );
-  bool __b3DGndCourse =
-    __b2DGndCourse
-    && !( _roData.ui32tVrtSpeed & CData::UNDEFINED_UINT32 );
-  bool __b2DGndCourseDt =
-    !( _roData.ui32tBearingDt & CData::UNDEFINED_UINT32
-       || _roData.ui32tGndSpeedDt & CData::UNDEFINED_UINT32 );
-  bool __b3DGndCourseDt =
-    __b2DGndCourseDt
-    && !( _roData.ui32tVrtSpeedDt & CData::UNDEFINED_UINT32 );
-  bool __b2DAppCourse =
-    !( _roData.ui32tHeading & CData::UNDEFINED_UINT32
-       || _roData.ui32tAppSpeed & CData::UNDEFINED_UINT32 );
-  // ... extended content
-  bool __bExtendedContent = false;
-  bool __b2SourceType =
-    !( _roData.ui32tSourceType & CData::UNDEFINED_UINT32 );
-  __bExtendedContent |= __b2SourceType;
-  bool __b2DPositionError =
-    !( _roData.ui32tLatitudeError & CData::UNDEFINED_UINT32
-       || _roData.ui32tLongitudeError & CData::UNDEFINED_UINT32 );
-  __bExtendedContent |= __b2DPositionError;
-  bool __b3DPositionError =
-    __b2DPositionError
-    && !( _roData.ui32tElevationError & CData::UNDEFINED_UINT32 );
-  __bExtendedContent |= __b3DPositionError;
-  bool __b2DGndCourseError =
-    !( _roData.ui32tBearingError & CData::UNDEFINED_UINT32
-       || _roData.ui32tGndSpeedError & CData::UNDEFINED_UINT32 );
-  __bExtendedContent |= __b2DGndCourseError;
-  bool __b3DGndCourseError =
-    __b2DGndCourseError
-    && !( _roData.ui32tVrtSpeedError & CData::UNDEFINED_UINT32 );
-  __bExtendedContent |= __b3DGndCourseError;
-  bool __b2DGndCourseDtError =
-    !( _roData.ui32tBearingDtError & CData::UNDEFINED_UINT32
-       || _roData.ui32tGndSpeedDtError & CData::UNDEFINED_UINT32 );
-  __bExtendedContent |= __b2DGndCourseDtError;
-  bool __b3DGndCourseDtError =
-    __b2DGndCourseDtError
-    && !( _roData.ui32tVrtSpeedDtError & CData::UNDEFINED_UINT32 );
-  __bExtendedContent |= __b3DGndCourseDtError;
-  bool __b2DAppCourseError =
-    !( _roData.ui32tHeadingError & CData::UNDEFINED_UINT32
-       || _roData.ui32tAppSpeedError & CData::UNDEFINED_UINT32 );
-  __bExtendedContent |= __b2DAppCourseError;
+  uint8_t __ui8tIDLength = _roData.ui8tIDLength;
+  uint32_t __ui32tGroups =
+    CGroupCodec<0,CField::GROUP_COUNT>::used(
+      _roData.ui32tDefined );
+  uint8_t __ui8tContent =
+    CGroupCodec<0,CField::GROUP_COUNT>::content( CField::CONTENT,
+                                                 __ui32tGroups );
+  uint8_t __ui8tContentExtended =
+    CGroupCodec<0,CField::GROUP_COUNT>::content( CField::CONTENT_EXTENDED,
+                                                 __ui32tGroups );
+  bool __bExtendedContent =
+    __ui32tGroups & CField::contentGroups( CField::CONTENT_EXTENDED );
 
   // Content
-  putBits( 1, __b2DPosition );
-  putBits( 1, __b3DPosition );
-  putBits( 1, __b2DGndCourse );
-  putBits( 1, __b3DGndCourse );
-  putBits( 1, __b2DGndCourseDt );
-  putBits( 1, __b3DGndCourseDt );
-  putBits( 1, __b2DAppCourse );
-  putBits( 1, __bExtendedContent );
+  putBits( 8,
+           __ui8tContent
+           | ( __bExtendedContent ? CField::FLAG_EXTENDED : 0 ) );
 
   // ID' + ID
-  putBits( 7, __ui8tIDLength );
-  putBits( 1, _roData.ui16tDataSize > 0 );
+  putBits( 8,
+           __ui8tIDLength << 1
+           | ( _roData.ui16tDataSize > 0 ) );
   if( __ui8tIDLength > 0 )
-    putBytes( __ui8tIDLength, (unsigned char*)_roData.pcID );
+    putBytes( __ui8tIDLength, (unsigned char*)_roData.getID() );
 
   // Data' + Data" + Data
   if( _roData.ui16tDataSize > 0 )
   {
     if( _roData.ui16tDataSize > 127 )
-    {
-      putBits( 7, (uint8_t)( _roData.ui16tDataSize ) );
-      putBits( 1, 1 );
-      putBits( 8, (uint8_t)( _roData.ui16tDataSize >> 7 ) );
-    }
+      putBits( 16,
+               ( _roData.ui16tDataSize & 0x7F ) << 9
+               | 1 << 8
+               | ( ( _roData.ui16tDataSize >> 7 ) & 0xFF ) );
     else
-    {
-      putBits( 7, (uint8_t)( _roData.ui16tDataSize ) );
-      putBits( 1, 0 );
-    }
-  }
-  if( _roData.ui16tDataSize > 0 )
+      putBits( 8, _roData.ui16tDataSize << 1 );
     putBytes( _roData.ui16tDataSize, _roData.pucData );
-
-  // Content
-
-  // ... Time
-  if( __bTime )
-  {
-    putBits( 7, (uint8_t)( _roData.ui32tTime >> 16 ) );
-    putBits( 8, (uint8_t)( _roData.ui32tTime >> 8 ) );
-    putBits( 8, (uint8_t)( _roData.ui32tTime ) );
-  }
-  else
-  {
-    putBits( 7, (uint8_t)( CData::OVERFLOW_UINT32 >> 16 ) );
-    putBits( 8, (uint8_t)( CData::OVERFLOW_UINT32 >> 8 ) );
-    putBits( 8, (uint8_t)( CData::OVERFLOW_UINT32 ) );
-  }
-
-  // ... Position
-  if( __b2DPosition )
-  {
-    // ... Latitude
-    putBits( 6, (uint8_t)( _roData.ui32tLatitude >> 24 ) );
-    putBits( 8, (uint8_t)( _roData.ui32tLatitude >> 16 ) );
-    putBits( 8, (uint8_t)( _roData.ui32tLatitude >> 8 ) );
-    putBits( 8, (uint8_t)( _roData.ui32tLatitude ) );
-    // ... Longitude
-    putBits( 7, (uint8_t)( _roData.ui32tLongitude >> 24 ) );
-    putBits( 8, (uint8_t)( _roData.ui32tLongitude >> 16 ) );
-    putBits( 8, (uint8_t)( _roData.ui32tLongitude >> 8 ) );
-    putBits( 8, (uint8_t)( _roData.ui32tLongitude ) );
-  }
-  if( __b3DPosition )
-  {
-    // ... Elevation
-    putBits( 3, (uint8_t)( _roData.ui32tElevation >> 16 ) );
-    putBits( 8, (uint8_t)( _roData.ui32tElevation >> 8 ) );
-    putBits( 8, (uint8_t)( _roData.ui32tElevation ) );
-  }
-
-  // ... Ground course
-  if( __b2DGndCourse )
-  {
-    // ... Bearing
-    putBits( 4, (uint8_t)( _roData.ui32tBearing >> 8) );
-    putBits( 8, (uint8_t)( _roData.ui32tBearing ) );
-    // ... Ground speed
-    putBits( 8, (uint8_t)( _roData.ui32tGndSpeed >> 8 ) );
-    putBits( 8, (uint8_t)( _roData.ui32tGndSpeed ) );
-  }
-  if( __b3DGndCourse )
-  {
-    // ... Vertical speed
-    putBits( 5, (uint8_t)( _roData.ui32tVrtSpeed >> 8) );
-    putBits( 8, (uint8_t)( _roData.ui32tVrtSpeed ) );
-  }
-
-  // ... Ground course variation over time
-  if( __b2DGndCourseDt )
-  {
-    // ... Bearing
-    putBits( 2, (uint8_t)( _roData.ui32tBearingDt >> 8) );
-    putBits( 8, (uint8_t)( _roData.ui32tBearingDt ) );
-    // ... Ground speed
-    putBits( 4, (uint8_t)( _roData.ui32tGndSpeedDt >> 8 ) );
-    putBits( 8, (uint8_t)( _roData.ui32tGndSpeedDt ) );
-  }
-  if( __b3DGndCourseDt )
-  {
-    // ... Vertical speed
-    putBits( 4, (uint8_t)( _roData.ui32tVrtSpeedDt >> 8) );
-    putBits( 8, (uint8_t)( _roData.ui32tVrtSpeedDt ) );
   }
 
-  // ... Apparent course
-  if( __b2DAppCourse )
-  {
-    // ... Heading
-    putBits( 4, (uint8_t)( _roData.ui32tHeading >> 8) );
-    putBits( 8, (uint8_t)( _roData.ui32tHeading ) );
-    // ... Apparent speed
-    putBits( 8, (uint8_t)( _roData.ui32tAppSpeed >> 8 ) );
-    putBits( 8, (uint8_t)( _roData.ui32tAppSpeed ) );
-  }
+  // Content
+  uint32_t __pui32tFields[CField::COUNT];
+  _roData.getFields( __pui32tFields );
+  CShapeTable<256>::TABLE.pPut[__ui8tContent]( this, __pui32tFields );
 
   // Extended content
   if( __bExtendedContent )
   {
     putBytes( 0, NULL ); // re-align
-    putBits( 1, __b2DPositionError );
-    putBits( 1, __b3DPositionError );
-    putBits( 1, __b2DGndCourseError );
-    putBits( 1, __b3DGndCourseError );
-    putBits( 1, __b2DGndCourseDtError );
-    putBits( 1, __b3DGndCourseDtError );
-    putBits( 1, __b2DAppCourseError );
-    putBits( 1, 0 );
+    putBits( 8, __ui8tContentExtended );
   }
-  // ... Source type
-  putBits( 8, (uint8_t)( _roData.ui32tSourceType ) );
+  CShapeTable<256>::TABLE.pPutExtended[__ui8tContentExtended]( this,
+                                                               __pui32tFields );
 
-  // ... Position error
-  if( __b2DPositionError )
-  {
-    // ... Latitude
-    putBits( 4, (uint8_t)( _roData.ui32tLatitudeError >> 8 ) );
-    putBits( 8, (uint8_t)( _roData.ui32tLatitudeError ) );
-    // ... Longitude
-    putBits( 4, (uint8_t)( _roData.ui32tLongitudeError >> 8 ) );
-    putBits( 8, (uint8_t)( _roData.ui32tLongitudeError ) );
-  }
-  if( __b3DPositionError )
-  {
-    // ... Elevation
-    putBits( 4, (uint8_t)( _roData.ui32tElevationError >> 8 ) );
-    putBits( 8, (uint8_t)( _roData.ui32tElevationError ) );
-  }
+  // Flush bits cache
+  putBytes( 0, NULL );
+  ui32tBufferPutSize = ui32tBufferByteOffset;
 
-  // ... Ground course error
-  if( __b2DGndCourseError )
-  {
-    // ... Bearing
-    putBits( 8, (uint8_t)( _roData.ui32tBearingError ) );
-    // ... Ground speed
-    putBits( 8, (uint8_t)( _roData.ui32tGndSpeedError ) );
-  }
-  if( __b3DGndCourseError )
-  {
-    // ... Vertical speed
-    putBits( 8, (uint8_t)( _roData.ui32tVrtSpeedError ) );
-  }
+  // Done
+  return ui32tBufferByteOffset;
+}
 
-  // ... Ground course variation over time error
-  if( __b2DGndCourseDtError )
-  {
-    // ... Bearing
-    putBits( 8, (uint8_t)( _roData.ui32tBearingDtError ) );
-    // ... Ground speed
-    putBits( 8, (uint8_t)( _roData.ui32tGndSpeedDtError ) );
-  }
-  if( __b3DGndCourseDtError )
-  {
-    // ... Vertical speed
-    putBits( 8, (uint8_t)( _roData.ui32tVrtSpeedDtError ) );
-  }
+int CPayload::serializeBatch( unsigned char *_pucBuffer,
+                              int _iBufferSize,
+                              const CData *_poData,
+                              int _iDataCount,
+                              int *_piDataSerialized )
+{
+  int __iReturn;
+
+  // Check buffer
+  if( !_pucBuffer )
+    return -EINVAL;
 
-  // ... Apparent course error
-  if( __b2DAppCourseError )
+  // Create (framed) payloads
+  int __iBufferOffset = 0;
+  int __i;
+  for( __i = 0; __i < _iDataCount; __i++ )
   {
-    // ... Heading
-    putBits( 8, (uint8_t)( _roData.ui32tHeadingError ) );
-    // ... Apparent speed
-    putBits( 8, (uint8_t)( _roData.ui32tAppSpeedError ) );
+    if( _iBufferSize - __iBufferOffset < encodedSize( _poData[__i] )+2 )
+      break;
+
+    // ... content
+    __iReturn = serialize( _pucBuffer+__iBufferOffset+2, _poData[__i] );
+    if( __iReturn < 0 )
+      return __iReturn;
+
+    // ... size
+    uint16_t __ui16tPayloadSize_NS = htons( __iReturn );
+    memcpy( _pucBuffer+__iBufferOffset, &__ui16tPayloadSize_NS, 2 );
+    __iBufferOffset += __iReturn+2;
   }
+  if( _piDataSerialized )
+    *_piDataSerialized = __i;
 
   // Done
-  return ( ui32tBufferBitOffset + 7 ) >> 3;
+  return __iBufferOffset;
 }
 
 int CPayload::unserialize( CData *_poData,
@@ -359,298 +524,230 @@ int CPayload::unserialize( CData *_poData,
   // Check buffer
   if( !_pucBuffer )
     return -EINVAL;
-  pucBufferGet = _pucBuffer;
-
-  // Reset bit counter
-  ui32tBufferBitOffset = 0;
 
   // Zero data container
   _poData->reset( false );
 
   // Content
-  // ... Geolocalization data
-  bool __b2DPosition = (bool)getBits( 1 );
-  bool __b3DPosition = (bool)getBits( 1 );
-  bool __b2DGndCourse = (bool)getBits( 1 );
-  bool __b3DGndCourse = (bool)getBits( 1 );
-  bool __b2DGndCourseDt = (bool)getBits( 1 );
-  bool __b3DGndCourseDt = (bool)getBits( 1 );
-  bool __b2DAppCourse = (bool)getBits( 1 );
-  bool __bExtendedContent = (bool)getBits( 1 );
+  uint8_t __ui8tContent = getContent( _pucBuffer, _ui16tPayloadSize );
 
   // ID' + ID
-  uint8_t __ui8tIDLength = getBits( 7 );
-  bool __bData = (bool)getBits( 1 );
-  if( __ui8tIDLength > 0 )
-    getBytes( __ui8tIDLength, (unsigned char*)_poData->pcID );
-  _poData->pcID[__ui8tIDLength] = '\0';
+  uint32_t __ui32tIDLength = getBits( 8 );
+  bool __bData = __ui32tIDLength & 0x01;
+  __ui32tIDLength >>= 1;
+  char *__pcID = _poData->allocID( __ui32tIDLength );
+  if( !__pcID )
+    return -ENOMEM;
+  if( __ui32tIDLength > 0 )
+    getBytes( __ui32tIDLength, (unsigned char*)__pcID );
+  __pcID[__ui32tIDLength] = '\0';
 
   // Data' + Data" + Data
   if( __bData )
   {
-    uint16_t __ui16tDataSize = getBits( 7 );
-    if( (bool)getBits( 1 ) )
-      __ui16tDataSize |= getBits( 8 ) << 7;
-    _poData->allocData( __ui16tDataSize );
+    uint32_t __ui32tDataSize = getBits( 8 );
+    if( __ui32tDataSize & 0x01 )
+      __ui32tDataSize = ( __ui32tDataSize >> 1 ) | getBits( 8 ) << 7;
+    else
+      __ui32tDataSize >>= 1;
+    _poData->allocData( __ui32tDataSize );
   }
   else
-    _poData->freeData();
+    _poData->allocData( 0 );
   if( _poData->ui16tDataSize > 0 )
     getBytes( _poData->ui16tDataSize, _poData->pucData );
 
   // Content
-  uint32_t __ui32tData;
-
-  // ... Time
-  __ui32tData = getBits( 7 );
-  __ui32tData <<= 8; __ui32tData |= getBits( 8 );
-  __ui32tData <<= 8; __ui32tData |= getBits( 8 );
-  _poData->ui32tTime =
-    ( __ui32tData == ( 0xFFFFFFFF >> 9 ) )
-    ? CData::UNDEFINED_UINT32
-    : __ui32tData;
-
-  // ... Position
-  if( __b2DPosition )
-  {
-    // ... Latitude
-    __ui32tData = getBits( 6 );
-    __ui32tData <<= 8; __ui32tData |= getBits( 8 );
-    __ui32tData <<= 8; __ui32tData |= getBits( 8 );
-    __ui32tData <<= 8; __ui32tData |= getBits( 8 );
-    _poData->ui32tLatitude =
-      ( __ui32tData == ( 0xFFFFFFFF >> 2 ) )
-      ? CData::OVERFLOW_UINT32
-      : __ui32tData;
-    // ... Longitude
-    __ui32tData = getBits( 7 );
-    __ui32tData <<= 8; __ui32tData |= getBits( 8 );
-    __ui32tData <<= 8; __ui32tData |= getBits( 8 );
-    __ui32tData <<= 8; __ui32tData |= getBits( 8 );
-    _poData->ui32tLongitude =
-      ( __ui32tData == ( 0xFFFFFFFF >> 1 ) )
-      ? CData::OVERFLOW_UINT32
-      : __ui32tData;
-  }
-  if( __b3DPosition )
-  {
-    // ... Elevation
-    __ui32tData = getBits( 3 );
-    __ui32tData <<= 8; __ui32tData |= getBits( 8 );
-    __ui32tData <<= 8; __ui32tData |= getBits( 8 );
-    _poData->ui32tElevation =
-      ( __ui32tData == ( 0xFFFFFFFF >> 13 ) )
-      ? CData::OVERFLOW_UINT32
-      : __ui32tData;
-  }
+  uint32_t __pui32tFields[CField::COUNT];
+  for( int __i = 0; __i < CField::COUNT; __i++ )
+    __pui32tFields[__i] = CField::UNDEFINED_UINT32;
+  getFields( __ui8tContent, __pui32tFields );
+  _poData->setFields( __pui32tFields );
 
-  // ... Ground course
-  if( __b2DGndCourse )
-  {
-    // ... Bearing
-    __ui32tData = getBits( 4 );
-    __ui32tData <<= 8; __ui32tData |= getBits( 8 );
-    _poData->ui32tBearing =
-      ( __ui32tData == ( 0xFFFFFFFF >> 20 ) )
-      ? CData::OVERFLOW_UINT32
-      : __ui32tData;
-    // ... Ground speed
-    __ui32tData = getBits( 8 );
-    __ui32tData <<= 8; __ui32tData |= getBits( 8 );
-    _poData->ui32tGndSpeed =
-      ( __ui32tData == ( 0xFFFFFFFF >> 16 ) )
-      ? CData::OVERFLOW_UINT32
-      : __ui32tData;
-  }
-  if( __b3DGndCourse )
-  {
-    // ... Vertical speed
-    __ui32tData = getBits( 5 );
-    __ui32tData <<= 8; __ui32tData |= getBits( 8 );
-    _poData->ui32tVrtSpeed =
-      ( __ui32tData == ( 0xFFFFFFFF >> 19 ) )
-      ? CData::OVERFLOW_UINT32
-      : __ui32tData;
-  }
+  // Check size
+  if( ( ui32tBufferBitOffset + 7 ) >> 3 != _ui16tPayloadSize )
+    return -EBADMSG;
 
-  // ... Ground course variation over time
-  if( __b2DGndCourseDt )
-  {
-    // ... Bearing
-    __ui32tData = getBits( 2 );
-    __ui32tData <<= 8; __ui32tData |= getBits( 8 );
-    _poData->ui32tBearingDt =
-      ( __ui32tData == ( 0xFFFFFFFF >> 22 ) )
-      ? CData::OVERFLOW_UINT32
-      : __ui32tData;
-    // ... Ground speed
-    __ui32tData = getBits( 4 );
-    __ui32tData <<= 8; __ui32tData |= getBits( 8 );
-    _poData->ui32tGndSpeedDt =
-      ( __ui32tData == ( 0xFFFFFFFF >> 20 ) )
-      ? CData::OVERFLOW_UINT32
-      : __ui32tData;
-  }
-  if( __b3DGndCourseDt )
-  {
-    // ... Vertical speed
-    __ui32tData = getBits( 4 );
-    __ui32tData <<= 8; __ui32tData |= getBits( 8 );
-    _poData->ui32tVrtSpeedDt =
-      ( __ui32tData == ( 0xFFFFFFFF >> 20 ) )
-      ? CData::OVERFLOW_UINT32
-      : __ui32tData;
-  }
+  // Done
+  return ( ui32tBufferBitOffset + 7 ) >> 3;
+}
+
+int CPayload::peek( const unsigned char *_pucBuffer,
+                    uint16_t _ui16tPayloadSize,
+                    uint8_t *_pui8tContent,
+                    const char **_ppcID,
+                    uint8_t *_pui8tIDLength )
+{
+  // Check buffer
+  if( !_pucBuffer )
+    return -EINVAL;
+  if( _ui16tPayloadSize < 2 )
+    return -EBADMSG;
+
+  // NOTE: content, ID and data are always byte-aligned; fields need not be
+  //       decoded, their size being given by the content flags
+
+  // Content
+  uint8_t __ui8tContent = _pucBuffer[0];
+
+  // ID' + ID
+  uint32_t __ui32tIDLength = _pucBuffer[1] >> 1;
+  bool __bData = _pucBuffer[1] & 0x01;
+  uint32_t __ui32tByteOffset = 2 + __ui32tIDLength;
 
-  // ... Apparent course
-  if( __b2DAppCourse )
+  // Data' + Data" + Data
+  if( __bData )
   {
-    // ... Heading
-    __ui32tData = getBits( 4 );
-    __ui32tData <<= 8; __ui32tData |= getBits( 8 );
-    _poData->ui32tHeading =
-      ( __ui32tData == ( 0xFFFFFFFF >> 20 ) )
-      ? CData::OVERFLOW_UINT32
-      : __ui32tData;
-    // ... Apparent speed
-    __ui32tData = getBits( 8 );
-    __ui32tData <<= 8; __ui32tData |= getBits( 8 );
-    _poData->ui32tAppSpeed =
-      ( __ui32tData == ( 0xFFFFFFFF >> 16 ) )
-      ? CData::OVERFLOW_UINT32
-      : __ui32tData;
+    if( __ui32tByteOffset >= _ui16tPayloadSize )
+      return -EBADMSG;
+    uint32_t __ui32tDataSize = _pucBuffer[__ui32tByteOffset++];
+    if( __ui32tDataSize & 0x01 )
+    {
+      if( __ui32tByteOffset >= _ui16tPayloadSize )
+        return -EBADMSG;
+      __ui32tDataSize =
+        ( __ui32tDataSize >> 1 ) | _pucBuffer[__ui32tByteOffset++] << 7;
+    }
+    else
+      __ui32tDataSize >>= 1;
+    __ui32tByteOffset += __ui32tDataSize;
   }
 
+  // Content
+  uint32_t __ui32tBitOffset =
+    __ui32tByteOffset * 8
+    + CShapeTable<256>::TABLE.pui16tBits[__ui8tContent];
 
   // Extended content
-  bool __b2DPositionError = false;
-  bool __b3DPositionError = false;
-  bool __b2DGndCourseError = false;
-  bool __b3DGndCourseError = false;
-  bool __b2DGndCourseDtError = false;
-  bool __b3DGndCourseDtError = false;
-  bool __b2DAppCourseError = false;
-  if( __bExtendedContent )
+  uint8_t __ui8tContentExtended = 0;
+  if( __ui8tContent & CField::FLAG_EXTENDED )
   {
-    getBytes( 0, NULL ); // re-align
-    __b2DPositionError = (bool)getBits( 1 );
-    __b3DPositionError = (bool)getBits( 1 );
-    __b2DGndCourseError = (bool)getBits( 1 );
-    __b3DGndCourseError = (bool)getBits( 1 );
-    __b2DGndCourseDtError = (bool)getBits( 1 );
-    __b3DGndCourseDtError = (bool)getBits( 1 );
-    __b2DAppCourseError = (bool)getBits( 1 );
-    getBits( 1 );
-  }
-  // ... Source type
-  __ui32tData = getBits( 8 );
-  _poData->ui32tSourceType =
-    ( __ui32tData != CData::SOURCE_UNDEFINED )
-    ? __ui32tData
-    : CData::UNDEFINED_UINT32;
-
-  // ... Position error
-  if( __b2DPositionError )
-  {
-    // ... Latitude
-    __ui32tData = getBits( 4 );
-    __ui32tData <<= 8; __ui32tData |= getBits( 8 );
-    _poData->ui32tLatitudeError =
-      ( __ui32tData == ( 0xFFFFFFFF >> 20 ) )
-      ? CData::OVERFLOW_UINT32
-      : __ui32tData;
-    // ... Longitude
-    __ui32tData = getBits( 4 );
-    __ui32tData <<= 8; __ui32tData |= getBits( 8 );
-    _poData->ui32tLongitudeError =
-      ( __ui32tData == ( 0xFFFFFFFF >> 20 ) )
-      ? CData::OVERFLOW_UINT32
-      : __ui32tData;
-  }
-  if( __b3DPositionError )
-  {
-    // ... Elevation
-    __ui32tData = getBits( 4 );
-    __ui32tData <<= 8; __ui32tData |= getBits( 8 );
-    _poData->ui32tElevationError =
-      ( __ui32tData == ( 0xFFFFFFFF >> 20 ) )
-      ? CData::OVERFLOW_UINT32
-      : __ui32tData;
+    __ui32tByteOffset = ( __ui32tBitOffset + 7 ) >> 3; // re-align
+    if( __ui32tByteOffset >= _ui16tPayloadSize )
+      return -EBADMSG;
+    __ui8tContentExtended = _pucBuffer[__ui32tByteOffset];
+    __ui32tBitOffset = ( __ui32tByteOffset + 1 ) * 8;
   }
+  __ui32tBitOffset +=
+    CShapeTable<256>::TABLE.pui16tBitsExtended[__ui8tContentExtended];
 
-  // ... Ground course error
-  if( __b2DGndCourseError )
-  {
-    // ... Bearing
-    __ui32tData = getBits( 8 );
-    _poData->ui32tBearingError =
-      ( __ui32tData == ( 0xFFFFFFFF >> 24 ) )
-      ? CData::OVERFLOW_UINT32
-      : __ui32tData;
-    // ... Ground speed
-    __ui32tData = getBits( 8 );
-    _poData->ui32tGndSpeedError =
-      ( __ui32tData == ( 0xFFFFFFFF >> 24 ) )
-      ? CData::OVERFLOW_UINT32
-      : __ui32tData;
-  }
-  if( __b3DGndCourseError )
-  {
-    // ... Vertical speed
-    __ui32tData = getBits( 8 );
-    _poData->ui32tVrtSpeedError =
-      ( __ui32tData == ( 0xFFFFFFFF >> 24 ) )
-      ? CData::OVERFLOW_UINT32
-      : __ui32tData;
-  }
+  // Check size
+  if( ( __ui32tBitOffset + 7 ) >> 3 != _ui16tPayloadSize )
+    return -EBADMSG;
 
-  // ... Ground course variation over time error
-  if( __b2DGndCourseDtError )
-  {
-    // ... Bearing
-    __ui32tData = getBits( 8 );
-    _poData->ui32tBearingDtError =
-      ( __ui32tData == ( 0xFFFFFFFF >> 24 ) )
-      ? CData::OVERFLOW_UINT32
-      : __ui32tData;
-    // ... Ground speed
-    __ui32tData = getBits( 8 );
-    _poData->ui32tGndSpeedDtError =
-      ( __ui32tData == ( 0xFFFFFFFF >> 24 ) )
-      ? CData::OVERFLOW_UINT32
-      : __ui32tData;
-  }
-  if( __b3DGndCourseDtError )
+  // Done
+  if( _pui8tContent )
+    *_pui8tContent = __ui8tContent;
+  if( _ppcID )
+    *_ppcID = (const char*)_pucBuffer+2;
+  if( _pui8tIDLength )
+    *_pui8tIDLength = __ui32tIDLength;
+  return _ui16tPayloadSize;
+}
+
+int CPayload::unserialize( CDataBlock *_poDataBlock,
+                           const unsigned char *_pucBuffer,
+                           uint16_t _ui16tPayloadSize )
+{
+  int __iReturn;
+
+  // Check buffer (and data block)
+  if( !_pucBuffer )
+    return -EINVAL;
+  if( _poDataBlock->isFull() )
+    return -ENOSPC;
+  int __iIndex = _poDataBlock->iSize;
+
+  // Content
+  uint8_t __ui8tContent = getContent( _pucBuffer, _ui16tPayloadSize );
+
+  // ID' + ID
+  uint32_t __ui32tIDLength = getBits( 8 );
+  bool __bData = __ui32tIDLength & 0x01;
+  __ui32tIDLength >>= 1;
+  uint32_t __ui32tDataSize = 0;
+  if( __bData )
   {
-    // ... Vertical speed
-    __ui32tData = getBits( 8 );
-    _poData->ui32tVrtSpeedDtError =
-      ( __ui32tData == ( 0xFFFFFFFF >> 24 ) )
-      ? CData::OVERFLOW_UINT32
-      : __ui32tData;
+    // NOTE: the data size follows the ID; make room for the largest data
+    __ui32tDataSize = CData::MAX_DATA_SIZE;
   }
+  __iReturn = _poDataBlock->reserve( __ui32tIDLength+1, __ui32tDataSize );
+  if( __iReturn < 0 )
+    return __iReturn;
+  char *__pcID = _poDataBlock->pcIDs + _poDataBlock->pui32tIDOffsets[__iIndex];
+  if( __ui32tIDLength > 0 )
+    getBytes( __ui32tIDLength, (unsigned char*)__pcID );
+  __pcID[__ui32tIDLength] = '\0';
 
-  // ... Apparent course error
-  if( __b2DAppCourseError )
+  // Data' + Data" + Data
+  if( __bData )
   {
-    // ... Heading
-    __ui32tData = getBits( 8 );
-    _poData->ui32tHeadingError =
-      ( __ui32tData == ( 0xFFFFFFFF >> 24 ) )
-      ? CData::OVERFLOW_UINT32
-      : __ui32tData;
-    // ... Apparent speed
-    __ui32tData = getBits( 8 );
-    _poData->ui32tAppSpeedError =
-      ( __ui32tData == ( 0xFFFFFFFF >> 24 ) )
-      ? CData::OVERFLOW_UINT32
-      : __ui32tData;
+    __ui32tDataSize = getBits( 8 );
+    if( __ui32tDataSize & 0x01 )
+      __ui32tDataSize = ( __ui32tDataSize >> 1 ) | getBits( 8 ) << 7;
+    else
+      __ui32tDataSize >>= 1;
+    if( __ui32tDataSize > 0 )
+      getBytes( __ui32tDataSize,
+                _poDataBlock->pucData + _poDataBlock->pui32tDataOffsets[__iIndex] );
   }
 
+  // Content
+  uint32_t __pui32tFields[CField::COUNT];
+  for( int __i = 0; __i < CField::COUNT; __i++ )
+    __pui32tFields[__i] = CField::UNDEFINED_UINT32;
+  getFields( __ui8tContent, __pui32tFields );
+
   // Check size
   if( ( ui32tBufferBitOffset + 7 ) >> 3 != _ui16tPayloadSize )
     return -EBADMSG;
 
+  // Append record
+  int __iCapacity = _poDataBlock->iCapacity;
+  for( int __i = 0; __i < CField::COUNT; __i++ )
+    _poDataBlock->pui32tFields[__i * __iCapacity + __iIndex] = __pui32tFields[__i];
+  _poDataBlock->pui32tDefined[__iIndex] =
+    CFieldCodec<0,CField::COUNT>::defined( __pui32tFields );
+  _poDataBlock->pui32tIDOffsets[__iIndex+1] =
+    _poDataBlock->pui32tIDOffsets[__iIndex] + __ui32tIDLength+1;
+  _poDataBlock->pui32tDataOffsets[__iIndex+1] =
+    _poDataBlock->pui32tDataOffsets[__iIndex] + __ui32tDataSize;
+  _poDataBlock->iSize++;
+
   // Done
   return ( ui32tBufferBitOffset + 7 ) >> 3;
 }
+
+int CPayload::unserializeBatch( CDataBlock *_poDataBlock,
+                                const unsigned char *_pucBuffer,
+                                int _iBufferSize )
+{
+  int __iReturn;
+
+  // Check buffer
+  if( !_pucBuffer )
+    return -EINVAL;
+
+  // Unserialize (framed) payloads
+  int __iBufferOffset = 0;
+  while( !_poDataBlock->isFull() && _iBufferSize - __iBufferOffset >= 2 )
+  {
+    // ... size
+    uint16_t __ui16tPayloadSize_NS;
+    memcpy( &__ui16tPayloadSize_NS, _pucBuffer+__iBufferOffset, 2 );
+    uint16_t __ui16tPayloadSize = ntohs( __ui16tPayloadSize_NS );
+    if( _iBufferSize - __iBufferOffset - 2 < __ui16tPayloadSize )
+      break;
+
+    // ... content
+    __iReturn = unserialize( _poDataBlock,
+                             _pucBuffer+__iBufferOffset+2,
+                             __ui16tPayloadSize );
+    if( __iReturn < 0 )
+      return __iReturn;
+    __iBufferOffset += __ui16tPayloadSize+2;
+  }
+
+  // Done
+  return __iBufferOffset;
+}
@@ -131,6 +131,15 @@ int CPayload_AES128::alloc()
   return 0;
 }
 
+int CPayload_AES128::encodedSize( const CData &_roData ) const
+{
+  // IV + cipher(raw payload + seal + PKCS#7 padding)
+  int __iPayloadSize_RAW = CPayload::encodedSize( _roData ) + CRYPTO_SEAL_SIZE;
+  return
+    CRYPTO_BLOCK_SIZE
+    + ( __iPayloadSize_RAW / CRYPTO_BLOCK_SIZE + 1 ) * CRYPTO_BLOCK_SIZE;
+}
+
 int CPayload_AES128::serialize( unsigned char *_pucBuffer,
                                 const CData &_roData )
 {
@@ -214,6 +223,7 @@ int CPayload_AES128::serialize( unsigned char *_pucBuffer,
   gcry_cipher_close( __gcryCipherHd );
 
 #endif // NOT __SGCTP_USE_OPENSSL__
+  ui32tBufferPutSize = __iPayloadSize;
 
   // Done
   return __iPayloadSize;
@@ -225,6 +235,91 @@ int CPayload_AES128::unserialize( CData *_poData,
 {
   int __iReturn;
 
+  // Decrypt
+  int __iPayloadSize;
+  __iReturn = decrypt( _pucBuffer, _ui16tBufferSize, &__iPayloadSize );
+  if( __iReturn < 0 )
+    return __iReturn;
+
+  // Unserialize raw payload
+  __iReturn = CPayload::unserialize( _poData,
+                                     pucBufferTmp,
+                                     __iReturn );
+  if( __iReturn <= 0 )
+    return __iReturn;
+
+  // Done
+  return __iPayloadSize;
+}
+
+int CPayload_AES128::peek( const unsigned char *_pucBuffer,
+                           uint16_t _ui16tBufferSize,
+                           uint8_t *_pui8tContent,
+                           const char **_ppcID,
+                           uint8_t *_pui8tIDLength )
+{
+  int __iReturn;
+
+  // Decrypt
+  int __iPayloadSize;
+  __iReturn = decrypt( _pucBuffer, _ui16tBufferSize, &__iPayloadSize );
+  if( __iReturn < 0 )
+    return __iReturn;
+
+  // Peek at raw payload
+  __iReturn = CPayload::peek( pucBufferTmp,
+                              __iReturn,
+                              _pui8tContent,
+                              _ppcID,
+                              _pui8tIDLength );
+  if( __iReturn <= 0 )
+    return __iReturn;
+
+  // Done
+  return __iPayloadSize;
+}
+
+int CPayload_AES128::unserialize( CDataBlock *_poDataBlock,
+                                  const unsigned char *_pucBuffer,
+                                  uint16_t _ui16tBufferSize )
+{
+  int __iReturn;
+
+  // Decrypt
+  int __iPayloadSize;
+  __iReturn = decrypt( _pucBuffer, _ui16tBufferSize, &__iPayloadSize );
+  if( __iReturn < 0 )
+    return __iReturn;
+
+  // Unserialize raw payload
+  __iReturn = CPayload::unserialize( _poDataBlock,
+                                     pucBufferTmp,
+                                     __iReturn );
+  if( __iReturn <= 0 )
+    return __iReturn;
+
+  // Done
+  return __iPayloadSize;
+}
+
+void CPayload_AES128::free()
+{
+  if( pucBufferTmp )
+    freeBuffer( pucBufferTmp );
+  pucBufferTmp = NULL;
+}
+
+
+//----------------------------------------------------------------------
+// METHODS
+//----------------------------------------------------------------------
+
+int CPayload_AES128::decrypt( const unsigned char *_pucBuffer,
+                              uint16_t _ui16tBufferSize,
+                              int *_piPayloadSize )
+{
+  int __iReturn;
+
   // Check buffer
   if( _ui16tBufferSize-CRYPTO_BLOCK_SIZE > BUFFER_SIZE )
     return -EOVERFLOW;
@@ -299,29 +394,11 @@ int CPayload_AES128::unserialize( CData *_poData,
   if( __iReturn )
     return -EBADE;
 
-  // ... unserialize raw payload
-  __iReturn = CPayload::unserialize( _poData,
-                                     pucBufferTmp,
-                                     __iPayloadSize_RAW );
-  if( __iReturn <= 0 )
-    return __iReturn;
-
   // Done
-  return __iPayloadSize;
-}
-
-void CPayload_AES128::free()
-{
-  if( pucBufferTmp )
-    freeBuffer( pucBufferTmp );
-  pucBufferTmp = NULL;
+  *_piPayloadSize = __iPayloadSize;
+  return __iPayloadSize_RAW;
 }
 
-
-//----------------------------------------------------------------------
-// METHODS
-//----------------------------------------------------------------------
-
 int CPayload_AES128::makeCryptoKey( const unsigned char *_pucPassword,
                                     int _iPasswordLength,
                                     const unsigned char *_pucNonce )
@@ -0,0 +1,536 @@
+// INDENTING (emacs/vi): -*- mode:c++; tab-width:2; c-basic-offset:2; intent-tabs-mode:nil; -*- ex: set tabstop=2 expandtab:
+
+/*
+ * Simple Geolocalization and Course Transmission Protocol (SGCTP)
+ * Copyright (C) 2014 Cedric Dufour <http://cedric.dufour.name>
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * free software:
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, Version 3.
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ */
+
+// C
+#include <errno.h>
+#include <string.h>
+
+// C++
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+// SGCTP
+#include "sgctp/data.hpp"
+#include "sgctp/field.hpp"
+#include "sgctp/payload_delta.hpp"
+using namespace SGCTP;
+
+
+//----------------------------------------------------------------------
+// CONSTRUCTORS / DESTRUCTOR
+//----------------------------------------------------------------------
+
+CPayload_DELTA::CPayload_DELTA()
+  : CPayload()
+  , pucBufferTmp( NULL )
+  , ui16tSlotRecycle( 0 )
+  , poDataTmp_put( NULL )
+  , poDataTmp_get( NULL )
+{}
+
+CPayload_DELTA::~CPayload_DELTA()
+{
+  free();
+}
+
+
+//----------------------------------------------------------------------
+// METHODS: CPayload (implement/override)
+//----------------------------------------------------------------------
+
+int CPayload_DELTA::alloc()
+{
+  if( !pucBufferTmp )
+  {
+    pucBufferTmp = allocBuffer();
+    if( !pucBufferTmp )
+      return -ENOMEM;
+  }
+  if( !poDataTmp_put )
+  {
+    poDataTmp_put = new CData();
+    if( !poDataTmp_put )
+      return -ENOMEM;
+  }
+  if( !poDataTmp_get )
+  {
+    poDataTmp_get = new CData();
+    if( !poDataTmp_get )
+      return -ENOMEM;
+  }
+  return 0;
+}
+
+int CPayload_DELTA::encodedSize( const CData &_roData ) const
+{
+  // Frame flags + slot + raw payload (keyframe; delta payloads are never larger)
+  return 1 + 2 + CPayload::encodedSize( _roData );
+}
+
+int CPayload_DELTA::serialize( unsigned char *_pucBuffer,
+                               const CData &_roData )
+{
+  int __iReturn;
+
+  // Check resources
+  if( !pucBufferTmp || !poDataTmp_put )
+  {
+    __iReturn = alloc();
+    if( __iReturn < 0 )
+      return __iReturn;
+  }
+
+  // Slot
+  uint16_t __ui16tSlot;
+  string __sID( _roData.getID() );
+  unordered_map<string,uint16_t>::const_iterator __it =
+    ui16tSlots_umap.find( __sID );
+  if( __it != ui16tSlots_umap.end() )
+    __ui16tSlot = __it->second;
+  else
+  {
+    if( poData_put_vector.size() < MAX_SLOTS )
+    {
+      // ... new slot
+      CData *__poData = new CData();
+      if( !__poData )
+        return -ENOMEM;
+      __ui16tSlot = poData_put_vector.size();
+      poData_put_vector.push_back( __poData );
+      ui16tCountdown_vector.push_back( 0 );
+    }
+    else
+    {
+      // ... recycle slot (round-robin)
+      __ui16tSlot = ui16tSlotRecycle;
+      ui16tSlotRecycle = ( ui16tSlotRecycle + 1 ) % MAX_SLOTS;
+      ui16tSlots_umap.erase( string( poData_put_vector[__ui16tSlot]->getID() ) );
+      ui16tCountdown_vector[__ui16tSlot] = 0;
+    }
+    ui16tSlots_umap[__sID] = __ui16tSlot;
+  }
+
+  // Keyframe (raw payload)
+  int __iPayloadSize = 0;
+  _pucBuffer[__iPayloadSize++] = FRAME_KEYFRAME;
+  __iPayloadSize += putVarint( _pucBuffer+__iPayloadSize, __ui16tSlot );
+  __iReturn = CPayload::serialize( _pucBuffer+__iPayloadSize, _roData );
+  if( __iReturn < 0 )
+    return __iReturn;
+
+  // ... data, as it will be unserialized
+  __iReturn = CPayload::unserialize( poDataTmp_put,
+                                     _pucBuffer+__iPayloadSize,
+                                     __iReturn );
+  if( __iReturn <= 0 )
+    return __iReturn < 0 ? __iReturn : -EBADMSG;
+  __iPayloadSize += __iReturn;
+
+  // Delta payload (if no keyframe is due and smaller)
+  bool __bKeyframe = true;
+  if( ui16tCountdown_vector[__ui16tSlot] )
+  {
+    const CData *__poDataPrevious = poData_put_vector[__ui16tSlot];
+    int __iDeltaSize = 1;
+    __iDeltaSize += putVarint( pucBufferTmp+__iDeltaSize, __ui16tSlot );
+
+    // ... fields
+    uint32_t __pui32tFields[CField::COUNT], __pui32tFieldsPrevious[CField::COUNT];
+    poDataTmp_put->getFields( __pui32tFields );
+    __poDataPrevious->getFields( __pui32tFieldsPrevious );
+    uint32_t __ui32tMask = 0;
+    for( int __i = 0; __i < CField::COUNT; __i++ )
+      if( __pui32tFields[__i] != __pui32tFieldsPrevious[__i] )
+        __ui32tMask |= 1u << __i;
+    __iDeltaSize += putVarint( pucBufferTmp+__iDeltaSize, __ui32tMask );
+    for( int __i = 0; __ui32tMask; __i++, __ui32tMask >>= 1 )
+    {
+      if( !( __ui32tMask & 1 ) )
+        continue;
+      int32_t __i32tDelta =
+        (int32_t)( __pui32tFields[__i] - __pui32tFieldsPrevious[__i] );
+      __iDeltaSize += putVarint( pucBufferTmp+__iDeltaSize,
+                                 ( (uint32_t)__i32tDelta << 1 ) ^ (uint32_t)( __i32tDelta >> 31 ) );
+    }
+
+    // ... data
+    uint8_t __ui8tFlags = 0;
+    uint16_t __ui16tDataSize = poDataTmp_put->ui16tDataSize;
+    if( __ui16tDataSize != __poDataPrevious->ui16tDataSize
+        || ( __ui16tDataSize
+             && memcmp( poDataTmp_put->pucData, __poDataPrevious->pucData, __ui16tDataSize ) ) )
+    {
+      __ui8tFlags |= FRAME_DATA;
+      __iDeltaSize += putVarint( pucBufferTmp+__iDeltaSize, __ui16tDataSize );
+      if( __ui16tDataSize )
+        memcpy( pucBufferTmp+__iDeltaSize, poDataTmp_put->pucData, __ui16tDataSize );
+      __iDeltaSize += __ui16tDataSize;
+    }
+    pucBufferTmp[0] = __ui8tFlags;
+
+    // ... use delta payload
+    if( __iDeltaSize < __iPayloadSize )
+    {
+      memcpy( _pucBuffer, pucBufferTmp, __iDeltaSize );
+      __iPayloadSize = __iDeltaSize;
+      __bKeyframe = false;
+    }
+  }
+  if( __bKeyframe )
+    ui16tCountdown_vector[__ui16tSlot] = KEYFRAME_INTERVAL;
+  else
+    ui16tCountdown_vector[__ui16tSlot]--;
+
+  // Save state
+  CData *__poData = poData_put_vector[__ui16tSlot];
+  poData_put_vector[__ui16tSlot] = poDataTmp_put;
+  poDataTmp_put = __poData;
+  ui32tBufferPutSize = __iPayloadSize;
+
+  // Done
+  return __iPayloadSize;
+}
+
+int CPayload_DELTA::unserialize( CData *_poData,
+                                 const unsigned char *_pucBuffer,
+                                 uint16_t _ui16tBufferSize )
+{
+  int __iReturn;
+
+  // Check resources
+  if( !poDataTmp_get )
+  {
+    __iReturn = alloc();
+    if( __iReturn < 0 )
+      return __iReturn;
+  }
+
+  // Frame header
+  uint8_t __ui8tFlags;
+  uint16_t __ui16tSlot;
+  __iReturn = getHeader( _pucBuffer, _ui16tBufferSize,
+                         &__ui8tFlags, &__ui16tSlot );
+  if( __iReturn < 0 )
+    return __iReturn;
+  int __iHeaderSize = __iReturn;
+
+  if( __ui8tFlags & FRAME_KEYFRAME )
+  {
+    // Keyframe (raw payload)
+    CData *__poDataSlot = useSlot_get( __ui16tSlot );
+    if( !__poDataSlot )
+      return -ENOMEM;
+    __iReturn = CPayload::unserialize( _poData,
+                                       _pucBuffer+__iHeaderSize,
+                                       _ui16tBufferSize-__iHeaderSize );
+    if( __iReturn <= 0 )
+      return __iReturn;
+    __poDataSlot->copy( *_poData );
+  }
+  else
+  {
+    // Delta payload
+    if( __ui16tSlot >= poData_get_vector.size()
+        || !poData_get_vector[__ui16tSlot] )
+      return -EBADMSG;
+    poDataTmp_get->copy( *poData_get_vector[__ui16tSlot] );
+    __iReturn = getDelta( _pucBuffer+__iHeaderSize,
+                          _ui16tBufferSize-__iHeaderSize,
+                          __ui8tFlags,
+                          poDataTmp_get );
+    if( __iReturn < 0 )
+      return __iReturn;
+    _poData->copy( *poDataTmp_get );
+    CData *__poData = poData_get_vector[__ui16tSlot];
+    poData_get_vector[__ui16tSlot] = poDataTmp_get;
+    poDataTmp_get = __poData;
+  }
+
+  // Done
+  return _ui16tBufferSize;
+}
+
+int CPayload_DELTA::peek( const unsigned char *_pucBuffer,
+                          uint16_t _ui16tBufferSize,
+                          uint8_t *_pui8tContent,
+                          const char **_ppcID,
+                          uint8_t *_pui8tIDLength )
+{
+  int __iReturn;
+
+  // Decode
+  const unsigned char *__pucPayload;
+  uint8_t __ui8tFlags;
+  uint16_t __ui16tSlot;
+  __iReturn = decode( _pucBuffer, _ui16tBufferSize,
+                      &__pucPayload, &__ui8tFlags, &__ui16tSlot );
+  if( __iReturn < 0 )
+    return __iReturn;
+
+  // Peek at raw payload
+  __iReturn = CPayload::peek( __pucPayload,
+                              __iReturn,
+                              _pui8tContent,
+                              _ppcID,
+                              _pui8tIDLength );
+  if( __iReturn <= 0 )
+    return __iReturn;
+
+  // Done
+  return _ui16tBufferSize;
+}
+
+int CPayload_DELTA::unserialize( CDataBlock *_poDataBlock,
+                                 const unsigned char *_pucBuffer,
+                                 uint16_t _ui16tBufferSize )
+{
+  int __iReturn;
+
+  // Decode
+  const unsigned char *__pucPayload;
+  uint8_t __ui8tFlags;
+  uint16_t __ui16tSlot;
+  __iReturn = decode( _pucBuffer, _ui16tBufferSize,
+                      &__pucPayload, &__ui8tFlags, &__ui16tSlot );
+  if( __iReturn < 0 )
+    return __iReturn;
+  int __iPayloadSize_RAW = __iReturn;
+
+  // Unserialize raw payload
+  __iReturn = CPayload::unserialize( _poDataBlock,
+                                     __pucPayload,
+                                     __iPayloadSize_RAW );
+  if( __iReturn <= 0 )
+    return __iReturn;
+
+  // Save state
+  __iReturn = commit( __pucPayload, __iPayloadSize_RAW,
+                      __ui8tFlags, __ui16tSlot );
+  if( __iReturn < 0 )
+    return __iReturn;
+
+  // Done
+  return _ui16tBufferSize;
+}
+
+void CPayload_DELTA::reset()
+{
+  for( vector<CData*>::const_iterator __it = poData_put_vector.begin();
+       __it != poData_put_vector.end();
+       ++__it )
+    delete *__it;
+  poData_put_vector.clear();
+  ui16tCountdown_vector.clear();
+  ui16tSlots_umap.clear();
+  ui16tSlotRecycle = 0;
+  for( vector<CData*>::const_iterator __it = poData_get_vector.begin();
+       __it != poData_get_vector.end();
+       ++__it )
+    if( *__it )
+      delete *__it;
+  poData_get_vector.clear();
+}
+
+void CPayload_DELTA::free()
+{
+  reset();
+  if( pucBufferTmp )
+    freeBuffer( pucBufferTmp );
+  pucBufferTmp = NULL;
+  if( poDataTmp_put )
+    delete poDataTmp_put;
+  poDataTmp_put = NULL;
+  if( poDataTmp_get )
+    delete poDataTmp_get;
+  poDataTmp_get = NULL;
+}
+
+
+//----------------------------------------------------------------------
+// METHODS
+//----------------------------------------------------------------------
+
+int CPayload_DELTA::getHeader( const unsigned char *_pucBuffer,
+                               uint16_t _ui16tBufferSize,
+                               uint8_t *_pui8tFlags,
+                               uint16_t *_pui16tSlot )
+{
+  int __iReturn;
+
+  // Flags
+  if( _ui16tBufferSize < 2 )
+    return -EBADMSG;
+  *_pui8tFlags = _pucBuffer[0];
+
+  // Slot
+  uint32_t __ui32tSlot;
+  __iReturn = getVarint( _pucBuffer+1, _ui16tBufferSize-1, &__ui32tSlot );
+  if( __iReturn < 0 )
+    return __iReturn;
+  if( __ui32tSlot >= MAX_SLOTS )
+    return -EBADMSG;
+  *_pui16tSlot = __ui32tSlot;
+
+  // Done
+  return 1+__iReturn;
+}
+
+int CPayload_DELTA::getDelta( const unsigned char *_pucBuffer,
+                              int _iBufferSize,
+                              uint8_t _ui8tFlags,
+                              CData *_poData )
+{
+  int __iReturn;
+  int __iOffset = 0;
+
+  // Fields
+  uint32_t __ui32tMask;
+  __iReturn = getVarint( _pucBuffer, _iBufferSize, &__ui32tMask );
+  if( __iReturn < 0 )
+    return __iReturn;
+  __iOffset += __iReturn;
+  if( __ui32tMask >> CField::COUNT )
+    return -EBADMSG;
+  uint32_t __pui32tFields[CField::COUNT];
+  _poData->getFields( __pui32tFields );
+  for( int __i = 0; __ui32tMask; __i++, __ui32tMask >>= 1 )
+  {
+    if( !( __ui32tMask & 1 ) )
+      continue;
+    uint32_t __ui32tZigzag;
+    __iReturn = getVarint( _pucBuffer+__iOffset, _iBufferSize-__iOffset, &__ui32tZigzag );
+    if( __iReturn < 0 )
+      return __iReturn;
+    __iOffset += __iReturn;
+    __pui32tFields[__i] += ( __ui32tZigzag >> 1 ) ^ ( 0u - ( __ui32tZigzag & 1 ) );
+  }
+  _poData->setFields( __pui32tFields );
+
+  // Data
+  if( _ui8tFlags & FRAME_DATA )
+  {
+    uint32_t __ui32tDataSize;
+    __iReturn = getVarint( _pucBuffer+__iOffset, _iBufferSize-__iOffset, &__ui32tDataSize );
+    if( __iReturn < 0 )
+      return __iReturn;
+    __iOffset += __iReturn;
+    if( __ui32tDataSize > CData::MAX_DATA_SIZE
+        || __ui32tDataSize > (uint32_t)( _iBufferSize-__iOffset ) )
+      return -EBADMSG;
+    if( __ui32tDataSize )
+      _poData->setData( _pucBuffer+__iOffset, __ui32tDataSize );
+    else
+      _poData->freeData();
+    __iOffset += __ui32tDataSize;
+  }
+
+  // Done
+  return ( __iOffset == _iBufferSize ) ? 0 : -EBADMSG;
+}
+
+int CPayload_DELTA::decode( const unsigned char *_pucBuffer,
+                            uint16_t _ui16tBufferSize,
+                            const unsigned char **_ppucPayload,
+                            uint8_t *_pui8tFlags,
+                            uint16_t *_pui16tSlot )
+{
+  int __iReturn;
+
+  // Check resources
+  if( !pucBufferTmp || !poDataTmp_get )
+  {
+    __iReturn = alloc();
+    if( __iReturn < 0 )
+      return __iReturn;
+  }
+
+  // Frame header
+  __iReturn = getHeader( _pucBuffer, _ui16tBufferSize,
+                         _pui8tFlags, _pui16tSlot );
+  if( __iReturn < 0 )
+    return __iReturn;
+  int __iHeaderSize = __iReturn;
+
+  // Keyframe (raw payload)
+  if( *_pui8tFlags & FRAME_KEYFRAME )
+  {
+    *_ppucPayload = _pucBuffer+__iHeaderSize;
+    return _ui16tBufferSize-__iHeaderSize;
+  }
+
+  // Delta payload
+  if( *_pui16tSlot >= poData_get_vector.size()
+      || !poData_get_vector[*_pui16tSlot] )
+    return -EBADMSG;
+  poDataTmp_get->copy( *poData_get_vector[*_pui16tSlot] );
+  __iReturn = getDelta( _pucBuffer+__iHeaderSize,
+                        _ui16tBufferSize-__iHeaderSize,
+                        *_pui8tFlags,
+                        poDataTmp_get );
+  if( __iReturn < 0 )
+    return __iReturn;
+  __iReturn = CPayload::serialize( pucBufferTmp, *poDataTmp_get );
+  if( __iReturn < 0 )
+    return __iReturn;
+  *_ppucPayload = pucBufferTmp;
+
+  // Done
+  return __iReturn;
+}
+
+int CPayload_DELTA::commit( const unsigned char *_pucPayload,
+                            uint16_t _ui16tPayloadSize,
+                            uint8_t _ui8tFlags,
+                            uint16_t _ui16tSlot )
+{
+  int __iReturn;
+
+  // Keyframe (raw payload)
+  if( _ui8tFlags & FRAME_KEYFRAME )
+  {
+    CData *__poDataSlot = useSlot_get( _ui16tSlot );
+    if( !__poDataSlot )
+      return -ENOMEM;
+    __iReturn = CPayload::unserialize( __poDataSlot,
+                                       _pucPayload,
+                                       _ui16tPayloadSize );
+    if( __iReturn <= 0 )
+      return __iReturn < 0 ? __iReturn : -EBADMSG;
+    return 0;
+  }
+
+  // Delta payload (see decode())
+  CData *__poData = poData_get_vector[_ui16tSlot];
+  poData_get_vector[_ui16tSlot] = poDataTmp_get;
+  poDataTmp_get = __poData;
+
+  // Done
+  return 0;
+}
+
+CData* CPayload_DELTA::useSlot_get( uint16_t _ui16tSlot )
+{
+  if( _ui16tSlot >= poData_get_vector.size() )
+    poData_get_vector.resize( _ui16tSlot+1, NULL );
+  if( !poData_get_vector[_ui16tSlot] )
+    poData_get_vector[_ui16tSlot] = new CData();
+  return poData_get_vector[_ui16tSlot];
+}
@@ -0,0 +1,396 @@
+// INDENTING (emacs/vi): -*- mode:c++; tab-width:2; c-basic-offset:2; intent-tabs-mode:nil; -*- ex: set tabstop=2 expandtab:
+
+/*
+ * Simple Geolocalization and Course Transmission Protocol (SGCTP)
+ * Copyright (C) 2014 Cedric Dufour <http://cedric.dufour.name>
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * free software:
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, Version 3.
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ */
+
+// C
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#ifdef __SGCTP_USE_IO_URING__
+
+// Linux
+#include <linux/io_uring.h>
+
+#endif // __SGCTP_USE_IO_URING__
+
+// SGCTP
+#include "sgctp/ring.hpp"
+using namespace SGCTP;
+
+
+//----------------------------------------------------------------------
+// CONSTANTS / STATIC
+//----------------------------------------------------------------------
+
+bool CRing::isAvailable()
+{
+#ifdef __SGCTP_USE_IO_URING__
+  return true;
+#else // __SGCTP_USE_IO_URING__
+  return false;
+#endif // NOT __SGCTP_USE_IO_URING__
+}
+
+
+//----------------------------------------------------------------------
+// METHODS
+//----------------------------------------------------------------------
+
+#ifdef __SGCTP_USE_IO_URING__
+
+int CRing::init( unsigned int _uiEntries )
+{
+  int __iReturn;
+
+  // Check ring
+  if( iRingFileDescriptor >= 0 )
+    return 0;
+
+  // Create ring
+  // NOTE: io_uring may be disabled (by the kernel configuration or a
+  //       security policy), in which case the caller falls back to POSIX I/O
+  struct io_uring_params __tParams;
+  memset( &__tParams, 0, sizeof( __tParams ) );
+  __iReturn = syscall( __NR_io_uring_setup, _uiEntries, &__tParams );
+  if( __iReturn < 0 )
+    return ( errno == ENOSYS || errno == EPERM ) ? -ENOTSUP : -errno;
+  iRingFileDescriptor = __iReturn;
+  if( !( __tParams.features & IORING_FEAT_RW_CUR_POS ) )
+  {
+    free();
+    return -ENOTSUP;
+  }
+
+  // Map rings
+  tSqRingSize = __tParams.sq_off.array + __tParams.sq_entries * sizeof( uint32_t );
+  pSqRing = mmap( NULL, tSqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                  iRingFileDescriptor, IORING_OFF_SQ_RING );
+  if( pSqRing == MAP_FAILED )
+  {
+    __iReturn = -errno;
+    pSqRing = NULL;
+    free();
+    return __iReturn;
+  }
+  tCqRingSize = __tParams.cq_off.cqes + __tParams.cq_entries * sizeof( struct io_uring_cqe );
+  pCqRing = mmap( NULL, tCqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                  iRingFileDescriptor, IORING_OFF_CQ_RING );
+  if( pCqRing == MAP_FAILED )
+  {
+    __iReturn = -errno;
+    pCqRing = NULL;
+    free();
+    return __iReturn;
+  }
+  tSqEntriesSize = __tParams.sq_entries * sizeof( struct io_uring_sqe );
+  pSqEntries = mmap( NULL, tSqEntriesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                     iRingFileDescriptor, IORING_OFF_SQES );
+  if( pSqEntries == MAP_FAILED )
+  {
+    __iReturn = -errno;
+    pSqEntries = NULL;
+    free();
+    return __iReturn;
+  }
+  pui32tSqHead = (uint32_t*)( (unsigned char*)pSqRing + __tParams.sq_off.head );
+  pui32tSqTail = (uint32_t*)( (unsigned char*)pSqRing + __tParams.sq_off.tail );
+  pui32tSqMask = (uint32_t*)( (unsigned char*)pSqRing + __tParams.sq_off.ring_mask );
+  pui32tSqArray = (uint32_t*)( (unsigned char*)pSqRing + __tParams.sq_off.array );
+  pui32tCqHead = (uint32_t*)( (unsigned char*)pCqRing + __tParams.cq_off.head );
+  pui32tCqTail = (uint32_t*)( (unsigned char*)pCqRing + __tParams.cq_off.tail );
+  pui32tCqMask = (uint32_t*)( (unsigned char*)pCqRing + __tParams.cq_off.ring_mask );
+  pCqEntries = (unsigned char*)pCqRing + __tParams.cq_off.cqes;
+  uiQueued = 0;
+
+  // Done
+  return 0;
+}
+
+void CRing::free()
+{
+  if( pSqEntries )
+  {
+    munmap( pSqEntries, tSqEntriesSize );
+    pSqEntries = NULL;
+  }
+  if( pCqRing )
+  {
+    munmap( pCqRing, tCqRingSize );
+    pCqRing = NULL;
+  }
+  if( pSqRing )
+  {
+    munmap( pSqRing, tSqRingSize );
+    pSqRing = NULL;
+  }
+  if( iRingFileDescriptor >= 0 )
+  {
+    close( iRingFileDescriptor );
+    iRingFileDescriptor = -1;
+  }
+  uiQueued = 0;
+  iBuffers = 0;
+}
+
+int CRing::registerBuffers( const struct iovec *_ptBuffers,
+                            int _iBuffers )
+{
+  if( iRingFileDescriptor < 0 )
+    return -EBADF;
+  if( _iBuffers > MAX_BUFFERS )
+    return -EINVAL;
+  unregisterBuffers();
+  if( syscall( __NR_io_uring_register, iRingFileDescriptor, IORING_REGISTER_BUFFERS,
+               _ptBuffers, _iBuffers ) < 0 )
+    return -errno;
+  memcpy( ptBuffers, _ptBuffers, _iBuffers * sizeof( struct iovec ) );
+  iBuffers = _iBuffers;
+  return 0;
+}
+
+void CRing::unregisterBuffers()
+{
+  if( !iBuffers )
+    return;
+  syscall( __NR_io_uring_register, iRingFileDescriptor, IORING_UNREGISTER_BUFFERS, NULL, 0 );
+  iBuffers = 0;
+}
+
+int CRing::read( int _iFileDescriptor,
+                 void *_pBuffer,
+                 int _iSize,
+                 uint64_t _ui64tUserData )
+{
+  struct io_uring_sqe *__ptEntry = (struct io_uring_sqe*)getEntry();
+  if( !__ptEntry )
+    return -EBUSY;
+  int __iBufferIndex = getBufferIndex( _pBuffer, _iSize );
+  __ptEntry->opcode = ( __iBufferIndex >= 0 ) ? IORING_OP_READ_FIXED : IORING_OP_READ;
+  __ptEntry->fd = _iFileDescriptor;
+  __ptEntry->off = (uint64_t)-1; // current file offset
+  __ptEntry->addr = (uint64_t)(uintptr_t)_pBuffer;
+  __ptEntry->len = _iSize;
+  __ptEntry->buf_index = ( __iBufferIndex >= 0 ) ? __iBufferIndex : 0;
+  __ptEntry->user_data = _ui64tUserData;
+  return 0;
+}
+
+int CRing::write( int _iFileDescriptor,
+                  const void *_pBuffer,
+                  int _iSize,
+                  uint64_t _ui64tUserData,
+                  bool _bLink )
+{
+  struct io_uring_sqe *__ptEntry = (struct io_uring_sqe*)getEntry();
+  if( !__ptEntry )
+    return -EBUSY;
+  int __iBufferIndex = getBufferIndex( _pBuffer, _iSize );
+  __ptEntry->opcode = ( __iBufferIndex >= 0 ) ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+  __ptEntry->fd = _iFileDescriptor;
+  __ptEntry->off = (uint64_t)-1; // current file offset
+  __ptEntry->addr = (uint64_t)(uintptr_t)_pBuffer;
+  __ptEntry->len = _iSize;
+  __ptEntry->buf_index = ( __iBufferIndex >= 0 ) ? __iBufferIndex : 0;
+  __ptEntry->user_data = _ui64tUserData;
+  if( _bLink )
+    __ptEntry->flags |= IOSQE_IO_LINK;
+  return 0;
+}
+
+int CRing::datasync( int _iFileDescriptor,
+                     uint64_t _ui64tUserData )
+{
+  struct io_uring_sqe *__ptEntry = (struct io_uring_sqe*)getEntry();
+  if( !__ptEntry )
+    return -EBUSY;
+  __ptEntry->opcode = IORING_OP_FSYNC;
+  __ptEntry->fd = _iFileDescriptor;
+  __ptEntry->fsync_flags = IORING_FSYNC_DATASYNC;
+  __ptEntry->user_data = _ui64tUserData;
+  return 0;
+}
+
+int CRing::cancel( uint64_t _ui64tTargetUserData,
+                   uint64_t _ui64tUserData )
+{
+  struct io_uring_sqe *__ptEntry = (struct io_uring_sqe*)getEntry();
+  if( !__ptEntry )
+    return -EBUSY;
+  __ptEntry->opcode = IORING_OP_ASYNC_CANCEL;
+  __ptEntry->fd = -1;
+  __ptEntry->addr = _ui64tTargetUserData;
+  __ptEntry->user_data = _ui64tUserData;
+  return 0;
+}
+
+int CRing::submit()
+{
+  int __iReturn;
+  while( uiQueued )
+  {
+    __iReturn = syscall( __NR_io_uring_enter, iRingFileDescriptor, uiQueued, 0, 0, NULL, 0 );
+    if( __iReturn < 0 )
+    {
+      if( errno == EINTR )
+        continue;
+      return -errno;
+    }
+    uiQueued -= __iReturn;
+  }
+  return 0;
+}
+
+int CRing::complete( uint64_t *_pui64tUserData,
+                     int *_piResult,
+                     bool _bWait )
+{
+  int __iReturn;
+  if( iRingFileDescriptor < 0 )
+    return -EBADF;
+  while( true )
+  {
+    // ... completion queue
+    uint32_t __ui32tHead = *pui32tCqHead;
+    if( __ui32tHead != __atomic_load_n( pui32tCqTail, __ATOMIC_ACQUIRE ) )
+    {
+      struct io_uring_cqe *__ptEntry = (struct io_uring_cqe*)pCqEntries + ( __ui32tHead & *pui32tCqMask );
+      *_pui64tUserData = __ptEntry->user_data;
+      *_piResult = __ptEntry->res;
+      __atomic_store_n( pui32tCqHead, __ui32tHead+1, __ATOMIC_RELEASE );
+      return 1;
+    }
+    if( !_bWait )
+      return 0;
+
+    // ... wait (submitting queued operations along)
+    __iReturn = syscall( __NR_io_uring_enter, iRingFileDescriptor, uiQueued, 1, IORING_ENTER_GETEVENTS, NULL, 0 );
+    if( __iReturn < 0 )
+    {
+      if( errno == EINTR )
+        continue;
+      return -errno;
+    }
+    uiQueued -= __iReturn;
+  }
+}
+
+void* CRing::getEntry()
+{
+  if( iRingFileDescriptor < 0 )
+    return NULL;
+  uint32_t __ui32tTail = *pui32tSqTail;
+  if( __ui32tTail - __atomic_load_n( pui32tSqHead, __ATOMIC_ACQUIRE ) > *pui32tSqMask )
+    return NULL;
+  uint32_t __ui32tIndex = __ui32tTail & *pui32tSqMask;
+  struct io_uring_sqe *__ptEntry = (struct io_uring_sqe*)pSqEntries + __ui32tIndex;
+  memset( __ptEntry, 0, sizeof( struct io_uring_sqe ) );
+  pui32tSqArray[__ui32tIndex] = __ui32tIndex;
+  // NOTE: entries are consumed by the kernel only when submitted
+  __atomic_store_n( pui32tSqTail, __ui32tTail+1, __ATOMIC_RELEASE );
+  uiQueued++;
+  return __ptEntry;
+}
+
+int CRing::getBufferIndex( const void *_pBuffer,
+                           int _iSize ) const
+{
+  for( int __i = 0; __i < iBuffers; __i++ )
+  {
+    const unsigned char *__pucBase = (const unsigned char*)ptBuffers[__i].iov_base;
+    if( (const unsigned char*)_pBuffer >= __pucBase
+        && (const unsigned char*)_pBuffer + _iSize <= __pucBase + ptBuffers[__i].iov_len )
+      return __i;
+  }
+  return -1;
+}
+
+#else // __SGCTP_USE_IO_URING__
+
+int CRing::init( unsigned int _uiEntries )
+{
+  return -ENOTSUP;
+}
+
+void CRing::free()
+{}
+
+int CRing::registerBuffers( const struct iovec *_ptBuffers,
+                            int _iBuffers )
+{
+  return -ENOTSUP;
+}
+
+void CRing::unregisterBuffers()
+{}
+
+int CRing::read( int _iFileDescriptor,
+                 void *_pBuffer,
+                 int _iSize,
+                 uint64_t _ui64tUserData )
+{
+  return -ENOTSUP;
+}
+
+int CRing::write( int _iFileDescriptor,
+                  const void *_pBuffer,
+                  int _iSize,
+                  uint64_t _ui64tUserData,
+                  bool _bLink )
+{
+  return -ENOTSUP;
+}
+
+int CRing::datasync( int _iFileDescriptor,
+                     uint64_t _ui64tUserData )
+{
+  return -ENOTSUP;
+}
+
+int CRing::cancel( uint64_t _ui64tTargetUserData,
+                   uint64_t _ui64tUserData )
+{
+  return -ENOTSUP;
+}
+
+int CRing::submit()
+{
+  return -ENOTSUP;
+}
+
+int CRing::complete( uint64_t *_pui64tUserData,
+                     int *_piResult,
+                     bool _bWait )
+{
+  return -ENOTSUP;
+}
+
+void* CRing::getEntry()
+{
+  return NULL;
+}
+
+int CRing::getBufferIndex( const void *_pBuffer,
+                           int _iSize ) const
+{
+  return -1;
+}
+
+#endif // NOT __SGCTP_USE_IO_URING__
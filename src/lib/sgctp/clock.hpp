@@ -0,0 +1,177 @@
+// INDENTING (emacs/vi): -*- mode:c++; tab-width:2; c-basic-offset:2; intent-tabs-mode:nil; -*- ex: set tabstop=2 expandtab:
+
+/*
+ * Simple Geolocalization and Course Transmission Protocol (SGCTP)
+ * Copyright (C) 2014 Cedric Dufour <http://cedric.dufour.name>
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * free software:
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, Version 3.
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ */
+
+#ifndef SGCTP_CCLOCK_HPP
+#define SGCTP_CCLOCK_HPP
+
+// C
+#include <stdint.h>
+#include <time.h>
+
+
+// SGCTP namespace
+namespace SGCTP
+{
+
+  /// SGCTP clock (time service)
+  /**
+   * This class provides the conversions between UNIX epoch and SGCTP time
+   * (which does NOT contain date information, being the UTC time-of-day).
+   * UTC days being exactly 86400 seconds long (UNIX epoch ignores leap
+   * seconds), those conversions boil down to integer arithmetic.
+   * The current time is obtained from the realtime clock; a coarse variant,
+   * cheap to query but only accurate to a few milliseconds, is available for
+   * hot paths which do not require accurate (sub-second) time.
+   * ISO-8601 formatting and parsing are also hand-rolled (allocation-free;
+   * no strftime/strptime), the date prefix of formatted strings being cached
+   * (per thread) as long as the date does not change.
+   * This class is thread-safe.
+   */
+  class CClock
+  {
+
+    //----------------------------------------------------------------------
+    // CONSTANTS / STATIC
+    //----------------------------------------------------------------------
+
+  public:
+    /// Day duration (seconds)
+    static const time_t DAY = 86400;
+    /// ISO-8601 date/time string (maximum) size, including the terminating NUL character
+    static const int ISO8601_SIZE = 25;
+
+  private:
+    /// ISO-8601 date prefix (UTC midnight; cached per thread)
+    static thread_local time_t ttIso8601Date;
+    /// ISO-8601 date prefix ("YYYY-MM-DDT"; cached per thread)
+    static thread_local char pcIso8601Date[11];
+
+  public:
+    /// Return the current UNIX epoch
+    static double now();
+    /// Return the current (coarse) UNIX epoch
+    /**
+     *  NOTE: cheaper than now() but only accurate to a few milliseconds
+     */
+    static double nowCoarse();
+    /// Return the current UTC midnight (UNIX epoch)
+    static time_t midnight();
+    /// Return the UTC midnight (UNIX epoch) of the given UNIX epoch
+    /**
+     *  @param[in] _ttEpoch UNIX epoch
+     */
+    static time_t midnight( time_t _ttEpoch )
+    {
+      time_t __ttTime = _ttEpoch % DAY;
+      return _ttEpoch - ( __ttTime < 0 ? __ttTime + DAY : __ttTime );
+    };
+    /// Return the UNIX epoch (including sub-second decimals) corresponding to the given SGCTP time (relative to the given epoch)
+    /**
+     *  @param[in] _fdTime SGCTP time (REMINDER: does NOT contain date information)
+     *  @param[in] _fdEpochReference Reference UNIX epoch/data (to obtain date information; current date if zero)
+     *  @return UNIX epoch (time AND date)
+     */
+    static double toEpoch( double _fdTime,
+                           double _fdEpochReference = 0 );
+    /// Return the SGCTP time (including sub-second decimals) corresponding to the given UNIX epoch
+    /**
+     *  @param[in] _fdEpoch UNIX epoch (time AND date)
+     *  @return SGCTP time (UTC time-of-day)
+     */
+    static double toTime( double _fdEpoch );
+    /// Return the UNIX epoch corresponding to the given (proleptic Gregorian) UTC date
+    /**
+     *  @param[in] _iYear Year
+     *  @param[in] _iMonth Month (1-12)
+     *  @param[in] _iDay Day (1-31)
+     *  @return UNIX epoch (midnight)
+     */
+    static time_t fromDate( int _iYear,
+                            int _iMonth,
+                            int _iDay );
+    /// Retrieve the (proleptic Gregorian) UTC date corresponding to the given UNIX epoch
+    /**
+     *  @param[in] _ttEpoch UNIX epoch
+     *  @param[out] _piYear Year
+     *  @param[out] _piMonth Month (1-12)
+     *  @param[out] _piDay Day (1-31)
+     */
+    static void toDate( time_t _ttEpoch,
+                        int *_piYear,
+                        int *_piMonth,
+                        int *_piDay );
+    /// Store the ISO-8601 date/time string corresponding to the given UNIX epoch
+    /**
+     *  Epochs lower than one day are formatted as time only ("HH:MM:SS.sssZ");
+     *  "YYYY-MM-DDTHH:MM:SS.sssZ" otherwise.
+     *  @param[in] _pcIso8601 Pointer to the characters string to store the ISO-8601 date/time into (at least ISO8601_SIZE long)
+     *  @param[in] _fdEpoch UNIX epoch (time AND date)
+     *  @return ISO-8601 date/time string length (excluding the terminating NUL character)
+     */
+    static int toIso8601( char *_pcIso8601,
+                          double _fdEpoch );
+    /// Store the ISO-8601 date/time strings corresponding to the given UNIX epochs (bulk)
+    /**
+     *  @param[in] _pcIso8601 Pointer to the characters strings to store the ISO-8601 date/time into (ISO8601_SIZE apart)
+     *  @param[in] _pfdEpoch Pointer to the UNIX epochs (time AND date)
+     *  @param[in] _uiCount Quantity of UNIX epochs
+     */
+    static void toIso8601( char *_pcIso8601,
+                           const double *_pfdEpoch,
+                           unsigned int _uiCount );
+    /// Parse the given ISO-8601 date/time string
+    /**
+     *  Supported formats are "YYYY-MM-DD[(T| )HH:MM:SS[.s...]]" and
+     *  "HH:MM:SS[.s...]" (any trailing timezone designator being ignored).
+     *  @param[in] _pcIso8601 Pointer to the characters string containing the ISO-8601 date/time
+     *  @param[out] _pfdEpoch UNIX epoch (time AND date)
+     *  @return Pointer to the first unparsed character; NULL if the string could not be parsed
+     */
+    static const char* fromIso8601( const char *_pcIso8601,
+                                    double *_pfdEpoch );
+
+  private:
+    /// Parse the given (unsigned) decimal number
+    /**
+     *  @param[in] _pcNumber Pointer to the characters string containing the number
+     *  @param[in] _iDigits Maximum quantity of digits
+     *  @param[in] _iMin Minimum value
+     *  @param[in] _iMax Maximum value
+     *  @param[out] _piValue Value
+     *  @return Pointer to the first unparsed character; NULL on failure
+     */
+    static const char* parseNumber( const char *_pcNumber,
+                                    int _iDigits,
+                                    int _iMin,
+                                    int _iMax,
+                                    int *_piValue );
+    /// Parse the given "HH:MM:SS" time
+    /**
+     *  @param[in] _pcTime Pointer to the characters string containing the time
+     *  @param[out] _ptTime Time (seconds)
+     *  @return Pointer to the first unparsed character; NULL on failure
+     */
+    static const char* parseTime( const char *_pcTime,
+                                  time_t *_ptTime );
+
+  };
+
+}
+
+#endif // SGCTP_CCLOCK_HPP
@@ -0,0 +1,185 @@
+// INDENTING (emacs/vi): -*- mode:c++; tab-width:2; c-basic-offset:2; intent-tabs-mode:nil; -*- ex: set tabstop=2 expandtab:
+
+/*
+ * Simple Geolocalization and Course Transmission Protocol (SGCTP)
+ * Copyright (C) 2014 Cedric Dufour <http://cedric.dufour.name>
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * free software:
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, Version 3.
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ */
+
+#ifndef SGCTP_CCOLUMNAR_HPP
+#define SGCTP_CCOLUMNAR_HPP
+
+// C
+#include <errno.h>
+#include <stdint.h>
+
+// C++
+#include <vector>
+using namespace std;
+
+// SGCTP
+#include "sgctp/field.hpp"
+
+
+// SGCTP namespace
+namespace SGCTP
+{
+
+  /// SGCTP columnar archive (generic)
+  /**
+   * This class defines the generic aspects of the SGCTP columnar archive
+   * format (*.sgctpc), where data are stored in row groups, each column of a
+   * row group being stored (and encoded) separately along its min/max
+   * statistics. Columns can thus be read selectively (projection) and row
+   * groups skipped according to their statistics (predicate pushdown).
+   * See the PROTOCOL document for the format of the columnar archive.
+   */
+  class CColumnar
+  {
+
+    //----------------------------------------------------------------------
+    // CONSTANTS / STATIC
+    //----------------------------------------------------------------------
+
+  public:
+    /// File format version
+    static const uint8_t FILE_VERSION = 1;
+    /// File header size ("SGCTPC", file format version, reserved)
+    static const int FILE_HEADER_SIZE = 8;
+    /// Default row group size (quantity of records)
+    static const int ROW_GROUP_SIZE = 65536;
+    /// Row group header size (rows quantity, columns size, columns quantity, reserved)
+    static const int ROW_GROUP_HEADER_SIZE = 12;
+    /// Column directory entry size (column, encoding, reserved, size, minimum, maximum)
+    static const int COLUMN_ENTRY_SIZE = 16;
+
+    /// Columns (data fields columns being identified by their CField::EField value)
+    enum EColumn {
+      COLUMN_ID = CField::COUNT,  ///< ID string
+      COLUMN_DATA,                ///< data
+      COLUMN_COUNT
+    };
+
+    /// Column encodings
+    enum EEncoding {
+      ENCODING_DELTA = 1,       ///< zigzag/varint-encoded difference with previous value
+      ENCODING_DELTA2 = 2,      ///< zigzag/varint-encoded difference with previous difference (delta-of-delta)
+      ENCODING_DICTIONARY = 3,  ///< (row group) dictionary and varint-encoded dictionary index
+      ENCODING_PLAIN = 4        ///< varint-encoded size and raw bytes
+    };
+
+    /// Columns names (see the sgctp2dsv utility)
+    static const char* const COLUMN_NAMES[COLUMN_COUNT];
+    /// Return the column corresponding to the given name
+    /**
+     *  @param[in] _pcName Column name
+     *  @return Column (see EColumn and CField::EField); Negative error code if no such column
+     */
+    static int getColumn( const char *_pcName );
+    /// Return the (bit) mask corresponding to the given column
+    static inline uint32_t columnMask( int _iColumn )
+    {
+      return 1u << _iColumn;
+    };
+    /// All columns (bit mask)
+    static const uint32_t COLUMNS_ALL = ( 1u << COLUMN_COUNT ) - 1;
+    /// Return the given columns completed with the columns they depend on in a SGCTP payload
+    /**
+     *  Payload fields are (de-)serialized by content-flag groups (see CField),
+     *  which MUST be entirely defined (along their parent group) to be
+     *  transmitted; e.g. the latitude can not be transmitted without the
+     *  longitude.
+     *  @param[in] _ui32tColumns Columns (bit mask; see columnMask())
+     *  @return Completed columns (bit mask)
+     */
+    static uint32_t payloadColumns( uint32_t _ui32tColumns );
+
+  protected:
+    /// Return the encoding of the given column
+    static uint8_t columnEncoding( int _iColumn );
+    /// Add the given (unsigned) integer to the given buffer (LEB128 varint)
+    static inline void putVarint( vector<unsigned char> *_pucBuffer_vector,
+                                  uint64_t _ui64tValue )
+    {
+      while( _ui64tValue >= 0x80 )
+      {
+        _pucBuffer_vector->push_back( (unsigned char)( _ui64tValue | 0x80 ) );
+        _ui64tValue >>= 7;
+      }
+      _pucBuffer_vector->push_back( (unsigned char)_ui64tValue );
+    };
+    /// Retrieve the next (unsigned) integer from the given buffer (LEB128 varint)
+    /**
+     *  @param[in] _pucBuffer Buffer
+     *  @param[in] _iBufferSize Buffer size
+     *  @param[in,out] _piOffset Buffer offset (updated past the varint)
+     *  @param[out] _pui64tValue Integer value
+     *  @return Negative error code in case of error (truncated varint), zero otherwise
+     */
+    static inline int getVarint( const unsigned char *_pucBuffer,
+                                 int _iBufferSize,
+                                 int *_piOffset,
+                                 uint64_t *_pui64tValue )
+    {
+      uint64_t __ui64tValue = 0;
+      for( int __iShift = 0; __iShift < 64; __iShift += 7 )
+      {
+        if( *_piOffset >= _iBufferSize )
+          return -EPROTO;
+        unsigned char __ucByte = _pucBuffer[(*_piOffset)++];
+        __ui64tValue |= (uint64_t)( __ucByte & 0x7F ) << __iShift;
+        if( !( __ucByte & 0x80 ) )
+        {
+          *_pui64tValue = __ui64tValue;
+          return 0;
+        }
+      }
+      return -EPROTO;
+    };
+    /// Return the zigzag-encoded (unsigned) integer corresponding to the given signed integer
+    static inline uint64_t zigzag( int64_t _i64tValue )
+    {
+      return ( (uint64_t)_i64tValue << 1 ) ^ (uint64_t)( _i64tValue >> 63 );
+    };
+    /// Return the signed integer corresponding to the given zigzag-encoded integer
+    static inline int64_t unzigzag( uint64_t _ui64tValue )
+    {
+      return (int64_t)( _ui64tValue >> 1 ) ^ -(int64_t)( _ui64tValue & 1 );
+    };
+    /// Write the given data to the given file (entirely)
+    /**
+     *  @return (Positive) Quantity of data actually written; Negative error code in case of error
+     */
+    static int writeFile( int _iFileDescriptor,
+                          const void *_pBuffer,
+                          int _iSize );
+    /// Read the given quantity of data from the given file (entirely)
+    /**
+     *  @return (Positive) Quantity of data actually read (less than requested only at end of file); Negative error code in case of error
+     */
+    static int readFile( int _iFileDescriptor,
+                         void *_pBuffer,
+                         int _iSize );
+    /// Skip the given quantity of data from the given file (seeking, if possible)
+    /**
+     *  @return Negative error code in case of error, zero otherwise
+     */
+    static int skipFile( int _iFileDescriptor,
+                         uint32_t _ui32tSize );
+
+  };
+
+}
+
+#endif // SGCTP_CCOLUMNAR_HPP
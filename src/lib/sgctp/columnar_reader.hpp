@@ -0,0 +1,202 @@
+// INDENTING (emacs/vi): -*- mode:c++; tab-width:2; c-basic-offset:2; intent-tabs-mode:nil; -*- ex: set tabstop=2 expandtab:
+
+/*
+ * Simple Geolocalization and Course Transmission Protocol (SGCTP)
+ * Copyright (C) 2014 Cedric Dufour <http://cedric.dufour.name>
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * free software:
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, Version 3.
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ */
+
+#ifndef SGCTP_CCOLUMNAR_READER_HPP
+#define SGCTP_CCOLUMNAR_READER_HPP
+
+// C
+#include <stdint.h>
+
+// C++
+#include <string>
+#include <vector>
+using namespace std;
+
+// SGCTP
+#include "sgctp/columnar.hpp"
+
+
+// SGCTP namespace
+namespace SGCTP
+{
+
+  // External
+  class CDataBlock;
+
+  /// SGCTP columnar archive reader
+  /**
+   * This class reads SGCTP data from a columnar archive (see CColumnar),
+   * one row group at a time.
+   * Only the projected columns (see setProjection()) are decoded, the other
+   * columns being skipped. Row groups whose statistics do not match the
+   * filters (see addFilter() and setFilterID()) are skipped entirely, and
+   * the records of the remaining row groups are filtered individually.
+   */
+  class CColumnar_Reader: public CColumnar
+  {
+
+    //----------------------------------------------------------------------
+    // CONSTANTS / STATIC
+    //----------------------------------------------------------------------
+
+  private:
+    /// Field filter
+    struct TFilter
+    {
+      /// Field (see CField::EField)
+      uint8_t ui8tField;
+      /// Minimum (internal integer) value
+      uint32_t ui32tMinimum;
+      /// Maximum (internal integer) value
+      uint32_t ui32tMaximum;
+    };
+
+
+    //----------------------------------------------------------------------
+    // FIELDS
+    //----------------------------------------------------------------------
+
+  private:
+    /// Projected columns (bit mask; see columnMask())
+    uint32_t ui32tProjection;
+    /// Fields filters
+    vector<TFilter> tFilters_vector;
+    /// ID filter
+    string sFilterID;
+    /// Whether the file header has been received
+    bool bFileHeaderReceived;
+    /// Row group header and columns directory (encoded)
+    vector<unsigned char> ucHeader_vector;
+    /// Column (encoded)
+    vector<unsigned char> ucColumn_vector;
+    /// Dictionary index of each row ID (ID filter)
+    vector<uint32_t> ui32tIDIndex_vector;
+    /// Dictionary index of the filtered ID (-1 if not in dictionary)
+    int64_t i64tFilterIDIndex;
+    /// Quantity of data actually read
+    uint64_t ui64tBytesRead;
+    /// Quantity of data skipped
+    uint64_t ui64tBytesSkipped;
+
+
+    //----------------------------------------------------------------------
+    // CONSTRUCTORS / DESTRUCTOR
+    //----------------------------------------------------------------------
+
+  public:
+    CColumnar_Reader()
+      : ui32tProjection( COLUMNS_ALL )
+      , sFilterID( "" )
+      , bFileHeaderReceived( false )
+      , i64tFilterIDIndex( -1 )
+      , ui64tBytesRead( 0 )
+      , ui64tBytesSkipped( 0 )
+    {};
+    ~CColumnar_Reader()
+    {};
+
+
+    //----------------------------------------------------------------------
+    // METHODS
+    //----------------------------------------------------------------------
+
+  private:
+    /// Receive (and check) the file header
+    /**
+     *  @param[in] _iFileDescriptor File descriptor
+     *  @return (Positive) Quantity of data actually received; zero at end of file; Negative error code in case of error
+     */
+    int recvFileHeader( int _iFileDescriptor );
+    /// Decode the given column (into the given data block)
+    /**
+     *  @param[in] _iColumn Column (see EColumn and CField::EField)
+     *  @param[in] _iRows Quantity of rows
+     *  @param[out] _poDataBlock SGCTP data block (to store decoded data)
+     *  @return Negative error code in case of error, zero otherwise
+     */
+    int decodeColumn( int _iColumn,
+                      int _iRows,
+                      CDataBlock *_poDataBlock );
+    /// Filter (and compact) the records of the given data block
+    /**
+     *  @param[in,out] _poDataBlock SGCTP data block
+     */
+    void filterRows( CDataBlock *_poDataBlock );
+
+  public:
+    /// Set the projected columns
+    /**
+     *  Columns which are required by filters are decoded in any case.
+     *  @param[in] _ui32tColumns Projected columns (bit mask; see columnMask())
+     */
+    void setProjection( uint32_t _ui32tColumns )
+    {
+      ui32tProjection = _ui32tColumns;
+    };
+    /// Add a filter on the given field, matching the given (internal integer) values range
+    /**
+     *  Internal values may be obtained using CField::fromValue(). Records
+     *  for which the field is undefined do not match the filter.
+     *  @param[in] _eField Field
+     *  @param[in] _ui32tMinimum Minimum (internal integer) value
+     *  @param[in] _ui32tMaximum Maximum (internal integer) value
+     */
+    void addFilter( CField::EField _eField,
+                    uint32_t _ui32tMinimum,
+                    uint32_t _ui32tMaximum );
+    /// Set the ID filter (NULL or empty string for none)
+    void setFilterID( const char *_pcID )
+    {
+      sFilterID = _pcID ? _pcID : "";
+    };
+    /// Clear all filters
+    void resetFilters()
+    {
+      tFilters_vector.clear();
+      sFilterID.clear();
+    };
+    /// Read the next (matching) records from the given file
+    /**
+     *  Records are read from the next row group(s), until at least one record
+     *  matches the filters. The data block is (re-)allocated if its capacity
+     *  is smaller than the row group size.
+     *  @param[in] _iFileDescriptor File descriptor
+     *  @param[out] _poDataBlock SGCTP data block (to store the read records into; previous content is discarded)
+     *  @return (Positive) Quantity of records read; zero at end of file; Negative error code in case of error
+     */
+    int read( int _iFileDescriptor,
+              CDataBlock *_poDataBlock );
+    /// Return the quantity of data actually read
+    uint64_t getBytesRead() const
+    {
+      return ui64tBytesRead;
+    };
+    /// Return the quantity of data skipped (thanks to projection and filters)
+    uint64_t getBytesSkipped() const
+    {
+      return ui64tBytesSkipped;
+    };
+    /// Reset the reader state (to read another file)
+    void free();
+
+  };
+
+}
+
+#endif // SGCTP_CCOLUMNAR_READER_HPP
@@ -0,0 +1,125 @@
+// INDENTING (emacs/vi): -*- mode:c++; tab-width:2; c-basic-offset:2; intent-tabs-mode:nil; -*- ex: set tabstop=2 expandtab:
+
+/*
+ * Simple Geolocalization and Course Transmission Protocol (SGCTP)
+ * Copyright (C) 2014 Cedric Dufour <http://cedric.dufour.name>
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * free software:
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, Version 3.
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ */
+
+#ifndef SGCTP_CCOLUMNAR_WRITER_HPP
+#define SGCTP_CCOLUMNAR_WRITER_HPP
+
+// C
+#include <stdint.h>
+
+// C++
+#include <vector>
+using namespace std;
+
+// SGCTP
+#include "sgctp/columnar.hpp"
+#include "sgctp/data_block.hpp"
+
+
+// SGCTP namespace
+namespace SGCTP
+{
+
+  // External
+  class CData;
+
+  /// SGCTP columnar archive writer
+  /**
+   * This class writes SGCTP data to a columnar archive (see CColumnar).
+   * Data are buffered until a row group is full (or flush() is called), at
+   * which point the row group is encoded and written.
+   */
+  class CColumnar_Writer: public CColumnar
+  {
+
+    //----------------------------------------------------------------------
+    // FIELDS
+    //----------------------------------------------------------------------
+
+  private:
+    /// Row group (buffered data)
+    CDataBlock oDataBlock;
+    /// Whether the file header has been written
+    bool bFileHeaderSent;
+    /// Row group header and columns directory (encoded)
+    vector<unsigned char> ucHeader_vector;
+    /// Row group columns (encoded)
+    vector<unsigned char> ucColumns_vector;
+
+
+    //----------------------------------------------------------------------
+    // CONSTRUCTORS / DESTRUCTOR
+    //----------------------------------------------------------------------
+
+  public:
+    CColumnar_Writer()
+      : bFileHeaderSent( false )
+    {};
+    ~CColumnar_Writer()
+    {};
+
+
+    //----------------------------------------------------------------------
+    // METHODS
+    //----------------------------------------------------------------------
+
+  private:
+    /// Encode the given column of the buffered row group (and add its directory entry)
+    /**
+     *  Columns which contain no (defined) value are not stored.
+     *  @param[in] _iColumn Column (see EColumn and CField::EField)
+     */
+    void encodeColumn( int _iColumn );
+    /// Encode and write the buffered row group
+    /**
+     *  @param[in] _iFileDescriptor File descriptor
+     *  @return (Positive) Quantity of data actually written; Negative error code in case of error
+     */
+    int writeRowGroup( int _iFileDescriptor );
+
+  public:
+    /// Allocate resources for the given row group size
+    /**
+     *  @param[in] _iRowGroupSize Row group size (quantity of records)
+     *  @return Negative error code in case of error, zero otherwise
+     */
+    int alloc( int _iRowGroupSize = ROW_GROUP_SIZE );
+    /// Free resources (discarding buffered data)
+    void free();
+    /// Write the given SGCTP data to the given file (buffering it until the row group is full)
+    /**
+     *  @param[in] _iFileDescriptor File descriptor
+     *  @param[in] _roData SGCTP data object (to be written)
+     *  @return (Positive) Quantity of data actually written (zero if buffered); Negative error code in case of error
+     */
+    int write( int _iFileDescriptor,
+               const CData &_roData );
+    /// Write the buffered row group (if any) to the given file
+    /**
+     *  This method MUST be called before the file is closed.
+     *  @param[in] _iFileDescriptor File descriptor
+     *  @return (Positive) Quantity of data actually written; Negative error code in case of error
+     */
+    int flush( int _iFileDescriptor );
+
+  };
+
+}
+
+#endif // SGCTP_CCOLUMNAR_WRITER_HPP
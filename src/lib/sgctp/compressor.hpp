@@ -0,0 +1,139 @@
+// INDENTING (emacs/vi): -*- mode:c++; tab-width:2; c-basic-offset:2; intent-tabs-mode:nil; -*- ex: set tabstop=2 expandtab:
+
+/*
+ * Simple Geolocalization and Course Transmission Protocol (SGCTP)
+ * Copyright (C) 2014 Cedric Dufour <http://cedric.dufour.name>
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * free software:
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, Version 3.
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ */
+
+#ifndef SGCTP_CCOMPRESSOR_HPP
+#define SGCTP_CCOMPRESSOR_HPP
+
+// C
+#include <errno.h>
+#include <stdint.h>
+
+
+// SGCTP namespace
+namespace SGCTP
+{
+
+  /// SGCTP data (block) compressor
+  /**
+   * This class provides the (stateless) compression algorithms used to store
+   * SGCTP data in compressed (block) archives (see CTransmit_File).
+   * The built-in LZ algorithm is always available; the ZLIB algorithm is
+   * available only if the library was built along the zlib library.
+   */
+  class CCompressor
+  {
+
+    //----------------------------------------------------------------------
+    // CONSTANTS / STATIC
+    //----------------------------------------------------------------------
+
+  public:
+    /// Compression types
+    enum ECompressionType {
+      COMPRESSION_NONE = 0,  ///< no compression (stored)
+      COMPRESSION_LZ = 1,    ///< built-in LZ77 (byte-oriented; fast)
+      COMPRESSION_ZLIB = 2   ///< zlib (deflate; compact)
+    };
+
+  private:
+    /// LZ minimum match length
+    static const int LZ_MIN_MATCH = 4;
+    /// LZ maximum match offset
+    static const int LZ_MAX_OFFSET = 65535;
+    /// LZ hash table size (bits)
+    static const int LZ_HASH_BITS = 13;
+
+  public:
+    /// Return whether the given compression type is available
+    /**
+     *  @param[in] _ui8tCompressionType Compression type (code)
+     *  @see ECompressionType
+     */
+    static bool isAvailable( uint8_t _ui8tCompressionType );
+    /// Return the maximum compressed size of data of the given (uncompressed) size, for all compression types
+    static int bound( int _iSize )
+    {
+      return _iSize + _iSize/255 + 64;
+    };
+    /// Compress the given data
+    /**
+     *  @param[in] _ui8tCompressionType Compression type (code)
+     *  @param[in] _pucInput Input (uncompressed) data
+     *  @param[in] _iInputSize Input (uncompressed) data size
+     *  @param[out] _pucOutput Output buffer (to store compressed data into)
+     *  @param[in] _iOutputSize Output buffer size
+     *  @return (Positive) Compressed data size; Negative error code in case of error (-ENOSPC if the output buffer is too small)
+     */
+    static int compress( uint8_t _ui8tCompressionType,
+                         const unsigned char *_pucInput,
+                         int _iInputSize,
+                         unsigned char *_pucOutput,
+                         int _iOutputSize );
+    /// Decompress the given data
+    /**
+     *  @param[in] _ui8tCompressionType Compression type (code)
+     *  @param[in] _pucInput Input (compressed) data
+     *  @param[in] _iInputSize Input (compressed) data size
+     *  @param[out] _pucOutput Output buffer (to store uncompressed data into)
+     *  @param[in] _iOutputSize Output buffer size
+     *  @return (Positive) Uncompressed data size; Negative error code in case of error (-EPROTO if the data are corrupted)
+     */
+    static int decompress( uint8_t _ui8tCompressionType,
+                           const unsigned char *_pucInput,
+                           int _iInputSize,
+                           unsigned char *_pucOutput,
+                           int _iOutputSize );
+
+  private:
+    /// Compress the given data (built-in LZ algorithm)
+    static int compressLZ( const unsigned char *_pucInput,
+                           int _iInputSize,
+                           unsigned char *_pucOutput,
+                           int _iOutputSize );
+    /// Decompress the given data (built-in LZ algorithm)
+    static int decompressLZ( const unsigned char *_pucInput,
+                             int _iInputSize,
+                             unsigned char *_pucOutput,
+                             int _iOutputSize );
+    /// Add the given (extended) length to the given buffer (255-valued bytes, followed by remainder)
+    /**
+     *  @return Quantity of bytes written; Negative error code in case of error
+     */
+    static inline int putLength( unsigned char *_pucOutput,
+                                 int _iOutputSize,
+                                 int _iLength )
+    {
+      int __iSize = 0;
+      for( ; _iLength >= 255; _iLength -= 255 )
+      {
+        if( __iSize >= _iOutputSize )
+          return -ENOSPC;
+        _pucOutput[__iSize++] = 255;
+      }
+      if( __iSize >= _iOutputSize )
+        return -ENOSPC;
+      _pucOutput[__iSize++] = (unsigned char)_iLength;
+      return __iSize;
+    };
+
+  };
+
+}
+
+#endif // SGCTP_CCOMPRESSOR_HPP
@@ -29,6 +29,9 @@
 #include <string>
 using namespace std;
 
+// SGCTP
+#include "sgctp/field.hpp"
+
 // SGCTP namespace
 namespace SGCTP
 {
@@ -39,11 +42,16 @@ namespace SGCTP
    * precision-loss format).
    * It provides the necessary setters/getters to convert all geolocalization
    * and motion data from/to their SI-standardized form.
+   * Fields are stored compactly (presence bit mask and values packed to their
+   * payload size); short IDs are stored inline.
    * See the PROTOCOL document to see the meaning of each data field.
    */
   class CData
   {
     friend class CPayload;
+    friend class CPayload_DELTA;
+    friend class CDataBlock;
+    friend class CFileIndex;
 
     //----------------------------------------------------------------------
     // CONSTANTS / STATIC
@@ -61,9 +69,9 @@ namespace SGCTP
 
   private:
     /// Internal (integer) undefined value
-    static const uint32_t UNDEFINED_UINT32 = 0x80000000;
+    static const uint32_t UNDEFINED_UINT32 = CField::UNDEFINED_UINT32;
     /// Internal (integer) positive overflow value
-    static const uint32_t OVERFLOW_UINT32 = 0x7FFFFFFF;
+    static const uint32_t OVERFLOW_UINT32 = CField::OVERFLOW_UINT32;
 
   public:
     /// Undefined value
@@ -76,6 +84,14 @@ namespace SGCTP
     static const uint8_t MAX_ID_SIZE = 128;
     /// Maximum data size
     static const uint16_t MAX_DATA_SIZE = 32767;
+
+  private:
+    /// Inline ID size (longer IDs being stored out-of-line)
+    static const uint8_t ID_INLINE_SIZE = 24;
+    /// Inline data size (larger data being stored out-of-line)
+    static const uint16_t DATA_INLINE_SIZE = 64;
+
+  public:
     /// Return whether the given value is defined
     inline static bool isDefined( double _fdValue )
     {
@@ -103,15 +119,17 @@ namespace SGCTP
                            double _fdEpochReference = 0 );
     /// Return the ISO-8601 date/time string corresponding to the given UNIX epoch
     /**
-     *  @param[in] _pcIso8601 Pointer to the characters string to store the ISO-8601 date/time into
+     *  @param[in] _pcIso8601 Pointer to the characters string to store the ISO-8601 date/time into (at least CClock::ISO8601_SIZE long)
      *  @param[in] _fdEpoch UNIX epoch (time AND date)
+     *  @see CClock::toIso8601()
      */
     static void toIso8601( char *_pcIso8601,
                            double _fdEpoch );
     /// Return the UNIX epoch corresponding to the given ISO-8601 date/time string
     /**
      *  @param[in] _pcIso8601 Pointer to the characters string containing the ISO-8601 date/time
-     *  @return _fdEpoch UNIX epoch (time AND date)
+     *  @return _fdEpoch UNIX epoch (time AND date); string parsed as a number if it is not ISO-8601
+     *  @see CClock::fromIso8601()
      */
     static double fromIso8601( const char *_pcIso8601 );
 
@@ -121,60 +139,28 @@ namespace SGCTP
     //----------------------------------------------------------------------
 
   private:
-    /// ID string (max. 127 characters)
-    char pcID[MAX_ID_SIZE];
-    /// Data (max. 32767 symbols)
+    /// Defined fields (bit mask; see CField)
+    uint32_t ui32tDefined;
+    /// Overflowing fields (bit mask; see CField)
+    uint32_t ui32tOverflow;
+    /// Fields values (packed to their payload size; see CField::storageOffset)
+    unsigned char pucFields[CField::storageOffset( CField::COUNT )];
+    /// ID length
+    uint8_t ui8tIDLength;
+    /// ID string (short IDs; inline)
+    char pcIDInline[ID_INLINE_SIZE];
+    /// ID string (long IDs; out-of-line, allocated on demand)
+    char *pcIDExtended;
+    /// Data (max. 32767 symbols; pointer to inline or out-of-line storage, NULL if none)
     unsigned char *pucData;
     /// Data size
     uint16_t ui16tDataSize;
-    /// Time
-    uint32_t ui32tTime;
-    /// Latitude
-    uint32_t ui32tLatitude;
-    /// Longitude
-    uint32_t ui32tLongitude;
-    /// Elevation
-    uint32_t ui32tElevation;
-    /// Bearing
-    uint32_t ui32tBearing;
-    /// Ground speed
-    uint32_t ui32tGndSpeed;
-    /// Vertical speed
-    uint32_t ui32tVrtSpeed;
-    /// Bearing variation over time (rate of turn)
-    uint32_t ui32tBearingDt;
-    /// Ground speed variation over time (acceleration)
-    uint32_t ui32tGndSpeedDt;
-    /// Vertical speed variation over time (acceleration)
-    uint32_t ui32tVrtSpeedDt;
-    /// Heading
-    uint32_t ui32tHeading;
-    /// Apparent speed
-    uint32_t ui32tAppSpeed;
-    /// Source type
-    uint32_t ui32tSourceType;
-    /// Latitude error
-    uint32_t ui32tLatitudeError;
-    /// Longitude error
-    uint32_t ui32tLongitudeError;
-    /// Elevation error
-    uint32_t ui32tElevationError;
-    /// Bearing error
-    uint32_t ui32tBearingError;
-    /// Ground speed error
-    uint32_t ui32tGndSpeedError;
-    /// Vertical speed error
-    uint32_t ui32tVrtSpeedError;
-    /// Bearing variation over time (rate of turn) error
-    uint32_t ui32tBearingDtError;
-    /// Ground speed variation over time (acceleration) error
-    uint32_t ui32tGndSpeedDtError;
-    /// Vertical speed variation over time (acceleration) error
-    uint32_t ui32tVrtSpeedDtError;
-    /// Heading error
-    uint32_t ui32tHeadingError;
-    /// Apparent speed error
-    uint32_t ui32tAppSpeedError;
+    /// Data (small data; inline)
+    unsigned char pucDataInline[DATA_INLINE_SIZE];
+    /// Data (large data; out-of-line, allocated on demand and re-used)
+    unsigned char *pucDataExtended;
+    /// Data (out-of-line) storage capacity
+    uint16_t ui16tDataExtendedCapacity;
 
 
     //----------------------------------------------------------------------
@@ -183,12 +169,47 @@ namespace SGCTP
 
   public:
     CData()
-      : pucData( NULL )
+      : pcIDExtended( NULL )
+      , pucData( NULL )
+      , ui16tDataSize( 0 )
+      , pucDataExtended( NULL )
+      , ui16tDataExtendedCapacity( 0 )
     {
       reset();
     }
+    CData( const CData &_roData )
+      : pcIDExtended( NULL )
+      , pucData( NULL )
+      , ui16tDataSize( 0 )
+      , pucDataExtended( NULL )
+      , ui16tDataExtendedCapacity( 0 )
+    {
+      reset();
+      copy( _roData );
+    }
+    CData( CData &&_rroData )
+      : pcIDExtended( NULL )
+      , pucData( NULL )
+      , ui16tDataSize( 0 )
+      , pucDataExtended( NULL )
+      , ui16tDataExtendedCapacity( 0 )
+    {
+      reset();
+      swap( _rroData );
+    }
     ~CData();
 
+    CData& operator=( const CData &_roData )
+    {
+      copy( _roData );
+      return *this;
+    }
+    CData& operator=( CData &&_rroData )
+    {
+      swap( _rroData );
+      return *this;
+    }
+
 
     //----------------------------------------------------------------------
     // METHODS
@@ -238,10 +259,10 @@ namespace SGCTP
     void setAppSpeed( double _fdApparentSpeed );
     /// Set the source type
     void setSourceType( ESourceType _eSourceType )
-    { ui32tSourceType =
+    { setField<CField::SOURCE_TYPE>(
         ( _eSourceType != SOURCE_UNDEFINED )
         ? _eSourceType
-        : UNDEFINED_UINT32;
+        : UNDEFINED_UINT32 );
     };
     /// Set the latitude error, in meters
     void setLatitudeError( double _fdLatitudeError );
@@ -275,7 +296,12 @@ namespace SGCTP
     /// Return the ID string
     const char* getID() const
     {
-      return pcID;
+      return ( ui8tIDLength < ID_INLINE_SIZE ) ? pcIDInline : pcIDExtended;
+    };
+    /// Return the ID length
+    uint8_t getIDLength() const
+    {
+      return ui8tIDLength;
     };
     /// Return the data (max. 32767 symbols)
     void getData( unsigned char *_pucData,
@@ -317,7 +343,7 @@ namespace SGCTP
     /// Return the source type
     ESourceType getSourceType() const
     {
-      return (ESourceType)(ui32tSourceType & 0xFF);
+      return (ESourceType)(getField<CField::SOURCE_TYPE>() & 0xFF);
     };
     /// Return the latitude error, in meters
     double getLatitudeError() const;
@@ -348,6 +374,76 @@ namespace SGCTP
     //
 
   private:
+    /// Data fields (packed storage) accessor
+    /**
+     *  Handles fields I to N-1 (in payload order).
+     *  @see CField::FIELDS
+     */
+    template<int I, int N> struct CFieldAccessor;
+    /// Return the internal (integer) value of the given field (see CField)
+    template<int I> inline uint32_t getField() const
+    {
+      if( !( ui32tDefined & ( 1u << I ) ) )
+        return UNDEFINED_UINT32;
+      if( ui32tOverflow & ( 1u << I ) )
+        return OVERFLOW_UINT32;
+      const unsigned char *__pucField = pucFields + CField::storageOffset( I );
+      if( CField::storageSize( I ) == 4 )
+      {
+        uint32_t __ui32tValue;
+        memcpy( &__ui32tValue, __pucField, 4 );
+        return __ui32tValue;
+      }
+      if( CField::storageSize( I ) == 2 )
+      {
+        uint16_t __ui16tValue;
+        memcpy( &__ui16tValue, __pucField, 2 );
+        return __ui16tValue;
+      }
+      return *__pucField;
+    };
+    /// Set the internal (integer) value of the given field (see CField)
+    template<int I> inline void setField( uint32_t _ui32tValue )
+    {
+      ui32tOverflow &= ~( 1u << I );
+      if( _ui32tValue & UNDEFINED_UINT32 )
+      {
+        ui32tDefined &= ~( 1u << I );
+        return;
+      }
+      ui32tDefined |= 1u << I;
+      if( _ui32tValue == OVERFLOW_UINT32 )
+      {
+        ui32tOverflow |= 1u << I;
+        return;
+      }
+      unsigned char *__pucField = pucFields + CField::storageOffset( I );
+      if( CField::storageSize( I ) == 4 )
+        memcpy( __pucField, &_ui32tValue, 4 );
+      else if( CField::storageSize( I ) == 2 )
+      {
+        uint16_t __ui16tValue = _ui32tValue;
+        memcpy( __pucField, &__ui16tValue, 2 );
+      }
+      else
+        *__pucField = _ui32tValue;
+    };
+    /// Retrieve all fields internal (integer) values
+    /**
+     *  @param[out] _pui32tFields Fields (internal integer values; see CField)
+     */
+    void getFields( uint32_t *_pui32tFields ) const;
+    /// Set all fields internal (integer) values
+    /**
+     *  @param[in] _pui32tFields Fields (internal integer values; see CField)
+     */
+    void setFields( const uint32_t *_pui32tFields );
+    /// Allocate the memory for the ID string (max. 127 characters)
+    /**
+     *  @param[in] _ui8tIDLength ID length
+     *  @return Pointer to the ID string storage (_ui8tIDLength+1 bytes); NULL in case of error
+     */
+    char* allocID( uint8_t _ui8tIDLength );
     /// Allocate the memory for the data container (max. 32767 symbols)
     uint16_t allocData( uint16_t _ui16tDataSize );
 
@@ -355,7 +451,16 @@ namespace SGCTP
     /// Clear (free) the data container
     void freeData();
     /// Copy the entire content from another data object
+    /**
+     *  Storage is re-used whenever possible (no memory allocation for short
+     *  IDs and small data).
+     */
     void copy( const CData &_roData );
+    /// Swap the entire content with another data object
+    /**
+     *  Storage is exchanged (no memory allocation nor data copy).
+     */
+    void swap( CData &_roData );
     /// Synchronize the (defined) content from another data object
     /**
      *  @return Whether some (defined) content has actually been synchronized
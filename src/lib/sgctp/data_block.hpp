@@ -0,0 +1,228 @@
+// INDENTING (emacs/vi): -*- mode:c++; tab-width:2; c-basic-offset:2; intent-tabs-mode:nil; -*- ex: set tabstop=2 expandtab:
+
+/*
+ * Simple Geolocalization and Course Transmission Protocol (SGCTP)
+ * Copyright (C) 2014 Cedric Dufour <http://cedric.dufour.name>
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * free software:
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, Version 3.
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ */
+
+#ifndef SGCTP_CDATABLOCK_HPP
+#define SGCTP_CDATABLOCK_HPP
+
+// C
+#include <stdint.h>
+#include <stdlib.h>
+
+// SGCTP
+#include "sgctp/field.hpp"
+
+
+// SGCTP namespace
+namespace SGCTP
+{
+
+  // External
+  class CData;
+
+
+  /// SGCTP data block (structure-of-arrays) container
+  /**
+   * This class stores a block of SGCTP data records column-wise, each field
+   * being held in its own contiguous array (in integer/no-precision-loss
+   * format), along the ID and data of each record in contiguous heaps.
+   * It allows many records to be unserialized (see CPayload::unserialize()
+   * and CTransmit::unserializeBatch()) and processed without per-record
+   * CData objects.
+   */
+  class CDataBlock
+  {
+    friend class CPayload;
+    friend class CColumnar_Reader;
+
+    //----------------------------------------------------------------------
+    // CONSTANTS / STATIC
+    //----------------------------------------------------------------------
+
+  public:
+    /// Default block capacity (quantity of records)
+    static const int DEFAULT_CAPACITY = 1024;
+
+
+    //----------------------------------------------------------------------
+    // FIELDS
+    //----------------------------------------------------------------------
+
+  private:
+    /// Block capacity (quantity of records)
+    int iCapacity;
+    /// Block size (quantity of records actually stored)
+    int iSize;
+    /// Fields columns (internal integer values; CField::COUNT columns of capacity size)
+    uint32_t *pui32tFields;
+    /// Defined fields (bit mask of CField::EField) of each record
+    uint32_t *pui32tDefined;
+    /// ID strings offsets (into the IDs heap; capacity+1 entries)
+    uint32_t *pui32tIDOffsets;
+    /// IDs heap (NUL-terminated ID strings)
+    char *pcIDs;
+    /// IDs heap allocated size
+    uint32_t ui32tIDsSize;
+    /// Data offsets (into the data heap; capacity+1 entries)
+    uint32_t *pui32tDataOffsets;
+    /// Data heap
+    unsigned char *pucData;
+    /// Data heap allocated size
+    uint32_t ui32tDataSize;
+
+
+    //----------------------------------------------------------------------
+    // CONSTRUCTORS / DESTRUCTOR
+    //----------------------------------------------------------------------
+
+  public:
+    CDataBlock()
+      : iCapacity( 0 )
+      , iSize( 0 )
+      , pui32tFields( NULL )
+      , pui32tDefined( NULL )
+      , pui32tIDOffsets( NULL )
+      , pcIDs( NULL )
+      , ui32tIDsSize( 0 )
+      , pui32tDataOffsets( NULL )
+      , pucData( NULL )
+      , ui32tDataSize( 0 )
+    {};
+    ~CDataBlock()
+    {
+      free();
+    };
+
+
+    //----------------------------------------------------------------------
+    // METHODS
+    //----------------------------------------------------------------------
+
+  private:
+    /// Make sure the given quantity of bytes is available in the IDs and data heaps
+    /**
+     *  @param[in] _ui32tIDSize Required (additional) IDs heap size
+     *  @param[in] _ui32tDataSize Required (additional) data heap size
+     *  @return Negative error code in case of error, zero otherwise
+     */
+    int reserve( uint32_t _ui32tIDSize,
+                 uint32_t _ui32tDataSize );
+
+  public:
+    /// Allocate resources for the given block capacity
+    /**
+     *  Previously stored records are discarded.
+     *  @param[in] _iCapacity Block capacity (quantity of records)
+     *  @return Negative error code in case of error, zero otherwise
+     */
+    int alloc( int _iCapacity = DEFAULT_CAPACITY );
+    /// Free resources
+    void free();
+    /// Append (copy) the given data object to the block
+    /**
+     *  @param[in] _roData SGCTP data object
+     *  @return Negative error code in case of error (-ENOSPC if the block is full), zero otherwise
+     */
+    int append( const CData &_roData );
+    /// Reset (discard) all stored records
+    void reset()
+    {
+      iSize = 0;
+      if( pui32tIDOffsets )
+        pui32tIDOffsets[0] = 0;
+      if( pui32tDataOffsets )
+        pui32tDataOffsets[0] = 0;
+    };
+
+    //
+    // GETTERS
+    //
+
+  public:
+    /// Return the block capacity (quantity of records)
+    int getCapacity() const
+    {
+      return iCapacity;
+    };
+    /// Return the block size (quantity of records actually stored)
+    int getSize() const
+    {
+      return iSize;
+    };
+    /// Return whether the block is full
+    bool isFull() const
+    {
+      return iSize >= iCapacity;
+    };
+    /// Return the given field column (internal integer values)
+    /**
+     *  Undefined values have their CField::UNDEFINED_UINT32 bit set.
+     *  @param[in] _eField Field
+     *  @return Column (array of getSize() values)
+     */
+    const uint32_t* getColumn( CField::EField _eField ) const
+    {
+      return pui32tFields + _eField * iCapacity;
+    };
+    /// Return the defined fields (bit mask of CField::EField) of each record
+    /**
+     *  @return Array of getSize() bit masks
+     */
+    const uint32_t* getDefined() const
+    {
+      return pui32tDefined;
+    };
+    /// Return the given field column SI-standardized values
+    /**
+     *  @param[out] _pfdValues Values buffer (of at least getSize() values)
+     *  @see CField::toValue()
+     */
+    template<int I> void getValues( double *_pfdValues ) const
+    {
+      const uint32_t *__pui32tColumn = pui32tFields + I * iCapacity;
+      for( int __i = 0; __i < iSize; __i++ )
+        _pfdValues[__i] = CField::toValue<I>( __pui32tColumn[__i] );
+    };
+    /// Return the ID string of the given record
+    const char* getID( int _iIndex ) const
+    {
+      return pcIDs + pui32tIDOffsets[_iIndex];
+    };
+    /// Return the data of the given record
+    const unsigned char* getData( int _iIndex ) const
+    {
+      return pucData + pui32tDataOffsets[_iIndex];
+    };
+    /// Return the data size of the given record
+    uint16_t getDataSize( int _iIndex ) const
+    {
+      return pui32tDataOffsets[_iIndex+1] - pui32tDataOffsets[_iIndex];
+    };
+    /// Copy the given record into the given data object
+    /**
+     *  @param[in] _iIndex Record index
+     *  @param[out] _poData SGCTP data object (to store the record into)
+     */
+    void getRecord( int _iIndex,
+                    CData *_poData ) const;
+
+  };
+
+}
+
+#endif // SGCTP_CDATABLOCK_HPP
@@ -0,0 +1,388 @@
+// INDENTING (emacs/vi): -*- mode:c++; tab-width:2; c-basic-offset:2; intent-tabs-mode:nil; -*- ex: set tabstop=2 expandtab:
+
+/*
+ * Simple Geolocalization and Course Transmission Protocol (SGCTP)
+ * Copyright (C) 2014 Cedric Dufour <http://cedric.dufour.name>
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * free software:
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, Version 3.
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ */
+
+#ifndef SGCTP_CFIELD_HPP
+#define SGCTP_CFIELD_HPP
+
+// C
+#include <math.h>
+#include <stdint.h>
+
+// SGCTP namespace
+namespace SGCTP
+{
+
+  /// SGCTP data fields schema
+  /**
+   * This class describes - in a single (compile-time) table - each data field
+   * of the SGCTP payload: its payload size, its content-flag group, its
+   * payload (undefined/overflow) codes and its conversion from/to its
+   * SI-standardized form.
+   * The (raw) payload encoder/decoder and the data container setters/getters
+   * are all generated from this table.
+   * Fields are listed in their payload order; see the PROTOCOL document.
+   */
+  class CField
+  {
+
+    //----------------------------------------------------------------------
+    // CONSTANTS / STATIC
+    //----------------------------------------------------------------------
+
+  public:
+    /// Data fields (in payload order)
+    enum EField {
+      TIME = 0,
+      LATITUDE,
+      LONGITUDE,
+      ELEVATION,
+      BEARING,
+      GND_SPEED,
+      VRT_SPEED,
+      BEARING_DT,
+      GND_SPEED_DT,
+      VRT_SPEED_DT,
+      HEADING,
+      APP_SPEED,
+      SOURCE_TYPE,
+      LATITUDE_ERROR,
+      LONGITUDE_ERROR,
+      ELEVATION_ERROR,
+      BEARING_ERROR,
+      GND_SPEED_ERROR,
+      VRT_SPEED_ERROR,
+      BEARING_DT_ERROR,
+      GND_SPEED_DT_ERROR,
+      VRT_SPEED_DT_ERROR,
+      HEADING_ERROR,
+      APP_SPEED_ERROR,
+      COUNT,
+      EXTENDED = SOURCE_TYPE  ///< first extended content field
+    };
+
+    /// Content-flag groups
+    enum EGroup {
+      GROUP_2D_POSITION = 0,
+      GROUP_3D_POSITION,
+      GROUP_2D_GND_COURSE,
+      GROUP_3D_GND_COURSE,
+      GROUP_2D_GND_COURSE_DT,
+      GROUP_3D_GND_COURSE_DT,
+      GROUP_2D_APP_COURSE,
+      GROUP_2D_POSITION_ERROR,
+      GROUP_3D_POSITION_ERROR,
+      GROUP_2D_GND_COURSE_ERROR,
+      GROUP_3D_GND_COURSE_ERROR,
+      GROUP_2D_GND_COURSE_DT_ERROR,
+      GROUP_3D_GND_COURSE_DT_ERROR,
+      GROUP_2D_APP_COURSE_ERROR,
+      GROUP_TIME,
+      GROUP_SOURCE_TYPE,
+      GROUP_COUNT,
+      GROUP_NONE = 0xFF
+    };
+
+    /// Content bytes
+    enum EContent {
+      CONTENT = 0,            ///< content byte
+      CONTENT_EXTENDED = 1    ///< extended content byte
+    };
+
+    /// Extended content flag (in content byte)
+    static const uint8_t FLAG_EXTENDED = 0x01;
+    /// Internal (integer) undefined value
+    static const uint32_t UNDEFINED_UINT32 = 0x80000000;
+    /// Internal (integer) positive overflow value
+    static const uint32_t OVERFLOW_UINT32 = 0x7FFFFFFF;
+    /// Payload code placeholder (no such code)
+    static const uint32_t CODE_NONE = 0xFFFFFFFF;
+
+    /// Data field descriptor
+    struct TField
+    {
+      /// Payload size (bits quantity)
+      uint8_t ui8tBits;
+      /// Content-flag group
+      uint8_t ui8tGroup;
+      /// Payload code standing for an undefined value (CODE_NONE if the field is only present when defined)
+      uint32_t ui32tUndefinedCode;
+      /// Payload code standing for an overflow value (CODE_NONE if none)
+      uint32_t ui32tOverflowCode;
+      /// Internal value for (SI) values below minimum (zero being decoded as negative overflow)
+      uint32_t ui32tUnderflow;
+      /// Whether the (SI) value sign is discarded
+      bool bAbsolute;
+      /// Whether the (SI) maximum value is excluded
+      bool bMaximumExcluded;
+      /// Minimum (SI) value
+      double fdMinimum;
+      /// Maximum (SI) value
+      double fdMaximum;
+      /// Scale (SI value to internal integer)
+      double fdScale;
+      /// Offset (internal integer)
+      double fdOffset;
+      /// Divisor and unit (internal integer to SI value)
+      /**
+       *  NOTE: integer-to-SI conversion is performed as a division followed
+       *        by a multiplication, for historical (bit-exact) results
+       */
+      double fdDivisor;
+      double fdUnit;
+    };
+
+    /// Content-flag group descriptor
+    struct TGroup
+    {
+      /// Content byte
+      uint8_t ui8tContent;
+      /// Content flag (zero if the group is always present)
+      uint8_t ui8tFlag;
+      /// Parent group (which must also be present; GROUP_NONE if none)
+      uint8_t ui8tParent;
+    };
+
+    /// Data fields descriptors
+    static constexpr TField FIELDS[COUNT] = {
+      // TIME
+      { 23, GROUP_TIME, 0xFFFFFFFF >> 9, CODE_NONE, OVERFLOW_UINT32, false, false,
+        0.0, 86400.0, 10.0, 0.0, 1.0, 0.1 },
+      // LATITUDE
+      { 30, GROUP_2D_POSITION, CODE_NONE, 0xFFFFFFFF >> 2, 0, false, false,
+        -90.0, 90.0, 3600000.0, 536870912.0, 36.0, 0.00001 },
+      // LONGITUDE
+      { 31, GROUP_2D_POSITION, CODE_NONE, 0xFFFFFFFF >> 1, 0, false, false,
+        -180.0, 180.0, 3600000.0, 1073741824.0, 36.0, 0.00001 },
+      // ELEVATION
+      { 19, GROUP_3D_POSITION, CODE_NONE, 0xFFFFFFFF >> 13, 0, false, false,
+        -13107.15, 39321.35, 10.0, 131072.0, 1.0, 0.1 },
+      // BEARING
+      { 12, GROUP_2D_GND_COURSE, CODE_NONE, 0xFFFFFFFF >> 20, OVERFLOW_UINT32, false, true,
+        0.0, 360.0, 10.0, 0.0, 1.0, 0.1 },
+      // GND_SPEED
+      { 16, GROUP_2D_GND_COURSE, CODE_NONE, 0xFFFFFFFF >> 16, 0, false, false,
+        0.0, 6553.35, 10.0, 1.0, 1.0, 0.1 },
+      // VRT_SPEED
+      { 13, GROUP_3D_GND_COURSE, CODE_NONE, 0xFFFFFFFF >> 19, 0, false, false,
+        -409.55, 409.35, 10.0, 4096.0, 1.0, 0.1 },
+      // BEARING_DT
+      { 10, GROUP_2D_GND_COURSE_DT, CODE_NONE, 0xFFFFFFFF >> 22, 0, false, false,
+        -51.15, 50.95, 10.0, 512.0, 1.0, 0.1 },
+      // GND_SPEED_DT
+      { 12, GROUP_2D_GND_COURSE_DT, CODE_NONE, 0xFFFFFFFF >> 20, 0, false, false,
+        -204.75, 204.55, 10.0, 2048.0, 1.0, 0.1 },
+      // VRT_SPEED_DT
+      { 12, GROUP_3D_GND_COURSE_DT, CODE_NONE, 0xFFFFFFFF >> 20, 0, false, false,
+        -204.75, 204.55, 10.0, 2048.0, 1.0, 0.1 },
+      // HEADING
+      { 12, GROUP_2D_APP_COURSE, CODE_NONE, 0xFFFFFFFF >> 20, OVERFLOW_UINT32, false, false,
+        0.0, 360.0, 10.0, 0.0, 1.0, 0.1 },
+      // APP_SPEED
+      { 16, GROUP_2D_APP_COURSE, CODE_NONE, 0xFFFFFFFF >> 16, 0, false, false,
+        0.0, 6553.35, 10.0, 1.0, 1.0, 0.1 },
+      // SOURCE_TYPE (no SI conversion)
+      { 8, GROUP_SOURCE_TYPE, 0, CODE_NONE, OVERFLOW_UINT32, false, false,
+        0.0, 255.0, 1.0, 0.0, 1.0, 1.0 },
+      // LATITUDE_ERROR
+      { 12, GROUP_2D_POSITION_ERROR, CODE_NONE, 0xFFFFFFFF >> 20, OVERFLOW_UINT32, true, false,
+        0.0, 409.45, 10.0, 0.0, 1.0, 0.1 },
+      // LONGITUDE_ERROR
+      { 12, GROUP_2D_POSITION_ERROR, CODE_NONE, 0xFFFFFFFF >> 20, OVERFLOW_UINT32, true, false,
+        0.0, 409.45, 10.0, 0.0, 1.0, 0.1 },
+      // ELEVATION_ERROR
+      { 12, GROUP_3D_POSITION_ERROR, CODE_NONE, 0xFFFFFFFF >> 20, OVERFLOW_UINT32, true, false,
+        0.0, 409.45, 10.0, 0.0, 1.0, 0.1 },
+      // BEARING_ERROR
+      { 8, GROUP_2D_GND_COURSE_ERROR, CODE_NONE, 0xFFFFFFFF >> 24, OVERFLOW_UINT32, true, false,
+        0.0, 25.45, 10.0, 0.0, 1.0, 0.1 },
+      // GND_SPEED_ERROR
+      { 8, GROUP_2D_GND_COURSE_ERROR, CODE_NONE, 0xFFFFFFFF >> 24, OVERFLOW_UINT32, true, false,
+        0.0, 25.45, 10.0, 0.0, 1.0, 0.1 },
+      // VRT_SPEED_ERROR
+      { 8, GROUP_3D_GND_COURSE_ERROR, CODE_NONE, 0xFFFFFFFF >> 24, OVERFLOW_UINT32, true, false,
+        0.0, 25.45, 10.0, 0.0, 1.0, 0.1 },
+      // BEARING_DT_ERROR
+      { 8, GROUP_2D_GND_COURSE_DT_ERROR, CODE_NONE, 0xFFFFFFFF >> 24, OVERFLOW_UINT32, true, false,
+        0.0, 25.45, 10.0, 0.0, 1.0, 0.1 },
+      // GND_SPEED_DT_ERROR
+      { 8, GROUP_2D_GND_COURSE_DT_ERROR, CODE_NONE, 0xFFFFFFFF >> 24, OVERFLOW_UINT32, true, false,
+        0.0, 25.45, 10.0, 0.0, 1.0, 0.1 },
+      // VRT_SPEED_DT_ERROR
+      { 8, GROUP_3D_GND_COURSE_DT_ERROR, CODE_NONE, 0xFFFFFFFF >> 24, OVERFLOW_UINT32, true, false,
+        0.0, 25.45, 10.0, 0.0, 1.0, 0.1 },
+      // HEADING_ERROR
+      { 8, GROUP_2D_APP_COURSE_ERROR, CODE_NONE, 0xFFFFFFFF >> 24, OVERFLOW_UINT32, true, false,
+        0.0, 25.45, 10.0, 0.0, 1.0, 0.1 },
+      // APP_SPEED_ERROR
+      { 8, GROUP_2D_APP_COURSE_ERROR, CODE_NONE, 0xFFFFFFFF >> 24, OVERFLOW_UINT32, true, false,
+        0.0, 25.45, 10.0, 0.0, 1.0, 0.1 }
+    };
+
+    /// Content-flag groups descriptors
+    static constexpr TGroup GROUPS[GROUP_COUNT] = {
+      { CONTENT, 0x80, GROUP_NONE },                           // GROUP_2D_POSITION
+      { CONTENT, 0x40, GROUP_2D_POSITION },                    // GROUP_3D_POSITION
+      { CONTENT, 0x20, GROUP_NONE },                           // GROUP_2D_GND_COURSE
+      { CONTENT, 0x10, GROUP_2D_GND_COURSE },                  // GROUP_3D_GND_COURSE
+      { CONTENT, 0x08, GROUP_NONE },                           // GROUP_2D_GND_COURSE_DT
+      { CONTENT, 0x04, GROUP_2D_GND_COURSE_DT },               // GROUP_3D_GND_COURSE_DT
+      { CONTENT, 0x02, GROUP_NONE },                           // GROUP_2D_APP_COURSE
+      { CONTENT_EXTENDED, 0x80, GROUP_NONE },                  // GROUP_2D_POSITION_ERROR
+      { CONTENT_EXTENDED, 0x40, GROUP_2D_POSITION_ERROR },     // GROUP_3D_POSITION_ERROR
+      { CONTENT_EXTENDED, 0x20, GROUP_NONE },                  // GROUP_2D_GND_COURSE_ERROR
+      { CONTENT_EXTENDED, 0x10, GROUP_2D_GND_COURSE_ERROR },   // GROUP_3D_GND_COURSE_ERROR
+      { CONTENT_EXTENDED, 0x08, GROUP_NONE },                  // GROUP_2D_GND_COURSE_DT_ERROR
+      { CONTENT_EXTENDED, 0x04, GROUP_2D_GND_COURSE_DT_ERROR },// GROUP_3D_GND_COURSE_DT_ERROR
+      { CONTENT_EXTENDED, 0x02, GROUP_NONE },                  // GROUP_2D_APP_COURSE_ERROR
+      { CONTENT, 0x00, GROUP_NONE },                           // GROUP_TIME
+      { CONTENT_EXTENDED, 0x00, GROUP_NONE }                   // GROUP_SOURCE_TYPE
+    };
+
+    /// Return the (bit) mask of the fields belonging to the given group
+    /**
+     *  @param[in] _ui8tGroup Content-flag group
+     *  @param[in] _iField Field to start from (recursion)
+     */
+    static constexpr uint32_t groupFields( uint8_t _ui8tGroup,
+                                           int _iField = 0 )
+    {
+      return ( _iField >= COUNT )
+        ? 0
+        : ( ( FIELDS[_iField].ui8tGroup == _ui8tGroup ) ? 1u << _iField : 0 )
+          | groupFields( _ui8tGroup, _iField+1 );
+    };
+    /// Return the (bit) mask of the given group's parent group (zero if none)
+    /**
+     *  @param[in] _ui8tGroup Content-flag group
+     */
+    static constexpr uint32_t groupParent( uint8_t _ui8tGroup )
+    {
+      return ( GROUPS[_ui8tGroup].ui8tParent == GROUP_NONE )
+        ? 0
+        : 1u << GROUPS[_ui8tGroup].ui8tParent;
+    };
+    /// Return the (bit) mask of the groups belonging to the given content byte
+    /**
+     *  @param[in] _ui8tContent Content byte
+     *  @param[in] _iGroup Group to start from (recursion)
+     */
+    static constexpr uint32_t contentGroups( uint8_t _ui8tContent,
+                                             int _iGroup = 0 )
+    {
+      return ( _iGroup >= GROUP_COUNT )
+        ? 0
+        : ( ( GROUPS[_iGroup].ui8tContent == _ui8tContent ) ? 1u << _iGroup : 0 )
+          | contentGroups( _ui8tContent, _iGroup+1 );
+    };
+    /// Return the (bit) mask of the groups corresponding to the given content flags
+    /**
+     *  @param[in] _ui8tContent Content byte
+     *  @param[in] _ui8tFlags Content flags
+     *  @param[in] _iGroup Group to start from (recursion)
+     */
+    static constexpr uint32_t flagsGroups( uint8_t _ui8tContent,
+                                           uint8_t _ui8tFlags,
+                                           int _iGroup = 0 )
+    {
+      return ( _iGroup >= GROUP_COUNT )
+        ? 0
+        : ( ( GROUPS[_iGroup].ui8tContent == _ui8tContent
+              && _ui8tFlags & GROUPS[_iGroup].ui8tFlag ) ? 1u << _iGroup : 0 )
+          | flagsGroups( _ui8tContent, _ui8tFlags, _iGroup+1 );
+    };
+
+    /// Return the (packed) storage size of the given field, in bytes
+    /**
+     *  Fields are stored in the smallest integer type fitting their payload size.
+     *  @param[in] _iField Field
+     */
+    static constexpr int storageSize( int _iField )
+    {
+      return ( FIELDS[_iField].ui8tBits > 16 )
+        ? 4
+        : ( FIELDS[_iField].ui8tBits > 8 ) ? 2 : 1;
+    };
+    /// Return the quantity of fields (preceding the given one) with the given storage size
+    /**
+     *  @param[in] _iSize Storage size, in bytes
+     *  @param[in] _iField Field to stop at (recursion)
+     */
+    static constexpr int storageCount( int _iSize,
+                                       int _iField = COUNT )
+    {
+      return ( _iField <= 0 )
+        ? 0
+        : ( ( storageSize( _iField-1 ) == _iSize ) ? 1 : 0 )
+          + storageCount( _iSize, _iField-1 );
+    };
+    /// Return the (packed) storage offset of the given field, in bytes
+    /**
+     *  Fields are grouped by decreasing storage size (preserving alignment).
+     *  @param[in] _iField Field (COUNT for the overall storage size)
+     */
+    static constexpr int storageOffset( int _iField )
+    {
+      return ( _iField >= COUNT )
+        ? 4 * storageCount( 4 ) + 2 * storageCount( 2 ) + storageCount( 1 )
+        : ( ( storageSize( _iField ) < 4 ) ? 4 * storageCount( 4 ) : 0 )
+          + ( ( storageSize( _iField ) < 2 ) ? 2 * storageCount( 2 ) : 0 )
+          + storageSize( _iField ) * storageCount( storageSize( _iField ), _iField );
+    };
+
+    /// Return the internal (integer) value of the given field SI-standardized value
+    /**
+     *  Conversion and range checking are performed according to the field descriptor.
+     *  @param[in] _fdValue SI-standardized value
+     */
+    template<int I> static inline uint32_t fromValue( double _fdValue )
+    {
+      if( FIELDS[I].bAbsolute )
+        _fdValue = fabs( _fdValue );
+      if( _fdValue < FIELDS[I].fdMinimum )
+        return FIELDS[I].ui32tUnderflow;
+      if( FIELDS[I].bMaximumExcluded
+          ? _fdValue >= FIELDS[I].fdMaximum
+          : _fdValue > FIELDS[I].fdMaximum )
+        return OVERFLOW_UINT32;
+      return (uint32_t)( _fdValue * FIELDS[I].fdScale
+                         + ( FIELDS[I].fdOffset + 0.5 ) );
+    };
+    /// Return the SI-standardized value of the given field internal (integer) value
+    /**
+     *  Conversion is performed according to the field descriptor.
+     *  @param[in] _ui32tValue Internal (integer) value
+     *  @return SI-standardized value; NAN if undefined; (-)INFINITY if overflowing
+     */
+    template<int I> static inline double toValue( uint32_t _ui32tValue )
+    {
+      if( _ui32tValue & UNDEFINED_UINT32 )
+        return NAN;
+      if( FIELDS[I].ui32tUnderflow == 0 && _ui32tValue == 0 )
+        return -INFINITY;
+      if( _ui32tValue == OVERFLOW_UINT32 )
+        return INFINITY;
+      return ( (double)_ui32tValue - FIELDS[I].fdOffset )
+        / FIELDS[I].fdDivisor * FIELDS[I].fdUnit;
+    };
+
+  };
+
+}
+
+#endif // SGCTP_CFIELD_HPP
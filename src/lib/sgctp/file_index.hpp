@@ -0,0 +1,236 @@
+// INDENTING (emacs/vi): -*- mode:c++; tab-width:2; c-basic-offset:2; intent-tabs-mode:nil; -*- ex: set tabstop=2 expandtab:
+
+/*
+ * Simple Geolocalization and Course Transmission Protocol (SGCTP)
+ * Copyright (C) 2014 Cedric Dufour <http://cedric.dufour.name>
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * free software:
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, Version 3.
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ */
+
+#ifndef SGCTP_CFILEINDEX_HPP
+#define SGCTP_CFILEINDEX_HPP
+
+// C
+#include <stdint.h>
+
+// C++
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+// SGCTP
+#include "sgctp/field.hpp"
+
+
+// SGCTP namespace
+namespace SGCTP
+{
+
+  // External
+  class CTransmit_File;
+
+  /// SGCTP file index
+  /**
+   * This class builds and uses the index (sidecar) file of a SGCTP file,
+   * allowing to seek directly to the data matching a given ID and/or time
+   * range (rather than unserializing the entire file).
+   * The index consists of sparse checkpoints - each covering a range of
+   * records, starting at a synchronization point (see CTransmit_File::tell())
+   * and along its time range and the IDs it contains - from which ID-to-
+   * checkpoints posting lists are derived. It is append-only, such that it
+   * can be updated incrementally while the SGCTP file is being appended.
+   * See the PROTOCOL document for the format of the index file.
+   */
+  class CFileIndex
+  {
+
+    //----------------------------------------------------------------------
+    // CONSTANTS / STATIC
+    //----------------------------------------------------------------------
+
+  public:
+    /// File format version
+    static const uint8_t FILE_VERSION = 1;
+    /// File header size ("SGCTPI", file format version, reserved)
+    static const int FILE_HEADER_SIZE = 8;
+    /// Checkpoint entry size (type, reserved, IDs quantity, offset, size, records quantity, time minimum, time maximum)
+    static const int CHECKPOINT_ENTRY_SIZE = 32;
+    /// Default quantity of records between checkpoints
+    static const int CHECKPOINT_RECORDS = 1024;
+
+    /// Entry types
+    enum EEntryType {
+      ENTRY_ID = 1,         ///< ID (dictionary entry)
+      ENTRY_CHECKPOINT = 2  ///< checkpoint
+    };
+
+    /// Checkpoint
+    struct TCheckpoint
+    {
+      /// File offset (synchronization point)
+      uint64_t ui64tOffset;
+      /// Size (from the file offset to the next synchronization point)
+      uint32_t ui32tSize;
+      /// Quantity of records
+      uint32_t ui32tRecords;
+      /// Minimum (internal integer) time (zero if some time is undefined)
+      uint32_t ui32tTimeMinimum;
+      /// Maximum (internal integer) time (overflow if some time is undefined)
+      uint32_t ui32tTimeMaximum;
+    };
+
+
+    //----------------------------------------------------------------------
+    // FIELDS
+    //----------------------------------------------------------------------
+
+  private:
+    /// IDs (indexed by ID number)
+    vector<string> sIDs_vector;
+    /// ID numbers (indexed by ID)
+    unordered_map<string,uint32_t> ui32tIDs_umap;
+    /// Checkpoints
+    vector<TCheckpoint> tCheckpoints_vector;
+    /// Checkpoints (numbers) containing each ID (indexed by ID number)
+    vector< vector<uint32_t> > ui32tPostings_vector;
+    /// Index (valid) size
+    uint64_t ui64tIndexSize;
+    /// Entries pending to be written (index update)
+    vector<unsigned char> ucEntries_vector;
+    /// Whether checkpoints have been selected (see select())
+    bool bSelection;
+    /// Selected checkpoints (numbers)
+    vector<uint32_t> ui32tSelection_vector;
+    /// Next selected checkpoint
+    size_t iSelection;
+    /// Quantity of records remaining in the current selected checkpoint
+    uint32_t ui32tSelectionRecords;
+
+
+    //----------------------------------------------------------------------
+    // CONSTRUCTORS / DESTRUCTOR
+    //----------------------------------------------------------------------
+
+  public:
+    CFileIndex()
+      : ui64tIndexSize( 0 )
+      , bSelection( false )
+      , iSelection( 0 )
+      , ui32tSelectionRecords( 0 )
+    {};
+    ~CFileIndex()
+    {};
+
+
+    //----------------------------------------------------------------------
+    // METHODS
+    //----------------------------------------------------------------------
+
+  private:
+    /// Return the number of the given ID (adding it to the dictionary if need be)
+    /**
+     *  @param[in] _pcID ID
+     *  @param[in] _bEntry Whether to add the corresponding (pending) entry, if the ID is new
+     */
+    uint32_t addID( const char *_pcID,
+                    bool _bEntry );
+    /// Add the given checkpoint (and its IDs)
+    /**
+     *  @param[in] _rtCheckpoint Checkpoint
+     *  @param[in] _rui32tIDs_vector IDs (numbers) contained in the checkpoint
+     *  @param[in] _bEntry Whether to add the corresponding (pending) entry
+     */
+    void addCheckpoint( const TCheckpoint &_rtCheckpoint,
+                        const vector<uint32_t> &_rui32tIDs_vector,
+                        bool _bEntry );
+    /// Write the pending entries to the given index file
+    /**
+     *  @return Negative error code in case of error, zero otherwise
+     */
+    int writeEntries( int _iIndexFileDescriptor );
+
+  public:
+    /// Load the given index file
+    /**
+     *  Loading stops at the first incomplete entry (e.g. index being written),
+     *  which is discarded by subsequent update().
+     *  @param[in] _iIndexFileDescriptor Index file descriptor
+     *  @return (Positive) Quantity of checkpoints loaded; Negative error code in case of error
+     */
+    int load( int _iIndexFileDescriptor );
+    /// Index the given SGCTP file, from the end of the (loaded) index, and append the corresponding entries to the given index file
+    /**
+     *  Indexing stops at the end of the SGCTP file or at its first incomplete
+     *  (or invalid) record, such that it can be resumed later on (e.g. once
+     *  more data have been appended).
+     *  @param[in] _iIndexFileDescriptor Index file descriptor (read/write)
+     *  @param[in] _iFileDescriptor SGCTP file descriptor
+     *  @param[in] _poTransmit Transmission object (used to unserialize the SGCTP file)
+     *  @param[in] _iCheckpointRecords Quantity of records between checkpoints
+     *  @return (Positive) Quantity of records indexed; Negative error code in case of error
+     */
+    int update( int _iIndexFileDescriptor,
+                int _iFileDescriptor,
+                CTransmit_File *_poTransmit,
+                int _iCheckpointRecords = CHECKPOINT_RECORDS );
+    /// Return the quantity of checkpoints
+    int getCheckpointCount() const
+    {
+      return tCheckpoints_vector.size();
+    };
+    /// Return the given checkpoint
+    const TCheckpoint& getCheckpoint( int _iCheckpoint ) const
+    {
+      return tCheckpoints_vector[_iCheckpoint];
+    };
+    /// Return the quantity of IDs
+    int getIDCount() const
+    {
+      return sIDs_vector.size();
+    };
+    /// Return the file offset up to which the SGCTP file is indexed
+    uint64_t getEndOffset() const
+    {
+      return tCheckpoints_vector.empty()
+        ? 0
+        : tCheckpoints_vector.back().ui64tOffset + tCheckpoints_vector.back().ui32tSize;
+    };
+    /// Select the checkpoints matching the given ID and (internal integer) time range
+    /**
+     *  @param[in] _pcID ID (NULL or empty string for any)
+     *  @param[in] _ui32tTimeMinimum Minimum (internal integer) time (undefined for none)
+     *  @param[in] _ui32tTimeMaximum Maximum (internal integer) time (undefined for none)
+     *  @return Quantity of selected checkpoints
+     */
+    int select( const char *_pcID,
+                uint32_t _ui32tTimeMinimum = CField::UNDEFINED_UINT32,
+                uint32_t _ui32tTimeMaximum = CField::UNDEFINED_UINT32 );
+    /// Position the given transmission object on the next record to unserialize (selected checkpoints first, then non-indexed records)
+    /**
+     *  This method MUST be called before each record unserialization; it has
+     *  no effect unless checkpoints have been selected (see select()).
+     *  @param[in] _iFileDescriptor SGCTP file descriptor
+     *  @param[in] _poTransmit Transmission object (used to unserialize the SGCTP file)
+     *  @return Negative error code in case of error, zero otherwise
+     */
+    int seek( int _iFileDescriptor,
+              CTransmit_File *_poTransmit );
+    /// Free resources (and reset the index)
+    void free();
+
+  };
+
+}
+
+#endif // SGCTP_CFILEINDEX_HPP
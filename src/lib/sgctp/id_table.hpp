@@ -0,0 +1,215 @@
+// INDENTING (emacs/vi): -*- mode:c++; tab-width:2; c-basic-offset:2; intent-tabs-mode:nil; -*- ex: set tabstop=2 expandtab:
+
+/*
+ * Simple Geolocalization and Course Transmission Protocol (SGCTP)
+ * Copyright (C) 2014 Cedric Dufour <http://cedric.dufour.name>
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * free software:
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, Version 3.
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ */
+
+#ifndef SGCTP_CIDTABLE_HPP
+#define SGCTP_CIDTABLE_HPP
+
+// C
+#include <stdint.h>
+#include <string.h>
+
+// C++
+#include <vector>
+using namespace std;
+
+
+// SGCTP namespace
+namespace SGCTP
+{
+
+  /// SGCTP ID interning table
+  /**
+   * This class maps ID strings to stable (32-bit) handles, such that IDs may
+   * be stored, queued and looked up as plain integers rather than strings.
+   * Handles are allocated sequentially (starting at zero) and remain valid
+   * until the corresponding ID is erased or the table cleared; erased handles
+   * are re-used by subsequent additions, such that handles remain lower than
+   * the peak quantity of IDs and may thus also be used as indexes.
+   * Each ID is stored along its (pre-computed) hash, which is used for look-
+   * ups and when re-hashing the table (no ID being hashed more than once).
+   * Erased IDs leave tombstones in the hash table and holes in the IDs heap,
+   * both being reclaimed once they account for too large a share of them.
+   * This class is NOT thread-safe; callers MUST serialize its access.
+   */
+  class CIDTable
+  {
+
+    //----------------------------------------------------------------------
+    // CONSTANTS / STATIC
+    //----------------------------------------------------------------------
+
+  public:
+    /// Invalid handle
+    static const uint32_t INVALID_HANDLE = 0xFFFFFFFF;
+    /// Initial hash table size (slots quantity; power of two)
+    static const uint32_t INITIAL_SLOTS = 256;
+
+  private:
+    /// Tombstone slot (erased ID)
+    static const uint32_t TOMBSTONE_SLOT = 0xFFFFFFFF;
+    /// Erased entry (IDs heap) offset
+    static const uint32_t ERASED_OFFSET = 0xFFFFFFFF;
+
+  public:
+    /// Return the hash of the given ID (FNV-1a)
+    /**
+     *  @param[in] _pcID ID
+     *  @param[in] _ui8tIDLength ID length
+     */
+    static uint32_t hash( const char *_pcID,
+                          uint8_t _ui8tIDLength );
+
+
+    //----------------------------------------------------------------------
+    // FIELDS
+    //----------------------------------------------------------------------
+
+  private:
+    /// ID entry
+    struct TEntry
+    {
+      /// ID hash
+      uint32_t ui32tHash;
+      /// ID offset (in IDs heap)
+      uint32_t ui32tOffset;
+      /// ID length
+      uint8_t ui8tLength;
+    };
+    /// ID entries (indexed by handle)
+    vector<TEntry> tEntries_vector;
+    /// Erased (free) handles
+    vector<uint32_t> ui32tFree_vector;
+    /// IDs heap (NUL-terminated strings)
+    vector<char> cIDs_vector;
+    /// IDs heap holes (erased IDs) size
+    uint32_t ui32tIDsHoles;
+    /// Hash table slots (handle+1; zero if empty; TOMBSTONE_SLOT if erased)
+    vector<uint32_t> ui32tSlots_vector;
+    /// Hash table tombstones quantity
+    uint32_t ui32tTombstones;
+
+
+    //----------------------------------------------------------------------
+    // CONSTRUCTORS / DESTRUCTOR
+    //----------------------------------------------------------------------
+
+  public:
+    CIDTable()
+    {
+      clear();
+    };
+
+
+    //----------------------------------------------------------------------
+    // METHODS
+    //----------------------------------------------------------------------
+
+  public:
+    /// Clear the table (invalidating all handles)
+    void clear();
+    /// Return the handle of the given ID, adding it to the table if need be
+    /**
+     *  WARNING: the returned handle may be that of a previously erased ID
+     *  @param[in] _pcID ID
+     *  @param[in] _ui8tIDLength ID length
+     *  @return ID handle
+     */
+    uint32_t intern( const char *_pcID,
+                     uint8_t _ui8tIDLength );
+    /// Return the handle of the given ID, adding it to the table if need be
+    uint32_t intern( const char *_pcID )
+    {
+      return intern( _pcID, strnlen( _pcID, 255 ) );
+    };
+    /// Return the handle of the given ID
+    /**
+     *  @param[in] _pcID ID
+     *  @param[in] _ui8tIDLength ID length
+     *  @return ID handle; INVALID_HANDLE if the ID is not in the table
+     */
+    uint32_t find( const char *_pcID,
+                   uint8_t _ui8tIDLength ) const;
+    /// Return the handle of the given ID
+    uint32_t find( const char *_pcID ) const
+    {
+      return find( _pcID, strnlen( _pcID, 255 ) );
+    };
+    /// Erase the ID corresponding to the given handle (releasing the handle)
+    /**
+     *  @param[in] _ui32tHandle ID handle (ignored if invalid or already erased)
+     */
+    void erase( uint32_t _ui32tHandle );
+    /// Return the ID corresponding to the given handle
+    /**
+     *  WARNING: the returned pointer is invalidated by subsequent additions or erasures
+     *  @param[in] _ui32tHandle ID handle (MUST be valid)
+     */
+    const char* getID( uint32_t _ui32tHandle ) const
+    {
+      return cIDs_vector.data() + tEntries_vector[_ui32tHandle].ui32tOffset;
+    };
+    /// Return the length of the ID corresponding to the given handle
+    uint8_t getIDLength( uint32_t _ui32tHandle ) const
+    {
+      return tEntries_vector[_ui32tHandle].ui8tLength;
+    };
+    /// Return the (pre-computed) hash of the ID corresponding to the given handle
+    uint32_t getHash( uint32_t _ui32tHandle ) const
+    {
+      return tEntries_vector[_ui32tHandle].ui32tHash;
+    };
+    /// Return whether the given handle is valid (not erased)
+    bool isValid( uint32_t _ui32tHandle ) const
+    {
+      return _ui32tHandle < tEntries_vector.size()
+        && tEntries_vector[_ui32tHandle].ui32tOffset != ERASED_OFFSET;
+    };
+    /// Return the quantity of IDs in the table
+    uint32_t getSize() const
+    {
+      return tEntries_vector.size() - ui32tFree_vector.size();
+    };
+    /// Return the handles limit (all handles being lower than that limit)
+    uint32_t getLimit() const
+    {
+      return tEntries_vector.size();
+    };
+
+  private:
+    /// Return the slot of the given ID (either matching or empty)
+    /**
+     *  @param[in] _ui32tHash ID hash
+     *  @param[in] _pcID ID
+     *  @param[in] _ui8tIDLength ID length
+     *  @param[out] _pui32tTombstone First tombstone slot encountered (if not NULL; unchanged if none)
+     */
+    uint32_t slot( uint32_t _ui32tHash,
+                   const char *_pcID,
+                   uint8_t _ui8tIDLength,
+                   uint32_t *_pui32tTombstone = NULL ) const;
+    /// Re-hash the table (dropping tombstones and growing it if need be)
+    void rehash();
+    /// Compact the IDs heap (dropping holes)
+    void compact();
+
+  };
+
+}
+
+#endif // SGCTP_CIDTABLE_HPP
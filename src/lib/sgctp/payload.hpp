@@ -32,6 +32,7 @@ namespace SGCTP
 
   // External
   class CData;
+  class CDataBlock;
 
 
   /// (Raw) SGCTP payload
@@ -48,10 +49,8 @@ namespace SGCTP
   public:
     /// Buffer size required for payload (un-)serialization
     static const uint16_t BUFFER_SIZE = 33024; // Actually, it is 32939... but let's keep a few extra bytes available
-
-  private:
-    /// Bit masks used to (un-)serialize data bit-per-bit
-    static const uint8_t BITMASK[9];
+    /// Buffer size required for each (framed) payload batch serialization
+    static const uint32_t BATCH_FRAME_SIZE = BUFFER_SIZE + 2;
 
   public:
     /// Allocate a buffer for payload (un-)serialization
@@ -64,6 +63,7 @@ namespace SGCTP
     };
     /// Zero-out a buffer required for payload (un-)serialization
     /**
+     *  NOTE: serialization does NOT require the buffer to be zeroed-out
      *  @param[in] _pucBuffer Allocated buffer
      *  @see allocBuffer()
      */
@@ -85,6 +85,10 @@ namespace SGCTP
     // FIELDS
     //----------------------------------------------------------------------
 
+  protected:
+    /// Quantity of bytes written to the export buffer (by the last serialization)
+    uint32_t ui32tBufferPutSize;
+
   private:
     /// SGCTP payload export buffer pointer
     unsigned char *pucBufferPut;
@@ -92,6 +96,14 @@ namespace SGCTP
     const unsigned char *pucBufferGet;
     /// SGCTP payload bit position
     uint32_t ui32tBufferBitOffset;
+    /// SGCTP payload byte position (next byte to write to or read from)
+    uint32_t ui32tBufferByteOffset;
+    /// SGCTP payload size (import buffer), in bytes
+    uint32_t ui32tBufferByteSize;
+    /// Bits cache (64-bit accumulator)
+    uint64_t ui64tBitCache;
+    /// Bits cache size (quantity of pending/available bits)
+    uint32_t ui32tBitCacheSize;
 
 
     //----------------------------------------------------------------------
@@ -100,6 +112,7 @@ namespace SGCTP
 
   public:
     CPayload()
+      : ui32tBufferPutSize( 0 )
     {};
     virtual ~CPayload()
     {};
@@ -110,15 +123,57 @@ namespace SGCTP
     //----------------------------------------------------------------------
 
   private:
+    /// Data fields encoder/decoder (generated from the fields schema)
+    /**
+     *  Handles fields I to N-1 (in payload order).
+     *  @see CField::FIELDS
+     */
+    template<int I, int N> struct CFieldCodec;
+    /// Content-flag groups encoder/decoder (generated from the fields schema)
+    /**
+     *  Handles groups G to N-1.
+     *  @see CField::GROUPS
+     */
+    template<int G, int N> struct CGroupCodec;
+    /// Content-shape specialized encoder/decoder (generated from the fields schema)
+    /**
+     *  Handles the fields corresponding to the content (or extended content)
+     *  flags C, all groups checks being resolved at compile time.
+     */
+    template<int C> struct CShapeCodec;
+    /// Content-shape encoders/decoders dispatch table
+    struct TShapeTable
+    {
+      /// Content fields encoders (indexed by content flags)
+      void (*pPut[256])( CPayload*, const uint32_t* );
+      /// Content fields decoders (indexed by content flags)
+      void (*pGet[256])( CPayload*, uint32_t* );
+      /// Content fields size, in bits (indexed by content flags)
+      uint16_t pui16tBits[256];
+      /// Extended content fields encoders (indexed by extended content flags)
+      void (*pPutExtended[256])( CPayload*, const uint32_t* );
+      /// Extended content fields decoders (indexed by extended content flags)
+      void (*pGetExtended[256])( CPayload*, uint32_t* );
+      /// Extended content fields size, in bits (indexed by extended content flags)
+      uint16_t pui16tBitsExtended[256];
+    };
+    /// Content-shape encoders/decoders dispatch table builder
+    /**
+     *  Builds the table for content flags 0 to N-1 (see TABLE member).
+     */
+    template<int N, int... C> struct CShapeTable;
     /// Add the given bits to the payload
     /**
-     *  @param[in] _ui8tBitsSize Data size (bits quantity)
-     *  @param[in] _ui8tBits Data (bits)
+     *  Bits are accumulated in the bits cache and written to the payload
+     *  32 bits at a time; use putBytes() to flush the bits cache.
+     *  @param[in] _ui8tBitsSize Data size (bits quantity; 1 to 32)
+     *  @param[in] _ui32tBits Data (bits)
      */
     void putBits( uint8_t _ui8tBitsSize,
-                  uint8_t _ui8tBits );
+                  uint32_t _ui32tBits );
     /// Add the given bytes to the payload
     /**
+     *  The bits cache is flushed and the payload re-aligned (zero-padded) first.
      *  @param[in] _ui16tBytesSize Data size (bytes quantity)
      *  @param[in] _pucBytes Data buffer (to read the data from)
      */
@@ -126,17 +181,35 @@ namespace SGCTP
                    const unsigned char *_pucBytes );
     /// Retrieve the given bits from the payload
     /**
-     *  @param[in] _ui8tBitsSize Data size (bits quantity)
+     *  Bits are read from the bits cache, which is refilled from the payload
+     *  64 bits at a time.
+     *  @param[in] _ui8tBitsSize Data size (bits quantity; 1 to 32)
      *  @return Data (bits)
      */
-    uint8_t getBits( uint8_t _ui8tBitsSize );
+    uint32_t getBits( uint8_t _ui8tBitsSize );
     /// Retrieve the given bytes from the payload
     /**
+     *  The payload is re-aligned (padding skipped) and the bits cache discarded first.
      *  @param[in] _ui16tBytesSize Data size (bytes quantity)
      *  @param[in] _pucBytes Data buffer (to write the data to)
      */
     void getBytes( uint16_t _ui16tBytesSize,
                    unsigned char *_pucBytes );
+    /// Reset the payload import buffer and retrieve the content flags
+    /**
+     *  @param[in] _pucBuffer Payload buffer (to read the serialization data from)
+     *  @param[in] _ui16tPayloadSize Payload size
+     *  @return Content flags
+     */
+    uint8_t getContent( const unsigned char *_pucBuffer,
+                        uint16_t _ui16tPayloadSize );
+    /// Retrieve the data fields (following the ID and data) from the payload
+    /**
+     *  @param[in] _ui8tContent Content flags
+     *  @param[out] _pui32tFields Fields (internal integer values; see CField)
+     */
+    void getFields( uint8_t _ui8tContent,
+                    uint32_t *_pui32tFields );
 
   public:
     /// Allocate resources for payload (un-)serialization
@@ -147,6 +220,14 @@ namespace SGCTP
     {
       return 0;
     };
+    /// Return the size of the payload the given SGCTP data would be serialized into
+    /**
+     *  The size is computed from the defined fields, ID and data sizes,
+     *  without actually serializing the data.
+     *  @param[in] _roData SGCTP data object
+     *  @return Payload size (as returned by serialize())
+     */
+    virtual int encodedSize( const CData &_roData ) const;
     /// Serialize the given SGCTP data into the given payload buffer
     /**
      *  @param[in] _pucBuffer Payload buffer (to write the serialization data to)
@@ -155,6 +236,25 @@ namespace SGCTP
      */
     virtual int serialize( unsigned char *_pucBuffer,
                            const CData &_roData );
+    /// Serialize the given SGCTP data (batch) into the given buffer
+    /**
+     *  Each payload is framed (prefixed) with its size (2 bytes, network order),
+     *  the same way as for transmission.
+     *  Serialization stops as soon as the remaining buffer size is smaller than
+     *  the next (framed) payload size.
+     *  @see encodedSize()
+     *  @param[in] _pucBuffer Buffer (to write the framed payloads to)
+     *  @param[in] _iBufferSize Buffer size
+     *  @param[in] _poData SGCTP data objects (array; to be serialized)
+     *  @param[in] _iDataCount Quantity of SGCTP data objects
+     *  @param[out] _piDataSerialized Quantity of SGCTP data objects actually serialized (ignored if NULL)
+     *  @return (Positive) Quantity of data actually serialized; Negative error code in case of error
+     */
+    int serializeBatch( unsigned char *_pucBuffer,
+                        int _iBufferSize,
+                        const CData *_poData,
+                        int _iDataCount,
+                        int *_piDataSerialized = NULL );
     /// Unserialize the SGCTP data from the given payload buffer
     /**
      *  @param[in] _poData SGCTP data object (to store unserialized data)
@@ -164,8 +264,66 @@ namespace SGCTP
     virtual int unserialize( CData *_poData,
                              const unsigned char *_pucBuffer,
                              uint16_t _ui16tBufferSize );
+    /// Peek at the content flags and ID of the given payload buffer, without unserializing it
+    /**
+     *  Only the payload header is parsed (no data is copied); the payload
+     *  size is checked against the size implied by the content flags.
+     *  NOTE: the ID is NOT NUL-terminated; it is valid as long as the given
+     *        payload buffer is (or, for encrypted payloads, until the next
+     *        payload is processed)
+     *  @param[in] _pucBuffer Payload buffer (to read the serialization data from)
+     *  @param[in] _ui16tBufferSize Payload size
+     *  @param[out] _pui8tContent Content flags (ignored if NULL)
+     *  @param[out] _ppcID ID string pointer (ignored if NULL)
+     *  @param[out] _pui8tIDLength ID string length (ignored if NULL)
+     *  @return (Positive) Quantity of data actually peeked at (payload size); Negative error code in case of error
+     */
+    virtual int peek( const unsigned char *_pucBuffer,
+                      uint16_t _ui16tBufferSize,
+                      uint8_t *_pui8tContent,
+                      const char **_ppcID,
+                      uint8_t *_pui8tIDLength );
+    /// Unserialize the SGCTP data from the given payload buffer and append it to the given data block
+    /**
+     *  @param[in] _poDataBlock SGCTP data block (to append unserialized data to)
+     *  @param[in] _pucBuffer Payload buffer (to read the serialization data from)
+     *  @return (Positive) Quantity of data actually unserialized; Negative error code in case of error
+     */
+    virtual int unserialize( CDataBlock *_poDataBlock,
+                             const unsigned char *_pucBuffer,
+                             uint16_t _ui16tBufferSize );
+    /// Unserialize the SGCTP data (batch) from the given buffer and append it to the given data block
+    /**
+     *  Each payload must be framed (prefixed) with its size (2 bytes, network order),
+     *  the same way as for transmission (see serializeBatch()).
+     *  Unserialization stops as soon as the data block is full or the remaining
+     *  buffer does not contain a complete (framed) payload.
+     *  @param[in] _poDataBlock SGCTP data block (to append unserialized data to)
+     *  @param[in] _pucBuffer Buffer (to read the framed payloads from)
+     *  @param[in] _iBufferSize Buffer size
+     *  @return (Positive) Quantity of data actually unserialized; Negative error code in case of error
+     */
+    int unserializeBatch( CDataBlock *_poDataBlock,
+                          const unsigned char *_pucBuffer,
+                          int _iBufferSize );
+    /// Reset the (inter-payload) state for payload (un-)serialization
+    /**
+     *  Payloads which depend on previously (un-)serialized ones (see CPayload_DELTA)
+     *  MUST be reset whenever the transmission (re-)starts (e.g. at handshake).
+     */
+    virtual void reset() {};
     /// Free resources for payload (un-)serialization
     virtual void free() {};
+    /// Return the quantity of bytes written to the payload buffer by the last serialization
+    /**
+     *  Serialization writes (and entirely overwrites) the bytes making up the
+     *  payload and nothing else; the remainder of the buffer is left untouched.
+     *  @return Quantity of bytes written (range [0,size[ of the payload buffer)
+     */
+    uint32_t getBufferPutSize() const
+    {
+      return ui32tBufferPutSize;
+    };
 
   };
 
@@ -112,6 +112,8 @@ namespace SGCTP
   public:
     virtual int alloc();
 
+    virtual int encodedSize( const CData &_roData ) const;
+
     virtual int serialize( unsigned char *_pucBuffer,
                            const CData &_roData );
 
@@ -119,6 +121,16 @@ namespace SGCTP
                              const unsigned char *_pucBuffer,
                              uint16_t _ui16tBufferSize );
 
+    virtual int peek( const unsigned char *_pucBuffer,
+                      uint16_t _ui16tBufferSize,
+                      uint8_t *_pui8tContent,
+                      const char **_ppcID,
+                      uint8_t *_pui8tIDLength );
+
+    virtual int unserialize( CDataBlock *_poDataBlock,
+                             const unsigned char *_pucBuffer,
+                             uint16_t _ui16tBufferSize );
+
     virtual void free();
 
 
@@ -126,6 +138,18 @@ namespace SGCTP
     // METHODS
     //----------------------------------------------------------------------
 
+  private:
+    /// Decrypt the given (encrypted) payload into the temporary buffer
+    /**
+     *  @param[in] _pucBuffer Payload buffer (to read the encrypted data from)
+     *  @param[in] _ui16tBufferSize Payload size
+     *  @param[out] _piPayloadSize Quantity of (encrypted) data actually processed
+     *  @return (Positive) Size of the raw payload; Negative error code in case of error
+     */
+    int decrypt( const unsigned char *_pucBuffer,
+                 uint16_t _ui16tBufferSize,
+                 int *_piPayloadSize );
+
   public:
     /// Create cryptographic key (and seal)
     /**
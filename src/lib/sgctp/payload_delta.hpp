@@ -0,0 +1,241 @@
+// INDENTING (emacs/vi): -*- mode:c++; tab-width:2; c-basic-offset:2; intent-tabs-mode:nil; -*- ex: set tabstop=2 expandtab:
+
+/*
+ * Simple Geolocalization and Course Transmission Protocol (SGCTP)
+ * Copyright (C) 2014 Cedric Dufour <http://cedric.dufour.name>
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * free software:
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, Version 3.
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ */
+
+#ifndef SGCTP_CPAYLOAD_DELTA_HPP
+#define SGCTP_CPAYLOAD_DELTA_HPP
+
+// C
+#include <errno.h>
+#include <stdint.h>
+
+// C++
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+// SGCTP
+#include "sgctp/payload.hpp"
+
+
+// SGCTP namespace
+namespace SGCTP
+{
+
+  /// Delta-encoded SGCTP payload
+  /**
+   * This class (un-)serializes SGCTP data from/to a delta-encoded SGCTP
+   * payload, where each data is encoded as the (presence-masked, zigzag/varint
+   * encoded) difference against the previous data sharing the same ID.
+   * A full (raw) SGCTP payload - keyframe - is sent for newly seen IDs and
+   * periodically thereafter.
+   * Payloads MUST be unserialized in the same order as they were serialized
+   * (no loss, no re-ordering); it is thus NOT suitable for UDP transmission.
+   * See the PROTOCOL document for the format of the delta payload.
+   */
+  class CPayload_DELTA: public CPayload
+  {
+
+    //----------------------------------------------------------------------
+    // CONSTANTS / STATIC
+    //----------------------------------------------------------------------
+
+  public:
+    /// Maximum quantity of IDs (slots) being tracked
+    static const uint16_t MAX_SLOTS = 1024;
+    /// Quantity of delta payloads after which a keyframe is forced (for each ID)
+    static const uint16_t KEYFRAME_INTERVAL = 60;
+    /// Frame flag: keyframe (raw SGCTP payload)
+    static const uint8_t FRAME_KEYFRAME = 0x80;
+    /// Frame flag: data changed (delta payload)
+    static const uint8_t FRAME_DATA = 0x40;
+
+  private:
+    /// Add the given (unsigned) integer to the given buffer (LEB128 varint)
+    /**
+     *  @param[in] _pucBuffer Buffer (to write the varint to)
+     *  @param[in] _ui32tValue Integer value
+     *  @return Quantity of bytes written
+     */
+    static inline int putVarint( unsigned char *_pucBuffer,
+                                 uint32_t _ui32tValue )
+    {
+      int __iSize = 0;
+      while( _ui32tValue >= 0x80 )
+      {
+        _pucBuffer[__iSize++] = (unsigned char)( _ui32tValue | 0x80 );
+        _ui32tValue >>= 7;
+      }
+      _pucBuffer[__iSize++] = (unsigned char)_ui32tValue;
+      return __iSize;
+    };
+    /// Retrieve an (unsigned) integer from the given buffer (LEB128 varint)
+    /**
+     *  @param[in] _pucBuffer Buffer (to read the varint from)
+     *  @param[in] _iBufferSize Buffer (remaining) size
+     *  @param[out] _pui32tValue Integer value
+     *  @return Quantity of bytes read; Negative error code in case of error
+     */
+    static inline int getVarint( const unsigned char *_pucBuffer,
+                                 int _iBufferSize,
+                                 uint32_t *_pui32tValue )
+    {
+      uint32_t __ui32tValue = 0;
+      for( int __i = 0; __i < 5 && __i < _iBufferSize; __i++ )
+      {
+        __ui32tValue |= (uint32_t)( _pucBuffer[__i] & 0x7F ) << ( 7 * __i );
+        if( !( _pucBuffer[__i] & 0x80 ) )
+        {
+          *_pui32tValue = __ui32tValue;
+          return __i+1;
+        }
+      }
+      return -EBADMSG;
+    };
+
+    //----------------------------------------------------------------------
+    // FIELDS
+    //----------------------------------------------------------------------
+
+  private:
+    /// Payload temporary import/export buffer
+    unsigned char *pucBufferTmp;
+    /// Serialization: slots (indexed by ID)
+    unordered_map<string,uint16_t> ui16tSlots_umap;
+    /// Serialization: last (serialized) data (indexed by slot)
+    vector<CData*> poData_put_vector;
+    /// Serialization: remaining delta payloads before next keyframe (indexed by slot)
+    vector<uint16_t> ui16tCountdown_vector;
+    /// Serialization: next slot to recycle (once all slots are used)
+    uint16_t ui16tSlotRecycle;
+    /// Serialization: temporary data
+    CData *poDataTmp_put;
+    /// Unserialization: last (unserialized) data (indexed by slot)
+    vector<CData*> poData_get_vector;
+    /// Unserialization: temporary data
+    CData *poDataTmp_get;
+
+
+    //----------------------------------------------------------------------
+    // CONSTRUCTORS / DESTRUCTOR
+    //----------------------------------------------------------------------
+
+  public:
+    CPayload_DELTA();
+    virtual ~CPayload_DELTA();
+
+
+    //----------------------------------------------------------------------
+    // METHODS: CPayload (implement/override)
+    //----------------------------------------------------------------------
+
+  public:
+    virtual int alloc();
+
+    virtual int encodedSize( const CData &_roData ) const;
+
+    virtual int serialize( unsigned char *_pucBuffer,
+                           const CData &_roData );
+
+    virtual int unserialize( CData *_poData,
+                             const unsigned char *_pucBuffer,
+                             uint16_t _ui16tBufferSize );
+
+    virtual int peek( const unsigned char *_pucBuffer,
+                      uint16_t _ui16tBufferSize,
+                      uint8_t *_pui8tContent,
+                      const char **_ppcID,
+                      uint8_t *_pui8tIDLength );
+
+    virtual int unserialize( CDataBlock *_poDataBlock,
+                             const unsigned char *_pucBuffer,
+                             uint16_t _ui16tBufferSize );
+
+    virtual void reset();
+
+    virtual void free();
+
+
+    //----------------------------------------------------------------------
+    // METHODS
+    //----------------------------------------------------------------------
+
+  private:
+    /// Retrieve the frame flags and slot from the given (delta) payload
+    /**
+     *  @param[in] _pucBuffer Payload buffer (to read the frame header from)
+     *  @param[in] _ui16tBufferSize Payload size
+     *  @param[out] _pui8tFlags Frame flags
+     *  @param[out] _pui16tSlot Slot
+     *  @return (Positive) Size of the frame header; Negative error code in case of error
+     */
+    int getHeader( const unsigned char *_pucBuffer,
+                   uint16_t _ui16tBufferSize,
+                   uint8_t *_pui8tFlags,
+                   uint16_t *_pui16tSlot );
+    /// Apply the given delta frame (following the frame header) to the given data
+    /**
+     *  @param[in] _pucBuffer Delta frame buffer
+     *  @param[in] _iBufferSize Delta frame size
+     *  @param[in] _ui8tFlags Frame flags
+     *  @param[in,out] _poData SGCTP data object (holding the previous data)
+     *  @return Negative error code in case of error, zero otherwise
+     */
+    int getDelta( const unsigned char *_pucBuffer,
+                  int _iBufferSize,
+                  uint8_t _ui8tFlags,
+                  CData *_poData );
+    /// Decode the given (delta) payload into a raw SGCTP payload
+    /**
+     *  The unserialization state is NOT updated (see commit()).
+     *  @param[in] _pucBuffer Payload buffer (to read the delta data from)
+     *  @param[in] _ui16tBufferSize Payload size
+     *  @param[out] _ppucPayload Raw payload pointer (valid until the next payload is processed)
+     *  @param[out] _pui8tFlags Frame flags
+     *  @param[out] _pui16tSlot Slot
+     *  @return (Positive) Size of the raw payload; Negative error code in case of error
+     */
+    int decode( const unsigned char *_pucBuffer,
+                uint16_t _ui16tBufferSize,
+                const unsigned char **_ppucPayload,
+                uint8_t *_pui8tFlags,
+                uint16_t *_pui16tSlot );
+    /// Update the unserialization state with the last decoded payload
+    /**
+     *  @param[in] _pucPayload Raw payload (as returned by decode())
+     *  @param[in] _ui16tPayloadSize Raw payload size (as returned by decode())
+     *  @param[in] _ui8tFlags Frame flags (as returned by decode())
+     *  @param[in] _ui16tSlot Slot (as returned by decode())
+     *  @return Negative error code in case of error, zero otherwise
+     */
+    int commit( const unsigned char *_pucPayload,
+                uint16_t _ui16tPayloadSize,
+                uint8_t _ui8tFlags,
+                uint16_t _ui16tSlot );
+    /// Return the (unserialization) data for the given slot, allocating it if needed
+    /**
+     *  @return Pointer to the slot data; NULL in case of error
+     */
+    CData* useSlot_get( uint16_t _ui16tSlot );
+
+  };
+
+}
+
+#endif // SGCTP_CPAYLOAD_DELTA_HPP
@@ -0,0 +1,224 @@
+// INDENTING (emacs/vi): -*- mode:c++; tab-width:2; c-basic-offset:2; intent-tabs-mode:nil; -*- ex: set tabstop=2 expandtab:
+
+/*
+ * Simple Geolocalization and Course Transmission Protocol (SGCTP)
+ * Copyright (C) 2014 Cedric Dufour <http://cedric.dufour.name>
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * free software:
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, Version 3.
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ */
+
+#ifndef SGCTP_CRING_HPP
+#define SGCTP_CRING_HPP
+
+// C
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/uio.h>
+
+
+// SGCTP namespace
+namespace SGCTP
+{
+
+  /// SGCTP asynchronous I/O ring
+  /**
+   * This class provides a minimal interface to the Linux io_uring
+   * asynchronous I/O facility, used by the asynchronous mode of file
+   * transmissions (see CTransmit_File).
+   * Operations are queued (each identified by user-defined data), submitted
+   * in groups and their completion collected one by one. Read and write
+   * operations apply at the current file offset (like read() and write()),
+   * and use registered (pre-mapped) buffers whenever possible.
+   * The ring is available only if the library was built along io_uring
+   * support AND the running kernel allows it; callers MUST fall back to
+   * POSIX (synchronous) I/O otherwise.
+   */
+  class CRing
+  {
+
+    //----------------------------------------------------------------------
+    // CONSTANTS / STATIC
+    //----------------------------------------------------------------------
+
+  public:
+    /// Default ring size (submission queue entries)
+    static const unsigned int ENTRIES = 8;
+    /// Maximum quantity of registered buffers
+    static const int MAX_BUFFERS = 2;
+
+  public:
+    /// Return whether the library was built along io_uring support
+    static bool isAvailable();
+
+
+    //----------------------------------------------------------------------
+    // FIELDS
+    //----------------------------------------------------------------------
+
+  private:
+    /// Ring file descriptor (negative if not initialized)
+    int iRingFileDescriptor;
+    /// Submission queue ring (mapping)
+    void *pSqRing;
+    /// Submission queue ring (mapping) size
+    size_t tSqRingSize;
+    /// Completion queue ring (mapping)
+    void *pCqRing;
+    /// Completion queue ring (mapping) size
+    size_t tCqRingSize;
+    /// Submission queue entries (mapping)
+    void *pSqEntries;
+    /// Submission queue entries (mapping) size
+    size_t tSqEntriesSize;
+    /// Submission queue ring: head/tail/mask/array
+    uint32_t *pui32tSqHead, *pui32tSqTail, *pui32tSqMask, *pui32tSqArray;
+    /// Completion queue ring: head/tail/mask
+    uint32_t *pui32tCqHead, *pui32tCqTail, *pui32tCqMask;
+    /// Completion queue entries
+    void *pCqEntries;
+    /// Queued (not yet submitted) entries
+    unsigned int uiQueued;
+    /// Registered buffers
+    struct iovec ptBuffers[MAX_BUFFERS];
+    /// Registered buffers quantity
+    int iBuffers;
+
+
+    //----------------------------------------------------------------------
+    // CONSTRUCTORS / DESTRUCTOR
+    //----------------------------------------------------------------------
+
+  public:
+    CRing()
+      : iRingFileDescriptor( -1 )
+      , pSqRing( NULL )
+      , tSqRingSize( 0 )
+      , pCqRing( NULL )
+      , tCqRingSize( 0 )
+      , pSqEntries( NULL )
+      , tSqEntriesSize( 0 )
+      , uiQueued( 0 )
+      , iBuffers( 0 )
+    {};
+    ~CRing()
+    {
+      free();
+    };
+
+
+    //----------------------------------------------------------------------
+    // METHODS
+    //----------------------------------------------------------------------
+
+  public:
+    /// Initialize the ring
+    /**
+     *  @param[in] _uiEntries Ring size (submission queue entries)
+     *  @return Negative error code in case of error (-ENOTSUP if io_uring is not available), zero otherwise
+     */
+    int init( unsigned int _uiEntries = ENTRIES );
+    /// Return whether the ring is initialized
+    bool isInitialized() const
+    {
+      return iRingFileDescriptor >= 0;
+    };
+    /// Free the ring (pending operations MUST have completed beforehand)
+    void free();
+    /// Register the given buffers (replacing previously registered ones)
+    /**
+     *  Registration may fail if locked memory is limited (RLIMIT_MEMLOCK),
+     *  in which case buffers may still be used (unregistered).
+     *  @param[in] _ptBuffers Buffers
+     *  @param[in] _iBuffers Buffers quantity (max. MAX_BUFFERS)
+     *  @return Negative error code in case of error, zero otherwise
+     */
+    int registerBuffers( const struct iovec *_ptBuffers,
+                         int _iBuffers );
+    /// Unregister the registered buffers (no operation may be pending on them)
+    void unregisterBuffers();
+    /// Queue a read operation (at the current file offset)
+    /**
+     *  @param[in] _iFileDescriptor File descriptor
+     *  @param[in] _pBuffer Pointer to buffer (to store read data)
+     *  @param[in] _iSize Size of data to read
+     *  @param[in] _ui64tUserData Operation user-defined data
+     *  @return Negative error code in case of error (-EBUSY if the ring is full), zero otherwise
+     */
+    int read( int _iFileDescriptor,
+              void *_pBuffer,
+              int _iSize,
+              uint64_t _ui64tUserData );
+    /// Queue a write operation (at the current file offset)
+    /**
+     *  @param[in] _iFileDescriptor File descriptor
+     *  @param[in] _pBuffer Pointer to buffer (containing data to be written)
+     *  @param[in] _iSize Size of data to write
+     *  @param[in] _ui64tUserData Operation user-defined data
+     *  @param[in] _bLink Whether the next queued operation is linked to (executed after the success of) this one
+     *  @return Negative error code in case of error (-EBUSY if the ring is full), zero otherwise
+     */
+    int write( int _iFileDescriptor,
+               const void *_pBuffer,
+               int _iSize,
+               uint64_t _ui64tUserData,
+               bool _bLink = false );
+    /// Queue a data synchronization operation (fdatasync)
+    /**
+     *  @param[in] _iFileDescriptor File descriptor
+     *  @param[in] _ui64tUserData Operation user-defined data
+     *  @return Negative error code in case of error (-EBUSY if the ring is full), zero otherwise
+     */
+    int datasync( int _iFileDescriptor,
+                  uint64_t _ui64tUserData );
+    /// Queue a cancellation operation
+    /**
+     *  @param[in] _ui64tTargetUserData User-defined data of the operation to cancel
+     *  @param[in] _ui64tUserData Operation user-defined data
+     *  @return Negative error code in case of error (-EBUSY if the ring is full), zero otherwise
+     */
+    int cancel( uint64_t _ui64tTargetUserData,
+                uint64_t _ui64tUserData );
+    /// Submit the queued operations
+    /**
+     *  @return Negative error code in case of error, zero otherwise
+     */
+    int submit();
+    /// Retrieve the next operation completion
+    /**
+     *  @param[out] _pui64tUserData Completed operation user-defined data
+     *  @param[out] _piResult Completed operation result (as per the corresponding system call; negative error code in case of error)
+     *  @param[in] _bWait Whether to wait for a completion
+     *  @return Negative error code in case of error, one if a completion was retrieved, zero otherwise
+     */
+    int complete( uint64_t *_pui64tUserData,
+                  int *_piResult,
+                  bool _bWait = true );
+
+  private:
+    /// Return the next (cleared) submission queue entry
+    /**
+     *  @return Pointer to the entry; NULL if the ring is full (or not initialized)
+     */
+    void* getEntry();
+    /// Return the index of the registered buffer containing the given data
+    /**
+     *  @return Buffer index; -1 if none
+     */
+    int getBufferIndex( const void *_pBuffer,
+                        int _iSize ) const;
+
+  };
+
+}
+
+#endif // SGCTP_CRING_HPP
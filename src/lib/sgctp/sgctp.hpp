@@ -68,6 +68,10 @@
  *     - hub2sgctp: connects to an SGCTP hub and receives SGCTP data
  *    ... for data filtering
  *     - sgctpfilter: filter SGCTP data according to specified rules
+ *     - sgctpindex: index SGCTP data, for sgctpfilter to seek directly to the relevant data
+ *    ... for data archiving and analytics
+ *     - sgctp2col: convert SGCTP data to a columnar archive
+ *     - col2sgctp: convert (and query) a columnar archive to SGCTP data
  *    ... for developers/administrators
  *     - sgctperror: explains error codes return by SGCTP utilities/library
  *
@@ -144,11 +148,18 @@ dpkg -i ../{lib,}sgctp*.deb
 
 // SGCTP
 #include "sgctp/version.hpp"
+#include "sgctp/clock.hpp"
+#include "sgctp/field.hpp"
 #include "sgctp/data.hpp"
+#include "sgctp/data_block.hpp"
 #include "sgctp/payload.hpp"
 #include "sgctp/principal.hpp"
 #include "sgctp/transmit_udp.hpp"
 #include "sgctp/transmit_tcp.hpp"
 #include "sgctp/transmit_file.hpp"
+#include "sgctp/file_index.hpp"
+#include "sgctp/id_table.hpp"
+#include "sgctp/columnar_reader.hpp"
+#include "sgctp/columnar_writer.hpp"
 
 #endif // SGCTP_HPP
@@ -23,6 +23,7 @@
 // C
 #include <stdint.h>
 #include <string.h>
+#include <sys/uio.h>
 
 // SGCTP
 #include "sgctp/parameters.hpp"
@@ -34,6 +35,7 @@ namespace SGCTP
 
   // External
   class CData;
+  class CDataBlock;
   class CPayload;
 
   /// Generic transmission of SGCTP payload
@@ -53,6 +55,10 @@ namespace SGCTP
   public:
     /// Protocol version
     static const uint8_t PROTOCOL_VERSION = 1;
+    /// Batch (serialization) buffer size
+    static const int BATCH_BUFFER_SIZE = 262144;
+    /// Multi-record frame header size (records quantity + frame content size)
+    static const int FRAME_HEADER_SIZE = 4;
 
     /// Transmission types
     enum ETransmitType {
@@ -66,6 +72,7 @@ namespace SGCTP
     enum EPayloadType {
       PAYLOAD_RAW = 0,         ///< raw payload
       PAYLOAD_AES128 = 1,      ///< AES128-encrypted payload
+      PAYLOAD_DELTA = 2,       ///< delta-encoded payload
       PAYLOAD_UNDEFINED = 255  ///< undefined
     };
 
@@ -83,6 +90,14 @@ namespace SGCTP
     int iBufferDataStart;
     /// Transmission buffer actual data end offset
     int iBufferDataEnd;
+    /// Batch (serialization) buffer
+    unsigned char *pucBatchBuffer;
+    /// Batch (serialization) buffer actual data size
+    int iBatchSize;
+    /// Batch (serialization) buffer open frame start offset (negative if none)
+    int iBatchFrameStart;
+    /// Quantity of records in the open frame
+    int iBatchFrameRecords;
 
     /// Transmission timeout, in seconds
     double fdTimeout;
@@ -92,6 +107,13 @@ namespace SGCTP
     /// Associated payload type
     EPayloadType ePayloadType;
 
+    /// Multi-record frames (framed mode)
+    bool bFramed;
+    /// Quantity of records remaining in the current (received) frame
+    int iFrameRecords;
+    /// Quantity of bytes remaining in the current (received) frame
+    int iFrameBytes;
+
 
     //----------------------------------------------------------------------
     // CONSTRUCTORS / DESTRUCTOR
@@ -118,8 +140,8 @@ namespace SGCTP
      *  @param[in] _iSize Size of data to receive
      *  @return (Positive) Quantity of data actually received; Negative error code in case of error
      */
-    int recvBuffer( int _iDescriptor,
-                    int _iSize );
+    virtual int recvBuffer( int _iDescriptor,
+                            int _iSize );
     /// Pull data from the transmission buffer
     /**
      *  @param[in] _iSize Size of data to pull
@@ -130,6 +152,48 @@ namespace SGCTP
     void flushBuffer();
     /// Reset the data buffer (clear all data)
     void resetBuffer();
+    /// Send the batch (serialization) buffer content to the given descriptor (retrying interrupted/partial sends)
+    /**
+     *  The batch buffer is cleared once its content has been entirely sent.
+     *  In case of error, the unsent data are kept (at the start of) the batch
+     *  buffer, such that they are sent first on retry.
+     *  @param[in] _iDescriptor File/socket/... descriptor
+     *  @return (Positive) Quantity of data actually sent; Negative error code in case of error
+     */
+    int sendBatchBuffer( int _iDescriptor );
+    /// Create the given SGCTP data payload in the batch buffer (sending the latter whenever full)
+    /**
+     *  @param[in] _iDescriptor File/socket/... descriptor
+     *  @param[in] _roData SGCTP data object (to be serialized)
+     *  @return (Positive) Quantity of data added to the batch buffer (payload and framing); Negative error code in case of error
+     */
+    int batchPayload( int _iDescriptor,
+                      const CData &_roData );
+    /// Close the open frame (writing its header in the batch buffer)
+    void closeBatchFrame();
+    /// Send the batch buffer content (closing the open frame, if any) and clear it
+    /**
+     *  @param[in] _iDescriptor File/socket/... descriptor
+     *  @return (Positive) Quantity of data actually sent (zero if none); Negative error code in case of error (unsent data being kept; see sendBatchBuffer())
+     */
+    int sendBatch( int _iDescriptor );
+    /// Discard the batch buffer content (pending payloads and open frame)
+    void resetBatch();
+    /// Receive the next (size-prefixed) payload from the given descriptor
+    /**
+     *  In framed mode, the entire multi-record frame is received along its
+     *  first payload. The payload is left in the transmission buffer (to be
+     *  pulled by the caller).
+     *  @param[in] _iDescriptor File/socket/... descriptor
+     *  @param[in] _iMaxSize Maximum size of expected data (0 = no limit)
+     *  @param[in] _bBlocking Whether to wait for data; otherwise, only consider data already available in the transmission buffer
+     *  @param[out] _piReceivedSize Quantity of data actually received (payload and framing)
+     *  @return (Positive) Payload size; zero if no (entire) payload is available; Negative error code in case of error
+     */
+    int recvPayload( int _iDescriptor,
+                     int _iMaxSize,
+                     bool _bBlocking,
+                     int *_piReceivedSize );
 
   public:
     /// Set the transmission (send/receive) timeout, in seconds
@@ -147,6 +211,20 @@ namespace SGCTP
     {
       return iBufferDataEnd > iBufferDataStart;
     };
+    /// Enable/disable multi-record frames (framed mode)
+    /**
+     *  In framed mode, payloads are sent/received within frames, where a
+     *  single frame header precedes several (size-prefixed) payloads (see
+     *  the PROTOCOL document). It is not available for UDP transmission.
+     *  @param[in] _bFramed Framed mode
+     *  @return Negative error code in case of error, zero otherwise
+     */
+    int setFramed( bool _bFramed );
+    /// Return whether multi-record frames (framed mode) are used
+    bool isFramed() const
+    {
+      return bFramed;
+    };
 
   protected:
     /// Receive data from the given descriptor
@@ -173,6 +251,30 @@ namespace SGCTP
                       const void *_pBuffer,
                       int _iSize,
                       int _iFlags ) = 0;
+    /// Send data - gathered from the given buffers - to the given descriptor (at once)
+    /**
+     *  The default implementation sends each buffer in turn (with MSG_MORE
+     *  set for all but the last one).
+     *  @param[in] _iDescriptor File/socket/... descriptor
+     *  @param[in] _ptIovec Buffers (containing data to be sent)
+     *  @param[in] _iIovecCount Buffers quantity
+     *  @param[in] _iFlags Descriptor-specific control flags
+     *  @return (Positive) Quantity of data actually sent; Negative error code in case of error
+     */
+    virtual int sendv( int _iDescriptor,
+                       const struct iovec *_ptIovec,
+                       int _iIovecCount,
+                       int _iFlags );
+
+    /// Prepare the associated payload object for the next payload
+    /**
+     *  This method is called after each successful payload (un-)serialization.
+     *  @return Negative error code in case of error, zero otherwise
+     */
+    virtual int nextPayload()
+    {
+      return 0;
+    };
 
   public:
     /// Return the transmission type
@@ -209,14 +311,49 @@ namespace SGCTP
     virtual int alloc() = 0;
     /// Serialize the given SGCTP data to the given descriptor
     /**
+     *  In framed mode, payloads are coalesced in pending multi-record frames,
+     *  which are sent as soon as the batch buffer is full or flushFrames() is
+     *  called; the caller MUST thus call flushFrames() whenever the data must
+     *  actually be sent
+     *  (typically, when no more data are immediately available for
+     *  serialization, and before closing the descriptor).
      *  @param[in] _iDescriptor File/socket/... descriptor
      *  @param[in] _roData SGCTP data object (to be serialized/sent)
-     *  @return (Positive) Quantity of data actually serialized/sent; Negative error code in case of error
+     *  @return (Positive) Quantity of data actually serialized/sent (payload and framing, including the header of any frame it opened); Negative error code in case of error
      */
     virtual int serialize( int _iDescriptor,
                            const CData &_roData );
+    /// Serialize the given SGCTP data (batch) to the given descriptor
+    /**
+     *  Payloads are framed (size-prefixed) into a single batch buffer, which
+     *  is sent at once (whenever full and at the end of the batch, along any
+     *  payloads still pending from previous serializations).
+     *  In framed mode, payloads are further grouped into multi-record frames,
+     *  each no larger than CPayload::BUFFER_SIZE. In case of send error, the
+     *  batched payloads are kept and sent on retry (see flushFrames()).
+     *  @param[in] _iDescriptor File/socket/... descriptor
+     *  @param[in] _poData SGCTP data objects (array; to be serialized/sent)
+     *  @param[in] _iDataCount Quantity of SGCTP data objects
+     *  @return (Positive) Quantity of data actually serialized/sent for the given objects (payloads and framing); Negative error code in case of error
+     */
+    virtual int serializeBatch( int _iDescriptor,
+                                const CData *_poData,
+                                int _iDataCount );
+    /// Send the pending multi-record frames (framed mode; see serialize())
+    /**
+     *  In case of (e.g. transient) send error, the unsent data are kept and
+     *  sent first by the next serialization or flushFrames() call, which
+     *  SHOULD thus be used to retry sending them (rather than serializing
+     *  the same data again).
+     *  @param[in] _iDescriptor File/socket/... descriptor
+     *  @return (Positive) Quantity of data actually sent; Negative error code in case of error
+     */
+    int flushFrames( int _iDescriptor );
     /// Unserialize the SGCTP data from the given descriptor
     /**
+     *  In framed mode, the entire frame is received along its first payload
+     *  and the subsequent payloads are unserialized from the transmission
+     *  buffer (see hasData()).
      *  @param[in] _iDescriptor File/socket/... descriptor
      *  @param[in] _poData SGCTP data object (to store unserialized/received data)
      *  @param[in] _iMaxSize Maximum size of expected data (0 = no limit)
@@ -225,7 +362,41 @@ namespace SGCTP
     virtual int unserialize( int _iDescriptor,
                              CData *_poData,
                              int _iMaxSize = 0 );
+    /// Unserialize the SGCTP data (batch) from the given descriptor and append it to the given data block
+    /**
+     *  The first payload is received as per unserialize(); the subsequent
+     *  payloads are then unserialized only as long as they are already
+     *  (entirely) available in the transmission buffer and the data block is
+     *  not full (in other words, this method blocks no more than unserialize()).
+     *  @param[in] _iDescriptor File/socket/... descriptor
+     *  @param[in] _poDataBlock SGCTP data block (to append unserialized/received data to)
+     *  @param[in] _iMaxSize Maximum size of expected data, per payload (0 = no limit)
+     *  @return (Positive) Quantity of data actually unserialized/received; Negative error code in case of error
+     */
+    virtual int unserializeBatch( int _iDescriptor,
+                                  CDataBlock *_poDataBlock,
+                                  int _iMaxSize = 0 );
+    /// Unserialize the SGCTP data from the given descriptor, without blocking
+    /**
+     *  The data available from the descriptor are received without waiting
+     *  (MSG_DONTWAIT); an incomplete payload (or frame) is kept in the
+     *  transmission buffer and completed by subsequent calls. This method
+     *  may thus be used along event loops (select/poll/epoll) without any
+     *  transmission timeout, in which case it should be called until it
+     *  returns -EAGAIN. It may be mixed with unserialize().
+     *  @param[in] _iDescriptor File/socket/... descriptor
+     *  @param[out] _poData SGCTP data object (to store unserialized/received data)
+     *  @param[in] _iMaxSize Maximum size of expected data (0 = no limit)
+     *  @return (Positive) Quantity of data actually unserialized/received; zero at end of file (connection closed); Negative error code in case of error (-EAGAIN if no entire payload is available yet)
+     */
+    virtual int tryUnserialize( int _iDescriptor,
+                                CData *_poData,
+                                int _iMaxSize = 0 );
     /// Free resources required for data transmission (un-/serialization)
+    /**
+     *  NOTE: pending multi-record frames are discarded; the caller MUST call
+     *        flushFrames() beforehand (see serialize()).
+     */
     virtual void free();
 
   };
@@ -20,7 +20,17 @@
 #ifndef SGCTP_CTRANSMIT_FILE_HPP
 #define SGCTP_CTRANSMIT_FILE_HPP
 
+// C
+#include <errno.h>
+#include <stdint.h>
+
+// C++
+#include <vector>
+using namespace std;
+
 // SGCTP
+#include "sgctp/compressor.hpp"
+#include "sgctp/ring.hpp"
 #include "sgctp/transmit.hpp"
 
 
@@ -31,10 +41,159 @@ namespace SGCTP
   /// Save/load SGCTP payload to/from a file
   /**
    * This class allows to save/load a SGCTP payload to/from a file.
+   * In framed mode (see setFramed()), a file header is written first, which
+   * marks the file as containing multi-record frames; when loading, framed
+   * mode is set according to the presence of this header.
+   * In compressed mode (see setCompression()), the file content (following
+   * the file header) is stored as a sequence of independently compressed
+   * blocks, followed by a block index (see finish()); when loading, compressed
+   * blocks are detected and decompressed transparently.
+   * Unserialization may be resumed at any synchronization point - payload,
+   * frame or compressed block boundary - using tell() and seek(), unless
+   * payloads depend on each other (delta payload).
+   * In buffered output mode (see setOutputBuffer()), written data are
+   * combined in an output buffer and written in larger chunks (and
+   * optionally synchronized to disk as a group).
+   * In memory-mapped mode (see setMapped()), (regular) files are unserialized
+   * directly from a sliding read-only mapping of their content, without
+   * intermediate copies.
+   * In asynchronous mode (see setAsync()), file I/O is performed through an
+   * io_uring ring: data are read ahead while previously read data are being
+   * unserialized, and output buffer writes (see setOutputBuffer()) proceed
+   * while the next output buffer is being filled.
    */
   class CTransmit_File: public CTransmit
   {
 
+    //----------------------------------------------------------------------
+    // CONSTANTS / STATIC
+    //----------------------------------------------------------------------
+
+  public:
+    /// File header size ("SGCTP", protocol version, flags)
+    static const int FILE_HEADER_SIZE = 7;
+    /// File header flag: multi-record frames (framed mode)
+    static const uint8_t FILE_FLAG_FRAMED = 0x01;
+    /// File header flag: compressed blocks (compressed mode)
+    static const uint8_t FILE_FLAG_COMPRESSED = 0x02;
+    /// Block header size (type, compression type, reserved, compressed size, uncompressed size)
+    static const int BLOCK_HEADER_SIZE = 12;
+    /// Block (uncompressed) size, above which a block is compressed and written
+    static const int BLOCK_SIZE = 65536;
+    /// Block (uncompressed) buffer size (block size plus one entire batch)
+    static const int BLOCK_BUFFER_SIZE = BLOCK_SIZE + BATCH_BUFFER_SIZE;
+    /// Block index entry size (block offset, compressed size, uncompressed size)
+    static const int BLOCK_INDEX_ENTRY_SIZE = 16;
+    /// File mapping (window) size (memory-mapped mode)
+    static const int MAPPING_SIZE = 67108864;
+    /// Read-ahead buffer (half) size (asynchronous mode)
+    static const int READ_AHEAD_SIZE = 262144;
+
+    /// Block types
+    enum EBlockType {
+      BLOCK_DATA = 1,   ///< (compressed) data block
+      BLOCK_INDEX = 2   ///< block index
+    };
+
+  private:
+    /// Asynchronous operations (ring user-defined data)
+    enum EAsyncOperation {
+      ASYNC_READ = 1,    ///< read (ahead)
+      ASYNC_WRITE = 2,   ///< (output buffer) write
+      ASYNC_SYNC = 3,    ///< (output buffer) data synchronization
+      ASYNC_CANCEL = 4   ///< (read ahead) cancellation
+    };
+
+
+    //----------------------------------------------------------------------
+    // FIELDS
+    //----------------------------------------------------------------------
+
+  private:
+    /// Whether the file header has been sent (serialization)
+    bool bFileHeaderSent;
+    /// Whether the file header has been received (unserialization)
+    bool bFileHeaderReceived;
+    /// Received file header size (zero if none)
+    int iFileHeaderSize;
+
+    /// Compression type (serialization)
+    uint8_t ui8tCompressionType;
+    /// Whether the file content is compressed (unserialization)
+    bool bCompressed;
+    /// Block (uncompressed data) buffer
+    unsigned char *pucBlockBuffer;
+    /// Block buffer actual data start offset (unserialization)
+    int iBlockDataStart;
+    /// Block buffer actual data end offset
+    int iBlockDataEnd;
+    /// Compressed block buffer
+    unsigned char *pucBlockBufferCompressed;
+    /// Current file offset (actually written or read)
+    uint64_t ui64tFileOffset;
+    /// Block index (serialized entries)
+    vector<unsigned char> ucBlockIndex_vector;
+    /// Whether the block index has been sent (serialization)
+    bool bBlockIndexSent;
+
+    /// Output buffer size (serialization; zero if unbuffered)
+    int iOutputBufferSize;
+    /// Output buffer maximum delay, in seconds (zero if none)
+    double fdOutputBufferDelay;
+    /// Whether to synchronize data to disk after each output buffer write
+    bool bOutputBufferSync;
+    /// Output buffer
+    unsigned char *pucOutputBuffer;
+    /// Output buffer actual data end offset
+    int iOutputDataEnd;
+    /// Output buffer (first) data timestamp (UNIX epoch)
+    double fdOutputDataTime;
+
+    /// Whether the file is memory-mapped (unserialization)
+    bool bMapped;
+    /// File mapping (window) pointer
+    unsigned char *pucMapping;
+    /// File mapping (window) size
+    int iMappingSize;
+    /// File mapping (window) offset
+    uint64_t ui64tMappingOffset;
+    /// File size (as of the last mapping)
+    uint64_t ui64tFileSize;
+
+    /// Whether asynchronous (io_uring) I/O is enabled
+    bool bAsync;
+    /// Asynchronous I/O ring
+    CRing oRing;
+    /// Read-ahead buffer (two halves, alternately being read and consumed)
+    unsigned char *pucReadAheadBuffer;
+    /// Read-ahead buffer current (consumed) half
+    int iReadAheadHalf;
+    /// Read-ahead buffer actual data start offset (within the current half)
+    int iReadAheadDataStart;
+    /// Read-ahead buffer actual data end offset (within the current half)
+    int iReadAheadDataEnd;
+    /// Whether a read (ahead) is pending
+    bool bAsyncReadPending;
+    /// Last completed read (ahead) result
+    int iAsyncReadResult;
+    /// Whether a read (ahead) cancellation is pending
+    bool bAsyncCancelPending;
+    /// Output buffer being written (asynchronous mode)
+    unsigned char *pucOutputBufferPending;
+    /// Whether an output buffer write is pending
+    bool bAsyncWritePending;
+    /// Last completed output buffer write result
+    int iAsyncWriteResult;
+    /// Whether an output buffer data synchronization is pending
+    bool bAsyncSyncPending;
+    /// Last completed output buffer data synchronization result
+    int iAsyncSyncResult;
+    /// Output buffer being written: actually written data end offset
+    int iAsyncWriteStart;
+    /// Output buffer being written: data size
+    int iAsyncWriteSize;
+
+
     //----------------------------------------------------------------------
     // CONSTRUCTORS / DESTRUCTOR
     //----------------------------------------------------------------------
@@ -42,9 +201,53 @@ namespace SGCTP
   public:
     CTransmit_File()
       : CTransmit()
+      , bFileHeaderSent( false )
+      , bFileHeaderReceived( false )
+      , iFileHeaderSize( 0 )
+      , ui8tCompressionType( CCompressor::COMPRESSION_NONE )
+      , bCompressed( false )
+      , pucBlockBuffer( NULL )
+      , iBlockDataStart( 0 )
+      , iBlockDataEnd( 0 )
+      , pucBlockBufferCompressed( NULL )
+      , ui64tFileOffset( 0 )
+      , bBlockIndexSent( false )
+      , iOutputBufferSize( 0 )
+      , fdOutputBufferDelay( 0.0 )
+      , bOutputBufferSync( false )
+      , pucOutputBuffer( NULL )
+      , iOutputDataEnd( 0 )
+      , fdOutputDataTime( 0.0 )
+      , bMapped( false )
+      , pucMapping( NULL )
+      , iMappingSize( 0 )
+      , ui64tMappingOffset( 0 )
+      , ui64tFileSize( 0 )
+      , bAsync( false )
+      , pucReadAheadBuffer( NULL )
+      , iReadAheadHalf( 0 )
+      , iReadAheadDataStart( 0 )
+      , iReadAheadDataEnd( 0 )
+      , bAsyncReadPending( false )
+      , iAsyncReadResult( 0 )
+      , bAsyncCancelPending( false )
+      , pucOutputBufferPending( NULL )
+      , bAsyncWritePending( false )
+      , iAsyncWriteResult( 0 )
+      , bAsyncSyncPending( false )
+      , iAsyncSyncResult( 0 )
+      , iAsyncWriteStart( 0 )
+      , iAsyncWriteSize( 0 )
     {};
     virtual ~CTransmit_File()
-    {};
+    {
+      if( bMapped )
+        pucBuffer = NULL;
+      unmapFile();
+      freeBlock();
+      freeAsync();
+      freeOutputBuffer();
+    };
 
 
     //----------------------------------------------------------------------
@@ -57,11 +260,19 @@ namespace SGCTP
                       int _iSize,
                       int _iFlags );
 
+    virtual int sendv( int _iFileDescriptor,
+                       const struct iovec *_ptIovec,
+                       int _iIovecCount,
+                       int _iFlags );
+
     virtual int recv( int _iFileDescriptor,
                       void *_pBuffer,
                       int _iSize,
                       int _iFlags );
 
+    virtual int recvBuffer( int _iFileDescriptor,
+                            int _iSize );
+
   public:
     virtual ETransmitType getTransmitType()
     {
@@ -70,6 +281,283 @@ namespace SGCTP
 
     virtual int alloc();
 
+    virtual int serialize( int _iFileDescriptor,
+                           const CData &_roData );
+
+    virtual int serializeBatch( int _iFileDescriptor,
+                                const CData *_poData,
+                                int _iDataCount );
+
+    virtual int unserialize( int _iFileDescriptor,
+                             CData *_poData,
+                             int _iMaxSize = 0 );
+
+    virtual int unserializeBatch( int _iFileDescriptor,
+                                  CDataBlock *_poDataBlock,
+                                  int _iMaxSize = 0 );
+
+    /// Unserialize the SGCTP data from the given file, without blocking
+    /**
+     *  NOTE: not supported for files; reads from regular files never block
+     *        (-EAGAIN being meaningless) and silently falling back to
+     *        unserialize() would hide blocking reads from pipes/FIFOs
+     *        (standard input) from callers relying on non-blocking semantics.
+     *        Use unserialize() (or unserializeBatch()) instead.
+     *  @return Negative error code (-ENOTSUP)
+     */
+    virtual int tryUnserialize( int /*_iFileDescriptor*/,
+                                CData */*_poData*/,
+                                int /*_iMaxSize*/ = 0 )
+    {
+      return -ENOTSUP;
+    };
+
+    virtual void free();
+
+
+    //----------------------------------------------------------------------
+    // METHODS
+    //----------------------------------------------------------------------
+
+  public:
+    /// Enable/disable compressed mode (serialization)
+    /**
+     *  In compressed mode, serialized data are buffered and written in
+     *  compressed blocks, each block being written as soon as its
+     *  uncompressed size exceeds BLOCK_SIZE. The pending block and the
+     *  block index MUST be written - using finish() - before the file is
+     *  closed. This method MUST be called before the first serialization.
+     *  @param[in] _ui8tCompressionType Compression type (code; see CCompressor::ECompressionType)
+     *  @return Negative error code in case of error, zero otherwise
+     */
+    int setCompression( uint8_t _ui8tCompressionType );
+    /// Return the compression type (serialization)
+    uint8_t getCompressionType() const
+    {
+      return ui8tCompressionType;
+    };
+    /// Return whether the file content is compressed (unserialization)
+    bool isCompressed() const
+    {
+      return bCompressed;
+    };
+    /// Enable/disable buffered output mode (serialization)
+    /**
+     *  In buffered output mode, written data are combined in an output
+     *  buffer of the given size, which is written as soon as it is full
+     *  or - if a maximum delay is given - as soon as its first data are
+     *  older than that delay (checked on each write). The buffer content
+     *  MUST be written - using flush() - before the file is closed.
+     *  This method MUST be called before the first serialization.
+     *  @param[in] _iSize Output buffer size (zero to disable buffered output)
+     *  @param[in] _fdDelay Maximum delay, in seconds, before buffered data are written (zero for none)
+     *  @param[in] _bSync Whether to synchronize data to disk (fdatasync) after each output buffer write
+     *  @return Negative error code in case of error, zero otherwise
+     */
+    int setOutputBuffer( int _iSize,
+                         double _fdDelay = 0.0,
+                         bool _bSync = false );
+    /// Return the output buffer size (serialization; zero if unbuffered)
+    int getOutputBufferSize() const
+    {
+      return iOutputBufferSize;
+    };
+    /// Write the pending frames (see flushFrames()), the pending (compressed) block and the output buffer content
+    /**
+     *  This method may be called several times (and serialization resumed
+     *  afterwards). It does NOT write the block index (see finish()).
+     *  @param[in] _iFileDescriptor File descriptor
+     *  @return (Positive) Quantity of data actually written; Negative error code in case of error
+     */
+    int flush( int _iFileDescriptor );
+    /// Write all pending data (see flush()) and the block index (compressed mode), before the file is closed
+    /**
+     *  The block index covers all the blocks written and is written only
+     *  once, such that no data may be serialized after this method has been
+     *  called (until free() is called).
+     *  @param[in] _iFileDescriptor File descriptor
+     *  @return (Positive) Quantity of data actually written; Negative error code in case of error
+     */
+    int finish( int _iFileDescriptor );
+    /// Return the file offset of the next payload, if unserialization can be resumed from it (unserialization)
+    /**
+     *  The returned offset may be used with seek() to resume unserialization
+     *  at the same point later on (or by another transmission object).
+     *  @return File offset; Negative error code (-EAGAIN) if not at a synchronization point (within a frame or compressed block)
+     */
+    int64_t tell() const;
+    /// Resume unserialization at the given file offset (synchronization point; see tell())
+    /**
+     *  The file header is (re-)read first if need be, such that the file
+     *  descriptor MUST be seekable.
+     *  @param[in] _iFileDescriptor File descriptor
+     *  @param[in] _ui64tOffset File offset (synchronization point)
+     *  @return Negative error code in case of error (-ENOTSUP for delta payload), zero otherwise
+     */
+    int seek( int _iFileDescriptor,
+              uint64_t _ui64tOffset );
+    /// Enable/disable memory-mapped mode (unserialization)
+    /**
+     *  In memory-mapped mode, the file is mapped (read-only) in windows of
+     *  MAPPING_SIZE bytes, and payloads are unserialized directly from the
+     *  mapping (compressed blocks being decompressed from it). Non-regular
+     *  files (pipes, etc.) are transparently read in normal mode. This
+     *  method MUST be called before the first unserialization; serialization
+     *  is not possible in this mode.
+     *  @param[in] _bMapped Memory-mapped mode
+     */
+    void setMapped( bool _bMapped );
+    /// Return whether memory-mapped mode is enabled (unserialization)
+    bool isMapped() const
+    {
+      return bMapped;
+    };
+    /// Enable/disable asynchronous (io_uring) mode
+    /**
+     *  In asynchronous mode, file data are read ahead (in READ_AHEAD_SIZE
+     *  chunks) while previously read data are being unserialized, and
+     *  output buffer writes (see setOutputBuffer()) are queued - along the
+     *  data synchronization linked to them, if any - while the next output
+     *  buffer is being filled. Files are read and written at their current
+     *  offset, such that any file descriptor may be used. This method MUST
+     *  be called before the first (un)serialization.
+     *  @param[in] _bAsync Asynchronous mode
+     *  @return Negative error code in case of error (-ENOTSUP if io_uring is not available, in which case POSIX I/O is used), zero otherwise
+     */
+    int setAsync( bool _bAsync );
+    /// Return whether asynchronous mode is enabled
+    bool isAsync() const
+    {
+      return bAsync;
+    };
+
+  private:
+    /// Write the given data to the given file (entirely; bypassing compression, but buffered in buffered output mode)
+    /**
+     *  @param[in] _iFileDescriptor File descriptor
+     *  @param[in] _pBuffer Pointer to buffer (containing data to be written)
+     *  @param[in] _iSize Size of data to write
+     *  @return (Positive) Quantity of data actually written; Negative error code in case of error
+     */
+    int writeFile( int _iFileDescriptor,
+                   const void *_pBuffer,
+                   int _iSize );
+    /// Write the output buffer content to the given file (entirely)
+    /**
+     *  @param[in] _iFileDescriptor File descriptor
+     *  @return (Positive) Quantity of data actually written; Negative error code in case of error
+     */
+    int writeOutputBuffer( int _iFileDescriptor );
+    /// Free the output buffer (discarding its content)
+    void freeOutputBuffer();
+    /// Read (at most) the given quantity of data from the given file (like read(); from the read-ahead buffer in asynchronous mode)
+    /**
+     *  @param[in] _iFileDescriptor File descriptor
+     *  @param[in] _pBuffer Pointer to buffer (to store read data)
+     *  @param[in] _iSize Maximum size of data to read
+     *  @return (Positive) Quantity of data actually read; zero at end of file; Negative error code in case of error
+     */
+    int readChunk( int _iFileDescriptor,
+                   void *_pBuffer,
+                   int _iSize );
+    /// Queue (and submit) a read (ahead) into the read-ahead buffer half not being consumed (asynchronous mode)
+    /**
+     *  @param[in] _iFileDescriptor File descriptor
+     *  @return Negative error code in case of error, zero otherwise
+     */
+    int queueReadAhead( int _iFileDescriptor );
+    /// Retrieve the next asynchronous operation completion (and update the corresponding status)
+    /**
+     *  @param[in] _bWait Whether to wait for a completion
+     *  @return Negative error code in case of error, one if a completion was retrieved, zero otherwise
+     */
+    int completeAsync( bool _bWait );
+    /// Wait for the pending output buffer write to complete (writing its remainder synchronously, if need be)
+    /**
+     *  @param[in] _iFileDescriptor File descriptor
+     *  @return Negative error code in case of error, zero otherwise
+     */
+    int waitAsyncWrite( int _iFileDescriptor );
+    /// Cancel the pending read (ahead) and wait for all pending asynchronous operations to complete (discarding their result)
+    void drainAsync();
+    /// Free the read-ahead buffer (and reset the asynchronous read state)
+    void freeAsync();
+    /// Read the given quantity of data from the given file (entirely; bypassing compression)
+    /**
+     *  @param[in] _iFileDescriptor File descriptor
+     *  @param[in] _pBuffer Pointer to buffer (to store read data)
+     *  @param[in] _iSize Size of data to read
+     *  @return (Positive) Quantity of data actually read (less than requested only at end of file); Negative error code in case of error
+     */
+    int readFile( int _iFileDescriptor,
+                  void *_pBuffer,
+                  int _iSize );
+    /// Return a pointer to the given quantity of data from the given file, at the current offset (bypassing compression)
+    /**
+     *  In memory-mapped mode, the returned pointer points directly to the
+     *  file mapping; otherwise, data are read into the given buffer.
+     *  @param[in] _iFileDescriptor File descriptor
+     *  @param[in] _pBuffer Pointer to buffer (to store read data, if need be)
+     *  @param[in] _iSize Size of data to read
+     *  @param[out] _ppucData Pointer to the data
+     *  @return (Positive) Quantity of data actually available (less than requested only at end of file); Negative error code in case of error
+     */
+    int pullFile( int _iFileDescriptor,
+                  void *_pBuffer,
+                  int _iSize,
+                  const unsigned char **_ppucData );
+    /// (Re-)Map the given file such that the mapping (window) includes the given data
+    /**
+     *  @param[in] _iFileDescriptor File descriptor
+     *  @param[in] _ui64tOffset File offset of the data
+     *  @param[in] _iSize Size of the data
+     *  @param[out] _ppucData Pointer to the data (within the mapping)
+     *  @return (Positive) Quantity of data available from the given offset (less than requested only at end of file); Negative error code in case of error (-ENODEV for non-regular files)
+     */
+    int mapFile( int _iFileDescriptor,
+                 uint64_t _ui64tOffset,
+                 int _iSize,
+                 const unsigned char **_ppucData );
+    /// Unmap the file (mapping window)
+    void unmapFile();
+    /// Allocate the block buffers
+    /**
+     *  @return Negative error code in case of error, zero otherwise
+     */
+    int allocBlock();
+    /// Free the block buffers (and reset the blocks state)
+    void freeBlock();
+    /// Compress and write the pending block (if any)
+    /**
+     *  @param[in] _iFileDescriptor File descriptor
+     *  @return (Positive) Quantity of data actually written; Negative error code in case of error
+     */
+    int sendBlock( int _iFileDescriptor );
+    /// Write the block index (header, entries and footer)
+    /**
+     *  @param[in] _iFileDescriptor File descriptor
+     *  @return (Positive) Quantity of data actually written; Negative error code in case of error
+     */
+    int sendBlockIndex( int _iFileDescriptor );
+    /// Read and decompress the next (data) block
+    /**
+     *  @param[in] _iFileDescriptor File descriptor
+     *  @return (Positive) Quantity of data actually decompressed; zero at end of file; Negative error code in case of error
+     */
+    int recvBlock( int _iFileDescriptor );
+    /// Send the file header (in framed or compressed mode, if not already sent)
+    /**
+     *  @param[in] _iFileDescriptor File descriptor
+     *  @return (Positive) Quantity of data actually sent; Negative error code in case of error
+     */
+    int sendFileHeader( int _iFileDescriptor );
+    /// Receive the file header (if any and not already received) and set framed/compressed mode accordingly
+    /**
+     *  @param[in] _iFileDescriptor File descriptor
+     *  @return (Positive) Quantity of data actually received; Negative error code in case of error
+     */
+    int recvFileHeader( int _iFileDescriptor );
+
   };
 
 }
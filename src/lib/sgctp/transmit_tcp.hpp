@@ -40,6 +40,15 @@ namespace SGCTP
   class CTransmit_TCP: public CTransmit
   {
 
+    //----------------------------------------------------------------------
+    // CONSTANTS / STATIC
+    //----------------------------------------------------------------------
+
+  public:
+    /// Handshake payload type flag: multi-record frames (framed mode) request
+    static const uint8_t HANDSHAKE_FLAG_FRAMED = 0x80;
+
+
     //----------------------------------------------------------------------
     // CONSTRUCTORS / DESTRUCTOR
     //----------------------------------------------------------------------
@@ -66,11 +75,18 @@ namespace SGCTP
                       int _iSize,
                       int _iFlags );
 
+    virtual int sendv( int _iSocket,
+                       const struct iovec *_ptIovec,
+                       int _iIovecCount,
+                       int _iFlags );
+
     virtual int recv( int _iSocket,
                       void *_pBuffer,
                       int _iSize,
                       int _iFlags );
 
+    virtual int nextPayload();
+
   public:
     virtual ETransmitType getTransmitType()
     {
@@ -79,13 +95,6 @@ namespace SGCTP
 
     virtual int alloc();
 
-    virtual int serialize( int _iSocket,
-                           const CData &_roData );
-
-    virtual int unserialize( int _iSocket,
-                             CData *_poData,
-                             int _iMaxSize = 0 );
-
     //----------------------------------------------------------------------
     // METHODS
     //----------------------------------------------------------------------
@@ -93,12 +102,16 @@ namespace SGCTP
   public:
     /// Send the TCP handshake
     /**
+     *  If framed mode is enabled (see setFramed()), it is requested from the
+     *  server and used once the handshake is complete.
      *  @param[in] _iSocket TCP socket descriptor
      *  @return Negative error code in case of error, zero otherwise
      */
     int sendHandshake( int _iSocket );
     /// Receive the TCP handshake (and initialize internal resources: principal/payload)
     /**
+     *  Framed mode is enabled according to the client request (see setFramed())
+     *  once the handshake is complete.
      *  @param[in] _iSocket TCP socket descriptor
      *  @return Negative error code in case of error, zero otherwise
      */
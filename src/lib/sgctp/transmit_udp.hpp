@@ -20,6 +20,9 @@
 #ifndef SGCTP_CTRANSMIT_UDP_HPP
 #define SGCTP_CTRANSMIT_UDP_HPP
 
+// C
+#include <sys/socket.h>
+
 // SGCTP
 #include "sgctp/transmit.hpp"
 
@@ -31,10 +34,51 @@ namespace SGCTP
   /// UDP transmission of SGCTP payload
   /**
    * This class allows the transmission of a SGCTP payload via UDP.
+   * Batch (un-)serialization sends/receives up to DATAGRAM_BATCH_SIZE
+   * datagrams per system call (see sendmmsg/recvmmsg), the source address
+   * and decoding status of each received datagram being available via
+   * getDatagram().
    */
   class CTransmit_UDP: public CTransmit
   {
 
+    //----------------------------------------------------------------------
+    // CONSTANTS / STATIC
+    //----------------------------------------------------------------------
+
+  public:
+    /// Maximum quantity of datagrams sent/received per system call (batch)
+    static const int DATAGRAM_BATCH_SIZE = 64;
+
+    /// Datagram (batch) information
+    struct TDatagram
+    {
+      /// Source socket address
+      struct sockaddr_storage tSockaddr;
+      /// Source socket address length
+      socklen_t tSocklenT;
+      /// Datagram size
+      int iSize;
+      /// Decoding status: (positive) payload size; Negative error code in case of error
+      int iStatus;
+      /// Data block record index (negative if not decoded)
+      int iRecord;
+    };
+
+
+    //----------------------------------------------------------------------
+    // FIELDS
+    //----------------------------------------------------------------------
+
+  private:
+    /// Datagrams buffers (one payload frame per datagram)
+    unsigned char *pucDatagramBuffers;
+    /// Datagrams information (last batch)
+    TDatagram *ptDatagrams;
+    /// Datagrams quantity (last batch)
+    int iDatagramCount;
+
+
     //----------------------------------------------------------------------
     // CONSTRUCTORS / DESTRUCTOR
     //----------------------------------------------------------------------
@@ -42,9 +86,14 @@ namespace SGCTP
   public:
     CTransmit_UDP()
       : CTransmit()
+      , pucDatagramBuffers( NULL )
+      , ptDatagrams( NULL )
+      , iDatagramCount( 0 )
     {};
     virtual ~CTransmit_UDP()
-    {};
+    {
+      freeDatagrams();
+    };
 
 
     //----------------------------------------------------------------------
@@ -57,6 +106,11 @@ namespace SGCTP
                       int _iSize,
                       int _iFlags );
 
+    virtual int sendv( int _iSocket,
+                       const struct iovec *_ptIovec,
+                       int _iIovecCount,
+                       int _iFlags );
+
     virtual int recv( int _iSocket,
                       void *_pBuffer,
                       int _iSize,
@@ -70,10 +124,73 @@ namespace SGCTP
 
     virtual int alloc();
 
+    /// Serialize the given SGCTP data (batch) to the given socket
+    /**
+     *  NOTE: each payload MUST be sent in its own datagram; payloads are
+     *        thus NOT coalesced in a single batch buffer, but sent as
+     *        several datagrams per system call.
+     */
+    virtual int serializeBatch( int _iDescriptor,
+                                const CData *_poData,
+                                int _iDataCount );
+
     virtual int unserialize( int _iDescriptor,
                              CData *_poData,
                              int _iMaxSize = 0 );
 
+    /// Unserialize the SGCTP data from the given descriptor, without blocking
+    /**
+     *  NOTE: each payload is received in its own datagram, such that an
+     *        incomplete datagram is discarded (-EPROTO) rather than kept.
+     */
+    virtual int tryUnserialize( int _iDescriptor,
+                                CData *_poData,
+                                int _iMaxSize = 0 );
+
+    /// Unserialize the SGCTP data (batch) from the given descriptor and append it to the given data block
+    /**
+     *  NOTE: each payload is received in its own datagram; all datagrams
+     *        available - up to the data block free space or
+     *        DATAGRAM_BATCH_SIZE - are received at once (blocking only
+     *        for the first one). Datagrams which fail to be decoded are
+     *        skipped (see getDatagram()).
+     *  @return (Positive) Quantity of data actually unserialized; Negative error code in case of error (including the decoding error of the first datagram if none could be decoded)
+     */
+    virtual int unserializeBatch( int _iDescriptor,
+                                  CDataBlock *_poDataBlock,
+                                  int _iMaxSize = 0 );
+
+    virtual void free();
+
+
+    //----------------------------------------------------------------------
+    // METHODS
+    //----------------------------------------------------------------------
+
+  public:
+    /// Return the quantity of datagrams received by the last batch unserialization
+    int getDatagramCount() const
+    {
+      return iDatagramCount;
+    };
+    /// Return the information about the given datagram received by the last batch unserialization
+    /**
+     *  @param[in] _iIndex Datagram index
+     */
+    const TDatagram* getDatagram( int _iIndex ) const
+    {
+      return &ptDatagrams[_iIndex];
+    };
+
+  private:
+    /// Allocate the datagrams buffers
+    /**
+     *  @return Negative error code in case of error, zero otherwise
+     */
+    int allocDatagrams();
+    /// Free the datagrams buffers
+    void freeDatagrams();
+
   };
 
 }
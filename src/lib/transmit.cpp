@@ -19,14 +19,17 @@
 
 // C
 #include <errno.h>
+#include <stdlib.h>
 #include <string.h>
 #include <arpa/inet.h>
 #include <sys/socket.h>
 
 // SGCTP
 #include "sgctp/data.hpp"
+#include "sgctp/data_block.hpp"
 #include "sgctp/payload.hpp"
 #include "sgctp/payload_aes128.hpp"
+#include "sgctp/payload_delta.hpp"
 #include "sgctp/principal.hpp"
 #include "sgctp/transmit.hpp"
 #include "sgctp/transmit_file.hpp"
@@ -45,15 +48,24 @@ CTransmit::CTransmit()
   , iBufferSize( 0 )
   , iBufferDataStart( 0 )
   , iBufferDataEnd( 0 )
+  , pucBatchBuffer( NULL )
+  , iBatchSize( 0 )
+  , iBatchFrameStart( -1 )
+  , iBatchFrameRecords( 0 )
   , fdTimeout( 0.0 )
   , poPayload( NULL )
   , ePayloadType( PAYLOAD_UNDEFINED )
+  , bFramed( false )
+  , iFrameRecords( 0 )
+  , iFrameBytes( 0 )
 {}
 
 CTransmit::~CTransmit()
 {
   if( pucBuffer )
     CPayload::freeBuffer( pucBuffer );
+  if( pucBatchBuffer )
+    ::free( pucBatchBuffer );
   if( poPayload )
     delete poPayload;
 }
@@ -147,6 +159,175 @@ void CTransmit::resetBuffer()
 {
   iBufferDataStart = 0;
   iBufferDataEnd = 0;
+  iFrameRecords = 0;
+  iFrameBytes = 0;
+}
+
+int CTransmit::sendv( int _iDescriptor,
+                      const struct iovec *_ptIovec,
+                      int _iIovecCount,
+                      int _iFlags )
+{
+  int __iReturn;
+  int __iSentSize = 0;
+  for( int __i = 0; __i < _iIovecCount; __i++ )
+  {
+    __iReturn = send( _iDescriptor,
+                      _ptIovec[__i].iov_base,
+                      _ptIovec[__i].iov_len,
+                      ( __i < _iIovecCount-1 ) ? MSG_MORE : _iFlags );
+    if( __iReturn < 0 )
+      return __iReturn;
+    __iSentSize += __iReturn;
+    if( __iReturn != (int)_ptIovec[__i].iov_len )
+      break;
+  }
+  return __iSentSize;
+}
+
+int CTransmit::sendBatchBuffer( int _iDescriptor )
+{
+  int __iReturn;
+  int __iSentSize = 0;
+  while( __iSentSize < iBatchSize )
+  {
+    __iReturn = send( _iDescriptor, pucBatchBuffer+__iSentSize, iBatchSize-__iSentSize, MSG_EOR );
+    if( __iReturn == -EINTR )
+      continue;
+    if( __iReturn <= 0 )
+    {
+      // ... keep unsent data (to be sent first on retry)
+      if( __iSentSize )
+      {
+        iBatchSize -= __iSentSize;
+        memmove( pucBatchBuffer, pucBatchBuffer+__iSentSize, iBatchSize );
+      }
+      return
+        ( __iReturn < 0 )
+        ? __iReturn
+        : -EIO;
+    }
+    __iSentSize += __iReturn;
+  }
+  iBatchSize = 0;
+  return __iSentSize;
+}
+
+int CTransmit::recvPayload( int _iDescriptor,
+                            int _iMaxSize,
+                            bool _bBlocking,
+                            int *_piReceivedSize )
+{
+  int __iReturn;
+  int __iReceivedSize = 0;
+
+  // Receive frame (framed mode)
+  if( bFramed && !iFrameRecords )
+  {
+    // ... header
+    if( _bBlocking )
+    {
+      __iReturn = recvBuffer( _iDescriptor, FRAME_HEADER_SIZE );
+      if( __iReturn != FRAME_HEADER_SIZE )
+        return
+          ( __iReturn <= 0 )
+          ? __iReturn
+          : -EPROTO;
+    }
+    else if( iBufferDataEnd - iBufferDataStart < FRAME_HEADER_SIZE )
+      return 0;
+    uint16_t __pui16tFrameHeader_NS[2];
+    memcpy( __pui16tFrameHeader_NS, pucBuffer+iBufferDataStart, FRAME_HEADER_SIZE );
+    int __iFrameRecords = ntohs( __pui16tFrameHeader_NS[0] );
+    int __iFrameBytes = ntohs( __pui16tFrameHeader_NS[1] );
+    if( !__iFrameRecords
+        || __iFrameBytes < 2*__iFrameRecords
+        || FRAME_HEADER_SIZE+__iFrameBytes > CPayload::BUFFER_SIZE )
+      return -EPROTO;
+
+    // ... content
+    if( _bBlocking )
+    {
+      __iReturn = recvBuffer( _iDescriptor, FRAME_HEADER_SIZE+__iFrameBytes );
+      if( __iReturn != FRAME_HEADER_SIZE+__iFrameBytes )
+        return
+          ( __iReturn <= 0 )
+          ? __iReturn
+          : -EPROTO;
+    }
+    else if( iBufferDataEnd - iBufferDataStart < FRAME_HEADER_SIZE+__iFrameBytes )
+      return 0;
+    pullBuffer( FRAME_HEADER_SIZE );
+    iFrameRecords = __iFrameRecords;
+    iFrameBytes = __iFrameBytes;
+    __iReceivedSize += FRAME_HEADER_SIZE;
+  }
+
+  // Receive payload
+
+  // ... size
+  if( !bFramed )
+  {
+    if( _bBlocking )
+    {
+      __iReturn = recvBuffer( _iDescriptor, 2 );
+      if( __iReturn != 2 )
+        return
+          ( __iReturn <= 0 )
+          ? __iReturn
+          : -EPROTO;
+    }
+    else if( iBufferDataEnd - iBufferDataStart < 2 )
+      return 0;
+  }
+  uint16_t __ui16tPayloadSize_NS;
+  memcpy( &__ui16tPayloadSize_NS, pucBuffer+iBufferDataStart, 2 );
+  uint16_t __ui16tPayloadSize = ntohs( __ui16tPayloadSize_NS );
+  if( _iMaxSize && __ui16tPayloadSize > _iMaxSize )
+    return -EMSGSIZE;
+
+  // ... content
+  if( bFramed )
+  {
+    if( __ui16tPayloadSize+2 > iFrameBytes )
+      return -EPROTO;
+    iFrameRecords--;
+    iFrameBytes -= __ui16tPayloadSize+2;
+    if( !iFrameRecords && iFrameBytes )
+      return -EPROTO;
+  }
+  else if( _bBlocking )
+  {
+    __iReturn = recvBuffer( _iDescriptor, __ui16tPayloadSize+2 );
+    if( __iReturn != __ui16tPayloadSize+2 )
+      return
+        ( __iReturn <= 0 )
+        ? __iReturn
+        : -EPROTO;
+  }
+  else if( iBufferDataEnd - iBufferDataStart < __ui16tPayloadSize+2 )
+    return 0;
+  pullBuffer( 2 );
+  __iReceivedSize += __ui16tPayloadSize+2;
+
+  // Done
+  *_piReceivedSize = __iReceivedSize;
+  return __ui16tPayloadSize;
+}
+
+int CTransmit::setFramed( bool _bFramed )
+{
+  // Check transmission type (framing requires a stream)
+  if( _bFramed && getTransmitType() == TRANSMIT_UDP )
+    return -EINVAL;
+
+  // Set framed mode
+  bFramed = _bFramed;
+  iFrameRecords = 0;
+  iFrameBytes = 0;
+
+  // Done
+  return 0;
 }
 
 void CTransmit::resetPayload()
@@ -184,6 +365,13 @@ int CTransmit::initPayload( uint8_t _ui8tPayloadType )
     }
     break;
 
+  case PAYLOAD_DELTA:
+    // ... requires ordered and lossless transmission
+    if( getTransmitType() == TRANSMIT_UDP )
+      return -EINVAL;
+    poPayload = new CPayload_DELTA();
+    break;
+
   default:
     return -EINVAL;
   }
@@ -217,6 +405,11 @@ int CTransmit::serialize( int _iDescriptor,
   // Check resources
   if( !poPayload )
     return -ENODATA;
+  if( bFramed )
+  {
+    // ... coalesce payload in the pending frames (see flushFrames())
+    return batchPayload( _iDescriptor, _roData );
+  }
   if( !pucBuffer )
   {
     __iReturn = alloc();
@@ -230,27 +423,151 @@ int CTransmit::serialize( int _iDescriptor,
     return __iReturn;
   int __iPayloadSize = __iReturn;
 
-  // Send payload
+  // Send payload (size and content)
   uint16_t __ui16tPayloadSize_NS = htons( __iPayloadSize );
-
-  // ... size
-  __iReturn = send( _iDescriptor, &__ui16tPayloadSize_NS, 2, MSG_MORE );
-  if( __iReturn != 2 )
+  struct iovec __ptIovec[2];
+  __ptIovec[0].iov_base = &__ui16tPayloadSize_NS;
+  __ptIovec[0].iov_len = 2;
+  __ptIovec[1].iov_base = pucBuffer;
+  __ptIovec[1].iov_len = __iPayloadSize;
+  __iReturn = sendv( _iDescriptor, __ptIovec, 2, MSG_EOR );
+  if( __iReturn != __iPayloadSize+2 )
     return
       ( __iReturn <= 0 )
       ? __iReturn
       : -EIO;
 
-  // ... content
-  __iReturn = send( _iDescriptor, pucBuffer, __iPayloadSize, MSG_EOR );
-  if( __iReturn != __iPayloadSize )
+  // Next payload
+  __iReturn = nextPayload();
+  if( __iReturn < 0 )
+    return __iReturn;
+
+  // Done
+  return __iPayloadSize+2;
+}
+
+int CTransmit::serializeBatch( int _iDescriptor,
+                               const CData *_poData,
+                               int _iDataCount )
+{
+  int __iReturn;
+
+  // Check resources
+  if( !poPayload )
+    return -ENODATA;
+
+  // Create payloads
+  int __iBatchSize = 0;
+  for( int __i = 0; __i < _iDataCount; __i++ )
+  {
+    __iReturn = batchPayload( _iDescriptor, _poData[__i] );
+    if( __iReturn < 0 )
+      return __iReturn;
+    __iBatchSize += __iReturn;
+  }
+
+  // Send payloads (along pending ones)
+  __iReturn = sendBatch( _iDescriptor );
+  if( __iReturn < 0 )
+    return __iReturn;
+
+  // Done
+  return __iBatchSize;
+}
+
+int CTransmit::flushFrames( int _iDescriptor )
+{
+  return sendBatch( _iDescriptor );
+}
+
+int CTransmit::batchPayload( int _iDescriptor,
+                             const CData &_roData )
+{
+  int __iReturn;
+  int __iBatchSize = 0;
+
+  // Check resources
+  if( !pucBatchBuffer )
+  {
+    pucBatchBuffer = (unsigned char*)malloc( BATCH_BUFFER_SIZE * sizeof( unsigned char ) );
+    if( !pucBatchBuffer )
+      return -ENOMEM;
+  }
+  int __iPayloadSize = poPayload->encodedSize( _roData )+2;
+
+  // Close (full) frame (framed mode)
+  if( iBatchFrameStart >= 0
+      && iBatchSize - iBatchFrameStart + __iPayloadSize > CPayload::BUFFER_SIZE )
+    closeBatchFrame();
+
+  // Send (full) batch buffer
+  if( iBatchFrameStart < 0
+      && BATCH_BUFFER_SIZE - iBatchSize < ( bFramed ? CPayload::BUFFER_SIZE : __iPayloadSize ) )
+  {
+    __iReturn = sendBatch( _iDescriptor );
+    if( __iReturn < 0 )
+      return __iReturn;
+  }
+
+  // Open frame (framed mode)
+  if( bFramed && iBatchFrameStart < 0 )
+  {
+    iBatchFrameStart = iBatchSize;
+    iBatchFrameRecords = 0;
+    iBatchSize += FRAME_HEADER_SIZE;
+    __iBatchSize += FRAME_HEADER_SIZE;
+  }
+
+  // Create (framed) payload
+  __iReturn = poPayload->serializeBatch( pucBatchBuffer+iBatchSize,
+                                         bFramed
+                                         ? iBatchFrameStart+CPayload::BUFFER_SIZE-iBatchSize
+                                         : BATCH_BUFFER_SIZE-iBatchSize,
+                                         &_roData, 1 );
+  if( __iReturn <= 0 )
     return
-      ( __iReturn <= 0 )
+      ( __iReturn < 0 )
       ? __iReturn
-      : -EIO;
+      : -EOVERFLOW;
+  iBatchSize += __iReturn;
+  __iBatchSize += __iReturn;
+  iBatchFrameRecords++;
+
+  // Next payload
+  __iReturn = nextPayload();
+  if( __iReturn < 0 )
+    return __iReturn;
 
   // Done
-  return __iPayloadSize+2;
+  return __iBatchSize;
+}
+
+void CTransmit::closeBatchFrame()
+{
+  uint16_t __pui16tFrameHeader_NS[2];
+  __pui16tFrameHeader_NS[0] = htons( iBatchFrameRecords );
+  __pui16tFrameHeader_NS[1] = htons( iBatchSize - iBatchFrameStart - FRAME_HEADER_SIZE );
+  memcpy( pucBatchBuffer+iBatchFrameStart, __pui16tFrameHeader_NS, FRAME_HEADER_SIZE );
+  iBatchFrameStart = -1;
+}
+
+int CTransmit::sendBatch( int _iDescriptor )
+{
+  // Close (pending) frame (framed mode)
+  if( iBatchFrameStart >= 0 )
+    closeBatchFrame();
+
+  // Send batch buffer
+  // NOTE: in case of error, unsent data are kept in the batch buffer (see sendBatchBuffer())
+  if( !iBatchSize )
+    return 0;
+  return sendBatchBuffer( _iDescriptor );
+}
+
+void CTransmit::resetBatch()
+{
+  iBatchSize = 0;
+  iBatchFrameStart = -1;
 }
 
 int CTransmit::unserialize( int _iDescriptor,
@@ -270,25 +587,124 @@ int CTransmit::unserialize( int _iDescriptor,
   }
 
   // Receive payload
+  int __iReceivedSize;
+  __iReturn = recvPayload( _iDescriptor, _iMaxSize, true, &__iReceivedSize );
+  if( __iReturn <= 0 )
+    return __iReturn;
+  uint16_t __ui16tPayloadSize = __iReturn;
 
-  // ... size
-  __iReturn = recvBuffer( _iDescriptor, 2 );
-  if( __iReturn != 2 )
-    return
-      ( __iReturn <= 0 )
-      ? __iReturn
-      : -EPROTO;
-  uint16_t __ui16tPayloadSize = ntohs( *((uint16_t*)pullBuffer( 2 )) );
-  if( _iMaxSize && __ui16tPayloadSize > _iMaxSize )
-    return -EMSGSIZE;
+  // Parse payload
+  __iReturn = poPayload->unserialize( _poData,
+                                      pullBuffer( __ui16tPayloadSize ),
+                                      __ui16tPayloadSize );
+  if( __iReturn <= 0 )
+    return __iReturn;
 
-  // ... content
-  __iReturn = recvBuffer( _iDescriptor, __ui16tPayloadSize );
-  if( __iReturn != __ui16tPayloadSize )
-    return
-      ( __iReturn <= 0 )
-      ? __iReturn
-      : -EPROTO;
+  // Next payload
+  __iReturn = nextPayload();
+  if( __iReturn < 0 )
+    return __iReturn;
+
+  // Done
+  return __iReceivedSize;
+}
+
+int CTransmit::unserializeBatch( int _iDescriptor,
+                                 CDataBlock *_poDataBlock,
+                                 int _iMaxSize )
+{
+  int __iReturn;
+
+  // Check resources
+  if( !poPayload )
+    return -ENODATA;
+  if( !pucBuffer )
+  {
+    __iReturn = alloc();
+    if( __iReturn < 0 )
+      return __iReturn;
+  }
+  if( _poDataBlock->isFull() )
+    return -ENOSPC;
+
+  // Receive and parse payloads
+  int __iReceivedSize = 0;
+  do
+  {
+    // ... receive payload (blocking only for the first one)
+    int __iPayloadReceivedSize;
+    __iReturn = recvPayload( _iDescriptor, _iMaxSize, __iReceivedSize == 0,
+                             &__iPayloadReceivedSize );
+    if( __iReturn < 0 || ( __iReturn == 0 && __iReceivedSize == 0 ) )
+      return __iReturn;
+    if( __iReturn == 0 )
+      break;
+    uint16_t __ui16tPayloadSize = __iReturn;
+
+    // ... parse payload
+    __iReturn = poPayload->unserialize( _poDataBlock,
+                                        pullBuffer( __ui16tPayloadSize ),
+                                        __ui16tPayloadSize );
+    if( __iReturn <= 0 )
+      return __iReturn;
+
+    // ... next payload
+    __iReturn = nextPayload();
+    if( __iReturn < 0 )
+      return __iReturn;
+    __iReceivedSize += __iPayloadReceivedSize;
+  }
+  while( !_poDataBlock->isFull() );
+
+  // Done
+  return __iReceivedSize;
+}
+
+int CTransmit::tryUnserialize( int _iDescriptor,
+                               CData *_poData,
+                               int _iMaxSize )
+{
+  int __iReturn;
+
+  // Check resources
+  if( !poPayload )
+    return -ENODATA;
+  if( !pucBuffer )
+  {
+    __iReturn = alloc();
+    if( __iReturn < 0 )
+      return __iReturn;
+  }
+
+  // Receive payload (already available in the transmission buffer)
+  int __iReceivedSize;
+  __iReturn = recvPayload( _iDescriptor, _iMaxSize, false, &__iReceivedSize );
+  if( __iReturn < 0 )
+    return __iReturn;
+  if( __iReturn == 0 )
+  {
+    // ... receive available data (without waiting)
+    if( iBufferDataStart )
+      flushBuffer();
+    if( iBufferDataEnd >= iBufferSize )
+      return -EOVERFLOW;
+    __iReturn = recv( _iDescriptor,
+                      pucBuffer+iBufferDataEnd,
+                      iBufferSize-iBufferDataEnd,
+                      MSG_DONTWAIT );
+    if( __iReturn <= 0 )
+      return __iReturn;
+    iBufferDataEnd += __iReturn;
+
+    // ... payload (if now entirely available)
+    __iReturn = recvPayload( _iDescriptor, _iMaxSize, false, &__iReceivedSize );
+    if( __iReturn <= 0 )
+      return
+        ( __iReturn < 0 )
+        ? __iReturn
+        : -EAGAIN;
+  }
+  uint16_t __ui16tPayloadSize = __iReturn;
 
   // Parse payload
   __iReturn = poPayload->unserialize( _poData,
@@ -297,8 +713,13 @@ int CTransmit::unserialize( int _iDescriptor,
   if( __iReturn <= 0 )
     return __iReturn;
 
+  // Next payload
+  __iReturn = nextPayload();
+  if( __iReturn < 0 )
+    return __iReturn;
+
   // Done
-  return __ui16tPayloadSize+2;
+  return __iReceivedSize;
 }
 
 void CTransmit::free()
@@ -311,4 +732,10 @@ void CTransmit::free()
     iBufferDataStart = 0;
     iBufferDataEnd = 0;
   }
+  if( pucBatchBuffer )
+  {
+    ::free( pucBatchBuffer );
+    pucBatchBuffer = NULL;
+  }
+  resetBatch();
 }
@@ -19,9 +19,16 @@
 
 // C
 #include <errno.h>
+#include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 // SGCTP
+#include "sgctp/compressor.hpp"
+#include "sgctp/data.hpp"
 #include "sgctp/payload.hpp"
 #include "sgctp/transmit_file.hpp"
 using namespace SGCTP;
@@ -35,28 +42,1236 @@ using namespace SGCTP;
 int CTransmit_File::send( int _iFileDescriptor,
                           const void *_pBuffer,
                           int _iSize,
-                          int _iFlags )
+                          int /*_iFlags*/ )
 {
-  int __iReturn = ::write( _iFileDescriptor, _pBuffer, _iSize );
-  return
-    ( __iReturn >= 0 )
-    ? __iReturn
-    : -errno;
+  int __iReturn;
+
+  // Compressed block
+  if( ui8tCompressionType && bFileHeaderSent )
+  {
+    if( _iSize > BLOCK_BUFFER_SIZE )
+      return -EMSGSIZE;
+    if( !pucBlockBuffer )
+    {
+      __iReturn = allocBlock();
+      if( __iReturn < 0 )
+        return __iReturn;
+    }
+    if( iBlockDataEnd + _iSize > BLOCK_BUFFER_SIZE )
+    {
+      __iReturn = sendBlock( _iFileDescriptor );
+      if( __iReturn < 0 )
+        return __iReturn;
+    }
+    memcpy( pucBlockBuffer+iBlockDataEnd, _pBuffer, _iSize );
+    iBlockDataEnd += _iSize;
+    return _iSize;
+  }
+
+  // Write
+  if( iOutputBufferSize )
+    return writeFile( _iFileDescriptor, _pBuffer, _iSize );
+  __iReturn = ::write( _iFileDescriptor, _pBuffer, _iSize );
+  if( __iReturn < 0 )
+    return -errno;
+  ui64tFileOffset += __iReturn;
+  return __iReturn;
+}
+
+int CTransmit_File::sendv( int _iFileDescriptor,
+                           const struct iovec *_ptIovec,
+                           int _iIovecCount,
+                           int _iFlags )
+{
+  int __iReturn;
+
+  // Compressed block / buffered output (no system call involved)
+  if( ( ui8tCompressionType && bFileHeaderSent ) || iOutputBufferSize )
+    return CTransmit::sendv( _iFileDescriptor, _ptIovec, _iIovecCount, _iFlags );
+
+  // Write
+  __iReturn = ::writev( _iFileDescriptor, _ptIovec, _iIovecCount );
+  if( __iReturn < 0 )
+    return -errno;
+  ui64tFileOffset += __iReturn;
+  return __iReturn;
 }
 
 int CTransmit_File::recv( int _iFileDescriptor,
                           void *_pBuffer,
                           int _iSize,
-                          int _iFlags )
+                          int /*_iFlags*/ )
+{
+  int __iReturn;
+
+  // Compressed block
+  if( bCompressed )
+  {
+    if( iBlockDataStart >= iBlockDataEnd )
+    {
+      __iReturn = recvBlock( _iFileDescriptor );
+      if( __iReturn <= 0 )
+        return __iReturn;
+    }
+    if( _iSize > iBlockDataEnd - iBlockDataStart )
+      _iSize = iBlockDataEnd - iBlockDataStart;
+    memcpy( _pBuffer, pucBlockBuffer+iBlockDataStart, _iSize );
+    iBlockDataStart += _iSize;
+    return _iSize;
+  }
+
+  // Read
+  // NOTE: the file header is read on its own, such as not to read (compressed)
+  //       data beyond it
+  if( !bFileHeaderReceived
+      && _iSize > FILE_HEADER_SIZE - ( iBufferDataEnd - iBufferDataStart ) )
+    _iSize = FILE_HEADER_SIZE - ( iBufferDataEnd - iBufferDataStart );
+  __iReturn = readChunk( _iFileDescriptor, _pBuffer, _iSize );
+  if( __iReturn < 0 )
+    return __iReturn;
+  ui64tFileOffset += __iReturn;
+  return __iReturn;
+}
+
+int CTransmit_File::recvBuffer( int _iFileDescriptor,
+                                int _iSize )
 {
-  int __iReturn = ::read( _iFileDescriptor, _pBuffer, _iSize );
+  int __iReturn;
+
+  // Check memory-mapped mode and available data
+  if( !bMapped )
+    return CTransmit::recvBuffer( _iFileDescriptor, _iSize );
+  if( iBufferDataEnd - iBufferDataStart >= _iSize )
+    return _iSize;
+
+  // Compressed block
+  // NOTE: payloads (frames) never span several blocks, such that the block
+  //       buffer is used as data buffer (rather than copying its content)
+  if( bCompressed )
+  {
+    if( iBufferDataEnd > iBufferDataStart )
+      return -EPROTO;
+    __iReturn = recvBlock( _iFileDescriptor );
+    if( __iReturn <= 0 )
+      return __iReturn;
+    pucBuffer = pucBlockBuffer;
+    iBufferSize = BLOCK_BUFFER_SIZE;
+    iBufferDataStart = 0;
+    iBufferDataEnd = __iReturn;
+    iBlockDataStart = iBlockDataEnd;
+    return
+      ( __iReturn >= _iSize )
+      ? _iSize
+      : -EPROTO;
+  }
+
+  // Map data
+  uint64_t __ui64tOffset = ui64tFileOffset - ( iBufferDataEnd - iBufferDataStart );
+  const unsigned char *__pucData;
+  __iReturn = mapFile( _iFileDescriptor, __ui64tOffset, _iSize, &__pucData );
+  if( __iReturn == -ENODEV && !pucMapping )
+  {
+    // ... fall back to normal mode (non-regular file)
+    bMapped = false;
+    __iReturn = CTransmit::allocBuffer();
+    if( __iReturn < 0 )
+      return __iReturn;
+    return CTransmit::recvBuffer( _iFileDescriptor, _iSize );
+  }
+  if( __iReturn <= 0 )
+    return __iReturn;
+  // NOTE: the file header is read on its own (see recv())
+  if( !bFileHeaderReceived && __iReturn > FILE_HEADER_SIZE )
+    __iReturn = FILE_HEADER_SIZE;
+  pucBuffer = pucMapping;
+  iBufferSize = iMappingSize;
+  iBufferDataStart = __ui64tOffset - ui64tMappingOffset;
+  iBufferDataEnd = iBufferDataStart + __iReturn;
+  ui64tFileOffset = __ui64tOffset + __iReturn;
+
+  // Done
   return
-    ( __iReturn >= 0 )
-    ? __iReturn
-    : -errno;
+    ( __iReturn >= _iSize )
+    ? _iSize
+    : 0;
 }
 
 int CTransmit_File::alloc()
 {
+  // NOTE: the file mapping is used as data buffer in memory-mapped mode
+  if( bMapped )
+    return 0;
   return CTransmit::allocBuffer();
 }
+
+int CTransmit_File::serialize( int _iFileDescriptor,
+                               const CData &_roData )
+{
+  int __iReturn;
+
+  // Check memory-mapped mode (read-only)
+  if( bMapped )
+    return -EBADF;
+
+  // File header
+  __iReturn = sendFileHeader( _iFileDescriptor );
+  if( __iReturn < 0 )
+    return __iReturn;
+  int __iHeaderSize = __iReturn;
+
+  // Serialize
+  __iReturn = CTransmit::serialize( _iFileDescriptor, _roData );
+  if( __iReturn < 0 )
+    return __iReturn;
+  int __iDataSize = __iReturn;
+
+  // Compressed block
+  // NOTE: blocks are written only after entire payloads (frames) have been
+  //       serialized, such that they can be unserialized independently
+  if( iBlockDataEnd >= BLOCK_SIZE )
+  {
+    __iReturn = sendBlock( _iFileDescriptor );
+    if( __iReturn < 0 )
+      return __iReturn;
+  }
+
+  // Done
+  return __iHeaderSize+__iDataSize;
+}
+
+int CTransmit_File::serializeBatch( int _iFileDescriptor,
+                                    const CData *_poData,
+                                    int _iDataCount )
+{
+  int __iReturn;
+
+  // Check memory-mapped mode (read-only)
+  if( bMapped )
+    return -EBADF;
+
+  // File header
+  __iReturn = sendFileHeader( _iFileDescriptor );
+  if( __iReturn < 0 )
+    return __iReturn;
+  int __iHeaderSize = __iReturn;
+
+  // Serialize
+  __iReturn = CTransmit::serializeBatch( _iFileDescriptor, _poData, _iDataCount );
+  if( __iReturn < 0 )
+    return __iReturn;
+  int __iDataSize = __iReturn;
+
+  // Compressed block
+  if( iBlockDataEnd >= BLOCK_SIZE )
+  {
+    __iReturn = sendBlock( _iFileDescriptor );
+    if( __iReturn < 0 )
+      return __iReturn;
+  }
+
+  // Done
+  return __iHeaderSize+__iDataSize;
+}
+
+int CTransmit_File::unserialize( int _iFileDescriptor,
+                                 CData *_poData,
+                                 int _iMaxSize )
+{
+  int __iReturn;
+
+  // File header
+  __iReturn = recvFileHeader( _iFileDescriptor );
+  if( __iReturn < 0 )
+    return __iReturn;
+  int __iHeaderSize = __iReturn;
+
+  // Unserialize
+  __iReturn = CTransmit::unserialize( _iFileDescriptor, _poData, _iMaxSize );
+  if( __iReturn <= 0 )
+    return __iReturn;
+
+  // Done
+  return __iHeaderSize+__iReturn;
+}
+
+int CTransmit_File::unserializeBatch( int _iFileDescriptor,
+                                      CDataBlock *_poDataBlock,
+                                      int _iMaxSize )
+{
+  int __iReturn;
+
+  // File header
+  __iReturn = recvFileHeader( _iFileDescriptor );
+  if( __iReturn < 0 )
+    return __iReturn;
+  int __iHeaderSize = __iReturn;
+
+  // Unserialize
+  __iReturn = CTransmit::unserializeBatch( _iFileDescriptor, _poDataBlock, _iMaxSize );
+  if( __iReturn <= 0 )
+    return __iReturn;
+
+  // Done
+  return __iHeaderSize+__iReturn;
+}
+
+void CTransmit_File::free()
+{
+  if( bMapped )
+  {
+    pucBuffer = NULL;
+    iBufferSize = 0;
+    iBufferDataStart = 0;
+    iBufferDataEnd = 0;
+  }
+  unmapFile();
+  ui64tFileSize = 0;
+  CTransmit::free();
+  freeBlock();
+  freeAsync();
+  freeOutputBuffer();
+  bFileHeaderSent = false;
+  bFileHeaderReceived = false;
+  iFileHeaderSize = 0;
+}
+
+
+//----------------------------------------------------------------------
+// METHODS
+//----------------------------------------------------------------------
+
+int CTransmit_File::setCompression( uint8_t _ui8tCompressionType )
+{
+  if( !CCompressor::isAvailable( _ui8tCompressionType ) )
+    return -ENOTSUP;
+  ui8tCompressionType = _ui8tCompressionType;
+  return 0;
+}
+
+int CTransmit_File::setOutputBuffer( int _iSize,
+                                     double _fdDelay,
+                                     bool _bSync )
+{
+  if( _iSize < 0 || _fdDelay < 0.0 )
+    return -EINVAL;
+  freeOutputBuffer();
+  iOutputBufferSize = _iSize;
+  fdOutputBufferDelay = _fdDelay;
+  bOutputBufferSync = _bSync;
+  return 0;
+}
+
+int CTransmit_File::flush( int _iFileDescriptor )
+{
+  int __iReturn;
+  int __iSentSize = 0;
+
+  // Pending frames (framed mode)
+  __iReturn = flushFrames( _iFileDescriptor );
+  if( __iReturn < 0 )
+    return __iReturn;
+  __iSentSize += __iReturn;
+
+  // Compressed blocks
+  if( ui8tCompressionType && bFileHeaderSent )
+  {
+    // ... pending block
+    __iReturn = sendBlock( _iFileDescriptor );
+    if( __iReturn < 0 )
+      return __iReturn;
+    __iSentSize += __iReturn;
+  }
+
+  // Output buffer
+  __iReturn = writeOutputBuffer( _iFileDescriptor );
+  if( __iReturn < 0 )
+    return __iReturn;
+  if( bAsync )
+  {
+    __iReturn = waitAsyncWrite( _iFileDescriptor );
+    if( __iReturn < 0 )
+      return __iReturn;
+  }
+
+  // Done
+  return __iSentSize;
+}
+
+int CTransmit_File::finish( int _iFileDescriptor )
+{
+  int __iReturn;
+  int __iSentSize = 0;
+
+  // Pending frames (framed mode)
+  __iReturn = flushFrames( _iFileDescriptor );
+  if( __iReturn < 0 )
+    return __iReturn;
+  __iSentSize += __iReturn;
+
+  // Compressed blocks
+  if( ui8tCompressionType && bFileHeaderSent && !bBlockIndexSent )
+  {
+    // ... pending block
+    __iReturn = sendBlock( _iFileDescriptor );
+    if( __iReturn < 0 )
+      return __iReturn;
+    __iSentSize += __iReturn;
+
+    // ... block index
+    __iReturn = sendBlockIndex( _iFileDescriptor );
+    if( __iReturn < 0 )
+      return __iReturn;
+    __iSentSize += __iReturn;
+  }
+
+  // Output buffer
+  __iReturn = flush( _iFileDescriptor );
+  if( __iReturn < 0 )
+    return __iReturn;
+  __iSentSize += __iReturn;
+
+  // Done
+  return __iSentSize;
+}
+
+int64_t CTransmit_File::tell() const
+{
+  // Check synchronization point
+  if( iFrameRecords )
+    return -EAGAIN;
+  if( bCompressed )
+    return
+      ( iBlockDataStart >= iBlockDataEnd && iBufferDataStart >= iBufferDataEnd )
+      ? (int64_t)ui64tFileOffset
+      : -EAGAIN;
+
+  // Done
+  return ui64tFileOffset - ( iBufferDataEnd - iBufferDataStart );
+}
+
+int CTransmit_File::seek( int _iFileDescriptor,
+                          uint64_t _ui64tOffset )
+{
+  int __iReturn;
+
+  // Check payload
+  // NOTE: delta payloads can not be unserialized independently
+  if( ePayloadType == PAYLOAD_DELTA )
+    return -ENOTSUP;
+
+  // File header
+  // NOTE: data read ahead (asynchronous mode) are discarded
+  if( !bFileHeaderReceived )
+  {
+    freeAsync();
+    if( !bMapped && lseek( _iFileDescriptor, 0, SEEK_SET ) < 0 )
+      return -errno;
+    resetBuffer();
+    ui64tFileOffset = 0;
+    __iReturn = recvFileHeader( _iFileDescriptor );
+    if( __iReturn < 0 )
+      return __iReturn;
+  }
+
+  // Seek
+  if( _ui64tOffset < (uint64_t)iFileHeaderSize )
+    _ui64tOffset = iFileHeaderSize;
+  freeAsync();
+  if( !bMapped && lseek( _iFileDescriptor, _ui64tOffset, SEEK_SET ) < 0 )
+    return -errno;
+  resetBuffer();
+  iBlockDataStart = 0;
+  iBlockDataEnd = 0;
+  ui64tFileOffset = _ui64tOffset;
+
+  // Done
+  return 0;
+}
+
+void CTransmit_File::setMapped( bool _bMapped )
+{
+  if( _bMapped == bMapped )
+    return;
+  free();
+  bMapped = _bMapped;
+}
+
+int CTransmit_File::setAsync( bool _bAsync )
+{
+  int __iReturn;
+  if( _bAsync == bAsync )
+    return 0;
+  free();
+  if( _bAsync )
+  {
+    __iReturn = oRing.init();
+    if( __iReturn < 0 )
+      return __iReturn;
+  }
+  else
+    oRing.free();
+  bAsync = _bAsync;
+  return 0;
+}
+
+int CTransmit_File::writeFile( int _iFileDescriptor,
+                               const void *_pBuffer,
+                               int _iSize )
+{
+  int __iReturn;
+
+  // Buffered output
+  // NOTE: data larger than the output buffer are written directly
+  if( iOutputBufferSize )
+  {
+    if( !pucOutputBuffer )
+    {
+      // NOTE: in asynchronous mode, a second buffer is filled while the
+      //       first one is being written (registration failures are ignored)
+      pucOutputBuffer = (unsigned char*)malloc( ( bAsync ? 2 : 1 ) * iOutputBufferSize * sizeof( unsigned char ) );
+      if( !pucOutputBuffer )
+        return -ENOMEM;
+      iOutputDataEnd = 0;
+      if( bAsync )
+      {
+        pucOutputBufferPending = pucOutputBuffer + iOutputBufferSize;
+        struct iovec __ptBuffers[2] = { { pucOutputBuffer, (size_t)iOutputBufferSize },
+                                        { pucOutputBufferPending, (size_t)iOutputBufferSize } };
+        oRing.registerBuffers( __ptBuffers, 2 );
+      }
+    }
+    if( iOutputDataEnd + _iSize > iOutputBufferSize )
+    {
+      __iReturn = writeOutputBuffer( _iFileDescriptor );
+      if( __iReturn < 0 )
+        return __iReturn;
+    }
+    if( _iSize < iOutputBufferSize )
+    {
+      if( !iOutputDataEnd && fdOutputBufferDelay > 0.0 )
+        fdOutputDataTime = CData::epoch();
+      memcpy( pucOutputBuffer+iOutputDataEnd, _pBuffer, _iSize );
+      iOutputDataEnd += _iSize;
+      ui64tFileOffset += _iSize;
+      if( fdOutputBufferDelay > 0.0
+          && CData::epoch() - fdOutputDataTime >= fdOutputBufferDelay )
+      {
+        __iReturn = writeOutputBuffer( _iFileDescriptor );
+        if( __iReturn < 0 )
+          return __iReturn;
+      }
+      return _iSize;
+    }
+  }
+
+  // Write
+  if( bAsync )
+  {
+    __iReturn = waitAsyncWrite( _iFileDescriptor );
+    if( __iReturn < 0 )
+      return __iReturn;
+  }
+  int __iSentSize = 0;
+  while( __iSentSize < _iSize )
+  {
+    __iReturn = ::write( _iFileDescriptor, (const unsigned char*)_pBuffer+__iSentSize, _iSize-__iSentSize );
+    if( __iReturn < 0 )
+    {
+      if( errno == EINTR )
+        continue;
+      return -errno;
+    }
+    __iSentSize += __iReturn;
+    ui64tFileOffset += __iReturn;
+  }
+  if( iOutputBufferSize && bOutputBufferSync
+      && fdatasync( _iFileDescriptor ) < 0 && errno != EINVAL )
+    return -errno;
+  return __iSentSize;
+}
+
+int CTransmit_File::writeOutputBuffer( int _iFileDescriptor )
+{
+  int __iReturn;
+
+  // Check data
+  if( !iOutputDataEnd )
+    return 0;
+
+  // Write (asynchronous)
+  // NOTE: the data synchronization is linked to (executed after) the write
+  if( bAsync )
+  {
+    __iReturn = waitAsyncWrite( _iFileDescriptor );
+    if( __iReturn < 0 )
+      return __iReturn;
+    __iReturn = oRing.write( _iFileDescriptor, pucOutputBuffer, iOutputDataEnd, ASYNC_WRITE, bOutputBufferSync );
+    if( __iReturn < 0 )
+      return __iReturn;
+    if( bOutputBufferSync )
+    {
+      __iReturn = oRing.datasync( _iFileDescriptor, ASYNC_SYNC );
+      if( __iReturn < 0 )
+        return __iReturn;
+    }
+    __iReturn = oRing.submit();
+    if( __iReturn < 0 )
+      return __iReturn;
+    bAsyncWritePending = true;
+    bAsyncSyncPending = bOutputBufferSync;
+    iAsyncWriteStart = 0;
+    iAsyncWriteSize = iOutputDataEnd;
+    unsigned char *__pucOutputBuffer = pucOutputBuffer;
+    pucOutputBuffer = pucOutputBufferPending;
+    pucOutputBufferPending = __pucOutputBuffer;
+    iOutputDataEnd = 0;
+    return iAsyncWriteSize;
+  }
+
+  // Write
+  int __iSentSize = 0;
+  while( __iSentSize < iOutputDataEnd )
+  {
+    __iReturn = ::write( _iFileDescriptor, pucOutputBuffer+__iSentSize, iOutputDataEnd-__iSentSize );
+    if( __iReturn < 0 )
+    {
+      if( errno == EINTR )
+        continue;
+      __iReturn = -errno;
+      // ... keep unwritten data
+      memmove( pucOutputBuffer, pucOutputBuffer+__iSentSize, iOutputDataEnd-__iSentSize );
+      iOutputDataEnd -= __iSentSize;
+      return __iReturn;
+    }
+    __iSentSize += __iReturn;
+  }
+  iOutputDataEnd = 0;
+
+  // Synchronize (group commit)
+  // NOTE: non-synchronizable files (pipes, etc.) are silently ignored
+  if( bOutputBufferSync
+      && fdatasync( _iFileDescriptor ) < 0 && errno != EINVAL )
+    return -errno;
+
+  // Done
+  return __iSentSize;
+}
+
+void CTransmit_File::freeOutputBuffer()
+{
+  if( bAsyncWritePending || bAsyncSyncPending )
+    drainAsync();
+  if( pucOutputBuffer )
+  {
+    oRing.unregisterBuffers();
+    // NOTE: in asynchronous mode, both buffers share the same allocation
+    ::free( ( pucOutputBufferPending && pucOutputBufferPending < pucOutputBuffer )
+            ? pucOutputBufferPending
+            : pucOutputBuffer );
+    pucOutputBuffer = NULL;
+    pucOutputBufferPending = NULL;
+  }
+  iOutputDataEnd = 0;
+  iAsyncWriteStart = 0;
+  iAsyncWriteSize = 0;
+}
+
+int CTransmit_File::readChunk( int _iFileDescriptor,
+                               void *_pBuffer,
+                               int _iSize )
+{
+  int __iReturn;
+
+  // Read (synchronous)
+  if( !bAsync )
+  {
+    __iReturn = ::read( _iFileDescriptor, _pBuffer, _iSize );
+    return ( __iReturn < 0 ) ? -errno : __iReturn;
+  }
+
+  // Read ahead
+  if( iReadAheadDataStart >= iReadAheadDataEnd )
+  {
+    // ... buffer (registration failures are ignored)
+    if( !pucReadAheadBuffer )
+    {
+      pucReadAheadBuffer = (unsigned char*)malloc( 2 * READ_AHEAD_SIZE * sizeof( unsigned char ) );
+      if( !pucReadAheadBuffer )
+        return -ENOMEM;
+      struct iovec __ptBuffers[2] = { { pucReadAheadBuffer, (size_t)READ_AHEAD_SIZE },
+                                      { pucReadAheadBuffer+READ_AHEAD_SIZE, (size_t)READ_AHEAD_SIZE } };
+      oRing.registerBuffers( __ptBuffers, 2 );
+      iReadAheadHalf = 0;
+    }
+
+    // ... wait for the pending read (queuing it first if need be)
+    if( !bAsyncReadPending )
+    {
+      __iReturn = queueReadAhead( _iFileDescriptor );
+      if( __iReturn < 0 )
+        return __iReturn;
+    }
+    while( bAsyncReadPending )
+    {
+      __iReturn = completeAsync( true );
+      if( __iReturn < 0 )
+        return __iReturn;
+    }
+    if( iAsyncReadResult <= 0 )
+      return iAsyncReadResult;
+
+    // ... switch halves and read the next data ahead
+    iReadAheadHalf ^= 1;
+    iReadAheadDataStart = 0;
+    iReadAheadDataEnd = iAsyncReadResult;
+    __iReturn = queueReadAhead( _iFileDescriptor );
+    if( __iReturn < 0 )
+      return __iReturn;
+  }
+
+  // Copy
+  if( _iSize > iReadAheadDataEnd - iReadAheadDataStart )
+    _iSize = iReadAheadDataEnd - iReadAheadDataStart;
+  memcpy( _pBuffer, pucReadAheadBuffer + iReadAheadHalf*READ_AHEAD_SIZE + iReadAheadDataStart, _iSize );
+  iReadAheadDataStart += _iSize;
+  return _iSize;
+}
+
+int CTransmit_File::queueReadAhead( int _iFileDescriptor )
+{
+  int __iReturn;
+  __iReturn = oRing.read( _iFileDescriptor,
+                          pucReadAheadBuffer + ( iReadAheadHalf^1 )*READ_AHEAD_SIZE, READ_AHEAD_SIZE,
+                          ASYNC_READ );
+  if( __iReturn < 0 )
+    return __iReturn;
+  __iReturn = oRing.submit();
+  if( __iReturn < 0 )
+    return __iReturn;
+  bAsyncReadPending = true;
+  return 0;
+}
+
+int CTransmit_File::completeAsync( bool _bWait )
+{
+  int __iReturn;
+  uint64_t __ui64tOperation;
+  int __iResult;
+  __iReturn = oRing.complete( &__ui64tOperation, &__iResult, _bWait );
+  if( __iReturn <= 0 )
+    return __iReturn;
+  switch( __ui64tOperation )
+  {
+  case ASYNC_READ:
+    bAsyncReadPending = false;
+    iAsyncReadResult = __iResult;
+    break;
+  case ASYNC_WRITE:
+    bAsyncWritePending = false;
+    iAsyncWriteResult = __iResult;
+    break;
+  case ASYNC_SYNC:
+    bAsyncSyncPending = false;
+    iAsyncSyncResult = __iResult;
+    break;
+  case ASYNC_CANCEL:
+    bAsyncCancelPending = false;
+    break;
+  default:;
+  }
+  return 1;
+}
+
+int CTransmit_File::waitAsyncWrite( int _iFileDescriptor )
+{
+  int __iReturn;
+
+  // Wait for completion
+  while( bAsyncWritePending || bAsyncSyncPending )
+  {
+    __iReturn = completeAsync( true );
+    if( __iReturn < 0 )
+      return __iReturn;
+  }
+  if( !iAsyncWriteSize )
+    return 0;
+  if( iAsyncWriteResult > 0 )
+    iAsyncWriteStart += iAsyncWriteResult;
+  iAsyncWriteResult = 0;
+
+  // Write the remainder (after a failed or incomplete write)
+  // NOTE: the linked data synchronization is then canceled by the kernel
+  if( iAsyncWriteStart < iAsyncWriteSize )
+  {
+    while( iAsyncWriteStart < iAsyncWriteSize )
+    {
+      __iReturn = ::write( _iFileDescriptor, pucOutputBufferPending+iAsyncWriteStart, iAsyncWriteSize-iAsyncWriteStart );
+      if( __iReturn < 0 )
+      {
+        if( errno == EINTR )
+          continue;
+        return -errno;
+      }
+      iAsyncWriteStart += __iReturn;
+    }
+    if( bOutputBufferSync )
+      iAsyncSyncResult = ( fdatasync( _iFileDescriptor ) < 0 ) ? -errno : 0;
+  }
+  iAsyncWriteStart = 0;
+  iAsyncWriteSize = 0;
+
+  // Synchronize (group commit)
+  // NOTE: non-synchronizable files (pipes, etc.) are silently ignored
+  if( bOutputBufferSync && iAsyncSyncResult < 0 && iAsyncSyncResult != -EINVAL )
+    return iAsyncSyncResult;
+
+  // Done
+  return 0;
+}
+
+void CTransmit_File::drainAsync()
+{
+  if( !oRing.isInitialized() )
+    return;
+  if( bAsyncReadPending && !bAsyncCancelPending
+      && oRing.cancel( ASYNC_READ, ASYNC_CANCEL ) >= 0 )
+  {
+    bAsyncCancelPending = true;
+    oRing.submit();
+  }
+  while( bAsyncReadPending || bAsyncCancelPending || bAsyncWritePending || bAsyncSyncPending )
+  {
+    if( completeAsync( true ) < 0 )
+      break;
+  }
+}
+
+void CTransmit_File::freeAsync()
+{
+  drainAsync();
+  if( pucReadAheadBuffer )
+  {
+    oRing.unregisterBuffers();
+    ::free( pucReadAheadBuffer );
+    pucReadAheadBuffer = NULL;
+  }
+  iReadAheadHalf = 0;
+  iReadAheadDataStart = 0;
+  iReadAheadDataEnd = 0;
+  iAsyncReadResult = 0;
+}
+
+int CTransmit_File::readFile( int _iFileDescriptor,
+                              void *_pBuffer,
+                              int _iSize )
+{
+  int __iReturn;
+  int __iReceivedSize = 0;
+  while( __iReceivedSize < _iSize )
+  {
+    __iReturn = readChunk( _iFileDescriptor, (unsigned char*)_pBuffer+__iReceivedSize, _iSize-__iReceivedSize );
+    if( __iReturn < 0 )
+    {
+      if( __iReturn == -EINTR )
+        continue;
+      return __iReturn;
+    }
+    if( !__iReturn )
+      break;
+    __iReceivedSize += __iReturn;
+    ui64tFileOffset += __iReturn;
+  }
+  return __iReceivedSize;
+}
+
+int CTransmit_File::pullFile( int _iFileDescriptor,
+                              void *_pBuffer,
+                              int _iSize,
+                              const unsigned char **_ppucData )
+{
+  int __iReturn;
+
+  // Read
+  if( !bMapped )
+  {
+    *_ppucData = (const unsigned char*)_pBuffer;
+    return readFile( _iFileDescriptor, _pBuffer, _iSize );
+  }
+
+  // Map
+  __iReturn = mapFile( _iFileDescriptor, ui64tFileOffset, _iSize, _ppucData );
+  if( __iReturn <= 0 )
+    return __iReturn;
+  if( __iReturn > _iSize )
+    __iReturn = _iSize;
+  ui64tFileOffset += __iReturn;
+  return __iReturn;
+}
+
+int CTransmit_File::mapFile( int _iFileDescriptor,
+                             uint64_t _ui64tOffset,
+                             int _iSize,
+                             const unsigned char **_ppucData )
+{
+  // Check mapping (window)
+  if( !pucMapping
+      || _ui64tOffset < ui64tMappingOffset
+      || _ui64tOffset + _iSize > ui64tMappingOffset + iMappingSize )
+  {
+    // ... file size (which may have grown since the last mapping)
+    if( _ui64tOffset + _iSize > ui64tFileSize )
+    {
+      struct stat __tStat;
+      if( fstat( _iFileDescriptor, &__tStat ) < 0 )
+        return -errno;
+      if( !S_ISREG( __tStat.st_mode ) )
+        return -ENODEV;
+      ui64tFileSize = __tStat.st_size;
+    }
+    if( _ui64tOffset >= ui64tFileSize )
+      return 0;
+
+    // ... (re-)map (if more data may be made available)
+    uint64_t __ui64tMappingOffset = _ui64tOffset & ~(uint64_t)( sysconf( _SC_PAGESIZE ) - 1 );
+    uint64_t __ui64tMappingEnd = __ui64tMappingOffset + MAPPING_SIZE;
+    if( __ui64tMappingEnd > ui64tFileSize )
+      __ui64tMappingEnd = ui64tFileSize;
+    if( !pucMapping
+        || _ui64tOffset < ui64tMappingOffset
+        || __ui64tMappingEnd > ui64tMappingOffset + iMappingSize )
+    {
+      unmapFile();
+      void *__pMapping = mmap( NULL, __ui64tMappingEnd - __ui64tMappingOffset,
+                               PROT_READ, MAP_SHARED | MAP_POPULATE,
+                               _iFileDescriptor, __ui64tMappingOffset );
+      if( __pMapping == MAP_FAILED )
+        return -errno;
+      madvise( __pMapping, __ui64tMappingEnd - __ui64tMappingOffset, MADV_SEQUENTIAL );
+      pucMapping = (unsigned char*)__pMapping;
+      iMappingSize = __ui64tMappingEnd - __ui64tMappingOffset;
+      ui64tMappingOffset = __ui64tMappingOffset;
+    }
+  }
+
+  // Done
+  *_ppucData = pucMapping + ( _ui64tOffset - ui64tMappingOffset );
+  return ui64tMappingOffset + iMappingSize - _ui64tOffset;
+}
+
+void CTransmit_File::unmapFile()
+{
+  if( pucMapping )
+  {
+    munmap( pucMapping, iMappingSize );
+    pucMapping = NULL;
+  }
+  iMappingSize = 0;
+  ui64tMappingOffset = 0;
+}
+
+int CTransmit_File::allocBlock()
+{
+  if( !pucBlockBuffer )
+  {
+    pucBlockBuffer = (unsigned char*)malloc( BLOCK_BUFFER_SIZE * sizeof( unsigned char ) );
+    if( !pucBlockBuffer )
+      return -ENOMEM;
+  }
+  if( !pucBlockBufferCompressed )
+  {
+    pucBlockBufferCompressed = (unsigned char*)malloc( ( BLOCK_HEADER_SIZE + CCompressor::bound( BLOCK_BUFFER_SIZE ) ) * sizeof( unsigned char ) );
+    if( !pucBlockBufferCompressed )
+      return -ENOMEM;
+  }
+  return 0;
+}
+
+void CTransmit_File::freeBlock()
+{
+  if( pucBlockBuffer )
+  {
+    ::free( pucBlockBuffer );
+    pucBlockBuffer = NULL;
+  }
+  if( pucBlockBufferCompressed )
+  {
+    ::free( pucBlockBufferCompressed );
+    pucBlockBufferCompressed = NULL;
+  }
+  bCompressed = false;
+  iBlockDataStart = 0;
+  iBlockDataEnd = 0;
+  ui64tFileOffset = 0;
+  ucBlockIndex_vector.clear();
+  bBlockIndexSent = false;
+}
+
+int CTransmit_File::sendBlock( int _iFileDescriptor )
+{
+  int __iReturn;
+
+  // Check block
+  if( !iBlockDataEnd )
+    return 0;
+
+  // Compress block
+  uint8_t __ui8tCompressionType = ui8tCompressionType;
+  __iReturn = CCompressor::compress( __ui8tCompressionType,
+                                     pucBlockBuffer, iBlockDataEnd,
+                                     pucBlockBufferCompressed+BLOCK_HEADER_SIZE,
+                                     CCompressor::bound( BLOCK_BUFFER_SIZE ) );
+  if( __iReturn < 0 && __iReturn != -ENOSPC )
+    return __iReturn;
+  if( __iReturn < 0 || __iReturn >= iBlockDataEnd )
+  {
+    // ... store uncompressible data as is
+    __ui8tCompressionType = CCompressor::COMPRESSION_NONE;
+    memcpy( pucBlockBufferCompressed+BLOCK_HEADER_SIZE, pucBlockBuffer, iBlockDataEnd );
+    __iReturn = iBlockDataEnd;
+  }
+  uint32_t __ui32tCompressedSize = __iReturn;
+
+  // Block header
+  pucBlockBufferCompressed[0] = BLOCK_DATA;
+  pucBlockBufferCompressed[1] = __ui8tCompressionType;
+  pucBlockBufferCompressed[2] = 0;
+  pucBlockBufferCompressed[3] = 0;
+  // NOTE: multi-byte fields are (possibly) unaligned; let's use memcpy
+  uint32_t __ui32tCompressedSize_NS = htonl( __ui32tCompressedSize );
+  uint32_t __ui32tDataSize_NS = htonl( iBlockDataEnd );
+  memcpy( pucBlockBufferCompressed+4, &__ui32tCompressedSize_NS, 4 );
+  memcpy( pucBlockBufferCompressed+8, &__ui32tDataSize_NS, 4 );
+
+  // Block index entry
+  unsigned char __pucIndexEntry[BLOCK_INDEX_ENTRY_SIZE];
+  uint32_t __ui32tOffsetHigh_NS = htonl( ui64tFileOffset >> 32 );
+  uint32_t __ui32tOffsetLow_NS = htonl( ui64tFileOffset & 0xFFFFFFFF );
+  memcpy( __pucIndexEntry, &__ui32tOffsetHigh_NS, 4 );
+  memcpy( __pucIndexEntry+4, &__ui32tOffsetLow_NS, 4 );
+  memcpy( __pucIndexEntry+8, &__ui32tCompressedSize_NS, 4 );
+  memcpy( __pucIndexEntry+12, &__ui32tDataSize_NS, 4 );
+
+  // Write block
+  __iReturn = writeFile( _iFileDescriptor, pucBlockBufferCompressed, BLOCK_HEADER_SIZE+__ui32tCompressedSize );
+  if( __iReturn < 0 )
+    return __iReturn;
+  ucBlockIndex_vector.insert( ucBlockIndex_vector.end(), __pucIndexEntry, __pucIndexEntry+BLOCK_INDEX_ENTRY_SIZE );
+  iBlockDataEnd = 0;
+
+  // Done
+  return __iReturn;
+}
+
+int CTransmit_File::sendBlockIndex( int _iFileDescriptor )
+{
+  int __iReturn;
+  int __iSentSize = 0;
+  uint32_t __ui32tValue_NS;
+
+  // Header
+  uint32_t __ui32tIndexSize = ucBlockIndex_vector.size() + 8;
+  unsigned char __pucBlockHeader[BLOCK_HEADER_SIZE];
+  __pucBlockHeader[0] = BLOCK_INDEX;
+  __pucBlockHeader[1] = CCompressor::COMPRESSION_NONE;
+  __pucBlockHeader[2] = 0;
+  __pucBlockHeader[3] = 0;
+  __ui32tValue_NS = htonl( __ui32tIndexSize );
+  memcpy( __pucBlockHeader+4, &__ui32tValue_NS, 4 );
+  memcpy( __pucBlockHeader+8, &__ui32tValue_NS, 4 );
+  __iReturn = writeFile( _iFileDescriptor, __pucBlockHeader, BLOCK_HEADER_SIZE );
+  if( __iReturn < 0 )
+    return __iReturn;
+  __iSentSize += __iReturn;
+
+  // Entries
+  if( !ucBlockIndex_vector.empty() )
+  {
+    __iReturn = writeFile( _iFileDescriptor, ucBlockIndex_vector.data(), ucBlockIndex_vector.size() );
+    if( __iReturn < 0 )
+      return __iReturn;
+    __iSentSize += __iReturn;
+  }
+
+  // Footer (entries quantity and signature)
+  unsigned char __pucIndexFooter[8];
+  __ui32tValue_NS = htonl( ucBlockIndex_vector.size() / BLOCK_INDEX_ENTRY_SIZE );
+  memcpy( __pucIndexFooter, &__ui32tValue_NS, 4 );
+  memcpy( __pucIndexFooter+4, "SGIX", 4 );
+  __iReturn = writeFile( _iFileDescriptor, __pucIndexFooter, 8 );
+  if( __iReturn < 0 )
+    return __iReturn;
+  __iSentSize += __iReturn;
+  bBlockIndexSent = true;
+
+  // Done
+  return __iSentSize;
+}
+
+int CTransmit_File::recvBlock( int _iFileDescriptor )
+{
+  int __iReturn;
+
+  // Check resources
+  if( !pucBlockBuffer )
+  {
+    __iReturn = allocBlock();
+    if( __iReturn < 0 )
+      return __iReturn;
+  }
+  iBlockDataStart = 0;
+  iBlockDataEnd = 0;
+
+  // Read block
+  int __iCompressedBufferSize = CCompressor::bound( BLOCK_BUFFER_SIZE );
+  for(;;)
+  {
+    // ... header
+    unsigned char __pucBlockHeaderBuffer[BLOCK_HEADER_SIZE];
+    const unsigned char *__pucBlockHeader;
+    __iReturn = pullFile( _iFileDescriptor, __pucBlockHeaderBuffer, BLOCK_HEADER_SIZE, &__pucBlockHeader );
+    if( __iReturn != BLOCK_HEADER_SIZE )
+      return
+        ( __iReturn <= 0 )
+        ? __iReturn
+        : -EPROTO;
+    // NOTE: the block header is (possibly) unaligned (memory-mapped file); let's use memcpy
+    uint32_t __ui32tCompressedSize_NS, __ui32tDataSize_NS;
+    memcpy( &__ui32tCompressedSize_NS, __pucBlockHeader+4, 4 );
+    memcpy( &__ui32tDataSize_NS, __pucBlockHeader+8, 4 );
+    uint32_t __ui32tCompressedSize = ntohl( __ui32tCompressedSize_NS );
+    uint32_t __ui32tDataSize = ntohl( __ui32tDataSize_NS );
+    uint8_t __ui8tCompressionType = __pucBlockHeader[1];
+
+    // ... block index (skip)
+    if( __pucBlockHeader[0] == BLOCK_INDEX )
+    {
+      while( __ui32tCompressedSize )
+      {
+        int __iSize =
+          ( __ui32tCompressedSize < (uint32_t)__iCompressedBufferSize )
+          ? __ui32tCompressedSize
+          : __iCompressedBufferSize;
+        const unsigned char *__pucData;
+        __iReturn = pullFile( _iFileDescriptor, pucBlockBufferCompressed, __iSize, &__pucData );
+        if( __iReturn != __iSize )
+          return
+            ( __iReturn < 0 )
+            ? __iReturn
+            : -EPROTO;
+        __ui32tCompressedSize -= __iSize;
+      }
+      continue;
+    }
+
+    // ... data
+    if( __pucBlockHeader[0] != BLOCK_DATA
+        || __ui32tCompressedSize > (uint32_t)__iCompressedBufferSize
+        || __ui32tDataSize > (uint32_t)BLOCK_BUFFER_SIZE )
+      return -EPROTO;
+    // NOTE: in memory-mapped mode, data are decompressed directly from the mapping
+    const unsigned char *__pucData;
+    __iReturn = pullFile( _iFileDescriptor, pucBlockBufferCompressed, __ui32tCompressedSize, &__pucData );
+    if( __iReturn != (int)__ui32tCompressedSize )
+      return
+        ( __iReturn < 0 )
+        ? __iReturn
+        : -EPROTO;
+    __iReturn = CCompressor::decompress( __ui8tCompressionType,
+                                         __pucData, __ui32tCompressedSize,
+                                         pucBlockBuffer, BLOCK_BUFFER_SIZE );
+    if( __iReturn < 0 )
+      return __iReturn;
+    if( __iReturn != (int)__ui32tDataSize )
+      return -EPROTO;
+    if( __iReturn )
+      break;
+  }
+  iBlockDataEnd = __iReturn;
+
+  // Done
+  return __iReturn;
+}
+
+int CTransmit_File::sendFileHeader( int _iFileDescriptor )
+{
+  int __iReturn;
+
+  // Check header
+  if( bFileHeaderSent || !( bFramed || ui8tCompressionType ) )
+    return 0;
+
+  // Create header
+  unsigned char __pucFileHeader[FILE_HEADER_SIZE];
+  memcpy( __pucFileHeader, "SGCTP", 5 );
+  __pucFileHeader[5] = PROTOCOL_VERSION;
+  __pucFileHeader[6] =
+    ( bFramed ? FILE_FLAG_FRAMED : 0 )
+    | ( ui8tCompressionType ? FILE_FLAG_COMPRESSED : 0 );
+
+  // Send header
+  __iReturn = send( _iFileDescriptor, __pucFileHeader, FILE_HEADER_SIZE, 0 );
+  if( __iReturn != FILE_HEADER_SIZE )
+    return
+      ( __iReturn < 0 )
+      ? __iReturn
+      : -EIO;
+  bFileHeaderSent = true;
+
+  // Done
+  return FILE_HEADER_SIZE;
+}
+
+int CTransmit_File::recvFileHeader( int _iFileDescriptor )
+{
+  int __iReturn;
+
+  // Check header
+  if( bFileHeaderReceived )
+    return 0;
+  if( !pucBuffer )
+  {
+    __iReturn = alloc();
+    if( __iReturn < 0 )
+      return __iReturn;
+  }
+
+  // Receive header
+  // NOTE: a headerless file starts with a payload size, which MAY match the
+  //       signature prefix ("SG" = 0x5347 = 21319 is a valid payload size);
+  //       the 2-byte check is thus only a cheap pre-filter, the 5-byte "SGCTP"
+  //       signature deciding. The looked-ahead bytes are left in the receive
+  //       buffer and handed back to payload parsing for headerless files.
+  __iReturn = recvBuffer( _iFileDescriptor, 2 );
+  if( __iReturn != 2 )
+    return
+      ( __iReturn <= 0 )
+      ? __iReturn
+      : -EPROTO;
+  bool __bFileHeader = !memcmp( pucBuffer+iBufferDataStart, "SG", 2 );
+  if( __bFileHeader )
+  {
+    __iReturn = recvBuffer( _iFileDescriptor, FILE_HEADER_SIZE );
+    if( __iReturn != FILE_HEADER_SIZE )
+      return
+        ( __iReturn < 0 )
+        ? __iReturn
+        : -EPROTO;
+    __bFileHeader = !memcmp( pucBuffer+iBufferDataStart, "SGCTP", 5 );
+  }
+  bFileHeaderReceived = true;
+  if( !__bFileHeader )
+    return setFramed( false );
+
+  // Parse header
+  const unsigned char *__pucFileHeader = pullBuffer( FILE_HEADER_SIZE );
+  if( __pucFileHeader[5] != PROTOCOL_VERSION )
+    return -EPROTO;
+  __iReturn = setFramed( __pucFileHeader[6] & FILE_FLAG_FRAMED );
+  if( __iReturn < 0 )
+    return __iReturn;
+  bCompressed = __pucFileHeader[6] & FILE_FLAG_COMPRESSED;
+  iFileHeaderSize = FILE_HEADER_SIZE;
+
+  // Done
+  return FILE_HEADER_SIZE;
+}
@@ -70,6 +70,22 @@ int CTransmit_TCP::send( int _iSocket,
     : -errno;
 }
 
+int CTransmit_TCP::sendv( int _iSocket,
+                          const struct iovec *_ptIovec,
+                          int _iIovecCount,
+                          int _iFlags )
+{
+  struct msghdr __tMsghdr;
+  memset( &__tMsghdr, 0, sizeof( __tMsghdr ) );
+  __tMsghdr.msg_iov = (struct iovec*)_ptIovec;
+  __tMsghdr.msg_iovlen = _iIovecCount;
+  int __iReturn = ::sendmsg( _iSocket, &__tMsghdr, _iFlags );
+  return
+    ( __iReturn >= 0 )
+    ? __iReturn
+    : -errno;
+}
+
 int CTransmit_TCP::recv( int _iSocket,
                          void *_pBuffer,
                          int _iSize,
@@ -87,48 +103,9 @@ int CTransmit_TCP::alloc()
   return CTransmit::allocBuffer();
 }
 
-int CTransmit_TCP::serialize( int _iSocket,
-                              const CData &_roData )
-{
-  int __iReturn;
-  int __iExit;
-
-  // Standard serialization
-  __iReturn = CTransmit::serialize( _iSocket, _roData );
-  if( __iReturn <= 0 )
-    return __iReturn;
-  __iExit = __iReturn;
-
-  // Cryptographic key incrementation
-  switch( ePayloadType )
-  {
-
-  case PAYLOAD_AES128:
-    __iReturn = ((CPayload_AES128*)poPayload)->incrCryptoKey();
-    if( __iReturn )
-      return __iReturn;
-    break;
-
-  default:;
-
-  }
-
-  // Done
-  return __iExit;
-}
-
-int CTransmit_TCP::unserialize( int _iSocket,
-                                CData *_poData,
-                                int _iMaxSize )
+int CTransmit_TCP::nextPayload()
 {
   int __iReturn;
-  int __iExit;
-
-  // Standard unserialization
-  __iReturn = CTransmit::unserialize( _iSocket, _poData, _iMaxSize );
-  if( __iReturn <= 0 )
-    return __iReturn;
-  __iExit = __iReturn;
 
   // Cryptographic key incrementation
   switch( ePayloadType )
@@ -145,7 +122,7 @@ int CTransmit_TCP::unserialize( int _iSocket,
   }
 
   // Done
-  return __iExit;
+  return 0;
 }
 
 
@@ -184,9 +161,20 @@ int CTransmit_TCP::sendHandshake( int _iSocket )
       return __iReturn;
   }
 
+  // Reset payload state (encoder and decoder; see recvHandshake())
+  // NOTE: the transmission object may be re-used across (re-)connections
+  poPayload->reset();
+
+  // Discard pending (unsent) payloads (previous connection)
+  resetBatch();
+
   // Set socket timeout
   setTimeout( _iSocket, 3.0 ); // prevent DoS
 
+  // Framed mode (requested; used only after handshake)
+  bool __bFramed = bFramed;
+  setFramed( false );
+
   // Error-catching block
   int __iError = 1;
   int __iPayloadSize = 0;
@@ -216,7 +204,8 @@ int CTransmit_TCP::sendHandshake( int _iSocket )
     __iPayloadSize += 1;
 
     // ... payload type
-    *((uint8_t*)(pucBuffer+__iPayloadSize)) = (uint8_t)ePayloadType;
+    *((uint8_t*)(pucBuffer+__iPayloadSize)) =
+      (uint8_t)ePayloadType | ( __bFramed ? HANDSHAKE_FLAG_FRAMED : 0 );
     __iPayloadSize += 1;
 
     // ... principal ID
@@ -337,6 +326,9 @@ int CTransmit_TCP::sendHandshake( int _iSocket )
   // Reset buffer (for reception)
   resetBuffer();
 
+  // Framed mode
+  setFramed( __bFramed );
+
   // Done
   return
     ( __iError <= 0 )
@@ -356,9 +348,16 @@ int CTransmit_TCP::recvHandshake( int _iSocket )
       return __iReturn;
   }
 
+  // Discard pending (unsent) payloads (previous connection)
+  resetBatch();
+
   // Set socket timeout
   setTimeout( _iSocket, 3.0 ); // prevent DoS
 
+  // Framed mode (requested by client; used only after handshake)
+  bool __bFramed = false;
+  setFramed( false );
+
   // Error-catching block
   int __iError = 1;
   int __iPayloadSize = 0;
@@ -403,6 +402,8 @@ int CTransmit_TCP::recvHandshake( int _iSocket )
     uint8_t __ui8tPayloadType =
       *((uint8_t*)(__pucHandshakeBuffer+__iPayloadSize));
     __iPayloadSize += 1;
+    __bFramed = __ui8tPayloadType & HANDSHAKE_FLAG_FRAMED;
+    __ui8tPayloadType &= ~HANDSHAKE_FLAG_FRAMED;
 
     // ... principal ID
     uint64_t __ui64tPrincipalID =
@@ -424,6 +425,7 @@ int CTransmit_TCP::recvHandshake( int _iSocket )
     }
 
     // Initialize payload
+    // NOTE: (re-)initialization resets the payload state (see sendHandshake())
     __iReturn = initPayload( __ui8tPayloadType );
     if( __iReturn < 0 )
     {
@@ -532,6 +534,10 @@ int CTransmit_TCP::recvHandshake( int _iSocket )
   // Reset buffer (for reception)
   resetBuffer();
 
+  // Framed mode
+  if( __iError > 0 )
+    setFramed( __bFramed );
+
   // Done
   return
     ( __iError <= 0 )
@@ -19,9 +19,14 @@
 
 // C
 #include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <arpa/inet.h>
 #include <sys/socket.h>
 
 // SGCTP
+#include "sgctp/data.hpp"
+#include "sgctp/data_block.hpp"
 #include "sgctp/payload.hpp"
 #include "sgctp/transmit_udp.hpp"
 using namespace SGCTP;
@@ -44,6 +49,24 @@ int CTransmit_UDP::send( int _iSocket,
     : -errno;
 }
 
+int CTransmit_UDP::sendv( int _iSocket,
+                          const struct iovec *_ptIovec,
+                          int _iIovecCount,
+                          int _iFlags )
+{
+  struct msghdr __tMsghdr;
+  memset( &__tMsghdr, 0, sizeof( __tMsghdr ) );
+  __tMsghdr.msg_name = ptSockaddr;
+  __tMsghdr.msg_namelen = *ptSocklenT;
+  __tMsghdr.msg_iov = (struct iovec*)_ptIovec;
+  __tMsghdr.msg_iovlen = _iIovecCount;
+  int __iReturn = ::sendmsg( _iSocket, &__tMsghdr, _iFlags );
+  return
+    ( __iReturn >= 0 )
+    ? __iReturn
+    : -errno;
+}
+
 int CTransmit_UDP::recv( int _iSocket,
                          void *_pBuffer,
                          int _iSize,
@@ -62,6 +85,77 @@ int CTransmit_UDP::alloc()
   return CTransmit::allocBuffer();
 }
 
+int CTransmit_UDP::serializeBatch( int _iDescriptor,
+                                   const CData *_poData,
+                                   int _iDataCount )
+{
+  int __iReturn;
+
+  // Check resources
+  if( !poPayload )
+    return -ENODATA;
+  if( !pucDatagramBuffers )
+  {
+    __iReturn = allocDatagrams();
+    if( __iReturn < 0 )
+      return __iReturn;
+  }
+
+  // Serialize (one datagram per payload)
+  struct mmsghdr __ptMmsghdr[DATAGRAM_BATCH_SIZE];
+  struct iovec __ptIovec[DATAGRAM_BATCH_SIZE];
+  int __iSentSize = 0;
+  for( int __iDataStart = 0; __iDataStart < _iDataCount; __iDataStart += DATAGRAM_BATCH_SIZE )
+  {
+    int __iDatagramCount = _iDataCount - __iDataStart;
+    if( __iDatagramCount > DATAGRAM_BATCH_SIZE )
+      __iDatagramCount = DATAGRAM_BATCH_SIZE;
+
+    // ... create payloads (size and content)
+    memset( __ptMmsghdr, 0, __iDatagramCount * sizeof( struct mmsghdr ) );
+    for( int __i = 0; __i < __iDatagramCount; __i++ )
+    {
+      unsigned char *__pucDatagram = pucDatagramBuffers + __i * CPayload::BATCH_FRAME_SIZE;
+      __iReturn = poPayload->serialize( __pucDatagram+2, _poData[__iDataStart+__i] );
+      if( __iReturn < 0 )
+        return __iReturn;
+      uint16_t __ui16tPayloadSize_NS = htons( __iReturn );
+      memcpy( __pucDatagram, &__ui16tPayloadSize_NS, 2 );
+      __ptIovec[__i].iov_base = __pucDatagram;
+      __ptIovec[__i].iov_len = __iReturn+2;
+      __ptMmsghdr[__i].msg_hdr.msg_name = ptSockaddr;
+      __ptMmsghdr[__i].msg_hdr.msg_namelen = ptSocklenT ? *ptSocklenT : 0;
+      __ptMmsghdr[__i].msg_hdr.msg_iov = &__ptIovec[__i];
+      __ptMmsghdr[__i].msg_hdr.msg_iovlen = 1;
+      __iReturn = nextPayload();
+      if( __iReturn < 0 )
+        return __iReturn;
+    }
+
+    // ... send datagrams
+    int __iDatagramSent = 0;
+    while( __iDatagramSent < __iDatagramCount )
+    {
+      __iReturn = ::sendmmsg( _iDescriptor,
+                              __ptMmsghdr+__iDatagramSent,
+                              __iDatagramCount-__iDatagramSent,
+                              0 );
+      if( __iReturn < 0 )
+      {
+        if( errno == EINTR )
+          continue;
+        return -errno;
+      }
+      for( int __i = __iDatagramSent; __i < __iDatagramSent+__iReturn; __i++ )
+        __iSentSize += __ptMmsghdr[__i].msg_len;
+      __iDatagramSent += __iReturn;
+    }
+  }
+
+  // Done
+  return __iSentSize;
+}
+
 int CTransmit_UDP::unserialize( int _iDescriptor,
                                 CData *_poData,
                                 int _iMaxSize )
@@ -78,3 +172,167 @@ int CTransmit_UDP::unserialize( int _iDescriptor,
   return __iReturn;
 }
 
+int CTransmit_UDP::tryUnserialize( int _iDescriptor,
+                                   CData *_poData,
+                                   int _iMaxSize )
+{
+  // Unserialize
+  int __iReturn = CTransmit::tryUnserialize( _iDescriptor,
+                                             _poData,
+                                             _iMaxSize );
+  if( __iReturn == -EAGAIN && hasData() )
+    __iReturn = -EPROTO; // incomplete datagram
+
+  // Discard remaining buffer data (NOTE: help recover from corrupted data)
+  resetBuffer();
+
+  // Done
+  return __iReturn;
+}
+
+int CTransmit_UDP::unserializeBatch( int _iDescriptor,
+                                     CDataBlock *_poDataBlock,
+                                     int _iMaxSize )
+{
+  int __iReturn;
+
+  // Check resources
+  if( !poPayload )
+    return -ENODATA;
+  if( !pucDatagramBuffers )
+  {
+    __iReturn = allocDatagrams();
+    if( __iReturn < 0 )
+      return __iReturn;
+  }
+  if( _poDataBlock->isFull() )
+    return -ENOSPC;
+  iDatagramCount = 0;
+
+  // Receive datagrams (blocking only for the first one)
+  int __iDatagramCount = _poDataBlock->getCapacity() - _poDataBlock->getSize();
+  if( __iDatagramCount > DATAGRAM_BATCH_SIZE )
+    __iDatagramCount = DATAGRAM_BATCH_SIZE;
+  struct mmsghdr __ptMmsghdr[DATAGRAM_BATCH_SIZE];
+  struct iovec __ptIovec[DATAGRAM_BATCH_SIZE];
+  memset( __ptMmsghdr, 0, __iDatagramCount * sizeof( struct mmsghdr ) );
+  for( int __i = 0; __i < __iDatagramCount; __i++ )
+  {
+    __ptIovec[__i].iov_base = pucDatagramBuffers + __i * CPayload::BATCH_FRAME_SIZE;
+    __ptIovec[__i].iov_len = CPayload::BATCH_FRAME_SIZE;
+    __ptMmsghdr[__i].msg_hdr.msg_name = &ptDatagrams[__i].tSockaddr;
+    __ptMmsghdr[__i].msg_hdr.msg_namelen = sizeof( struct sockaddr_storage );
+    __ptMmsghdr[__i].msg_hdr.msg_iov = &__ptIovec[__i];
+    __ptMmsghdr[__i].msg_hdr.msg_iovlen = 1;
+  }
+  __iReturn = ::recvmmsg( _iDescriptor, __ptMmsghdr, __iDatagramCount, MSG_WAITFORONE, NULL );
+  if( __iReturn < 0 )
+    return -errno;
+  iDatagramCount = __iReturn;
+
+  // Parse payloads
+  int __iReceivedSize = 0;
+  int __iError = 0;
+  for( int __i = 0; __i < iDatagramCount; __i++ )
+  {
+    TDatagram *__ptDatagram = &ptDatagrams[__i];
+    const unsigned char *__pucDatagram = (const unsigned char*)__ptIovec[__i].iov_base;
+    __ptDatagram->tSocklenT = __ptMmsghdr[__i].msg_hdr.msg_namelen;
+    __ptDatagram->iSize = __ptMmsghdr[__i].msg_len;
+    __ptDatagram->iRecord = -1;
+
+    // ... size
+    uint16_t __ui16tPayloadSize = 0;
+    if( __ptDatagram->iSize >= 2 )
+    {
+      uint16_t __ui16tPayloadSize_NS;
+      memcpy( &__ui16tPayloadSize_NS, __pucDatagram, 2 );
+      __ui16tPayloadSize = ntohs( __ui16tPayloadSize_NS );
+    }
+    if( __ptDatagram->iSize < 2
+        || __ui16tPayloadSize+2 > __ptDatagram->iSize
+        || __ptMmsghdr[__i].msg_hdr.msg_flags & MSG_TRUNC )
+      __iReturn = -EPROTO;
+    else if( _iMaxSize && __ui16tPayloadSize > _iMaxSize )
+      __iReturn = -EMSGSIZE;
+
+    // ... content
+    else
+    {
+      int __iRecord = _poDataBlock->getSize();
+      __iReturn = poPayload->unserialize( _poDataBlock, __pucDatagram+2, __ui16tPayloadSize );
+      if( __iReturn > 0 )
+      {
+        __ptDatagram->iRecord = __iRecord;
+        __iReturn = nextPayload();
+        if( __iReturn < 0 )
+          return __iReturn;
+        __iReturn = __ui16tPayloadSize;
+        __iReceivedSize += __ui16tPayloadSize+2;
+      }
+      else if( __iReturn == 0 )
+        __iReturn = -EPROTO;
+    }
+    __ptDatagram->iStatus = __iReturn;
+    if( __iReturn < 0 && !__iError )
+      __iError = __iReturn;
+  }
+
+  // Save (last) source address
+  if( ptSockaddr && ptSocklenT && iDatagramCount )
+  {
+    TDatagram *__ptDatagram = &ptDatagrams[iDatagramCount-1];
+    if( *ptSocklenT > __ptDatagram->tSocklenT )
+      *ptSocklenT = __ptDatagram->tSocklenT;
+    memcpy( ptSockaddr, &__ptDatagram->tSockaddr, *ptSocklenT );
+  }
+
+  // Done
+  return
+    ( __iReceivedSize > 0 )
+    ? __iReceivedSize
+    : __iError;
+}
+
+void CTransmit_UDP::free()
+{
+  CTransmit::free();
+  freeDatagrams();
+}
+
+
+//----------------------------------------------------------------------
+// METHODS
+//----------------------------------------------------------------------
+
+int CTransmit_UDP::allocDatagrams()
+{
+  if( !pucDatagramBuffers )
+  {
+    pucDatagramBuffers = (unsigned char*)malloc( DATAGRAM_BATCH_SIZE * CPayload::BATCH_FRAME_SIZE * sizeof( unsigned char ) );
+    if( !pucDatagramBuffers )
+      return -ENOMEM;
+  }
+  if( !ptDatagrams )
+  {
+    ptDatagrams = (TDatagram*)malloc( DATAGRAM_BATCH_SIZE * sizeof( TDatagram ) );
+    if( !ptDatagrams )
+      return -ENOMEM;
+  }
+  return 0;
+}
+
+void CTransmit_UDP::freeDatagrams()
+{
+  if( pucDatagramBuffers )
+  {
+    ::free( pucDatagramBuffers );
+    pucDatagramBuffers = NULL;
+  }
+  if( ptDatagrams )
+  {
+    ::free( ptDatagrams );
+    ptDatagrams = NULL;
+  }
+  iDatagramCount = 0;
+}
@@ -26,7 +26,6 @@
 
 // C++
 #include <cmath>
-#include <unordered_map>
 #include <vector>
 using namespace std;
 
@@ -37,6 +36,8 @@ using namespace std;
 #endif
 
 // SGCTP
+#include "sgctp/clock.hpp"
+#include "sgctp/id_table.hpp"
 #include "main.hpp"
 using namespace SGCTP;
 
@@ -93,6 +94,9 @@ void CSgctpUtil::displayHelp()
   cout << "    Use shipname instead of MMSI number" << endl;
   displayOptionPrincipal( false, true );
   displayOptionPayload( false, true );
+  displayOptionCompression();
+  displayOptionOutputBuffer();
+  displayOptionAsync( false, true );
   displayOptionPassword( false, true );
   displayOptionPasswordSalt( false, true );
   displayOptionExtendedContent();
@@ -113,6 +117,9 @@ int CSgctpUtil::parseArgs()
       SGCTP_PARSE_ARGS( parseArgsHelp( &__i ) );
       SGCTP_PARSE_ARGS( parseArgsPrincipal( &__i, false, true ) );
       SGCTP_PARSE_ARGS( parseArgsPayload( &__i, false, true ) );
+      SGCTP_PARSE_ARGS( parseArgsCompression( &__i ) );
+      SGCTP_PARSE_ARGS( parseArgsOutputBuffer( &__i ) );
+      SGCTP_PARSE_ARGS( parseArgsAsync( &__i, false, true ) );
       SGCTP_PARSE_ARGS( parseArgsPassword( &__i, false, true ) );
       SGCTP_PARSE_ARGS( parseArgsPasswordSalt( &__i, false, true ) );
       SGCTP_PARSE_ARGS( parseArgsExtendedContent( &__i ) );
@@ -212,7 +219,8 @@ int CSgctpUtil::exec()
   sigCatch( CSgctpUtil::interrupt );
 
   // Error-catching block
-  unordered_map<string,CData*> __poData_umap;
+  CIDTable __oDataID_table;
+  vector<CData*> __poData_vector;
   do
   {
 
@@ -299,7 +307,7 @@ int CSgctpUtil::exec()
         continue; // We need a valid AIS packet
       if( !ptGpsDataT->ais.mmsi )
         continue; // We need a valid MMSI number
-      double __fdEpochNow = CData::epoch();
+      double __fdEpochNow = CClock::nowCoarse();
 
       // Originating source (ID)
       string __sSource = to_string( ptGpsDataT->ais.mmsi );
@@ -309,46 +317,35 @@ int CSgctpUtil::exec()
       {
         __fdEpochCleanup = __fdEpochNow;
 
-        // ... get keys
-        vector<string> __vsKeys;
-        __vsKeys.reserve( __poData_umap.size() );
-        for( unordered_map<string,CData*>::const_iterator __it =
-               __poData_umap.begin();
-             __it != __poData_umap.end();
-             ++__it )
-        {
-          __vsKeys.push_back( __it->first );
-        }
-
-        // ... loop through keys
-        for( vector<string>::const_iterator __it = __vsKeys.begin();
-             __it != __vsKeys.end();
+        // ... loop through entries
+        for( vector<CData*>::iterator __it = __poData_vector.begin();
+             __it != __poData_vector.end();
              ++__it )
         {
           // ... cleanup stale entries (older than data TTL)
-          if( __fdEpochNow - CData::toEpoch( __poData_umap[ *__it ]->getTime() )
-              > (double)iDataTTL )
+          if( *__it
+              && __fdEpochNow - CData::toEpoch( (*__it)->getTime() ) > (double)iDataTTL )
           {
-            delete __poData_umap[ *__it ];
-            __poData_umap.erase( *__it );
+            delete *__it;
+            *__it = NULL;
+            __oDataID_table.erase( __it - __poData_vector.begin() );
           }
         }
 
       }
 
       // Data map lookup
-      CData* __poData;
-      unordered_map<string,CData*>::const_iterator __it =
-        __poData_umap.find( __sSource );
-      if( __it == __poData_umap.end() )
+      uint32_t __ui32tSource = __oDataID_table.intern( __sSource.c_str() );
+      if( __ui32tSource >= __poData_vector.size() )
+        __poData_vector.resize( __ui32tSource+1, NULL );
+      CData* __poData = __poData_vector[__ui32tSource];
+      if( !__poData )
       {
         __poData = new CData();
         if( bExtendedContent )
           __poData->setSourceType( CData::SOURCE_AIS );
-        __poData_umap[__sSource] = __poData;
+        __poData_vector[__ui32tSource] = __poData;
       }
-      else
-        __poData = __it->second;
 
       // Parse AIS data
       // NOTE: we handle only message types: 1, 2, 3, 5, 18, 19, 24
@@ -480,9 +477,15 @@ int CSgctpUtil::exec()
       if( !strlen( __poData->getID() ) )
         continue;
 
-      // ... serialize
+      // ... serialize (and send pending frames; one GPSD message at a time)
       sigBlock();
       __iReturn = oTransmit_out.serialize( fdOutput, *__poData );
+      if( __iReturn > 0 )
+      {
+        int __iReturnFlush = oTransmit_out.flushFrames( fdOutput );
+        if( __iReturnFlush < 0 )
+          __iReturn = __iReturnFlush;
+      }
       sigUnblock();
       if( __iReturn == 0 )
         SGCTP_BREAK( 0 );
@@ -503,13 +506,15 @@ int CSgctpUtil::exec()
     gps_stream( ptGpsDataT, WATCH_DISABLE, NULL );
     gps_close( ptGpsDataT );
   }
+  if( fdOutput >= 0 )
+    oTransmit_out.finish( fdOutput );
   if( fdOutput >= 0 && fdOutput != STDOUT_FILENO )
     close( fdOutput );
-  for( unordered_map<string,CData*>::const_iterator __it =
-         __poData_umap.begin();
-       __it != __poData_umap.end();
+  for( vector<CData*>::const_iterator __it =
+         __poData_vector.begin();
+       __it != __poData_vector.end();
        ++__it )
-    delete __it->second;
+    delete *__it;
   daemonEnd();
   return __iExit;
 }
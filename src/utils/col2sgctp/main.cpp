@@ -0,0 +1,393 @@
+// INDENTING (emacs/vi): -*- mode:c++; tab-width:2; c-basic-offset:2; intent-tabs-mode:nil; -*- ex: set tabstop=2 expandtab:
+
+/*
+ * Simple Geolocalization and Course Transmission Protocol (SGCTP)
+ * Copyright (C) 2014 Cedric Dufour <http://cedric.dufour.name>
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * free software:
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, Version 3.
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ */
+
+// C
+#include <fcntl.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+// SGCTP
+#include "main.hpp"
+using namespace SGCTP;
+
+
+//----------------------------------------------------------------------
+// STATIC / CONSTANTS
+//----------------------------------------------------------------------
+
+void CSgctpUtil::interrupt( int _iSignal )
+{
+  SGCTP_INTERRUPTED = 1;
+}
+
+
+//----------------------------------------------------------------------
+// CONSTRUCTORS / DESTRUCTOR
+//----------------------------------------------------------------------
+
+CSgctpUtil::CSgctpUtil( int _iArgC, char *_ppcArgV[] )
+  : CSgctpUtilSkeleton( "col2sgctp", _iArgC, _ppcArgV )
+  , fdInput( STDIN_FILENO )
+  , fdOutput( STDOUT_FILENO )
+  , sInputPath( "-" )
+  , sOutputPath( "-" )
+  , ui32tProjection( 0 )
+  , sID( "" )
+  , fdTime1( CData::UNDEFINED_VALUE )
+  , fdLatitude1( CData::UNDEFINED_VALUE )
+  , fdLongitude1( CData::UNDEFINED_VALUE )
+  , fdElevation1( CData::UNDEFINED_VALUE )
+  , fdTime2( CData::UNDEFINED_VALUE )
+  , fdLatitude2( CData::UNDEFINED_VALUE )
+  , fdLongitude2( CData::UNDEFINED_VALUE )
+  , fdElevation2( CData::UNDEFINED_VALUE )
+{
+  // Link actual transmission objects
+  poTransmit_out = &oTransmit_out;
+}
+
+
+//----------------------------------------------------------------------
+// METHODS: CSgctpUtilSkeleton (implement/override)
+//----------------------------------------------------------------------
+
+void CSgctpUtil::displayHelp()
+{
+  // Display full help
+  displayUsageHeader();
+  cout << "  col2sgctp [options] [<path(in)>] [+<field> ...]" << endl;
+  displaySynopsisHeader();
+  cout << "  Convert the columnar archive (*.sgctpc) of the given file (default:'-',"  << endl;
+  cout << "  standard input) back to SGCTP data, limited to the given fields (default:all;" << endl;
+  cout << "  completed with the fields they are transmitted along) and to the records" << endl;
+  cout << "  matching the given filters." << endl;
+  cout << "  Row groups which can not match the filters, as well as non-requested" << endl;
+  cout << "  columns, are skipped without being decoded." << endl;
+  displayOptionsHeader();
+  cout << "  -o, --output <path>" << endl;
+  cout << "    Output file (default:'-', standard output)" << endl;
+  cout << "  -i, --id <ID>"   << endl;
+  cout << "    Source ID (defaut:none)"   << endl;
+  cout << "  -t1, --time-limit-1 <time>"   << endl;
+  cout << "    1st limit time (default:none, time-of-day; date is ignored)"   << endl;
+  cout << "  -lat1, --latitude-limit-1 <latitude>"   << endl;
+  cout << "    1st limit latitude (default:none, degrees)"   << endl;
+  cout << "  -lon1, --longitude-limit-1 <longitude>"   << endl;
+  cout << "    1st limit longitude (default:none, degrees)"   << endl;
+  cout << "  -ele1, --elevation-limit-1 <elevation>"   << endl;
+  cout << "    1st limit elevation (default:none, meters)"   << endl;
+  cout << "  -t2, --time-limit-2 <time>"   << endl;
+  cout << "    2nd limit time (default:none, time-of-day; date is ignored)"   << endl;
+  cout << "  -lat2, --latitude-limit-2 <latitude>"   << endl;
+  cout << "    2nd limit latitude (default:none, degrees)"   << endl;
+  cout << "  -lon2, --longitude-limit-2 <longitude>"   << endl;
+  cout << "    2nd limit longitude (default:none, degrees)"   << endl;
+  cout << "  -ele2, --elevation-limit-2 <elevation>"   << endl;
+  cout << "    2nd limit elevation (default:none, meters)"   << endl;
+  cout << endl << "FIELDS:" << endl;
+  cout << "  time, id, lat, lon, ele, bng, gsd, vsd, rtn, gac, vac, hng, asd," << endl;
+  cout << "  srct, elat, elon, eele, ebng, egsd, evsd, ertn, egac, evac, ehng, easd," << endl;
+  cout << "  data" << endl;
+  displayOptionPrincipal( false, true );
+  displayOptionPayload( false, true );
+  displayOptionCompression();
+  displayOptionOutputBuffer();
+  displayOptionAsync( false, true );
+  displayOptionPassword( false, true );
+  displayOptionPasswordSalt( false, true );
+}
+
+int CSgctpUtil::parseArgs()
+{
+  // Parse all arguments
+  int __iArgCount = 0;
+  for( int __i=1; __i<iArgC; __i++ )
+  {
+    string __sArg = ppcArgV[__i];
+    if( __sArg[0] == '-' )
+    {
+      SGCTP_PARSE_ARGS( parseArgsHelp( &__i ) );
+      SGCTP_PARSE_ARGS( parseArgsPrincipal( &__i, false, true ) );
+      SGCTP_PARSE_ARGS( parseArgsPayload( &__i, false, true ) );
+      SGCTP_PARSE_ARGS( parseArgsCompression( &__i ) );
+      SGCTP_PARSE_ARGS( parseArgsOutputBuffer( &__i ) );
+      SGCTP_PARSE_ARGS( parseArgsAsync( &__i, false, true ) );
+      SGCTP_PARSE_ARGS( parseArgsPassword( &__i, false, true ) );
+      SGCTP_PARSE_ARGS( parseArgsPasswordSalt( &__i, false, true ) );
+      if( __sArg=="-o" || __sArg=="--output" )
+      {
+        if( ++__i<iArgC )
+          sOutputPath = ppcArgV[__i];
+      }
+      else if( __sArg=="-i" || __sArg=="--id" )
+      {
+        if( ++__i<iArgC )
+          sID = ppcArgV[__i];
+      }
+      else if( __sArg=="-t1" || __sArg=="--time-limit-1" )
+      {
+        if( ++__i<iArgC )
+          fdTime1 = CData::fromIso8601( ppcArgV[__i] );
+      }
+      else if( __sArg=="-lat1" || __sArg=="--latitude-limit-1" )
+      {
+        if( ++__i<iArgC )
+          fdLatitude1 = strtod( ppcArgV[__i], NULL );
+      }
+      else if( __sArg=="-lon1" || __sArg=="--longitude-limit-1" )
+      {
+        if( ++__i<iArgC )
+          fdLongitude1 = strtod( ppcArgV[__i], NULL );
+      }
+      else if( __sArg=="-ele1" || __sArg=="--elevation-limit-1" )
+      {
+        if( ++__i<iArgC )
+          fdElevation1 = strtod( ppcArgV[__i], NULL );
+      }
+      else if( __sArg=="-t2" || __sArg=="--time-limit-2" )
+      {
+        if( ++__i<iArgC )
+          fdTime2 = CData::fromIso8601( ppcArgV[__i] );
+      }
+      else if( __sArg=="-lat2" || __sArg=="--latitude-limit-2" )
+      {
+        if( ++__i<iArgC )
+          fdLatitude2 = strtod( ppcArgV[__i], NULL );
+      }
+      else if( __sArg=="-lon2" || __sArg=="--longitude-limit-2" )
+      {
+        if( ++__i<iArgC )
+          fdLongitude2 = strtod( ppcArgV[__i], NULL );
+      }
+      else if( __sArg=="-ele2" || __sArg=="--elevation-limit-2" )
+      {
+        if( ++__i<iArgC )
+          fdElevation2 = strtod( ppcArgV[__i], NULL );
+      }
+      else if( __sArg[0] == '-' )
+      {
+        displayErrorInvalidOption( __sArg );
+        return -EINVAL;
+      }
+      if( __i == iArgC )
+      {
+        displayErrorMissingArgument ( __sArg );
+        return -EINVAL;
+      }
+    }
+    else if( __sArg[0] == '+' )
+    {
+      int __iColumn = CColumnar::getColumn( __sArg.substr( 1 ).c_str() );
+      if( __iColumn < 0 )
+      {
+        displayErrorInvalidOption( __sArg );
+        return -EINVAL;
+      }
+      ui32tProjection |= CColumnar::columnMask( __iColumn );
+    }
+    else
+    {
+      switch( __iArgCount++ )
+      {
+      case 0:
+        sInputPath = __sArg;
+        break;
+      default:
+        displayErrorExtraArgument( __sArg );
+        return -EINVAL;
+      }
+    }
+  }
+
+  // Done
+  return 0;
+}
+
+#define SGCTP_BREAK( __iExit__ ) { SGCTP_INTERRUPTED=1; __iExit = __iExit__; break; }
+int CSgctpUtil::exec()
+{
+  int __iExit = 0;
+  int __iReturn;
+
+  // Parse arguments
+  __iReturn = parseArgs();
+  if( __iReturn )
+    return __iReturn;
+
+  // Lookup principal(s)
+  __iReturn = principalLookup( false, true );
+  if( __iReturn )
+    return __iReturn;
+
+  // Initialize transmission object(s)
+  __iReturn = transmitInit( false, true );
+  if( __iReturn )
+    return __iReturn;
+
+  // Initialize columnar archive reader
+  oColumnar_in.setProjection( ui32tProjection
+                              ? CColumnar::payloadColumns( ui32tProjection )
+                              : CColumnar::COLUMNS_ALL );
+  if( !sID.empty() )
+    oColumnar_in.setFilterID( sID.c_str() );
+  // ... time (of day)
+  if( CData::isDefined( fdTime1 ) )
+    fdTime1 = fmod( fdTime1, 86400.0 );
+  if( CData::isDefined( fdTime2 ) )
+    fdTime2 = fmod( fdTime2, 86400.0 );
+  if( CData::isDefined( fdTime1 ) && CData::isDefined( fdTime2 ) && fdTime1 > fdTime2 )
+  {
+    SGCTP_LOG << SGCTP_ERROR << "Time limits must not span midnight" << endl;
+    return -EINVAL;
+  }
+  addFilter( CField::TIME,
+             CData::isDefined( fdTime1 ) ? CField::fromValue<CField::TIME>( fdTime1 ) : CField::UNDEFINED_UINT32,
+             CData::isDefined( fdTime2 ) ? CField::fromValue<CField::TIME>( fdTime2 ) : CField::UNDEFINED_UINT32 );
+  // ... position
+  addFilter( CField::LATITUDE,
+             CData::isDefined( fdLatitude1 ) ? CField::fromValue<CField::LATITUDE>( fdLatitude1 ) : CField::UNDEFINED_UINT32,
+             CData::isDefined( fdLatitude2 ) ? CField::fromValue<CField::LATITUDE>( fdLatitude2 ) : CField::UNDEFINED_UINT32 );
+  addFilter( CField::LONGITUDE,
+             CData::isDefined( fdLongitude1 ) ? CField::fromValue<CField::LONGITUDE>( fdLongitude1 ) : CField::UNDEFINED_UINT32,
+             CData::isDefined( fdLongitude2 ) ? CField::fromValue<CField::LONGITUDE>( fdLongitude2 ) : CField::UNDEFINED_UINT32 );
+  addFilter( CField::ELEVATION,
+             CData::isDefined( fdElevation1 ) ? CField::fromValue<CField::ELEVATION>( fdElevation1 ) : CField::UNDEFINED_UINT32,
+             CData::isDefined( fdElevation2 ) ? CField::fromValue<CField::ELEVATION>( fdElevation2 ) : CField::UNDEFINED_UINT32 );
+
+  // Catch signals
+  sigCatch( CSgctpUtil::interrupt );
+
+  // Error-catching block
+  do
+  {
+
+    // Open input (POSIX file descriptor)
+    if( sInputPath != "-" )
+    {
+      fdInput = open( sInputPath.c_str(),
+                      O_RDONLY );
+      if( fdInput < 0 )
+      {
+        SGCTP_LOG << SGCTP_ERROR << "Invalid/unreadable file (" << sInputPath << ") @ open=" << -errno << endl;
+        SGCTP_BREAK( -errno );
+      }
+    }
+
+    // Open output (POSIX file descriptor)
+    if( sOutputPath != "-" )
+    {
+      fdOutput = open( sOutputPath.c_str(),
+                       O_CREAT|O_TRUNC|O_WRONLY,
+                       S_IWUSR|S_IRUSR|S_IRGRP|S_IROTH );
+      if( fdOutput < 0 )
+      {
+        SGCTP_LOG << SGCTP_ERROR << "Invalid/unwritable file (" << sOutputPath << ") @ open=" << -errno << endl;
+        SGCTP_BREAK( -errno );
+      }
+    }
+
+    // Read and convert data
+    CDataBlock __oDataBlock;
+    CData __oData;
+    for(;;)
+    {
+      if( SGCTP_INTERRUPTED )
+        break;
+
+      // ... read (columnar archive)
+      __iReturn = oColumnar_in.read( fdInput, &__oDataBlock );
+      if( SGCTP_INTERRUPTED )
+        break;
+      if( __iReturn == 0 )
+        SGCTP_BREAK( 0 );
+      if( __iReturn < 0 )
+      {
+        SGCTP_LOG << SGCTP_ERROR << "Failed to read data @ read=" << __iReturn << endl;
+        SGCTP_BREAK( __iReturn );
+      }
+
+      // ... serialize
+      for( int __i = 0; __i < __oDataBlock.getSize(); __i++ )
+      {
+        __oDataBlock.getRecord( __i, &__oData );
+        __iReturn = oTransmit_out.serialize( fdOutput, __oData );
+        if( __iReturn < 0 )
+        {
+          SGCTP_LOG << SGCTP_ERROR << "Failed to serialize data @ serialize=" << __iReturn << endl;
+          break;
+        }
+      }
+      if( __iReturn < 0 )
+        SGCTP_BREAK( __iReturn );
+
+    }
+
+  }
+  while( false ); // Error-catching block
+
+  // Done
+  SGCTP_LOG << SGCTP_INFO << "Columnar archive: " << oColumnar_in.getBytesRead() << " bytes read, " << oColumnar_in.getBytesSkipped() << " bytes skipped" << endl;
+  if( fdOutput >= 0 )
+    oTransmit_out.finish( fdOutput );
+  if( fdInput >= 0 && fdInput != STDIN_FILENO )
+    close( fdInput );
+  if( fdOutput >= 0 && fdOutput != STDOUT_FILENO )
+    close( fdOutput );
+  oColumnar_in.free();
+  return __iExit;
+}
+
+
+//----------------------------------------------------------------------
+// METHODS
+//----------------------------------------------------------------------
+
+void CSgctpUtil::addFilter( CField::EField _eField,
+                            uint32_t _ui32tLimit1,
+                            uint32_t _ui32tLimit2 )
+{
+  bool __bDefined1 = !( _ui32tLimit1 & CField::UNDEFINED_UINT32 );
+  bool __bDefined2 = !( _ui32tLimit2 & CField::UNDEFINED_UINT32 );
+  if( !__bDefined1 && !__bDefined2 )
+    return;
+  uint32_t __ui32tMinimum = 0;
+  uint32_t __ui32tMaximum = CField::OVERFLOW_UINT32;
+  if( __bDefined1 && __bDefined2 )
+  {
+    __ui32tMinimum = _ui32tLimit1 < _ui32tLimit2 ? _ui32tLimit1 : _ui32tLimit2;
+    __ui32tMaximum = _ui32tLimit1 < _ui32tLimit2 ? _ui32tLimit2 : _ui32tLimit1;
+  }
+  else if( __bDefined1 )
+    __ui32tMinimum = _ui32tLimit1;
+  else
+    __ui32tMaximum = _ui32tLimit2;
+  oColumnar_in.addFilter( _eField, __ui32tMinimum, __ui32tMaximum );
+}
+
+
+//----------------------------------------------------------------------
+// MAIN
+//----------------------------------------------------------------------
+
+int main( int argc, char* argv[] )
+{
+  CSgctpUtil __oSgctpUtil( argc, argv );
+  return __oSgctpUtil.exec();
+}
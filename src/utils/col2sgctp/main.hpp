@@ -0,0 +1,125 @@
+// INDENTING (emacs/vi): -*- mode:c++; tab-width:2; c-basic-offset:2; intent-tabs-mode:nil; -*- ex: set tabstop=2 expandtab:
+
+/*
+ * Simple Geolocalization and Course Transmission Protocol (SGCTP)
+ * Copyright (C) 2014 Cedric Dufour <http://cedric.dufour.name>
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * free software:
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, Version 3.
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ */
+
+// SGCTP
+#include "../skeleton.hpp"
+using namespace SGCTP;
+
+
+//----------------------------------------------------------------------
+// CLASSES
+//----------------------------------------------------------------------
+
+class CSgctpUtil: protected CSgctpUtilSkeleton
+{
+
+  //----------------------------------------------------------------------
+  // STATIC / CONSTANTS
+  //----------------------------------------------------------------------
+
+public:
+  static void interrupt( int _iSignal );
+
+
+  //----------------------------------------------------------------------
+  // FIELDS
+  //----------------------------------------------------------------------
+
+  //
+  // Resources
+  //
+
+private:
+  /// Input (columnar archive) reader
+  CColumnar_Reader oColumnar_in;
+  /// Input file descriptor
+  int fdInput;
+  /// Output transmission object (actual)
+  CTransmit_File oTransmit_out;
+  /// Output file descriptor
+  int fdOutput;
+
+  //
+  // Arguments
+  //
+
+private:
+  /// Input file path
+  string sInputPath;
+  /// Output file path
+  string sOutputPath;
+  /// Projected columns (bit mask)
+  uint32_t ui32tProjection;
+  /// Source ID
+  string sID;
+  /// Time (1st limit)
+  double fdTime1;
+  /// Latitude (1st limit)
+  double fdLatitude1;
+  /// Longitude (1st limit)
+  double fdLongitude1;
+  /// Elevation (1st limit)
+  double fdElevation1;
+  /// Time (2nd limit)
+  double fdTime2;
+  /// Latitude (2nd limit)
+  double fdLatitude2;
+  /// Longitude (2nd limit)
+  double fdLongitude2;
+  /// Elevation (2nd limit)
+  double fdElevation2;
+
+
+  //----------------------------------------------------------------------
+  // CONSTRUCTORS / DESTRUCTOR
+  //----------------------------------------------------------------------
+
+public:
+  CSgctpUtil( int _iArgC, char *_ppcArgV[] );
+
+public:
+  virtual ~CSgctpUtil() {};
+
+
+  //----------------------------------------------------------------------
+  // METHODS: CSgctpUtilSkeleton (implement/override)
+  //----------------------------------------------------------------------
+
+private:
+  virtual void displayHelp();
+  virtual int parseArgs();
+
+public:
+  virtual int exec();
+
+
+  //----------------------------------------------------------------------
+  // METHODS
+  //----------------------------------------------------------------------
+
+private:
+  /// Add the filter corresponding to the given limits (internal integer values)
+  /**
+   *  Undefined limits are ignored; the filter is not added if both limits are undefined.
+   */
+  void addFilter( CField::EField _eField,
+                  uint32_t _ui32tLimit1,
+                  uint32_t _ui32tLimit2 );
+
+};
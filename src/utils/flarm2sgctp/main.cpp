@@ -23,7 +23,6 @@
 #include <unistd.h>
 
 // C++
-#include <unordered_map>
 #include <vector>
 using namespace std;
 
@@ -31,6 +30,8 @@ using namespace std;
 #include <boost/algorithm/string.hpp>
 
 // SGCTP
+#include "sgctp/clock.hpp"
+#include "sgctp/id_table.hpp"
 #define SGCTP_RECV_BUFFER_SIZE 131072
 #include "main.hpp"
 using namespace SGCTP;
@@ -187,6 +188,9 @@ void CSgctpUtil::displayHelp()
   cout << "    Use barometric instead of GPS elevation (default:no)" << endl;
   displayOptionPrincipal( false, true );
   displayOptionPayload( false, true );
+  displayOptionCompression();
+  displayOptionOutputBuffer();
+  displayOptionAsync( false, true );
   displayOptionPassword( false, true );
   displayOptionPasswordSalt( false, true );
   displayOptionExtendedContent();
@@ -207,6 +211,9 @@ int CSgctpUtil::parseArgs()
       SGCTP_PARSE_ARGS( parseArgsHelp( &__i ) );
       SGCTP_PARSE_ARGS( parseArgsPrincipal( &__i, false, true ) );
       SGCTP_PARSE_ARGS( parseArgsPayload( &__i, false, true ) );
+      SGCTP_PARSE_ARGS( parseArgsCompression( &__i ) );
+      SGCTP_PARSE_ARGS( parseArgsOutputBuffer( &__i ) );
+      SGCTP_PARSE_ARGS( parseArgsAsync( &__i, false, true ) );
       SGCTP_PARSE_ARGS( parseArgsPassword( &__i, false, true ) );
       SGCTP_PARSE_ARGS( parseArgsPasswordSalt( &__i, false, true ) );
       SGCTP_PARSE_ARGS( parseArgsExtendedContent( &__i ) );
@@ -441,7 +448,8 @@ int CSgctpUtil::exec()
     // Receive and dump data
     CData* __poDataReference = NULL;
     double __fdEpochReference = 0.0;
-    unordered_map<string, CData*> __poData_umap;
+    CIDTable __oDataID_table;
+    vector<CData*> __poData_vector;
     double __fdEpochCleanup = CData::epoch();
     unsigned char __pucBuffer[SGCTP_RECV_BUFFER_SIZE];
     int __iBufferRecvSize = 0;
@@ -496,7 +504,7 @@ int CSgctpUtil::exec()
         boost::split( __vsFLARMFields, __pcFLARM, boost::is_any_of(",") );
         if( !nmeaValid( __vsFLARMFields[0] ) )
           continue; // invalid NMEA-0183 message
-        double __fdEpochNow = CData::epoch();
+        double __fdEpochNow = CClock::nowCoarse();
 
         // Originating source (ID)
         string __sSource = "";
@@ -524,40 +532,31 @@ int CSgctpUtil::exec()
         {
           __fdEpochCleanup = __fdEpochNow;
 
-          // ... get keys
-          vector<string> __vsKeys;
-          __vsKeys.reserve( __poData_umap.size() );
-          for( unordered_map<string, CData*>::const_iterator __it =
-                 __poData_umap.begin();
-               __it != __poData_umap.end();
-               ++__it )
-          {
-            __vsKeys.push_back( __it->first );
-          }
-
-          // ... loop through keys
-          for( vector<string>::const_iterator __it = __vsKeys.begin();
-               __it != __vsKeys.end();
+          // ... loop through entries
+          for( vector<CData*>::iterator __it = __poData_vector.begin();
+               __it != __poData_vector.end();
                ++__it )
           {
             // ... cleanup stale entries (older than data TTL)
-            if( __fdEpochNow - CData::toEpoch( __poData_umap[ *__it ]->getTime() )
-                > (double)iDataTTL )
+            if( *__it
+                && __fdEpochNow - CData::toEpoch( (*__it)->getTime() ) > (double)iDataTTL )
             {
-              if( __poData_umap[ *__it ] == __poDataReference )
+              if( *__it == __poDataReference )
                 __poDataReference = NULL;
-              delete __poData_umap[ *__it ];
-              __poData_umap.erase( *__it );
+              delete *__it;
+              *__it = NULL;
+              __oDataID_table.erase( __it - __poData_vector.begin() );
             }
           }
 
         }
 
         // Data map lookup
-        CData* __poData;
-        unordered_map<string, CData*>::const_iterator __it =
-          __poData_umap.find( __sSource );
-        if( __it == __poData_umap.end() )
+        uint32_t __ui32tSource = __oDataID_table.intern( __sSource.c_str() );
+        if( __ui32tSource >= __poData_vector.size() )
+          __poData_vector.resize( __ui32tSource+1, NULL );
+        CData* __poData = __poData_vector[__ui32tSource];
+        if( !__poData )
         {
           __poData = new CData();
           __poData->setID( __sSource.c_str() );
@@ -565,10 +564,8 @@ int CSgctpUtil::exec()
             __poData->setSourceType( __bSourceReference
                                      ? CData::SOURCE_GPS
                                      : CData::SOURCE_FLARM );
-          __poData_umap[__sSource] = __poData;
+          __poData_vector[__ui32tSource] = __poData;
         }
-        else
-          __poData = __it->second;
 
         // ... reference source
         if( __bSourceReference )
@@ -790,6 +787,16 @@ int CSgctpUtil::exec()
 
       } // Loop through socket data
 
+      // Send pending frames (socket data processed)
+      sigBlock();
+      __iReturn = oTransmit_out.flushFrames( fdOutput );
+      sigUnblock();
+      if( __iReturn < 0 )
+      {
+        SGCTP_LOG << SGCTP_ERROR << "Failed to serialize data @ flushFrames=" << __iReturn << endl;
+        SGCTP_BREAK( __iReturn );
+      }
+
       // Flush buffer ?
       if( SGCTP_RECV_BUFFER_SIZE-__iBufferDataStart < 1024 )
       {
@@ -828,6 +835,8 @@ int CSgctpUtil::exec()
   // Done
   if( fdInput >= 0 && fdInput != STDIN_FILENO )
     close( fdInput );
+  if( fdOutput >= 0 )
+    oTransmit_out.finish( fdOutput );
   if( fdOutput >= 0 && fdOutput != STDOUT_FILENO )
     close( fdOutput );
   daemonEnd();
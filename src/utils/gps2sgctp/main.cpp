@@ -93,6 +93,9 @@ void CSgctpUtil::displayHelp()
   cout << "    Do not wait for consistent 3D fix" << endl;
   displayOptionPrincipal( false, true );
   displayOptionPayload( false, true );
+  displayOptionCompression();
+  displayOptionOutputBuffer();
+  displayOptionAsync( false, true );
   displayOptionPassword( false, true );
   displayOptionPasswordSalt( false, true );
   displayOptionExtendedContent();
@@ -111,6 +114,9 @@ int CSgctpUtil::parseArgs()
       SGCTP_PARSE_ARGS( parseArgsHelp( &__i ) );
       SGCTP_PARSE_ARGS( parseArgsPrincipal( &__i, false, true ) );
       SGCTP_PARSE_ARGS( parseArgsPayload( &__i, false, true ) );
+      SGCTP_PARSE_ARGS( parseArgsCompression( &__i ) );
+      SGCTP_PARSE_ARGS( parseArgsOutputBuffer( &__i ) );
+      SGCTP_PARSE_ARGS( parseArgsAsync( &__i, false, true ) );
       SGCTP_PARSE_ARGS( parseArgsPassword( &__i, false, true ) );
       SGCTP_PARSE_ARGS( parseArgsPasswordSalt( &__i, false, true ) );
       SGCTP_PARSE_ARGS( parseArgsExtendedContent( &__i ) );
@@ -389,9 +395,15 @@ int CSgctpUtil::exec()
         continue;
       __fdEpochFix = __fdEpochNow;
 
-      // ... serialize
+      // ... serialize (and send pending frames; one GPSD message at a time)
       sigBlock();
       __iReturn = oTransmit_out.serialize( fdOutput, __oData );
+      if( __iReturn > 0 )
+      {
+        int __iReturnFlush = oTransmit_out.flushFrames( fdOutput );
+        if( __iReturnFlush < 0 )
+          __iReturn = __iReturnFlush;
+      }
       sigUnblock();
       if( __iReturn == 0 )
         SGCTP_BREAK( 0 );
@@ -412,6 +424,8 @@ int CSgctpUtil::exec()
     gps_stream( ptGpsDataT, WATCH_DISABLE, NULL );
     gps_close( ptGpsDataT );
   }
+  if( fdOutput >= 0 )
+    oTransmit_out.finish( fdOutput );
   if( fdOutput >= 0 && fdOutput != STDOUT_FILENO )
     close( fdOutput );
   daemonEnd();
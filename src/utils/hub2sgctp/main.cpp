@@ -109,6 +109,9 @@ void CSgctpUtil::displayHelp()
   cout << "    Filter 2nd limit elevation (default:none, meters)"   << endl;
   displayOptionPrincipal( true, true );
   displayOptionPayload( true, true );
+  displayOptionCompression();
+  displayOptionOutputBuffer();
+  displayOptionAsync( false, true );
   displayOptionPassword( true, true );
   displayOptionPasswordSalt( false, true );
   displayOptionDaemon();
@@ -126,6 +129,9 @@ int CSgctpUtil::parseArgs()
       SGCTP_PARSE_ARGS( parseArgsHelp( &__i ) );
       SGCTP_PARSE_ARGS( parseArgsPrincipal( &__i, true, true ) );
       SGCTP_PARSE_ARGS( parseArgsPayload( &__i, true, true ) );
+      SGCTP_PARSE_ARGS( parseArgsCompression( &__i ) );
+      SGCTP_PARSE_ARGS( parseArgsOutputBuffer( &__i ) );
+      SGCTP_PARSE_ARGS( parseArgsAsync( &__i, false, true ) );
       SGCTP_PARSE_ARGS( parseArgsPassword( &__i, true, true ) );
       SGCTP_PARSE_ARGS( parseArgsPasswordSalt( &__i, false, true ) );
       SGCTP_PARSE_ARGS( parseArgsDaemon( &__i ) );
@@ -430,6 +436,12 @@ int CSgctpUtil::exec()
         __oData.reset();
         __oData.setID( "#START" );
         __iReturn = oTransmit_in.serialize( sdInput, __oData );
+        if( __iReturn > 0 )
+        {
+          int __iReturnFlush = oTransmit_in.flushFrames( sdInput );
+          if( __iReturnFlush < 0 )
+            __iReturn = __iReturnFlush;
+        }
         if( __iReturn <= 0 )
         {
           SGCTP_LOG << SGCTP_WARNING << "Failed to start data feed @ serialize=" << __iReturn << endl;
@@ -464,6 +476,19 @@ int CSgctpUtil::exec()
             break;
           }
 
+          // ... send pending frames (no more input data available)
+          if( !oTransmit_in.hasData() )
+          {
+            sigBlock();
+            __iReturn = oTransmit_out.flushFrames( fdOutput );
+            sigUnblock();
+            if( __iReturn < 0 )
+            {
+              SGCTP_LOG << SGCTP_WARNING << "Failed to serialize data @ flushFrames=" << __iReturn << endl;
+              break;
+            }
+          }
+
         }
 
       }
@@ -482,6 +507,8 @@ int CSgctpUtil::exec()
   // Done
   if( ptAddrinfo_in )
     free( ptAddrinfo_in );
+  if( fdOutput >= 0 )
+    oTransmit_out.finish( fdOutput );
   if( fdOutput >= 0 && fdOutput != STDOUT_FILENO )
     close( fdOutput );
   daemonEnd();
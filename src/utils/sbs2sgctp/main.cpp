@@ -24,7 +24,6 @@
 #include <sys/socket.h>
 
 // C++
-#include <unordered_map>
 #include <vector>
 using namespace std;
 
@@ -32,6 +31,8 @@ using namespace std;
 #include <boost/algorithm/string.hpp>
 
 // SGCTP
+#include "sgctp/clock.hpp"
+#include "sgctp/id_table.hpp"
 #define SGCTP_RECV_BUFFER_SIZE 131072
 #include "main.hpp"
 using namespace SGCTP;
@@ -90,6 +91,9 @@ void CSgctpUtil::displayHelp()
   cout << "    Use callsign instead of hexadecimal identification" << endl;
   displayOptionPrincipal( false, true );
   displayOptionPayload( false, true );
+  displayOptionCompression();
+  displayOptionOutputBuffer();
+  displayOptionAsync( false, true );
   displayOptionPassword( false, true );
   displayOptionPasswordSalt( false, true );
   displayOptionExtendedContent();
@@ -110,6 +114,9 @@ int CSgctpUtil::parseArgs()
       SGCTP_PARSE_ARGS( parseArgsHelp( &__i ) );
       SGCTP_PARSE_ARGS( parseArgsPrincipal( &__i, false, true ) );
       SGCTP_PARSE_ARGS( parseArgsPayload( &__i, false, true ) );
+      SGCTP_PARSE_ARGS( parseArgsCompression( &__i ) );
+      SGCTP_PARSE_ARGS( parseArgsOutputBuffer( &__i ) );
+      SGCTP_PARSE_ARGS( parseArgsAsync( &__i, false, true ) );
       SGCTP_PARSE_ARGS( parseArgsPassword( &__i, false, true ) );
       SGCTP_PARSE_ARGS( parseArgsPasswordSalt( &__i, false, true ) );
       SGCTP_PARSE_ARGS( parseArgsExtendedContent( &__i ) );
@@ -207,7 +214,8 @@ int CSgctpUtil::exec()
   sigCatch( CSgctpUtil::interrupt );
 
   // Error-catching block
-  unordered_map<string,CData*> __poData_umap;
+  CIDTable __oDataID_table;
+  vector<CData*> __poData_vector;
   do
   {
 
@@ -342,7 +350,7 @@ int CSgctpUtil::exec()
           continue; // Ignore ground traffic
         if( __vsSBSFields[4].empty() )
           continue; // We need a valid "HexIdent"
-        double __fdEpochNow = CData::epoch();
+        double __fdEpochNow = CClock::nowCoarse();
 
         // Originating source (ID)
         string __sSource = __vsSBSFields[4];
@@ -352,46 +360,35 @@ int CSgctpUtil::exec()
         {
           __fdEpochCleanup = __fdEpochNow;
 
-          // ... get keys
-          vector<string> __vsKeys;
-          __vsKeys.reserve( __poData_umap.size() );
-          for( unordered_map<string,CData*>::const_iterator __it =
-                 __poData_umap.begin();
-               __it != __poData_umap.end();
-               ++__it )
-          {
-            __vsKeys.push_back( __it->first );
-          }
-
-          // ... loop through keys
-          for( vector<string>::const_iterator __it = __vsKeys.begin();
-               __it != __vsKeys.end();
+          // ... loop through entries
+          for( vector<CData*>::iterator __it = __poData_vector.begin();
+               __it != __poData_vector.end();
                ++__it )
           {
             // ... cleanup stale entries (older than data TTL)
-            if( __fdEpochNow - CData::toEpoch( __poData_umap[ *__it ]->getTime() )
-                > (double)iDataTTL )
+            if( *__it
+                && __fdEpochNow - CData::toEpoch( (*__it)->getTime() ) > (double)iDataTTL )
             {
-              delete __poData_umap[ *__it ];
-              __poData_umap.erase( *__it );
+              delete *__it;
+              *__it = NULL;
+              __oDataID_table.erase( __it - __poData_vector.begin() );
             }
           }
 
         }
 
         // Data map lookup
-        CData* __poData;
-        unordered_map<string,CData*>::const_iterator __it =
-          __poData_umap.find( __sSource );
-        if( __it == __poData_umap.end() )
+        uint32_t __ui32tSource = __oDataID_table.intern( __sSource.c_str() );
+        if( __ui32tSource >= __poData_vector.size() )
+          __poData_vector.resize( __ui32tSource+1, NULL );
+        CData* __poData = __poData_vector[__ui32tSource];
+        if( !__poData )
         {
           __poData = new CData();
           if( bExtendedContent )
             __poData->setSourceType( CData::SOURCE_ADSB );
-          __poData_umap[__sSource] = __poData;
+          __poData_vector[__ui32tSource] = __poData;
         }
-        else
-          __poData = __it->second;
 
         // ... ID
         if( bCallsignLookup )
@@ -412,18 +409,16 @@ int CSgctpUtil::exec()
         // ... time
         if( !__vsSBSFields[6].empty() && !__vsSBSFields[7].empty() )
         {
-          struct tm __tmDateTime;
-          char __pcDateTime[24], *__pcSubSecond;
+          double __fdDateTime;
+          char __pcDateTime[24];
           memcpy( __pcDateTime, __vsSBSFields[6].c_str(), 10 );
+          __pcDateTime[4] = '-';
+          __pcDateTime[7] = '-';
           __pcDateTime[10] = ' ';
           memcpy( __pcDateTime+11, __vsSBSFields[7].c_str(), 12 );
           __pcDateTime[23] = '\0';
-          __pcSubSecond = strptime( __pcDateTime,
-                                    "%Y/%m/%d %H:%M:%S.",
-                                    &__tmDateTime );
-          if( __pcSubSecond )
-            __poData->setTime( (double)timegm( &__tmDateTime )
-                               + (double)atoi( __pcSubSecond )/1000.0 );
+          if( CClock::fromIso8601( __pcDateTime, &__fdDateTime ) )
+            __poData->setTime( __fdDateTime );
         }
         else
         {
@@ -478,6 +473,16 @@ int CSgctpUtil::exec()
 
       } // Loop through socket data
 
+      // Send pending frames (socket data processed)
+      sigBlock();
+      __iReturn = oTransmit_out.flushFrames( fdOutput );
+      sigUnblock();
+      if( __iReturn < 0 )
+      {
+        SGCTP_LOG << SGCTP_ERROR << "Failed to serialize data @ flushFrames=" << __iReturn << endl;
+        SGCTP_BREAK( __iReturn );
+      }
+
       // Flush buffer ?
       if( SGCTP_RECV_BUFFER_SIZE-__iBufferDataStart < 1024 )
       {
@@ -516,15 +521,17 @@ int CSgctpUtil::exec()
   // Done
   if( sdInput >= 0 )
     close( sdInput );
+  if( fdOutput >= 0 )
+    oTransmit_out.finish( fdOutput );
   if( fdOutput >= 0 && fdOutput != STDOUT_FILENO )
     close( fdOutput );
   if( ptAddrinfo_in )
     free( ptAddrinfo_in );
-  for( unordered_map<string,CData*>::const_iterator __it =
-         __poData_umap.begin();
-       __it != __poData_umap.end();
+  for( vector<CData*>::const_iterator __it =
+         __poData_vector.begin();
+       __it != __poData_vector.end();
        ++__it )
-    delete __it->second;
+    delete *__it;
   daemonEnd();
   return __iExit;
 }
@@ -0,0 +1,264 @@
+// INDENTING (emacs/vi): -*- mode:c++; tab-width:2; c-basic-offset:2; intent-tabs-mode:nil; -*- ex: set tabstop=2 expandtab:
+
+/*
+ * Simple Geolocalization and Course Transmission Protocol (SGCTP)
+ * Copyright (C) 2014 Cedric Dufour <http://cedric.dufour.name>
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * free software:
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, Version 3.
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ */
+
+// C
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+// SGCTP
+#include "main.hpp"
+using namespace SGCTP;
+
+
+//----------------------------------------------------------------------
+// STATIC / CONSTANTS
+//----------------------------------------------------------------------
+
+void CSgctpUtil::interrupt( int _iSignal )
+{
+  SGCTP_INTERRUPTED = 1;
+}
+
+
+//----------------------------------------------------------------------
+// CONSTRUCTORS / DESTRUCTOR
+//----------------------------------------------------------------------
+
+CSgctpUtil::CSgctpUtil( int _iArgC, char *_ppcArgV[] )
+  : CSgctpUtilSkeleton( "sgctp2col", _iArgC, _ppcArgV )
+  , fdInput( STDIN_FILENO )
+  , fdOutput( STDOUT_FILENO )
+  , sInputPath( "-" )
+  , sOutputPath( "-" )
+  , iRowGroupSize( CColumnar::ROW_GROUP_SIZE )
+{
+  // Link actual transmission objects
+  poTransmit_in = &oTransmit_in;
+}
+
+
+//----------------------------------------------------------------------
+// METHODS: CSgctpUtilSkeleton (implement/override)
+//----------------------------------------------------------------------
+
+void CSgctpUtil::displayHelp()
+{
+  // Display full help
+  displayUsageHeader();
+  cout << "  sgctp2col [options] [<path(in)>]" << endl;
+  displaySynopsisHeader();
+  cout << "  Convert the SGCTP data of the given file (default:'-', standard input)" << endl;
+  cout << "  to a columnar archive (*.sgctpc)." << endl;
+  displayOptionsHeader();
+  cout << "  -o, --output <path>" << endl;
+  cout << "    Output file (default:'-', standard output)" << endl;
+  cout << "  -g, --row-group <rows>" << endl;
+  cout << "    Row group size (default:65536, records)" << endl;
+  displayOptionPrincipal( true, false );
+  displayOptionPayload( true, false );
+  displayOptionPassword( true, false );
+  displayOptionPasswordSalt( true, false );
+  displayOptionMapped();
+  displayOptionAsync( true, false );
+}
+
+int CSgctpUtil::parseArgs()
+{
+  // Parse all arguments
+  int __iArgCount = 0;
+  for( int __i=1; __i<iArgC; __i++ )
+  {
+    string __sArg = ppcArgV[__i];
+    if( __sArg[0] == '-' )
+    {
+      SGCTP_PARSE_ARGS( parseArgsHelp( &__i ) );
+      SGCTP_PARSE_ARGS( parseArgsPrincipal( &__i, true, false ) );
+      SGCTP_PARSE_ARGS( parseArgsPayload( &__i, true, false ) );
+      SGCTP_PARSE_ARGS( parseArgsPassword( &__i, true, false ) );
+      SGCTP_PARSE_ARGS( parseArgsPasswordSalt( &__i, true, false ) );
+      SGCTP_PARSE_ARGS( parseArgsMapped( &__i ) );
+      SGCTP_PARSE_ARGS( parseArgsAsync( &__i, true, false ) );
+      if( __sArg=="-o" || __sArg=="--output" )
+      {
+        if( ++__i<iArgC )
+          sOutputPath = ppcArgV[__i];
+      }
+      else if( __sArg=="-g" || __sArg=="--row-group" )
+      {
+        if( ++__i<iArgC )
+        {
+          iRowGroupSize = strtol( ppcArgV[__i], NULL, 10 );
+          if( iRowGroupSize <= 0 )
+          {
+            SGCTP_LOG << SGCTP_ERROR << "Invalid row group size (" << ppcArgV[__i] << ")" << endl;
+            return -EINVAL;
+          }
+        }
+      }
+      else if( __sArg[0] == '-' )
+      {
+        displayErrorInvalidOption( __sArg );
+        return -EINVAL;
+      }
+      if( __i == iArgC )
+      {
+        displayErrorMissingArgument ( __sArg );
+        return -EINVAL;
+      }
+    }
+    else
+    {
+      switch( __iArgCount++ )
+      {
+      case 0:
+        sInputPath = __sArg;
+        break;
+      default:
+        displayErrorExtraArgument( __sArg );
+        return -EINVAL;
+      }
+    }
+  }
+
+  // Done
+  return 0;
+}
+
+#define SGCTP_BREAK( __iExit__ ) { SGCTP_INTERRUPTED=1; __iExit = __iExit__; break; }
+int CSgctpUtil::exec()
+{
+  int __iExit = 0;
+  int __iReturn;
+
+  // Parse arguments
+  __iReturn = parseArgs();
+  if( __iReturn )
+    return __iReturn;
+
+  // Lookup principal(s)
+  __iReturn = principalLookup( true, false );
+  if( __iReturn )
+    return __iReturn;
+
+  // Initialize transmission object(s)
+  __iReturn = transmitInit( true, false );
+  if( __iReturn )
+    return __iReturn;
+
+  // Initialize columnar archive writer
+  __iReturn = oColumnar_out.alloc( iRowGroupSize );
+  if( __iReturn )
+  {
+    SGCTP_LOG << SGCTP_ERROR << "Failed to allocate columnar archive writer @ alloc=" << __iReturn << endl;
+    return __iReturn;
+  }
+
+  // Catch signals
+  sigCatch( CSgctpUtil::interrupt );
+
+  // Error-catching block
+  do
+  {
+
+    // Open input (POSIX file descriptor)
+    if( sInputPath != "-" )
+    {
+      fdInput = open( sInputPath.c_str(),
+                      O_RDONLY );
+      if( fdInput < 0 )
+      {
+        SGCTP_LOG << SGCTP_ERROR << "Invalid/unreadable file (" << sInputPath << ") @ open=" << -errno << endl;
+        SGCTP_BREAK( -errno );
+      }
+    }
+
+    // Open output (POSIX file descriptor)
+    if( sOutputPath != "-" )
+    {
+      fdOutput = open( sOutputPath.c_str(),
+                       O_CREAT|O_TRUNC|O_WRONLY,
+                       S_IWUSR|S_IRUSR|S_IRGRP|S_IROTH );
+      if( fdOutput < 0 )
+      {
+        SGCTP_LOG << SGCTP_ERROR << "Invalid/unwritable file (" << sOutputPath << ") @ open=" << -errno << endl;
+        SGCTP_BREAK( -errno );
+      }
+    }
+
+    // Receive and convert data
+    CData __oData;
+    for(;;)
+    {
+      if( SGCTP_INTERRUPTED )
+        break;
+
+      // ... unserialize
+      __iReturn = oTransmit_in.unserialize( fdInput, &__oData );
+      if( SGCTP_INTERRUPTED )
+        break;
+      if( __iReturn == 0 )
+        SGCTP_BREAK( 0 );
+      if( __iReturn < 0 )
+      {
+        SGCTP_LOG << SGCTP_ERROR << "Failed to unserialize data @ unserialize=" << __iReturn << endl;
+        SGCTP_BREAK( __iReturn );
+      }
+
+      // ... write (columnar archive)
+      __iReturn = oColumnar_out.write( fdOutput, __oData );
+      if( __iReturn < 0 )
+      {
+        SGCTP_LOG << SGCTP_ERROR << "Failed to write data @ write=" << __iReturn << endl;
+        SGCTP_BREAK( __iReturn );
+      }
+
+    }
+
+  }
+  while( false ); // Error-catching block
+
+  // Done
+  if( fdOutput >= 0 && __iExit == 0 )
+  {
+    __iReturn = oColumnar_out.flush( fdOutput );
+    if( __iReturn < 0 )
+    {
+      SGCTP_LOG << SGCTP_ERROR << "Failed to write data @ flush=" << __iReturn << endl;
+      __iExit = __iReturn;
+    }
+  }
+  if( fdInput >= 0 && fdInput != STDIN_FILENO )
+    close( fdInput );
+  if( fdOutput >= 0 && fdOutput != STDOUT_FILENO )
+    close( fdOutput );
+  oColumnar_out.free();
+  return __iExit;
+}
+
+
+//----------------------------------------------------------------------
+// MAIN
+//----------------------------------------------------------------------
+
+int main( int argc, char* argv[] )
+{
+  CSgctpUtil __oSgctpUtil( argc, argv );
+  return __oSgctpUtil.exec();
+}
@@ -29,6 +29,7 @@ using namespace std;
 #include <boost/format.hpp>
 
 // SGCTP
+#include "sgctp/clock.hpp"
 #include "main.hpp"
 using namespace SGCTP;
 
@@ -86,6 +87,8 @@ void CSgctpUtil::displayHelp()
   displayOptionPayload( true, false );
   displayOptionPassword( true, false );
   displayOptionPasswordSalt( true, false );
+  displayOptionMapped();
+  displayOptionAsync( true, false );
 }
 
 int CSgctpUtil::parseArgs()
@@ -102,6 +105,8 @@ int CSgctpUtil::parseArgs()
       SGCTP_PARSE_ARGS( parseArgsPayload( &__i, true, false ) );
       SGCTP_PARSE_ARGS( parseArgsPassword( &__i, true, false ) );
       SGCTP_PARSE_ARGS( parseArgsPasswordSalt( &__i, true, false ) );
+      SGCTP_PARSE_ARGS( parseArgsMapped( &__i ) );
+      SGCTP_PARSE_ARGS( parseArgsAsync( &__i, true, false ) );
       if( __sArg=="-o" || __sArg=="--output" )
       {
         if( ++__i<iArgC )
@@ -269,7 +274,7 @@ void CSgctpUtil::dumpDSV( const CData& _roData )
         if( fdEpochReference >= 0 )
         {
           __fdValue = CData::toEpoch( __fdValue, fdEpochReference );
-          char __pcIso8601[24];
+          char __pcIso8601[CClock::ISO8601_SIZE];
           CData::toIso8601( __pcIso8601, __fdValue );
           *poOutputStream << __pcIso8601;
         }
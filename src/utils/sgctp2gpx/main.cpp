@@ -29,6 +29,7 @@ using namespace std;
 #include <boost/format.hpp>
 
 // SGCTP
+#include "sgctp/clock.hpp"
 #include "main.hpp"
 using namespace SGCTP;
 
@@ -89,6 +90,8 @@ void CSgctpUtil::displayHelp()
   displayOptionPayload( true, false );
   displayOptionPassword( true, false );
   displayOptionPasswordSalt( true, false );
+  displayOptionMapped();
+  displayOptionAsync( true, false );
   displayOptionExtendedContent();
 }
 
@@ -106,6 +109,8 @@ int CSgctpUtil::parseArgs()
       SGCTP_PARSE_ARGS( parseArgsPayload( &__i, true, false ) );
       SGCTP_PARSE_ARGS( parseArgsPassword( &__i, true, false ) );
       SGCTP_PARSE_ARGS( parseArgsPasswordSalt( &__i, true, false ) );
+      SGCTP_PARSE_ARGS( parseArgsMapped( &__i ) );
+      SGCTP_PARSE_ARGS( parseArgsAsync( &__i, true, false ) );
       SGCTP_PARSE_ARGS( parseArgsExtendedContent( &__i ) );
       if( __sArg=="-o" || __sArg=="--output" )
       {
@@ -261,7 +266,7 @@ void CSgctpUtil::dumpGPX( const CData& _roData )
   {
     if( fdEpochReference >= 0 )
       __fdValue1 = CData::toEpoch( __fdValue1, fdEpochReference );
-    char __pcIso8601[24];
+    char __pcIso8601[CClock::ISO8601_SIZE];
     CData::toIso8601( __pcIso8601, __fdValue1 );
     *poOutputStream << "<time>" << __pcIso8601 << "</time>" << endl;
   }
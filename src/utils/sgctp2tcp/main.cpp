@@ -78,6 +78,8 @@ void CSgctpUtil::displayHelp()
   displayOptionPayload( true, true );
   displayOptionPassword( true, true );
   displayOptionPasswordSalt( true, false );
+  displayOptionMapped();
+  displayOptionAsync( true, false );
   displayOptionDaemon();
 }
 
@@ -95,6 +97,8 @@ int CSgctpUtil::parseArgs()
       SGCTP_PARSE_ARGS( parseArgsPayload( &__i, true, true ) );
       SGCTP_PARSE_ARGS( parseArgsPassword( &__i, true, true ) );
       SGCTP_PARSE_ARGS( parseArgsPasswordSalt( &__i, true, false ) );
+      SGCTP_PARSE_ARGS( parseArgsMapped( &__i ) );
+      SGCTP_PARSE_ARGS( parseArgsAsync( &__i, true, false ) );
       SGCTP_PARSE_ARGS( parseArgsDaemon( &__i ) );
       if( __sArg=="-p" || __sArg=="--port" )
       {
@@ -290,6 +294,19 @@ int CSgctpUtil::exec()
             break;
           }
 
+          // ... send pending frames (no more input data available)
+          if( !oTransmit_in.hasData() )
+          {
+            sigBlock();
+            __iReturn = oTransmit_out.flushFrames( sdOutput );
+            sigUnblock();
+            if( __iReturn < 0 )
+            {
+              SGCTP_LOG << SGCTP_WARNING << "Failed to serialize data @ flushFrames=" << __iReturn << endl;
+              break;
+            }
+          }
+
         }
 
       }
@@ -76,6 +76,8 @@ void CSgctpUtil::displayHelp()
   displayOptionPayload( true, true );
   displayOptionPassword( true, true );
   displayOptionPasswordSalt( true, true );
+  displayOptionMapped();
+  displayOptionAsync( true, false );
   displayOptionDaemon();
 }
 
@@ -93,6 +95,8 @@ int CSgctpUtil::parseArgs()
       SGCTP_PARSE_ARGS( parseArgsPayload( &__i, true, true ) );
       SGCTP_PARSE_ARGS( parseArgsPassword( &__i, true, true ) );
       SGCTP_PARSE_ARGS( parseArgsPasswordSalt( &__i, true, true ) );
+      SGCTP_PARSE_ARGS( parseArgsMapped( &__i ) );
+      SGCTP_PARSE_ARGS( parseArgsAsync( &__i, true, false ) );
       SGCTP_PARSE_ARGS( parseArgsDaemon( &__i ) );
       if( __sArg=="-p" || __sArg=="--port" )
       {
@@ -234,14 +238,23 @@ int CSgctpUtil::exec()
     }
 
     // Receive and dump data
-    CData __oData;
+    // NOTE: several datagrams are sent at once (see CTransmit_UDP::serializeBatch)
+    CDataBlock __oDataBlock;
+    __iReturn = __oDataBlock.alloc( CTransmit_UDP::DATAGRAM_BATCH_SIZE );
+    if( __iReturn < 0 )
+    {
+      SGCTP_LOG << SGCTP_ERROR << "Failed to allocate data block @ alloc=" << __iReturn << endl;
+      SGCTP_BREAK( __iReturn );
+    }
+    CData __poData[CTransmit_UDP::DATAGRAM_BATCH_SIZE];
     for(;;)
     {
       if( SGCTP_INTERRUPTED )
         break;
 
       // ... unserialize
-      __iReturn = oTransmit_in.unserialize( fdInput, &__oData );
+      __oDataBlock.reset();
+      __iReturn = oTransmit_in.unserializeBatch( fdInput, &__oDataBlock );
       if( SGCTP_INTERRUPTED )
         break;
       if( __iReturn == 0 )
@@ -251,10 +264,12 @@ int CSgctpUtil::exec()
         SGCTP_LOG << SGCTP_ERROR << "Failed to unserialize data @ unserialize=" << __iReturn << endl;
         SGCTP_BREAK( __iReturn );
       }
+      for( int __i = 0; __i < __oDataBlock.getSize(); __i++ )
+        __oDataBlock.getRecord( __i, &__poData[__i] );
 
       // ... serialize
       sigBlock();
-      __iReturn = oTransmit_out.serialize( sdOutput, __oData );
+      __iReturn = oTransmit_out.serializeBatch( sdOutput, __poData, __oDataBlock.getSize() );
       sigUnblock();
       if( __iReturn == 0 )
         SGCTP_BREAK( 0 );
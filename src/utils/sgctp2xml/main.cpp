@@ -34,6 +34,7 @@ extern "C" {
 }
 
 // SGCTP
+#include "sgctp/clock.hpp"
 #include "main.hpp"
 using namespace SGCTP;
 
@@ -119,6 +120,8 @@ void CSgctpUtil::displayHelp()
   displayOptionPayload( true, false );
   displayOptionPassword( true, false );
   displayOptionPasswordSalt( true, false );
+  displayOptionMapped();
+  displayOptionAsync( true, false );
 }
 
 int CSgctpUtil::parseArgs()
@@ -135,6 +138,8 @@ int CSgctpUtil::parseArgs()
       SGCTP_PARSE_ARGS( parseArgsPayload( &__i, true, false ) );
       SGCTP_PARSE_ARGS( parseArgsPassword( &__i, true, false ) );
       SGCTP_PARSE_ARGS( parseArgsPasswordSalt( &__i, true, false ) );
+      SGCTP_PARSE_ARGS( parseArgsMapped( &__i ) );
+      SGCTP_PARSE_ARGS( parseArgsAsync( &__i, true, false ) );
       if( __sArg=="-o" || __sArg=="--output" )
       {
         if( ++__i<iArgC )
@@ -290,7 +295,7 @@ void CSgctpUtil::dumpXML( const CData& _roData )
   {
     if( fdEpochReference >= 0 )
       __fdValue = CData::toEpoch( __fdValue, fdEpochReference );
-    char __pcIso8601[24];
+    char __pcIso8601[CClock::ISO8601_SIZE];
     CData::toIso8601( __pcIso8601, __fdValue );
     *poOutputStream << "    <Time>" << __pcIso8601 << "</Time>" << endl;
   }
@@ -22,11 +22,11 @@
 #include <unistd.h>
 
 // C++
-#include <unordered_map>
 #include <vector>
 using namespace std;
 
 // SGCTP
+#include "sgctp/id_table.hpp"
 #include "main.hpp"
 using namespace SGCTP;
 
@@ -51,6 +51,7 @@ CSgctpUtil::CSgctpUtil( int _iArgC, char *_ppcArgV[] )
   , fdOutput( STDOUT_FILENO )
   , sInputPath( "-" )
   , sOutputPath( "-" )
+  , sIndexPath( "" )
   , fdReplayRate( CData::UNDEFINED_VALUE )
   , sID( "" )
   , fdTimeThrottle( CData::UNDEFINED_VALUE )
@@ -87,6 +88,8 @@ void CSgctpUtil::displayHelp()
   displayOptionsHeader();
   cout << "  -o, --output <path>" << endl;
   cout << "    Output file (default:'-', standard output)" << endl;
+  cout << "  -x, --index <path>" << endl;
+  cout << "    Input index file (default:none; see sgctpindex)" << endl;
   cout << "  -r, --replay-rate <rate>"   << endl;
   cout << "    Data replay rate (defaut:none, must be >= 1.0)"   << endl;
   cout << "  -i, --id <ID>"   << endl;
@@ -117,8 +120,12 @@ void CSgctpUtil::displayHelp()
   cout << "    2nd limit elevation (default:none, meters)"   << endl;
   displayOptionPrincipal( true, true );
   displayOptionPayload( true, true );
+  displayOptionCompression();
+  displayOptionOutputBuffer();
   displayOptionPassword( true, true );
   displayOptionPasswordSalt( true, true );
+  displayOptionMapped();
+  displayOptionAsync( true, true );
   displayOptionDaemon();
   cout << "  --ttl <seconds>" << endl;
   cout << "    Internal data Time-To-Live/TTL (default:3600)" << endl;
@@ -136,14 +143,23 @@ int CSgctpUtil::parseArgs()
       SGCTP_PARSE_ARGS( parseArgsHelp( &__i ) );
       SGCTP_PARSE_ARGS( parseArgsPrincipal( &__i, true, true ) );
       SGCTP_PARSE_ARGS( parseArgsPayload( &__i, true, true ) );
+      SGCTP_PARSE_ARGS( parseArgsCompression( &__i ) );
+      SGCTP_PARSE_ARGS( parseArgsOutputBuffer( &__i ) );
       SGCTP_PARSE_ARGS( parseArgsPassword( &__i, true, true ) );
       SGCTP_PARSE_ARGS( parseArgsPasswordSalt( &__i, true, true ) );
+      SGCTP_PARSE_ARGS( parseArgsMapped( &__i ) );
+      SGCTP_PARSE_ARGS( parseArgsAsync( &__i, true, true ) );
       SGCTP_PARSE_ARGS( parseArgsDaemon( &__i ) );
       if( __sArg=="-o" || __sArg=="--output" )
       {
         if( ++__i<iArgC )
           sOutputPath = ppcArgV[__i];
       }
+      else if( __sArg=="-x" || __sArg=="--index" )
+      {
+        if( ++__i<iArgC )
+          sIndexPath = ppcArgV[__i];
+      }
       else if( __sArg=="-r" || __sArg=="--replay-rate" )
       {
         if( ++__i<iArgC ) {
@@ -451,7 +467,11 @@ int CSgctpUtil::exec()
   sigCatch( CSgctpUtil::interrupt );
 
   // Error-catching block
-  unordered_map<string,CDataPrevious*> __poDataPrevious_umap;
+  CIDTable __oDataPreviousID_table;
+  vector<CDataPrevious*> __poDataPrevious_vector;
+  // NOTE: the data containers are re-used (no memory allocation on copy)
+  vector<CData> __oDataOut_vector( SERIALIZE_BATCH_SIZE );
+  int __iDataOutCount = 0;
   do
   {
 
@@ -467,6 +487,45 @@ int CSgctpUtil::exec()
       }
     }
 
+    // Load input index (and select the data matching the ID/time filters)
+    if( !sIndexPath.empty() )
+    {
+      if( sInputPath == "-" )
+      {
+        SGCTP_LOG << SGCTP_ERROR << "Indexed input must not be standard input" << endl;
+        SGCTP_BREAK( -EINVAL );
+      }
+      if( oTransmit_in.getPayloadType() == CTransmit::PAYLOAD_DELTA )
+      {
+        SGCTP_LOG << SGCTP_ERROR << "Unsupported payload type (delta payloads can not be indexed)" << endl;
+        SGCTP_BREAK( -ENOTSUP );
+      }
+      int __fdIndex = open( sIndexPath.c_str(),
+                            O_RDONLY );
+      if( __fdIndex < 0 )
+      {
+        SGCTP_LOG << SGCTP_ERROR << "Invalid/unreadable file (" << sIndexPath << ") @ open=" << -errno << endl;
+        SGCTP_BREAK( -errno );
+      }
+      __iReturn = oFileIndex.load( __fdIndex );
+      close( __fdIndex );
+      if( __iReturn < 0 )
+      {
+        SGCTP_LOG << SGCTP_ERROR << "Invalid index file (" << sIndexPath << ") @ load=" << __iReturn << endl;
+        SGCTP_BREAK( __iReturn );
+      }
+      // ... time (of day; lenient conversion, records being filtered individually anyway)
+      uint32_t __ui32tTimeMin = CField::UNDEFINED_UINT32;
+      uint32_t __ui32tTimeMax = CField::UNDEFINED_UINT32;
+      if( __bTimeLimit && __fdTimeMin >= 0.0 && __fdTimeMax < 86400.0 )
+      {
+        __ui32tTimeMin = CField::fromValue<CField::TIME>( fmax( __fdTimeMin - 1.0, 0.0 ) );
+        __ui32tTimeMax = CField::fromValue<CField::TIME>( fmin( __fdTimeMax + 1.0, 86399.0 ) );
+      }
+      __iReturn = oFileIndex.select( sID.c_str(), __ui32tTimeMin, __ui32tTimeMax );
+      SGCTP_LOG << SGCTP_INFO << "Index: " << __iReturn << " out of " << oFileIndex.getCheckpointCount() << " checkpoints selected" << endl;
+    }
+
     // Open output (POSIX file descriptor)
     if( sOutputPath != "-" )
     {
@@ -490,7 +549,32 @@ int CSgctpUtil::exec()
       if( SGCTP_INTERRUPTED )
         break;
 
+      // Serialize output (batch full, no more input data available or replay)
+      if( __iDataOutCount
+          && ( __iDataOutCount >= SERIALIZE_BATCH_SIZE
+               || !oTransmit_in.hasData()
+               || CData::isDefined( fdReplayRate ) ) )
+      {
+        sigBlock();
+        __iReturn = oTransmit_out.serializeBatch( fdOutput, &__oDataOut_vector[0], __iDataOutCount );
+        sigUnblock();
+        __iDataOutCount = 0;
+        if( __iReturn == 0 )
+          SGCTP_BREAK( 0 );
+        if( __iReturn < 0 )
+        {
+          SGCTP_LOG << SGCTP_ERROR << "Failed to serialize data @ serializeBatch=" << __iReturn << endl;
+          SGCTP_BREAK( __iReturn );
+        }
+      }
+
       // Unserialize input
+      __iReturn = oFileIndex.seek( fdInput, &oTransmit_in );
+      if( __iReturn < 0 )
+      {
+        SGCTP_LOG << SGCTP_ERROR << "Failed to seek data @ seek=" << __iReturn << endl;
+        SGCTP_BREAK( __iReturn );
+      }
       __iReturn = oTransmit_in.unserialize( fdInput, &__oData );
       if( SGCTP_INTERRUPTED )
         break;
@@ -503,52 +587,39 @@ int CSgctpUtil::exec()
       }
       double __fdEpochNow = CData::epoch();
 
-      // Originating source (ID)
-      string __sSource = __oData.getID();
-
       // Data map cleanup
       if( __fdEpochNow - __fdEpochCleanup > (double)300.0 )
       {
         __fdEpochCleanup = __fdEpochNow;
 
-        // ... get keys
-        vector<string> __vsKeys;
-        __vsKeys.reserve( __poDataPrevious_umap.size() );
-        for( unordered_map<string,CDataPrevious*>::const_iterator __it =
-               __poDataPrevious_umap.begin();
-             __it != __poDataPrevious_umap.end();
-             ++__it )
-        {
-          __vsKeys.push_back( __it->first );
-        }
-
-        // ... loop through keys
-        for( vector<string>::const_iterator __it = __vsKeys.begin();
-             __it != __vsKeys.end();
+        // ... loop through entries
+        for( vector<CDataPrevious*>::iterator __it = __poDataPrevious_vector.begin();
+             __it != __poDataPrevious_vector.end();
              ++__it )
         {
           // ... cleanup stale entries (older than data TTL)
-          if( __fdEpochNow - __poDataPrevious_umap[ *__it ]->fdEpoch
-              > (double)iDataTTL )
+          if( *__it
+              && __fdEpochNow - (*__it)->fdEpoch > (double)iDataTTL )
           {
-            delete __poDataPrevious_umap[ *__it ];
-            __poDataPrevious_umap.erase( *__it );
+            delete *__it;
+            *__it = NULL;
+            __oDataPreviousID_table.erase( __it - __poDataPrevious_vector.begin() );
           }
         }
 
       }
 
-      // Data map lookup
-      CDataPrevious* __poDataPrevious;
-      unordered_map<string,CDataPrevious*>::const_iterator __it =
-        __poDataPrevious_umap.find( __sSource );
-      if( __it == __poDataPrevious_umap.end() )
+      // Data map lookup (ID handle)
+      uint32_t __ui32tSource =
+        __oDataPreviousID_table.intern( __oData.getID(), __oData.getIDLength() );
+      if( __ui32tSource >= __poDataPrevious_vector.size() )
+        __poDataPrevious_vector.resize( __ui32tSource+1, NULL );
+      CDataPrevious* __poDataPrevious = __poDataPrevious_vector[__ui32tSource];
+      if( !__poDataPrevious )
       {
         __poDataPrevious = new CDataPrevious();
-        __poDataPrevious_umap[__sSource] = __poDataPrevious;
+        __poDataPrevious_vector[__ui32tSource] = __poDataPrevious;
       }
-      else
-        __poDataPrevious = __it->second;
       bool __b2DPrev =
         CData::isDefined( __poDataPrevious->fdLatitude )
         && CData::isDefined( __poDataPrevious->fdLongitude );
@@ -666,17 +737,8 @@ int CSgctpUtil::exec()
       if( CData::isDefined( __fdElevation ) )
         __poDataPrevious->fdElevation = __fdElevation;
 
-      // Serialize output
-      sigBlock();
-      __iReturn = oTransmit_out.serialize( fdOutput, __oData );
-      sigUnblock();
-      if( __iReturn == 0 )
-        SGCTP_BREAK( 0 );
-      if( __iReturn < 0 )
-      {
-        SGCTP_LOG << SGCTP_ERROR << "Failed to serialize data @ serialize=" << __iReturn << endl;
-        SGCTP_BREAK( __iReturn );
-      }
+      // Queue output (see above)
+      __oDataOut_vector[__iDataOutCount++].copy( __oData );
 
     }
 
@@ -686,13 +748,19 @@ int CSgctpUtil::exec()
   // Done
   if( fdInput >= 0 && fdInput != STDIN_FILENO )
     close( fdInput );
+  if( fdOutput >= 0 )
+  {
+    if( __iDataOutCount )
+      oTransmit_out.serializeBatch( fdOutput, &__oDataOut_vector[0], __iDataOutCount );
+    oTransmit_out.finish( fdOutput );
+  }
   if( fdOutput >= 0 && fdOutput != STDOUT_FILENO )
     close( fdOutput );
-  for( unordered_map<string,CDataPrevious*>::const_iterator __it =
-         __poDataPrevious_umap.begin();
-       __it != __poDataPrevious_umap.end();
+  for( vector<CDataPrevious*>::const_iterator __it =
+         __poDataPrevious_vector.begin();
+       __it != __poDataPrevious_vector.end();
        ++__it )
-    delete __it->second;
+    delete *__it;
   daemonEnd();
   return __iExit;
 }
@@ -48,6 +48,10 @@ class CSgctpUtil: protected CSgctpUtilSkeleton
   // STATIC / CONSTANTS
   //----------------------------------------------------------------------
 
+private:
+  /// Maximum quantity of data serialized at once (per batch)
+  static const int SERIALIZE_BATCH_SIZE = 256;
+
 public:
   static void interrupt( int _iSignal );
 
@@ -65,6 +69,8 @@ private:
   CTransmit_File oTransmit_in;
   /// Input file descriptor
   int fdInput;
+  /// Input index
+  CFileIndex oFileIndex;
   /// Output transmission object (actual)
   CTransmit_File oTransmit_out;
   /// Output file descriptor
@@ -79,6 +85,8 @@ private:
   string sInputPath;
   /// Output file path
   string sOutputPath;
+  /// Input index file path
+  string sIndexPath;
 
   /// Replay rate
   double fdReplayRate;
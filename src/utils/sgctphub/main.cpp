@@ -34,6 +34,7 @@
 using namespace std;
 
 // SGCTP
+#include "sgctp/clock.hpp"
 #include "main.hpp"
 using namespace SGCTP;
 
@@ -164,11 +165,11 @@ CSgctpHub::CSgctpHub( int _iArgC, char *_ppcArgV[] )
 CSgctpHub::~CSgctpHub()
 {
   // De-allocate data resources
-  for( unordered_map<string,CSgctpHubData*>::const_iterator __it =
-         poSgctpHubData_umap.begin();
-       __it != poSgctpHubData_umap.end();
+  for( vector<CSgctpHubData*>::const_iterator __it =
+         poSgctpHubData_vector.begin();
+       __it != poSgctpHubData_vector.end();
        ++__it )
-    delete __it->second;
+    delete *__it;
 
   // De-allocate TCP agent resources
   for( unordered_map<int,CSgctpHubAgentTCP*>::const_iterator __it =
@@ -534,15 +535,18 @@ void* CSgctpHub::dataThread()
   pthread_exit( NULL );
 }
 
-bool CSgctpHub::dataSync( const CData &_roData )
+bool CSgctpHub::dataSync( const CData &_roData,
+                          uint32_t *_pui32tID )
 {
-  string __sID = _roData.getID();
-  CSgctpHubData* __poSgctpHubData;
-  double __fdEpochNow = CData::epoch();
-  unordered_map<string,CSgctpHubData*>::const_iterator __it =
-    poSgctpHubData_umap.find( __sID );
+  uint32_t __ui32tID = oSgctpHubDataID_table.intern( _roData.getID(),
+                                                     _roData.getIDLength() );
+  *_pui32tID = __ui32tID;
+  if( __ui32tID >= poSgctpHubData_vector.size() )
+    poSgctpHubData_vector.resize( __ui32tID+1, NULL );
+  CSgctpHubData* __poSgctpHubData = poSgctpHubData_vector[__ui32tID];
+  double __fdEpochNow = CClock::nowCoarse();
   bool __bSync = false;
-  if( __it == poSgctpHubData_umap.end() )
+  if( !__poSgctpHubData )
   {
 
     // Create new data container
@@ -553,7 +557,7 @@ bool CSgctpHub::dataSync( const CData &_roData )
     __poSgctpHubData->fdLatitude = _roData.getLatitude();
     __poSgctpHubData->fdLongitude = _roData.getLongitude();
     __poSgctpHubData->fdElevation = _roData.getElevation();
-    poSgctpHubData_umap[__sID] = __poSgctpHubData;
+    poSgctpHubData_vector[__ui32tID] = __poSgctpHubData;
     __bSync = true;
 
   }
@@ -561,7 +565,6 @@ bool CSgctpHub::dataSync( const CData &_roData )
   {
 
     // Synchronize existing data container
-    __poSgctpHubData = __it->second;
     do // Error-catching block
     {
 
@@ -612,27 +615,21 @@ bool CSgctpHub::dataSync( const CData &_roData )
 
 void CSgctpHub::dataCleanup()
 {
-  // Get data keys (source IDs)
-  vector<string> __vsKeys;
-  __vsKeys.reserve( poSgctpHubData_umap.size() );
-  for( unordered_map<string,CSgctpHubData*>::const_iterator __it =
-         poSgctpHubData_umap.begin();
-       __it != poSgctpHubData_umap.end();
-       ++__it )
-    __vsKeys.push_back( __it->first );
-
-  // Loop through keys
-  double __fdEpochNow = CData::epoch();
-  for( vector<string>::const_iterator __it = __vsKeys.begin();
-       __it != __vsKeys.end();
+  // Loop through data (ID handles)
+  // NOTE: erased ID handles are re-used by subsequent IDs; handles still in
+  //       the synchronization queue may thus point to another ID's (valid) data
+  double __fdEpochNow = CClock::nowCoarse();
+  for( vector<CSgctpHubData*>::iterator __it = poSgctpHubData_vector.begin();
+       __it != poSgctpHubData_vector.end();
        ++__it )
   {
     // ... cleanup stale entries (older than data TTL)
-    if( __fdEpochNow - poSgctpHubData_umap[ *__it ]->fdEpoch
-        > (double)iDataTTL )
+    if( *__it
+        && __fdEpochNow - (*__it)->fdEpoch > (double)iDataTTL )
     {
-      delete poSgctpHubData_umap[ *__it ];
-      poSgctpHubData_umap.erase( *__it );
+      delete *__it;
+      *__it = NULL;
+      oSgctpHubDataID_table.erase( __it - poSgctpHubData_vector.begin() );
     }
   }
 }
@@ -709,6 +706,16 @@ void* CSgctpHub::agentUDPThread()
   int __iReturn;
 
   // Receive and dump data
+  // NOTE: several datagrams are received at once (see CTransmit_UDP::unserializeBatch)
+  CDataBlock __oDataBlock;
+  __iReturn = __oDataBlock.alloc( CTransmit_UDP::DATAGRAM_BATCH_SIZE );
+  if( __iReturn < 0 )
+  {
+    pthread_mutex_lock( &tLog_mutex );
+    SGCTP_LOG << SGCTP_ERROR << "Failed to allocate UDP agent data block @ alloc=" << __iReturn << endl;
+    pthread_mutex_unlock( &tLog_mutex );
+    pthread_exit( NULL );
+  }
   CData __oData;
   for(;;)
   {
@@ -716,29 +723,51 @@ void* CSgctpHub::agentUDPThread()
       break;
 
     // ... unserialize
-    __iReturn = oTransmit_AgentUDP.unserialize( sdAgentUDP, &__oData );
+    __oDataBlock.reset();
+    __iReturn = oTransmit_AgentUDP.unserializeBatch( sdAgentUDP, &__oDataBlock );
     if( SGCTP_INTERRUPTED )
       break;
     if( __iReturn == 0 )
       break;
-    if( __iReturn < 0 )
+    for( int __i = 0; __i < oTransmit_AgentUDP.getDatagramCount(); __i++ )
     {
+      const CTransmit_UDP::TDatagram *__ptDatagram = oTransmit_AgentUDP.getDatagram( __i );
+      if( __ptDatagram->iStatus >= 0 )
+        continue;
+      char __pcIP[INET6_ADDRSTRLEN];
+      inet_ntop( __ptDatagram->tSockaddr.ss_family,
+                 getInAddr( (struct sockaddr*)&__ptDatagram->tSockaddr ),
+                 __pcIP, INET6_ADDRSTRLEN );
       pthread_mutex_lock( &tLog_mutex );
-      SGCTP_LOG << SGCTP_WARNING << "Failed to unserialize UDP agent data @ unserialize=" << __iReturn << endl;
+      SGCTP_LOG << SGCTP_WARNING << "Failed to unserialize UDP agent data (" << __pcIP << ") @ unserialize=" << __ptDatagram->iStatus << endl;
       pthread_mutex_unlock( &tLog_mutex );
+    }
+    if( __iReturn < 0 )
+    {
+      if( !oTransmit_AgentUDP.getDatagramCount() )
+      {
+        pthread_mutex_lock( &tLog_mutex );
+        SGCTP_LOG << SGCTP_WARNING << "Failed to receive UDP agent data @ unserializeBatch=" << __iReturn << endl;
+        pthread_mutex_unlock( &tLog_mutex );
+      }
       continue;
     }
 
     // ... synchronize data
-    pthread_mutex_lock( &tSgctpHubData_mutex );
-    bool __bSync = dataSync( __oData );
-    pthread_mutex_unlock( &tSgctpHubData_mutex );
-    if( __bSync )
+    for( int __i = 0; __i < __oDataBlock.getSize(); __i++ )
     {
-      pthread_mutex_lock( &tSyncID_mutex );
-      sSyncID_queue.push( __oData.getID() );
-      pthread_mutex_unlock( &tSyncID_mutex );
-      pthread_cond_signal( &tClientTX_cond );
+      __oDataBlock.getRecord( __i, &__oData );
+      pthread_mutex_lock( &tSgctpHubData_mutex );
+      uint32_t __ui32tID;
+      bool __bSync = dataSync( __oData, &__ui32tID );
+      pthread_mutex_unlock( &tSgctpHubData_mutex );
+      if( __bSync )
+      {
+        pthread_mutex_lock( &tSyncID_mutex );
+        ui32tSyncID_queue.push( __ui32tID );
+        pthread_mutex_unlock( &tSyncID_mutex );
+        pthread_cond_signal( &tClientTX_cond );
+      }
     }
 
   }
@@ -976,17 +1005,18 @@ void CSgctpHub::agentTCPInput( int _iSocket,
 {
   int __iReturn;
 
-  // Set transmission timeout
-  _poSgctpHubAgentTCP->oTransmit.setTimeout( _iSocket, 3.0 ); // prevent DoS
-
   // Loop through available TCP agents data
+  // NOTE: data are received without blocking, such that a partially sent
+  //       payload can not stall the hub (no transmission timeout needed)
   for(;;)
   {
 
     // ... unserialize TCP agents data
     CData __oData;
     __iReturn =
-      _poSgctpHubAgentTCP->oTransmit.unserialize( _iSocket, &__oData );
+      _poSgctpHubAgentTCP->oTransmit.tryUnserialize( _iSocket, &__oData );
+    if( __iReturn == -EAGAIN )
+      break;
     if( __iReturn <= 0 )
     {
       _poSgctpHubAgentTCP->iError = __iReturn;
@@ -1022,6 +1052,7 @@ void CSgctpHub::agentTCPInput( int _iSocket,
             sdAgentTCP_max = __j;
             break;
           }
+      return;
 
     }
     else
@@ -1034,25 +1065,20 @@ void CSgctpHub::agentTCPInput( int _iSocket,
 
       // ... synchronize data
       pthread_mutex_lock( &tSgctpHubData_mutex );
-      bool __bSync = dataSync( __oData );
+      uint32_t __ui32tID;
+      bool __bSync = dataSync( __oData, &__ui32tID );
       pthread_mutex_unlock( &tSgctpHubData_mutex );
       if( __bSync )
       {
         pthread_mutex_lock( &tSyncID_mutex );
-        sSyncID_queue.push( __oData.getID() );
+        ui32tSyncID_queue.push( __ui32tID );
         pthread_mutex_unlock( &tSyncID_mutex );
         pthread_cond_signal( &tClientTX_cond );
       }
 
     }
 
-    if( !_poSgctpHubAgentTCP->oTransmit.hasData() )
-      break;
-
   } // Loop through available TCP agents data
-
-  // Unset transmission timeout
-  _poSgctpHubAgentTCP->oTransmit.setTimeout( _iSocket, 0.0 );
 }
 
 
@@ -1309,6 +1335,9 @@ void* CSgctpHub::clientTXThread()
 {
   int __iReturn;
 
+  // NOTE: the data containers are re-used (no memory allocation on copy)
+  vector<CData> __oData_vector;
+
   pthread_mutex_lock( &tClientTX_mutex );
   for(;;)
   {
@@ -1321,28 +1350,37 @@ void* CSgctpHub::clientTXThread()
     // Send data to clients
     for(;;)
     {
-      // ... retrieve ID to send
-      string __sID;
-      pthread_mutex_lock( &tSyncID_mutex );
-      if( sSyncID_queue.empty() )
+      // ... retrieve data to send (up to SYNC_BATCH_SIZE)
+      int __iDataCount = 0;
+      for( ; __iDataCount < SYNC_BATCH_SIZE; __iDataCount++ )
       {
+        // ... retrieve ID (handle) to send
+        uint32_t __ui32tID;
+        pthread_mutex_lock( &tSyncID_mutex );
+        if( ui32tSyncID_queue.empty() )
+        {
+          pthread_mutex_unlock( &tSyncID_mutex );
+          break;
+        }
+        __ui32tID = ui32tSyncID_queue.front();
+        ui32tSyncID_queue.pop();
         pthread_mutex_unlock( &tSyncID_mutex );
-        break;
-      }
-      __sID = sSyncID_queue.front();
-      sSyncID_queue.pop();
-      pthread_mutex_unlock( &tSyncID_mutex );
 
-      // ... retrieve data to send
-      CData __oData;
-      pthread_mutex_lock( &tSgctpHubData_mutex );
-      if( poSgctpHubData_umap.find( __sID ) == poSgctpHubData_umap.end() )
-      {
+        // ... retrieve data to send
+        pthread_mutex_lock( &tSgctpHubData_mutex );
+        if( !poSgctpHubData_vector[__ui32tID] )
+        {
+          pthread_mutex_unlock( &tSgctpHubData_mutex );
+          __iDataCount--;
+          continue;
+        }
+        if( __iDataCount >= (int)__oData_vector.size() )
+          __oData_vector.resize( __iDataCount+1 );
+        __oData_vector[__iDataCount].copy( poSgctpHubData_vector[__ui32tID]->oData );
         pthread_mutex_unlock( &tSgctpHubData_mutex );
-        continue;
       }
-      __oData.copy( poSgctpHubData_umap[__sID]->oData );
-      pthread_mutex_unlock( &tSgctpHubData_mutex );
+      if( !__iDataCount )
+        break;
 
       // ... lock client deletion
       pthread_mutex_lock( &tClientDelete_mutex );
@@ -1364,27 +1402,41 @@ void* CSgctpHub::clientTXThread()
         if( !__poSgctpHubClient->bSync )
           continue;
 
-        // ... check limits (filter)
-        if( !clientFilterCheck( __poSgctpHubClient, __oData ) )
-          continue;
-
-        // ... serialize data
+        // ... serialize data (runs of records passing the client filter)
+        bool __bError = false;
         sigBlock();
-        __iReturn = __poSgctpHubClient->oTransmit.serialize( __i, __oData );
-        sigUnblock();
-        if( __iReturn <= 0 )
-        {
-          __poSgctpHubClient->iError = __iReturn;
-          FD_SET( __i, &__sdClientClose_fdset );
-        }
-        else
+        for( int __j = 0; __j < __iDataCount; )
         {
+          // ... check limits (filter)
+          if( !clientFilterCheck( __poSgctpHubClient, __oData_vector[__j] ) )
+          {
+            __j++;
+            continue;
+          }
+          int __iRunStart = __j++;
+          while( __j < __iDataCount
+                 && clientFilterCheck( __poSgctpHubClient, __oData_vector[__j] ) )
+            __j++;
+
+          // ... serialize data
+          __iReturn = __poSgctpHubClient->oTransmit.serializeBatch( __i, &__oData_vector[__iRunStart], __j-__iRunStart );
+          if( __iReturn <= 0 )
+          {
+            __bError = true;
+            break;
+          }
           int __iPayloadSize = __iReturn;
 
           // ... increase counters
-          __poSgctpHubClient->ui64tPackets++;
+          __poSgctpHubClient->ui64tPackets += __j-__iRunStart;
           __poSgctpHubClient->ui64tBytes += __iPayloadSize;
         }
+        sigUnblock();
+        if( __bError )
+        {
+          __poSgctpHubClient->iError = __iReturn;
+          FD_SET( __i, &__sdClientClose_fdset );
+        }
 
       }
 
@@ -1412,17 +1464,17 @@ void CSgctpHub::clientInput( int _iSocket,
 {
   int __iReturn;
 
-  // Set transmission timeout
-  _poSgctpHubClient->oTransmit.setTimeout( _iSocket, 3.0 ); // prevent DoS
-
   // Loop through available client data
+  // NOTE: data are received without blocking (see agentTCPInput())
   for(;;)
   {
 
     // ... unserialize clients data
     CData __oData;
     __iReturn =
-      _poSgctpHubClient->oTransmit.unserialize( _iSocket, &__oData );
+      _poSgctpHubClient->oTransmit.tryUnserialize( _iSocket, &__oData );
+    if( __iReturn == -EAGAIN )
+      break;
     if( __iReturn <= 0 )
     {
       _poSgctpHubClient->iError = __iReturn;
@@ -1464,14 +1516,15 @@ void CSgctpHub::clientInput( int _iSocket,
 
       // ... unlock client deletion
       pthread_mutex_unlock( &tClientDelete_mutex );
+      return;
 
     }
     else
     {
 
       // ... handle filter directives
-      string __sID = __oData.getID();
-      if( __sID == "#START" )
+      const char *__pcID = __oData.getID();
+      if( !strcmp( __pcID, "#START" ) )
       {
         __iReturn = clientStart( _poSgctpHubClient );
         if( __iReturn )
@@ -1495,10 +1548,11 @@ void CSgctpHub::clientInput( int _iSocket,
 
           // ... unlock client deletion
           pthread_mutex_unlock( &tClientDelete_mutex );
+          return;
 
         }
       }
-      else if( __sID.substr( 0, 4 ) == "#FLT" )
+      else if( !strncmp( __pcID, "#FLT", 4 ) )
       {
         if( _poSgctpHubClient->bSync )
           break;
@@ -1507,20 +1561,14 @@ void CSgctpHub::clientInput( int _iSocket,
 
     }
 
-    if( !_poSgctpHubClient->oTransmit.hasData() )
-      break;
-
   } // Loop through available client data
-
-  // Unset transmission timeout
-  _poSgctpHubClient->oTransmit.setTimeout( _iSocket, 0.0 );
 }
 
 void CSgctpHub::clientFilterDefine( CSgctpHubClient *_poSgctpHubClient,
                                     const CData &_roData )
 {
-  string __sID = _roData.getID();
-  if( __sID == "#FLT0" )
+  const char *__pcID = _roData.getID();
+  if( !strcmp( __pcID, "#FLT0" ) )
   {
 
     // ... references
@@ -1528,7 +1576,7 @@ void CSgctpHub::clientFilterDefine( CSgctpHubClient *_poSgctpHubClient,
     _poSgctpHubClient->fdLongitude0 = _roData.getLongitude();
 
   }
-  else if( __sID == "#FLT1" )
+  else if( !strcmp( __pcID, "#FLT1" ) )
   {
 
     // ... 1st limits
@@ -1538,7 +1586,7 @@ void CSgctpHub::clientFilterDefine( CSgctpHubClient *_poSgctpHubClient,
     _poSgctpHubClient->fdElevation1 = _roData.getElevation();
 
   }
-  else if( __sID == "#FLT2" )
+  else if( !strcmp( __pcID, "#FLT2" ) )
   {
 
     // ... 2nd limits
@@ -27,6 +27,7 @@
 #include <queue>
 #include <string>
 #include <unordered_map>
+#include <vector>
 using namespace std;
 
 #ifndef __SGCTP_USE_OPENSSL__
@@ -37,6 +38,7 @@ using namespace std;
 #endif // NOT __SGCTP_USE_OPENSSL__
 
 // SGCTP
+#include "sgctp/id_table.hpp"
 #include "../skeleton.hpp"
 using namespace SGCTP;
 
@@ -191,6 +193,10 @@ class CSgctpHub: protected CSgctpUtilSkeleton
   // STATIC / CONSTANTS
   //----------------------------------------------------------------------
 
+private:
+  /// Maximum quantity of data sent to clients at once (per frame/batch)
+  static const int SYNC_BATCH_SIZE = 256;
+
 private:
   static pthread_t THREAD_DATA;
   static void* threadData( void* _poSgctpHub );
@@ -226,12 +232,14 @@ private:
   //
 
 private:
-  /// Internal data map
-  unordered_map<string,CSgctpHubData*> poSgctpHubData_umap;
+  /// Internal data IDs (interning table; see CIDTable)
+  CIDTable oSgctpHubDataID_table;
+  /// Internal data (indexed by ID handle; NULL if none)
+  vector<CSgctpHubData*> poSgctpHubData_vector;
   /// Internal data modification mutex
   pthread_mutex_t tSgctpHubData_mutex;
-  /// Pending data (IDs) to synchronize
-  queue<string> sSyncID_queue;
+  /// Pending data (ID handles) to synchronize
+  queue<uint32_t> ui32tSyncID_queue;
   /// Pending data (IDs) modification mutex
   pthread_mutex_t tSyncID_mutex;
 
@@ -355,7 +363,13 @@ private:
   /// Data thread (execution) function
   void* dataThread();
   /// Synchronize internal data
-  bool dataSync( const CData &_roData );
+  /**
+   *  @param[in] _roData Data
+   *  @param[out] _pui32tID Data ID handle (see CIDTable)
+   *  @return Whether data have actually been synchronized
+   */
+  bool dataSync( const CData &_roData,
+                 uint32_t *_pui32tID );
   /// Clean-up internal data
   void dataCleanup();
 
@@ -0,0 +1,264 @@
+// INDENTING (emacs/vi): -*- mode:c++; tab-width:2; c-basic-offset:2; intent-tabs-mode:nil; -*- ex: set tabstop=2 expandtab:
+
+/*
+ * Simple Geolocalization and Course Transmission Protocol (SGCTP)
+ * Copyright (C) 2014 Cedric Dufour <http://cedric.dufour.name>
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * free software:
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, Version 3.
+ *
+ * The Simple Geolocalization and Course Transmission Protocol (SGCTP) is
+ * distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ */
+
+// C
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+// SGCTP
+#include "main.hpp"
+using namespace SGCTP;
+
+
+//----------------------------------------------------------------------
+// STATIC / CONSTANTS
+//----------------------------------------------------------------------
+
+void CSgctpUtil::interrupt( int _iSignal )
+{
+  SGCTP_INTERRUPTED = 1;
+}
+
+
+//----------------------------------------------------------------------
+// CONSTRUCTORS / DESTRUCTOR
+//----------------------------------------------------------------------
+
+CSgctpUtil::CSgctpUtil( int _iArgC, char *_ppcArgV[] )
+  : CSgctpUtilSkeleton( "sgctpindex", _iArgC, _ppcArgV )
+  , fdInput( -1 )
+  , fdIndex( -1 )
+  , sInputPath( "" )
+  , sIndexPath( "" )
+  , iCheckpointRecords( CFileIndex::CHECKPOINT_RECORDS )
+  , bFollow( false )
+{
+  // Link actual transmission objects
+  poTransmit_in = &oTransmit_in;
+}
+
+
+//----------------------------------------------------------------------
+// METHODS: CSgctpUtilSkeleton (implement/override)
+//----------------------------------------------------------------------
+
+void CSgctpUtil::displayHelp()
+{
+  // Display full help
+  displayUsageHeader();
+  cout << "  sgctpindex [options] <path(in)>" << endl;
+  displaySynopsisHeader();
+  cout << "  Index (or update the index of) the SGCTP data of the given file, allowing" << endl;
+  cout << "  to seek directly to the data matching a given ID and/or time range" << endl;
+  cout << "  (see sgctpfilter)." << endl;
+  displayOptionsHeader();
+  cout << "  -o, --output <path>" << endl;
+  cout << "    Index file (default:'<path(in)>.idx')" << endl;
+  cout << "  -c, --checkpoint <records>" << endl;
+  cout << "    Quantity of records between checkpoints (default:1024)" << endl;
+  cout << "  -f, --follow" << endl;
+  cout << "    Keep indexing the data appended to the file (until interrupted)" << endl;
+  displayOptionPrincipal( true, false );
+  displayOptionPayload( true, false );
+  displayOptionPassword( true, false );
+  displayOptionPasswordSalt( true, false );
+  displayOptionMapped();
+  displayOptionAsync( true, false );
+}
+
+int CSgctpUtil::parseArgs()
+{
+  // Parse all arguments
+  int __iArgCount = 0;
+  for( int __i=1; __i<iArgC; __i++ )
+  {
+    string __sArg = ppcArgV[__i];
+    if( __sArg[0] == '-' )
+    {
+      SGCTP_PARSE_ARGS( parseArgsHelp( &__i ) );
+      SGCTP_PARSE_ARGS( parseArgsPrincipal( &__i, true, false ) );
+      SGCTP_PARSE_ARGS( parseArgsPayload( &__i, true, false ) );
+      SGCTP_PARSE_ARGS( parseArgsPassword( &__i, true, false ) );
+      SGCTP_PARSE_ARGS( parseArgsPasswordSalt( &__i, true, false ) );
+      SGCTP_PARSE_ARGS( parseArgsMapped( &__i ) );
+      SGCTP_PARSE_ARGS( parseArgsAsync( &__i, true, false ) );
+      if( __sArg=="-o" || __sArg=="--output" )
+      {
+        if( ++__i<iArgC )
+          sIndexPath = ppcArgV[__i];
+      }
+      else if( __sArg=="-c" || __sArg=="--checkpoint" )
+      {
+        if( ++__i<iArgC )
+        {
+          iCheckpointRecords = strtol( ppcArgV[__i], NULL, 10 );
+          if( iCheckpointRecords <= 0 )
+          {
+            SGCTP_LOG << SGCTP_ERROR << "Invalid checkpoint interval (" << ppcArgV[__i] << ")" << endl;
+            return -EINVAL;
+          }
+        }
+      }
+      else if( __sArg=="-f" || __sArg=="--follow" )
+      {
+        bFollow = true;
+      }
+      else if( __sArg[0] == '-' )
+      {
+        displayErrorInvalidOption( __sArg );
+        return -EINVAL;
+      }
+      if( __i == iArgC )
+      {
+        displayErrorMissingArgument ( __sArg );
+        return -EINVAL;
+      }
+    }
+    else
+    {
+      switch( __iArgCount++ )
+      {
+      case 0:
+        sInputPath = __sArg;
+        break;
+      default:
+        displayErrorExtraArgument( __sArg );
+        return -EINVAL;
+      }
+    }
+  }
+  if( sInputPath.empty() || sInputPath == "-" )
+  {
+    SGCTP_LOG << SGCTP_ERROR << "Input must be a (seekable) file" << endl;
+    return -EINVAL;
+  }
+  if( sIndexPath.empty() )
+    sIndexPath = sInputPath + ".idx";
+
+  // Done
+  return 0;
+}
+
+#define SGCTP_BREAK( __iExit__ ) { SGCTP_INTERRUPTED=1; __iExit = __iExit__; break; }
+int CSgctpUtil::exec()
+{
+  int __iExit = 0;
+  int __iReturn;
+
+  // Parse arguments
+  __iReturn = parseArgs();
+  if( __iReturn )
+    return __iReturn;
+
+  // Lookup principal(s)
+  __iReturn = principalLookup( true, false );
+  if( __iReturn )
+    return __iReturn;
+
+  // Initialize transmission object(s)
+  __iReturn = transmitInit( true, false );
+  if( __iReturn )
+    return __iReturn;
+
+  // Check payload type
+  // NOTE: delta payloads can not be unserialized independently (see CTransmit_File::seek())
+  if( oTransmit_in.getPayloadType() == CTransmit::PAYLOAD_DELTA )
+  {
+    SGCTP_LOG << SGCTP_ERROR << "Unsupported payload type (delta payloads can not be indexed)" << endl;
+    return -ENOTSUP;
+  }
+
+  // Catch signals
+  sigCatch( CSgctpUtil::interrupt );
+
+  // Error-catching block
+  do
+  {
+
+    // Open input (POSIX file descriptor)
+    fdInput = open( sInputPath.c_str(),
+                    O_RDONLY );
+    if( fdInput < 0 )
+    {
+      SGCTP_LOG << SGCTP_ERROR << "Invalid/unreadable file (" << sInputPath << ") @ open=" << -errno << endl;
+      SGCTP_BREAK( -errno );
+    }
+
+    // Open (and load) index
+    fdIndex = open( sIndexPath.c_str(),
+                    O_CREAT|O_RDWR,
+                    S_IWUSR|S_IRUSR|S_IRGRP|S_IROTH );
+    if( fdIndex < 0 )
+    {
+      SGCTP_LOG << SGCTP_ERROR << "Invalid/unwritable file (" << sIndexPath << ") @ open=" << -errno << endl;
+      SGCTP_BREAK( -errno );
+    }
+    __iReturn = oFileIndex.load( fdIndex );
+    if( __iReturn < 0 )
+    {
+      SGCTP_LOG << SGCTP_ERROR << "Invalid index file (" << sIndexPath << ") @ load=" << __iReturn << endl;
+      SGCTP_BREAK( __iReturn );
+    }
+
+    // Index data
+    for(;;)
+    {
+      if( SGCTP_INTERRUPTED )
+        break;
+
+      // ... update index
+      __iReturn = oFileIndex.update( fdIndex, fdInput, &oTransmit_in, iCheckpointRecords );
+      if( __iReturn < 0 )
+      {
+        SGCTP_LOG << SGCTP_ERROR << "Failed to index data @ update=" << __iReturn << endl;
+        SGCTP_BREAK( __iReturn );
+      }
+      if( __iReturn > 0 || !bFollow )
+        SGCTP_LOG << SGCTP_INFO << "Indexed " << __iReturn << " records (total: " << oFileIndex.getCheckpointCount() << " checkpoints, " << oFileIndex.getIDCount() << " IDs)" << endl;
+
+      // ... follow
+      if( !bFollow )
+        break;
+      sleep( 1 );
+
+    }
+
+  }
+  while( false ); // Error-catching block
+
+  // Done
+  if( fdInput >= 0 )
+    close( fdInput );
+  if( fdIndex >= 0 )
+    close( fdIndex );
+  oFileIndex.free();
+  return __iExit;
+}
+
+
+//----------------------------------------------------------------------
+// MAIN
+//----------------------------------------------------------------------
+
+int main( int argc, char* argv[] )
+{
+  CSgctpUtil __oSgctpUtil( argc, argv );
+  return __oSgctpUtil.exec();
+}
@@ -133,6 +133,15 @@ CSgctpUtilSkeleton::CSgctpUtilSkeleton( const string &_rsApplicationID, int _iAr
   , sPrincipalsPath( "" )
   , ui8tPayloadType_in( 0 )
   , ui8tPayloadType_out( 0 )
+  , bFramed_in( false )
+  , bFramed_out( false )
+  , ui8tCompressionType_out( 0 )
+  , iOutputBufferSize_out( 0 )
+  , fdOutputBufferDelay_out( 1.0 )
+  , bOutputBufferSync_out( false )
+  , bMapped_in( false )
+  , bAsync_in( false )
+  , bAsync_out( false )
   , bExtendedContent( false )
   , poTransmit_in( NULL )
   , poTransmit_out( NULL )
@@ -267,7 +276,13 @@ void CSgctpUtilSkeleton::displayOptionPayload( bool _bInput, bool _bOutput )
     cout << "  -Ti, --payload-in <type>" << endl;
   if( _bOutput )
     cout << "  -To, --payload-out <type>" << endl;
-  cout << "    Payload type (default:0; 0=RAW, 1=AES128)" << endl;
+  cout << "    Payload type (default:0; 0=RAW, 1=AES128, 2=DELTA)" << endl;
+  if( _bInput )
+    cout << "  -Fi, --framed-in" << endl;
+  if( _bOutput )
+    cout << "  -Fo, --framed-out" << endl;
+  cout << "    Use multi-record frames (TCP client request or file output;" << endl;
+  cout << "    negotiated by TCP server and detected on file input)" << endl;
 }
 
 void CSgctpUtilSkeleton::displayOptionPassword( bool _bInput, bool _bOutput )
@@ -288,6 +303,40 @@ void CSgctpUtilSkeleton::displayOptionPasswordSalt( bool _bInput, bool _bOutput
   cout << "    Payload password salt" << endl;
 }
 
+void CSgctpUtilSkeleton::displayOptionCompression()
+{
+  cout << "  -Zo, --compression-out <type>" << endl;
+  cout << "    Output file compression type (default:0; 0=NONE, 1=LZ, 2=ZLIB)" << endl;
+  cout << "    (compressed files are detected and decompressed on file input)" << endl;
+}
+
+void CSgctpUtilSkeleton::displayOptionOutputBuffer()
+{
+  cout << "  -Bo, --output-buffer <size>" << endl;
+  cout << "    Output file buffer size, in bytes (default:0, unbuffered)" << endl;
+  cout << "  -Bt, --output-buffer-delay <seconds>" << endl;
+  cout << "    Output file buffer maximum delay (default:1.0; 0=none)" << endl;
+  cout << "  -Bs, --output-buffer-sync" << endl;
+  cout << "    Synchronize output file to disk after each buffer write" << endl;
+}
+
+void CSgctpUtilSkeleton::displayOptionMapped()
+{
+  cout << "  -Mi, --mmap-in" << endl;
+  cout << "    Memory-map input file (zero-copy unserialization;" << endl;
+  cout << "    ignored for non-regular files)" << endl;
+}
+
+void CSgctpUtilSkeleton::displayOptionAsync( bool _bInput, bool _bOutput )
+{
+  if( _bInput )
+    cout << "  -Ai, --async-in" << endl;
+  if( _bOutput )
+    cout << "  -Ao, --async-out" << endl;
+  cout << "    Asynchronous (io_uring) file I/O (read-ahead/background writes;" << endl;
+  cout << "    synchronous I/O is used if io_uring is not available)" << endl;
+}
+
 void CSgctpUtilSkeleton::displayOptionExtendedContent()
 {
   cout << "  -X, --extended-content" << endl;
@@ -381,6 +430,16 @@ int CSgctpUtilSkeleton::parseArgsPayload( int *_piArgI, bool _bInput, bool _bOut
       ui8tPayloadType_out = (uint8_t)atoi( ppcArgV[*_piArgI] );
     return 1;
   }
+  else if( _bInput && ( __sArg=="-Fi" || __sArg=="--framed-in" ) )
+  {
+    bFramed_in = true;
+    return 1;
+  }
+  else if( _bOutput && ( __sArg=="-Fo" || __sArg=="--framed-out" ) )
+  {
+    bFramed_out = true;
+    return 1;
+  }
   return 0;
 }
 
@@ -436,6 +495,68 @@ int CSgctpUtilSkeleton::parseArgsPasswordSalt( int *_piArgI, bool _bInput, bool
   return 0;
 }
 
+int CSgctpUtilSkeleton::parseArgsCompression( int *_piArgI )
+{
+  string __sArg = ppcArgV[*_piArgI];
+  if( __sArg=="-Zo" || __sArg=="--compression-out" )
+  {
+    if( (*_piArgI)++ < iArgC )
+      ui8tCompressionType_out = (uint8_t)atoi( ppcArgV[*_piArgI] );
+    return 1;
+  }
+  return 0;
+}
+
+int CSgctpUtilSkeleton::parseArgsOutputBuffer( int *_piArgI )
+{
+  string __sArg = ppcArgV[*_piArgI];
+  if( __sArg=="-Bo" || __sArg=="--output-buffer" )
+  {
+    if( (*_piArgI)++ < iArgC )
+      iOutputBufferSize_out = atoi( ppcArgV[*_piArgI] );
+    return 1;
+  }
+  else if( __sArg=="-Bt" || __sArg=="--output-buffer-delay" )
+  {
+    if( (*_piArgI)++ < iArgC )
+      fdOutputBufferDelay_out = strtod( ppcArgV[*_piArgI], NULL );
+    return 1;
+  }
+  else if( __sArg=="-Bs" || __sArg=="--output-buffer-sync" )
+  {
+    bOutputBufferSync_out = true;
+    return 1;
+  }
+  return 0;
+}
+
+int CSgctpUtilSkeleton::parseArgsMapped( int *_piArgI )
+{
+  string __sArg = ppcArgV[*_piArgI];
+  if( __sArg=="-Mi" || __sArg=="--mmap-in" )
+  {
+    bMapped_in = true;
+    return 1;
+  }
+  return 0;
+}
+
+int CSgctpUtilSkeleton::parseArgsAsync( int *_piArgI, bool _bInput, bool _bOutput )
+{
+  string __sArg = ppcArgV[*_piArgI];
+  if( _bInput && ( __sArg=="-Ai" || __sArg=="--async-in" ) )
+  {
+    bAsync_in = true;
+    return 1;
+  }
+  else if( _bOutput && ( __sArg=="-Ao" || __sArg=="--async-out" ) )
+  {
+    bAsync_out = true;
+    return 1;
+  }
+  return 0;
+}
+
 int CSgctpUtilSkeleton::parseArgsExtendedContent( int *_piArgI )
 {
   string __sArg = ppcArgV[*_piArgI];
@@ -592,6 +713,35 @@ int CSgctpUtilSkeleton::transmitInit( bool _bInput, bool _bOutput )
       SGCTP_LOG << SGCTP_ERROR << "Failed to initialize payload (" << to_string( ui8tPayloadType_in ) << ") @ initPayload=" << __iReturn << endl;
       return __iReturn;
     }
+    __iReturn = poTransmit_in->setFramed( bFramed_in );
+    if( __iReturn < 0 )
+    {
+      SGCTP_LOG << SGCTP_ERROR << "Failed to set framed mode @ setFramed=" << __iReturn << endl;
+      return __iReturn;
+    }
+    if( bMapped_in )
+    {
+      if( poTransmit_in->getTransmitType() != CTransmit::TRANSMIT_FILE )
+      {
+        SGCTP_LOG << SGCTP_ERROR << "Failed to set memory-mapped mode (non-file input)" << endl;
+        return -EINVAL;
+      }
+      ((CTransmit_File*)poTransmit_in)->setMapped( true );
+    }
+    if( bAsync_in )
+    {
+      __iReturn =
+        ( poTransmit_in->getTransmitType() == CTransmit::TRANSMIT_FILE )
+        ? ((CTransmit_File*)poTransmit_in)->setAsync( true )
+        : -EINVAL;
+      if( __iReturn == -ENOTSUP )
+        SGCTP_LOG << SGCTP_WARNING << "Asynchronous I/O not available; using synchronous I/O" << endl;
+      else if( __iReturn < 0 )
+      {
+        SGCTP_LOG << SGCTP_ERROR << "Failed to set asynchronous mode @ setAsync=" << __iReturn << endl;
+        return __iReturn;
+      }
+    }
   }
 
   // ... output
@@ -606,6 +756,52 @@ int CSgctpUtilSkeleton::transmitInit( bool _bInput, bool _bOutput )
       SGCTP_LOG << SGCTP_ERROR << "Failed to initialize payload (" << to_string( ui8tPayloadType_out ) << ") @ initPayload=" << __iReturn << endl;
       return __iReturn;
     }
+    __iReturn = poTransmit_out->setFramed( bFramed_out );
+    if( __iReturn < 0 )
+    {
+      SGCTP_LOG << SGCTP_ERROR << "Failed to set framed mode @ setFramed=" << __iReturn << endl;
+      return __iReturn;
+    }
+    if( ui8tCompressionType_out )
+    {
+      __iReturn =
+        ( poTransmit_out->getTransmitType() == CTransmit::TRANSMIT_FILE )
+        ? ((CTransmit_File*)poTransmit_out)->setCompression( ui8tCompressionType_out )
+        : -EINVAL;
+      if( __iReturn < 0 )
+      {
+        SGCTP_LOG << SGCTP_ERROR << "Failed to set compression (" << to_string( ui8tCompressionType_out ) << ") @ setCompression=" << __iReturn << endl;
+        return __iReturn;
+      }
+    }
+    if( iOutputBufferSize_out )
+    {
+      __iReturn =
+        ( poTransmit_out->getTransmitType() == CTransmit::TRANSMIT_FILE )
+        ? ((CTransmit_File*)poTransmit_out)->setOutputBuffer( iOutputBufferSize_out,
+                                                              fdOutputBufferDelay_out,
+                                                              bOutputBufferSync_out )
+        : -EINVAL;
+      if( __iReturn < 0 )
+      {
+        SGCTP_LOG << SGCTP_ERROR << "Failed to set output buffer (" << to_string( iOutputBufferSize_out ) << ") @ setOutputBuffer=" << __iReturn << endl;
+        return __iReturn;
+      }
+    }
+    if( bAsync_out )
+    {
+      __iReturn =
+        ( poTransmit_out->getTransmitType() == CTransmit::TRANSMIT_FILE )
+        ? ((CTransmit_File*)poTransmit_out)->setAsync( true )
+        : -EINVAL;
+      if( __iReturn == -ENOTSUP )
+        SGCTP_LOG << SGCTP_WARNING << "Asynchronous I/O not available; using synchronous I/O" << endl;
+      else if( __iReturn < 0 )
+      {
+        SGCTP_LOG << SGCTP_ERROR << "Failed to set asynchronous mode @ setAsync=" << __iReturn << endl;
+        return __iReturn;
+      }
+    }
   }
 
   // Done
@@ -163,6 +163,24 @@ protected:
   uint8_t ui8tPayloadType_in;
   /// Output payload type
   uint8_t ui8tPayloadType_out;
+  /// Input multi-record frames (framed mode)
+  bool bFramed_in;
+  /// Output multi-record frames (framed mode)
+  bool bFramed_out;
+  /// Output (file) compression type
+  uint8_t ui8tCompressionType_out;
+  /// Output (file) buffer size
+  int iOutputBufferSize_out;
+  /// Output (file) buffer maximum delay
+  double fdOutputBufferDelay_out;
+  /// Output (file) buffer synchronization (group commit)
+  bool bOutputBufferSync_out;
+  /// Input (file) memory-mapped mode
+  bool bMapped_in;
+  /// Input (file) asynchronous mode
+  bool bAsync_in;
+  /// Output (file) asynchronous mode
+  bool bAsync_out;
   /// Extended content usage
   bool bExtendedContent;
   /// Input transmission (generic) object pointer
@@ -223,6 +241,14 @@ protected:
   void displayOptionPassword( bool _bInput, bool _bOutput );
   /// Displays the password salt option(s)
   void displayOptionPasswordSalt( bool _bInput, bool _bOutput );
+  /// Displays the (output file) compression option
+  void displayOptionCompression();
+  /// Displays the (output file) buffer options
+  void displayOptionOutputBuffer();
+  /// Displays the (input file) memory-mapped mode option
+  void displayOptionMapped();
+  /// Displays the (file) asynchronous mode option(s)
+  void displayOptionAsync( bool _bInput, bool _bOutput );
   /// Displays the extended content option
   void displayOptionExtendedContent();
   /// Displays the daemon options
@@ -245,6 +271,14 @@ protected:
   int parseArgsPassword( int *_piArgI, bool _bInput, bool _bOutput );
   /// Parses the password salt option(s)
   int parseArgsPasswordSalt( int *_piArgI, bool _bInput, bool _bOutput );
+  /// Parses the (output file) compression option
+  int parseArgsCompression( int *_piArgI );
+  /// Parses the (output file) buffer options
+  int parseArgsOutputBuffer( int *_piArgI );
+  /// Parses the (input file) memory-mapped mode option
+  int parseArgsMapped( int *_piArgI );
+  /// Parses the (file) asynchronous mode option(s)
+  int parseArgsAsync( int *_piArgI, bool _bInput, bool _bOutput );
   /// Parses the extended content option
   int parseArgsExtendedContent( int *_piArgI );
   /// Parses the daemon options
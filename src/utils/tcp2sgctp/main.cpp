@@ -79,6 +79,9 @@ void CSgctpUtil::displayHelp()
   cout << "    Host port (defaut:8947)" << endl;
   displayOptionPrincipal( false, true );
   displayOptionPayload( false, true );
+  displayOptionCompression();
+  displayOptionOutputBuffer();
+  displayOptionAsync( false, true );
   displayOptionPassword( false, true );
   displayOptionPasswordSalt( false, true );
   displayOptionDaemon();
@@ -98,6 +101,9 @@ int CSgctpUtil::parseArgs()
       SGCTP_PARSE_ARGS( parseArgsHelp( &__i ) );
       SGCTP_PARSE_ARGS( parseArgsPrincipal( &__i, false, true ) );
       SGCTP_PARSE_ARGS( parseArgsPayload( &__i, false, true ) );
+      SGCTP_PARSE_ARGS( parseArgsCompression( &__i ) );
+      SGCTP_PARSE_ARGS( parseArgsOutputBuffer( &__i ) );
+      SGCTP_PARSE_ARGS( parseArgsAsync( &__i, false, true ) );
       SGCTP_PARSE_ARGS( parseArgsPassword( &__i, false, true ) );
       SGCTP_PARSE_ARGS( parseArgsPasswordSalt( &__i, false, true ) );
       SGCTP_PARSE_ARGS( parseArgsDaemon( &__i ) );
@@ -322,6 +328,19 @@ int CSgctpUtil::exec()
             SGCTP_BREAK( -1 );
           }
 
+          // ... send pending frames (no more input data available)
+          if( !oTransmit_in.hasData() )
+          {
+            sigBlock();
+            __iReturn = oTransmit_out.flushFrames( fdOutput );
+            sigUnblock();
+            if( __iReturn < 0 )
+            {
+              SGCTP_LOG << SGCTP_ERROR << "Failed to serialize data @ flushFrames=" << __iReturn << endl;
+              SGCTP_BREAK( -1 );
+            }
+          }
+
         }
 
       }
@@ -341,6 +360,8 @@ int CSgctpUtil::exec()
     close( sdInput );
   if( ptAddrinfo_in )
     free( ptAddrinfo_in );
+  if( fdOutput >= 0 )
+    oTransmit_out.finish( fdOutput );
   if( fdOutput >= 0 && fdOutput != STDOUT_FILENO )
     close( fdOutput );
   daemonEnd();
@@ -79,6 +79,9 @@ void CSgctpUtil::displayHelp()
   cout << "    Host port (defaut:8947)" << endl;
   displayOptionPrincipal( true, true );
   displayOptionPayload( true, true );
+  displayOptionCompression();
+  displayOptionOutputBuffer();
+  displayOptionAsync( false, true );
   displayOptionPassword( true, true );
   displayOptionPasswordSalt( true, true );
   displayOptionDaemon();
@@ -96,6 +99,9 @@ int CSgctpUtil::parseArgs()
       SGCTP_PARSE_ARGS( parseArgsHelp( &__i ) );
       SGCTP_PARSE_ARGS( parseArgsPrincipal( &__i, true, true ) );
       SGCTP_PARSE_ARGS( parseArgsPayload( &__i, true, true ) );
+      SGCTP_PARSE_ARGS( parseArgsCompression( &__i ) );
+      SGCTP_PARSE_ARGS( parseArgsOutputBuffer( &__i ) );
+      SGCTP_PARSE_ARGS( parseArgsAsync( &__i, false, true ) );
       SGCTP_PARSE_ARGS( parseArgsPassword( &__i, true, true ) );
       SGCTP_PARSE_ARGS( parseArgsPasswordSalt( &__i, true, true ) );
       SGCTP_PARSE_ARGS( parseArgsDaemon( &__i ) );
@@ -247,6 +253,14 @@ int CSgctpUtil::exec()
     }
 
     // Receive and dump data
+    // NOTE: several datagrams are received at once (see CTransmit_UDP::unserializeBatch)
+    CDataBlock __oDataBlock;
+    __iReturn = __oDataBlock.alloc( CTransmit_UDP::DATAGRAM_BATCH_SIZE );
+    if( __iReturn < 0 )
+    {
+      SGCTP_LOG << SGCTP_ERROR << "Failed to allocate data block @ alloc=" << __iReturn << endl;
+      SGCTP_BREAK( __iReturn );
+    }
     CData __oData;
     for(;;)
     {
@@ -254,20 +268,41 @@ int CSgctpUtil::exec()
         break;
 
       // ... unserialize
-      __iReturn = oTransmit_in.unserialize( sdInput, &__oData );
+      __oDataBlock.reset();
+      __iReturn = oTransmit_in.unserializeBatch( sdInput, &__oDataBlock );
       if( SGCTP_INTERRUPTED )
         break;
       if( __iReturn == 0 )
         break;
+      for( int __i = 0; __i < oTransmit_in.getDatagramCount(); __i++ )
+      {
+        int __iStatus = oTransmit_in.getDatagram( __i )->iStatus;
+        if( __iStatus < 0 )
+          SGCTP_LOG << SGCTP_WARNING << "Failed to unserialize data @ unserialize=" << __iStatus << endl;
+      }
       if( __iReturn < 0 )
       {
-        SGCTP_LOG << SGCTP_WARNING << "Failed to unserialize data @ unserialize=" << __iReturn << endl;
+        if( !oTransmit_in.getDatagramCount() )
+          SGCTP_LOG << SGCTP_WARNING << "Failed to receive data @ unserializeBatch=" << __iReturn << endl;
         continue;
       }
 
       // ... serialize
       sigBlock();
-      __iReturn = oTransmit_out.serialize( fdOutput, __oData );
+      for( int __i = 0; __i < __oDataBlock.getSize(); __i++ )
+      {
+        __oDataBlock.getRecord( __i, &__oData );
+        __iReturn = oTransmit_out.serialize( fdOutput, __oData );
+        if( __iReturn <= 0 )
+          break;
+      }
+      if( __iReturn > 0 )
+      {
+        // ... send pending frames
+        int __iReturnFlush = oTransmit_out.flushFrames( fdOutput );
+        if( __iReturnFlush < 0 )
+          __iReturn = __iReturnFlush;
+      }
       sigUnblock();
       if( __iReturn == 0 )
         SGCTP_BREAK( 0 );
@@ -287,6 +322,8 @@ int CSgctpUtil::exec()
     close( sdInput );
   if( ptAddrinfo_in )
     free( ptAddrinfo_in );
+  if( fdOutput >= 0 )
+    oTransmit_out.finish( fdOutput );
   if( fdOutput >= 0 && fdOutput != STDOUT_FILENO )
     close( fdOutput );
   daemonEnd();